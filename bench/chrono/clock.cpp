@@ -0,0 +1,48 @@
+#include <benchmark/benchmark.h>
+
+import mini.core;
+
+using namespace mini;
+
+static void ClockNow(benchmark::State& state)
+{
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Clock::Now());
+    }
+}
+
+static void CycleClockNow(benchmark::State& state)
+{
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CycleClock::Now());
+    }
+}
+
+static void CycleClockCycles(benchmark::State& state)
+{
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CycleClock::Cycles());
+    }
+}
+
+static void CycleClockCyclesOrdered(benchmark::State& state)
+{
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CycleClock::CyclesOrdered());
+    }
+}
+
+static void CoarseClockNow(benchmark::State& state)
+{
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CoarseClock::Now());
+    }
+}
+
+BENCHMARK(ClockNow);
+BENCHMARK(CycleClockNow);
+BENCHMARK(CycleClockCycles);
+BENCHMARK(CycleClockCyclesOrdered);
+BENCHMARK(CoarseClockNow);
+
+BENCHMARK_MAIN();
\ No newline at end of file
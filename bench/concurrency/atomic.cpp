@@ -31,6 +31,15 @@ public:
     operator int32() const noexcept { return v[0]; }
 };
 
+struct Large {
+public:
+    int32 v[16];
+
+    Large() noexcept = default;
+    Large(int32 n) noexcept { memory::FillRange(&v[0], &v[16], n); }
+    operator int32() const noexcept { return v[15]; }
+};
+
 static void NoOp(benchmark::State& state)
 {
     for (; state.KeepRunning(););
@@ -80,6 +89,8 @@ BENCHMARK_TEMPLATE(AtomicLoad, Unaligned);
 BENCHMARK_TEMPLATE(AtomicLoad_std, Unaligned);
 BENCHMARK_TEMPLATE(AtomicLoad, NonAtomic);
 BENCHMARK_TEMPLATE(AtomicLoad_std, NonAtomic);
+BENCHMARK_TEMPLATE(AtomicLoad, Large);
+BENCHMARK_TEMPLATE(AtomicLoad_std, Large);
 
 template <typename T>
     requires ConstructibleFromT<T, int32> && ConvertibleToT<T, int32>
@@ -117,6 +128,8 @@ BENCHMARK_TEMPLATE(AtomicStore, Unaligned);
 BENCHMARK_TEMPLATE(AtomicStore_std, Unaligned);
 BENCHMARK_TEMPLATE(AtomicStore, NonAtomic);
 BENCHMARK_TEMPLATE(AtomicStore_std, NonAtomic);
+BENCHMARK_TEMPLATE(AtomicStore, Large);
+BENCHMARK_TEMPLATE(AtomicStore_std, Large);
 
 template <typename T>
     requires ConstructibleFromT<T, int32> && ConvertibleToT<T, int32>
@@ -158,6 +171,84 @@ BENCHMARK_TEMPLATE(AtomicCompareExchange, Unaligned);
 BENCHMARK_TEMPLATE(AtomicCompareExchange_std, Unaligned);
 BENCHMARK_TEMPLATE(AtomicCompareExchange, NonAtomic);
 BENCHMARK_TEMPLATE(AtomicCompareExchange_std, NonAtomic);
+BENCHMARK_TEMPLATE(AtomicCompareExchange, Large);
+BENCHMARK_TEMPLATE(AtomicCompareExchange_std, Large);
+
+template <typename T>
+    requires ConstructibleFromT<T, int32> && ConvertibleToT<T, int32>
+static void AtomicReadMostly(benchmark::State& state)
+{
+    Atomic<T> a(1);
+    Atomic<bool> done(false);
+    std::thread t([&a, &done]() {
+        for (int32 i = 1; !done.Load(MemoryOrder::relaxed); ++i) {
+            a.Store(i & 0xffff, MemoryOrder::release);
+            std::this_thread::yield();
+        }
+    });
+
+    int32 sum = 0;
+    for (auto _ : state) {
+        sum += static_cast<int32>(a.Load(MemoryOrder::acquire));
+    }
+
+    done.Store(true, MemoryOrder::relaxed);
+    t.join();
+    benchmark::DoNotOptimize(sum);
+}
+
+template <typename T>
+    requires ConstructibleFromT<T, int32> && ConvertibleToT<T, int32>
+static void AtomicReadMostly_std(benchmark::State& state)
+{
+    std::atomic<T> a(1);
+    std::atomic<bool> done(false);
+    std::thread t([&a, &done]() {
+        for (int32 i = 1; !done.load(std::memory_order::relaxed); ++i) {
+            a.store(i & 0xffff, std::memory_order::release);
+            std::this_thread::yield();
+        }
+    });
+
+    int32 sum = 0;
+    for (auto _ : state) {
+        sum += static_cast<int32>(a.load(std::memory_order::acquire));
+    }
+
+    done.store(true, std::memory_order::relaxed);
+    t.join();
+    benchmark::DoNotOptimize(sum);
+}
+
+template <typename T>
+    requires ConstructibleFromT<T, int32> && ConvertibleToT<T, int32>
+static void SeqLockReadMostly(benchmark::State& state)
+{
+    SeqLock<T> lock(1);
+    Atomic<bool> done(false);
+    std::thread t([&lock, &done]() {
+        for (int32 i = 1; !done.Load(MemoryOrder::relaxed); ++i) {
+            lock.Store(i & 0xffff);
+            std::this_thread::yield();
+        }
+    });
+
+    int32 sum = 0;
+    for (auto _ : state) {
+        sum += static_cast<int32>(lock.Load());
+    }
+
+    done.Store(true, MemoryOrder::relaxed);
+    t.join();
+    benchmark::DoNotOptimize(sum);
+}
+
+BENCHMARK_TEMPLATE(AtomicReadMostly, NonAtomic);
+BENCHMARK_TEMPLATE(AtomicReadMostly_std, NonAtomic);
+BENCHMARK_TEMPLATE(SeqLockReadMostly, NonAtomic);
+BENCHMARK_TEMPLATE(AtomicReadMostly, Large);
+BENCHMARK_TEMPLATE(AtomicReadMostly_std, Large);
+BENCHMARK_TEMPLATE(SeqLockReadMostly, Large);
 
 static void AtomicFalseWait(benchmark::State& state)
 {
@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+import mini.core;
+
+using namespace mini;
+
+struct SharedAtomic {
+public:
+    Atomic<int64> value;
+
+    SharedAtomic() noexcept
+        : value(0)
+    {
+    }
+
+    void Add() noexcept { value.FetchAdd(1, MemoryOrder::relaxed); }
+    int64 Load() const noexcept { return value.Load(MemoryOrder::relaxed); }
+};
+
+struct Sharded {
+public:
+    ShardedCounter value;
+
+    void Add() { value.Add(); }
+    int64 Load() const noexcept { return value.Load(); }
+};
+
+struct PerCpu {
+public:
+    PerCpuCounter value;
+
+    void Add() noexcept { value.Add(); }
+    int64 Load() const noexcept { return value.Load(); }
+};
+
+template <typename Counter>
+static void CounterAdd(benchmark::State& state)
+{
+    static Counter* counter = nullptr;
+    if (state.thread_index() == 0) {
+        counter = new Counter();
+    }
+
+    for (auto _ : state) {
+        counter->Add();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        benchmark::DoNotOptimize(counter->Load());
+        delete counter;
+    }
+}
+
+template <typename Counter>
+static void CounterLoad(benchmark::State& state)
+{
+    Counter counter;
+    for (auto _ : state) {
+        counter.Add();
+        benchmark::DoNotOptimize(counter.Load());
+    }
+}
+
+BENCHMARK_TEMPLATE(CounterAdd, SharedAtomic)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(CounterAdd, Sharded)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(CounterAdd, PerCpu)->ThreadRange(1, 8)->UseRealTime();
+
+BENCHMARK_TEMPLATE(CounterLoad, SharedAtomic);
+BENCHMARK_TEMPLATE(CounterLoad, Sharded);
+BENCHMARK_TEMPLATE(CounterLoad, PerCpu);
+
+BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,185 @@
+#include <benchmark/benchmark.h>
+#include <thread>
+
+import mini.core;
+
+using namespace mini;
+
+constexpr size_t queueCapacity = 1024;
+constexpr size_t batchSize = 32;
+
+// baseline, single threaded queue guarded by a mutex
+template <typename T, size_t CapacityN>
+class MutexQueue {
+private:
+    Mutex m_mutex;
+    FixedQueue<T, CapacityN> m_queue;
+
+public:
+    bool TryEnqueue(T value)
+    {
+        m_mutex.Lock();
+        bool result = !m_queue.Full();
+        if (result) {
+            m_queue.Enqueue(value);
+        }
+
+        m_mutex.Unlock();
+        return result;
+    }
+
+    bool TryDequeue(T& value)
+    {
+        m_mutex.Lock();
+        bool result = !m_queue.Empty();
+        if (result) {
+            value = m_queue.Dequeue();
+        }
+
+        m_mutex.Unlock();
+        return result;
+    }
+};
+
+template <typename Queue>
+static void QueueThroughput(benchmark::State& state)
+{
+    Queue* queue = new Queue();
+    Atomic<bool> stop(false);
+    std::thread producer([queue, &stop]() {
+        uint64 value = 0;
+        while (!stop.Load(MemoryOrder::relaxed)) {
+            if (queue->TryEnqueue(value)) {
+                ++value;
+            }
+        }
+    });
+
+    uint64 sum = 0;
+    for (auto _ : state) {
+        uint64 value;
+        while (!queue->TryDequeue(value)) { }
+        sum += value;
+    }
+
+    stop.Store(true, MemoryOrder::relaxed);
+    producer.join();
+    delete queue;
+
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Queue>
+static void QueueBatchThroughput(benchmark::State& state)
+{
+    Queue* queue = new Queue();
+    Atomic<bool> stop(false);
+    std::thread producer([queue, &stop]() {
+        FixedArray<uint64, batchSize> batch;
+        for (uint64 i = 0; i < batchSize; ++i) {
+            batch.Push(i);
+        }
+
+        while (!stop.Load(MemoryOrder::relaxed)) {
+            queue->TryEnqueueRange(batch.Begin(), batch.End());
+        }
+    });
+
+    FixedArray<uint64, batchSize> batch;
+    for (uint64 i = 0; i < batchSize; ++i) {
+        batch.Push(0);
+    }
+
+    uint64 received = 0;
+    for (auto _ : state) {
+        received += queue->TryDequeueRange(batch.Begin(), batch.End());
+    }
+
+    stop.Store(true, MemoryOrder::relaxed);
+    producer.join();
+    delete queue;
+
+    state.SetItemsProcessed(static_cast<int64>(received));
+}
+
+template <typename Queue>
+static void QueueMultiThroughput(benchmark::State& state)
+{
+    static Queue* queue = nullptr;
+    static Atomic<bool> stop(false);
+    static std::thread producer;
+
+    if (state.thread_index() == 0) {
+        queue = new Queue();
+        stop.Store(false, MemoryOrder::relaxed);
+        producer = std::thread([]() {
+            uint64 value = 0;
+            while (!stop.Load(MemoryOrder::relaxed)) {
+                value += queue->TryEnqueue(value) ? 1 : 0;
+            }
+        });
+    }
+
+    uint64 sum = 0;
+    for (auto _ : state) {
+        uint64 value = 0;
+        if (queue->TryDequeue(value)) {
+            sum += value;
+        }
+    }
+
+    if (state.thread_index() == 0) {
+        stop.Store(true, MemoryOrder::relaxed);
+        producer.join();
+        delete queue;
+    }
+
+    benchmark::DoNotOptimize(sum);
+}
+
+template <typename Queue>
+static void QueueLatency(benchmark::State& state)
+{
+    // round trip of a single element through two queues, ping-pong with an echo thread
+    Queue* request = new Queue();
+    Queue* response = new Queue();
+    std::thread echo([request, response]() {
+        uint64 value = 0;
+        do {
+            while (!request->TryDequeue(value)) { }
+            while (!response->TryEnqueue(value)) { }
+        } while (value != 0);
+    });
+
+    uint64 value = 1;
+    for (auto _ : state) {
+        while (!request->TryEnqueue(value)) { }
+        while (!response->TryDequeue(value)) { }
+    }
+
+    while (!request->TryEnqueue(0)) { }
+    echo.join();
+    delete request;
+    delete response;
+}
+
+typedef SpscQueue<uint64, queueCapacity> Spsc;
+typedef MpmcQueue<uint64, queueCapacity> Mpmc;
+typedef MutexQueue<uint64, queueCapacity> Locked;
+
+BENCHMARK_TEMPLATE(QueueThroughput, Spsc);
+BENCHMARK_TEMPLATE(QueueThroughput, Mpmc);
+BENCHMARK_TEMPLATE(QueueThroughput, Locked);
+
+BENCHMARK_TEMPLATE(QueueBatchThroughput, Spsc);
+BENCHMARK_TEMPLATE(QueueBatchThroughput, Mpmc);
+
+BENCHMARK_TEMPLATE(QueueMultiThroughput, Mpmc)->Threads(2)->Threads(4);
+BENCHMARK_TEMPLATE(QueueMultiThroughput, Locked)->Threads(2)->Threads(4);
+
+BENCHMARK_TEMPLATE(QueueLatency, Spsc);
+BENCHMARK_TEMPLATE(QueueLatency, Mpmc);
+BENCHMARK_TEMPLATE(QueueLatency, Locked);
+
+BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,30 @@
+#include <benchmark/benchmark.h>
+
+import mini.core;
+
+using namespace mini;
+
+static Histogram histogram;
+
+static void HistogramRecord(benchmark::State& state)
+{
+    uint64 value = 1;
+    for (auto _ : state) {
+        histogram.Record(value);
+        value = value * 6364136223846793005ull + 1442695040888963407ull;
+    }
+}
+
+static void HistogramSnapshotMerge(benchmark::State& state)
+{
+    for (auto _ : state) {
+        HistogramSnapshot snapshot;
+        histogram.Snapshot(snapshot);
+        benchmark::DoNotOptimize(snapshot.Percentile(99.0));
+    }
+}
+
+BENCHMARK(HistogramRecord)->ThreadRange(1, 8);
+BENCHMARK(HistogramSnapshotMerge);
+
+BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include <benchmark/benchmark.h>
+
+import mini.core;
+
+using namespace mini;
+
+class NullSink final : public LogSink {
+public:
+    void Write(LogRecord const& record) final { benchmark::DoNotOptimize(record.Message().Data()); }
+};
+
+// takes deferred records as they are, so the sink thread keeps up with the producers
+class BinaryNullSink final : public LogSink {
+public:
+    void Write(LogRecord const& record) final { benchmark::DoNotOptimize(record.Payload()); }
+    bool AcceptsDeferred() const noexcept final { return true; }
+};
+
+static Logger logger("bench");
+
+static void LogRecordFormat(benchmark::State& state)
+{
+    int32 frame = 0;
+    for (auto _ : state) {
+        LogRecord record(nullptr, 1, SourceLocation::current(), "frame {} took {:.2f} ms", ++frame, 16.6);
+        benchmark::DoNotOptimize(record.Message().Data());
+    }
+}
+
+static void LogRecordDeferred(benchmark::State& state)
+{
+    LogSite const* site =
+        LogSiteTable::Find(SourceLocation::current(), "frame {} took {:.2f} ms", logArgTypes<int32, double>, 2);
+
+    int32 frame = 0;
+    for (auto _ : state) {
+        LogRecord record(nullptr, 1, site, ++frame, 16.6);
+        benchmark::DoNotOptimize(record.Payload());
+    }
+}
+
+static void LoggerAsync(benchmark::State& state)
+{
+    if (state.thread_index() == 0) {
+        LogQueue::Start(UniquePtr<LogSink>(new NullSink()), LogOverflow::block, false);
+    }
+
+    int32 frame = 0;
+    for (auto _ : state) {
+        logger.Info("frame {} took {:.2f} ms", ++frame, 16.6);
+    }
+
+    if (state.thread_index() == 0) {
+        LogQueue::Stop();
+    }
+}
+
+static void LoggerDeferred(benchmark::State& state)
+{
+    if (state.thread_index() == 0) {
+        LogQueue::Start(UniquePtr<LogSink>(new BinaryNullSink()), LogOverflow::block);
+    }
+
+    int32 frame = 0;
+    for (auto _ : state) {
+        logger.Info("frame {} took {:.2f} ms", ++frame, 16.6);
+    }
+
+    if (state.thread_index() == 0) {
+        LogQueue::Stop();
+    }
+}
+
+static void LoggerFiltered(benchmark::State& state)
+{
+    Logger filtered("bench.filtered");
+    filtered.SetLevel(Logger::Level::error);
+
+    int32 frame = 0;
+    for (auto _ : state) {
+        filtered.Info("frame {} took {:.2f} ms", ++frame, 16.6);
+    }
+}
+
+static void LogRateLimitAcquire(benchmark::State& state)
+{
+    LogRateLimit::Configure(1'000'000'000, 1);
+
+    SourceLocation location = SourceLocation::current();
+    uint32 suppressed = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(LogRateLimit::Acquire(location, suppressed));
+    }
+
+    LogRateLimit::Configure(0, 0);
+}
+
+static void LoggerAsyncPlain(benchmark::State& state)
+{
+    if (state.thread_index() == 0) {
+        LogQueue::Start(UniquePtr<LogSink>(new NullSink()), LogOverflow::block);
+    }
+
+    for (auto _ : state) {
+        logger.Info("resource loaded");
+    }
+
+    if (state.thread_index() == 0) {
+        LogQueue::Stop();
+    }
+}
+
+BENCHMARK(LogRecordFormat);
+BENCHMARK(LogRecordDeferred);
+BENCHMARK(LoggerAsync)->ThreadRange(1, 8);
+BENCHMARK(LoggerDeferred)->ThreadRange(1, 8);
+BENCHMARK(LoggerAsyncPlain);
+BENCHMARK(LoggerFiltered);
+BENCHMARK(LogRateLimitAcquire);
+
+BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,43 @@
+#include <benchmark/benchmark.h>
+
+import mini.core;
+
+using namespace mini;
+
+static void ProfileScopeEnabled(benchmark::State& state)
+{
+    Profiler::SetEnabled(true);
+    for (auto _ : state) {
+        ProfileScope scope("bench.enabled");
+    }
+}
+
+static void ProfileScopeDisabled(benchmark::State& state)
+{
+    Profiler::SetEnabled(false);
+    for (auto _ : state) {
+        ProfileScope scope("bench.disabled");
+    }
+
+    Profiler::SetEnabled(true);
+}
+
+static void ProfileExport(benchmark::State& state)
+{
+    Profiler::Clear();
+    for (int64 i = 0; i < state.range(0); ++i) {
+        ProfileScope scope("bench.export");
+    }
+
+    for (auto _ : state) {
+        String trace;
+        Profiler::Export(trace);
+        benchmark::DoNotOptimize(trace.Data());
+    }
+}
+
+BENCHMARK(ProfileScopeEnabled)->ThreadRange(1, 8);
+BENCHMARK(ProfileScopeDisabled);
+BENCHMARK(ProfileExport)->Arg(1024)->Arg(Profiler::bufferCapacity);
+
+BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include <benchmark/benchmark.h>
+#include <cstdio>
+
+import mini.core;
+
+using namespace mini;
+
+static constexpr uint32 chunkSize = 1024 * 1024;
+
+// files are written once per configuration and opened for direct io, so that the page cache does not
+// turn every backend into a memory copy.
+struct FileSet {
+public:
+    Array<AsyncFile> files;
+    uint32 fileCount;
+    uint32 fileSize;
+    uint32 requestSize;
+
+    FileSet(uint32 count, uint32 size)
+        : files()
+        , fileCount(count)
+        , fileSize(size)
+        , requestSize(size < chunkSize ? size : chunkSize)
+    {
+        IoBuffer content(size);
+        for (size_t i = 0; i < content.Size(); ++i) {
+            content.Data()[i] = static_cast<byte>(i);
+        }
+
+        FileOpenOptions writeOptions;
+        writeOptions.write = true;
+        writeOptions.create = true;
+
+        FileOpenOptions readOptions;
+        readOptions.direct = true;
+
+        files.Reserve(count);
+        for (uint32 i = 0; i < count; ++i) {
+            char path[64];
+            Path(path, i);
+
+            AsyncFile writer;
+            writer.Open(path, writeOptions);
+            writer.WriteAt(0, content.Data(), size);
+            writer.Close();
+
+            files.Push(AsyncFile());
+            files.Last().Open(path, readOptions);
+        }
+    }
+
+    ~FileSet()
+    {
+        for (uint32 i = 0; i < fileCount; ++i) {
+            char path[64];
+            Path(path, i);
+
+            files[i].Close();
+            std::remove(path);
+        }
+    }
+
+    uint32 RequestCount() const noexcept { return fileCount * (fileSize / requestSize); }
+
+    static void Path(char* buffer, uint32 index) noexcept
+    {
+        std::snprintf(buffer, 64, "mini_bench_io_%u.bin", index);
+    }
+};
+
+static void SetProcessed(benchmark::State& state, FileSet const& set)
+{
+    state.SetBytesProcessed(static_cast<int64>(state.iterations()) * set.fileCount * set.fileSize);
+    state.SetItemsProcessed(static_cast<int64>(state.iterations()) * set.RequestCount());
+}
+
+static void ReadSync(benchmark::State& state)
+{
+    FileSet set(static_cast<uint32>(state.range(0)), static_cast<uint32>(state.range(1)));
+    IoBuffer buffer(set.requestSize);
+
+    for (auto _ : state) {
+        for (AsyncFile const& file : set.files) {
+            for (uint32 offset = 0; offset < set.fileSize; offset += set.requestSize) {
+                benchmark::DoNotOptimize(file.ReadAt(offset, buffer.Data(), set.requestSize));
+            }
+        }
+    }
+
+    SetProcessed(state, set);
+}
+
+static void ReadQueue(benchmark::State& state, bool forceThreadPool)
+{
+    FileSet set(static_cast<uint32>(state.range(0)), static_cast<uint32>(state.range(1)));
+
+    IoQueueOptions options;
+    options.forceThreadPool = forceThreadPool;
+    options.threadCount = 4;
+
+    IoQueue queue(options);
+    if (!forceThreadPool && queue.Backend() != IoBackend::ioUring) {
+        state.SkipWithError("io_uring is not available");
+        return;
+    }
+
+    uint32 requestCount = set.RequestCount();
+    Array<IoBuffer> buffers;
+    buffers.Reserve(requestCount);
+    for (uint32 i = 0; i < requestCount; ++i) {
+        buffers.Push(IoBuffer(set.requestSize));
+    }
+
+    // requests are pinned in place while in flight, hence not kept in a growable array
+    IoRequest* requests = new IoRequest[requestCount];
+
+    for (auto _ : state) {
+        uint32 index = 0;
+        for (AsyncFile const& file : set.files) {
+            for (uint32 offset = 0; offset < set.fileSize; offset += set.requestSize, ++index) {
+                requests[index].PrepareRead(file, offset, buffers[index].Data(), set.requestSize);
+                queue.Submit(requests[index]);
+            }
+        }
+
+        queue.Flush();
+
+        for (uint32 i = 0; i < requestCount; ++i) {
+            requests[i].Wait();
+            benchmark::DoNotOptimize(requests[i].Result());
+        }
+    }
+
+    delete[] requests;
+    SetProcessed(state, set);
+}
+
+static void ReadThreadPool(benchmark::State& state)
+{
+    ReadQueue(state, true);
+}
+
+static void ReadIoUring(benchmark::State& state)
+{
+    ReadQueue(state, false);
+}
+
+// many small files against a few large ones, the former is bound by request overhead and the latter by bandwidth
+#define IO_ARGS ->Args({ 256, 4096 })->Args({ 4, 16 * 1024 * 1024 })->UseRealTime()->Unit(benchmark::kMillisecond)
+
+BENCHMARK(ReadSync) IO_ARGS;
+BENCHMARK(ReadThreadPool) IO_ARGS;
+BENCHMARK(ReadIoUring) IO_ARGS;
+
+BENCHMARK_MAIN();
\ No newline at end of file
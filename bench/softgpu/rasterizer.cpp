@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+import mini.core;
+import mini.softgpu;
+
+using namespace mini;
+using namespace mini::softgpu;
+
+static constexpr int32 frameWidth = 1280;
+static constexpr int32 frameHeight = 720;
+
+// a frame of small triangles spread over the screen, the same every run so kernels compare on equal work
+static Array<Vertex> MakeScene(int32 triangleCount)
+{
+    Array<Vertex> vertices;
+    uint32 seed = 1;
+    auto random = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return float32(seed >> 8) / float32(1 << 24);
+    };
+
+    vertices.Reserve(static_cast<size_t>(triangleCount) * 3);
+    for (int32 i = 0; i < triangleCount; ++i) {
+        float32 x = random() * 2.f - 1.f;
+        float32 y = random() * 2.f - 1.f;
+        Color color(random(), random(), random(), 1.f);
+
+        vertices.Push(Vertex{ Vector4(x, y, random(), 1.f), color });
+        vertices.Push(Vertex{ Vector4(x + 0.1f, y, random(), 1.f), color });
+        vertices.Push(Vertex{ Vector4(x, y + 0.1f, random(), 1.f), color });
+    }
+
+    return vertices;
+}
+
+static void Draw(benchmark::State& state)
+{
+    bool simd = state.range(0) != 0;
+    uint32 workers = static_cast<uint32>(state.range(1));
+    int32 triangleCount = static_cast<int32>(state.range(2));
+
+    if (simd && !Rasterizer::SimdSupported()) {
+        state.SkipWithError("no SIMD kernel on this processor");
+        return;
+    }
+
+    Array<Vertex> vertices = MakeScene(triangleCount);
+    FrameBuffer buffer;
+    buffer.Resize(frameWidth, frameHeight);
+
+    Rasterizer rasterizer(workers);
+    rasterizer.SetSimd(simd);
+    rasterizer.SetViewport(Rect(0.f, 0.f, float32(frameWidth), float32(frameHeight)), 0.f, 1.f);
+
+    for (auto _ : state) {
+        rasterizer.Reset();
+        rasterizer.Submit(vertices.Data(), vertices.Size());
+        rasterizer.Draw(buffer);
+        benchmark::DoNotOptimize(buffer.ColorData());
+    }
+
+    state.SetItemsProcessed(static_cast<int64>(state.iterations()) * triangleCount);
+    state.counters["pixels"] = benchmark::Counter(static_cast<double>(frameWidth) * frameHeight,
+                                                  benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// simd, workers, triangles
+BENCHMARK(Draw)
+    ->ArgsProduct({ { 0, 1 }, { 0, 3 }, { 1000, 10000 } })
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
\ No newline at end of file
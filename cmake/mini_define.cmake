@@ -23,6 +23,15 @@ elseif (APPLE)
     else()
         message(FATAL_ERROR "unsupproted arch: " ${BUILD_TARGET_ARCH})
     endif()
+elseif (LINUX)
+    if (BUILD_TARGET_ARCH MATCHES "[Aa][Aa][Rr][Cc][Hh]64|[Aa][Rr][Mm]64")
+        set(ARM64 1)
+    elseif (BUILD_TARGET_ARCH MATCHES "[Xx]86_64|[Aa][Mm][Dd]64")
+        set(X86 1)
+        set(X86_64 1)
+    else()
+        message(FATAL_ERROR "unsupproted arch: " ${BUILD_TARGET_ARCH})
+    endif()
 endif()
 
 # define compiler specific compile definitions
@@ -50,6 +59,29 @@ else()
     set(assert "true")
 endif()
 
+if (PROFILE_LEVEL STREQUAL "Debug")
+    set(profile "$<CONFIG:Debug>")
+elseif (PROFILE_LEVEL STREQUAL "Develop")
+    set(profile "$<CONFIG:Debug,Develop>")
+elseif (PROFILE_LEVEL STREQUAL "Release")
+    set(profile "$<CONFIG:Debug,Develop,Release>")
+else()
+    set(profile "false")
+endif()
+
+# lowest log level compiled into develop and release builds, debug builds keep every level
+if (LOG_LEVEL STREQUAL "Debug")
+    set(log_level 0)
+elseif (LOG_LEVEL STREQUAL "Warn")
+    set(log_level 2)
+elseif (LOG_LEVEL STREQUAL "Error")
+    set(log_level 3)
+elseif (LOG_LEVEL STREQUAL "Fatal")
+    set(log_level 4)
+else()
+    set(log_level 1)
+endif()
+
 module_global_definitions(
     ENGINE_PROJECT_NAME="${ENGINE_PROJECT_NAME}"
     ENGINE_PROJECT_AUTHOR="${ENGINE_PROJECT_AUTHOR}"
@@ -61,6 +93,8 @@ module_global_definitions(
     DEVELOP=$<IF:$<CONFIG:Develop>,true,false>
     RELEASE=$<IF:$<CONFIG:Release>,true,false>
     NOASSERT=$<IF:${assert},false,true>
+    NOPROFILE=$<IF:${profile},false,true>
+    LOG_MIN_LEVEL=$<IF:$<CONFIG:Debug>,0,${log_level}>
 )
 
 # handle compiler specific definition here
@@ -16,4 +16,15 @@ public:
     static TimePoint Now() noexcept { return ClockNow<Duration>(); }
 };
 
+// Monotonic clock for timestamps that only need millisecond resolution, at a fraction of the cost of Clock.
+// Its epoch may differ from the one of Clock, so its time points are only comparable among themselves.
+export class CORE_API CoarseClock {
+public:
+    typedef NanoSeconds Duration;
+    typedef TimePoint<Duration> TimePoint;
+
+public:
+    static TimePoint Now() noexcept { return CoarseClockNow<Duration>(); }
+};
+
 } // namespace mini
\ No newline at end of file
@@ -1,6 +1,13 @@
 module;
 
+#include <sys/sysctl.h>
 #include <sys/time.h>
+#include <time.h>
+
+#if ARCH_X86
+#  include <cpuid.h>
+#  include <x86intrin.h>
+#endif
 
 export module mini.core:clock_platform;
 
@@ -18,4 +25,68 @@ inline TimePoint<T> ClockNow() noexcept
     return TimePoint<T>(Seconds(ts.tv_sec) + NanoSeconds(ts.tv_nsec));
 }
 
+inline uint64 CycleCounter() noexcept
+{
+#if ARCH_X86
+    return __rdtsc();
+#elif ARCH_ARM64
+    uint64 value;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#else
+#  error "unsupported architecture"
+#endif
+}
+
+// waits for every earlier instruction to retire, so the read is never hoisted above measured code
+inline uint64 CycleCounterOrdered() noexcept
+{
+#if ARCH_X86
+    uint32 aux;
+    return __rdtscp(&aux);
+#elif ARCH_ARM64
+    uint64 value;
+    asm volatile("isb\n\tmrs %0, cntvct_el0" : "=r"(value) : : "memory");
+    return value;
+#else
+#  error "unsupported architecture"
+#endif
+}
+
+inline bool CycleCounterInvariant() noexcept
+{
+#if ARCH_X86
+    // an invariant tsc ticks at a constant rate through frequency scaling and deep sleep states
+    uint32 eax, ebx, ecx, edx;
+    if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) == 0) {
+        return false;
+    }
+
+    return (edx & (1u << 8)) != 0;
+#else
+    return true;
+#endif
+}
+
+// zero when the frequency is not published and has to be measured against the clock
+inline uint64 CycleCounterFrequency() noexcept
+{
+#if ARCH_ARM64
+    uint64 value;
+    asm volatile("mrs %0, cntfrq_el0" : "=r"(value));
+    return value;
+#else
+    uint64 value = 0;
+    size_t size = sizeof(value);
+    return sysctlbyname("machdep.tsc.frequency", &value, &size, nullptr, 0) == 0 ? value : 0;
+#endif
+}
+
+template <DurationT T>
+inline TimePoint<T> CoarseClockNow() noexcept
+{
+    // only updated on context switches, which skips reading and scaling the hardware counter
+    return TimePoint<T>(NanoSeconds(static_cast<int64>(clock_gettime_nsec_np(CLOCK_MONOTONIC_RAW_APPROX))));
+}
+
 } // namespace mini
\ No newline at end of file
@@ -1,5 +1,7 @@
 module;
 
+#include <intrin.h>
+
 #include "win_include.h"
 
 export module mini.core:clock_platform;
@@ -46,4 +48,63 @@ inline TimePoint<T> ClockNow() noexcept
     return TimePoint<T>(NanoSeconds(duration));
 }
 
+inline uint64 CycleCounter() noexcept
+{
+#if ARCH_X86
+    return __rdtsc();
+#elif ARCH_ARM64
+    return static_cast<uint64>(_ReadStatusReg(ARM64_CNTVCT));
+#else
+#  error "unsupported architecture"
+#endif
+}
+
+// waits for every earlier instruction to retire, so the read is never hoisted above measured code
+inline uint64 CycleCounterOrdered() noexcept
+{
+#if ARCH_X86
+    unsigned int aux;
+    return __rdtscp(&aux);
+#elif ARCH_ARM64
+    __isb(_ARM64_BARRIER_SY);
+    return static_cast<uint64>(_ReadStatusReg(ARM64_CNTVCT));
+#else
+#  error "unsupported architecture"
+#endif
+}
+
+// zero when the frequency is not published and has to be measured against the clock
+inline uint64 CycleCounterFrequency() noexcept
+{
+#if ARCH_ARM64
+    return static_cast<uint64>(_ReadStatusReg(ARM64_SYSREG(3, 3, 14, 0, 0))); // cntfrq_el0
+#else
+    return 0;
+#endif
+}
+
+inline bool CycleCounterInvariant() noexcept
+{
+#if ARCH_X86
+    // an invariant tsc ticks at a constant rate through frequency scaling and deep sleep states
+    int32 info[4];
+    __cpuid(info, static_cast<int32>(0x80000000));
+    if (static_cast<uint32>(info[0]) < 0x80000007) {
+        return false;
+    }
+
+    __cpuid(info, static_cast<int32>(0x80000007));
+    return (info[3] & (1 << 8)) != 0;
+#else
+    return true;
+#endif
+}
+
+template <DurationT T>
+inline TimePoint<T> CoarseClockNow() noexcept
+{
+    // system tick count, it advances every 10 to 16 milliseconds depending on the timer resolution
+    return TimePoint<T>(MilliSeconds(static_cast<int64>(GetTickCount64())));
+}
+
 } // namespace mini
\ No newline at end of file
@@ -0,0 +1,45 @@
+export module mini.core:cycle_clock;
+
+import :type;
+import :duration;
+import :time_point;
+import :clock;
+import :clock_platform;
+
+namespace mini {
+
+// Clock reading the cycle counter of the cpu directly, rdtsc on x86 and cntvct_el0 on arm64.
+// A read costs a few nanoseconds instead of the system call or vdso path of Clock, which makes it suitable
+// for spin loops and profiling. The counter frequency is taken from the cpu where it is published, and
+// otherwise measured against Clock once the core is loaded. Time points share the epoch of Clock, but drift
+// apart by the calibration error over long spans, so prefer Clock for deadlines far in the future.
+// Without an invariant counter Now falls back to Clock, raw cycles are then only a rough measure.
+export class CORE_API CycleClock {
+public:
+    typedef NanoSeconds Duration;
+    typedef TimePoint<Duration> TimePoint;
+
+public:
+    static uint64 Cycles() noexcept { return CycleCounter(); }
+    static uint64 CyclesOrdered() noexcept { return CycleCounterOrdered(); }
+
+    static TimePoint Now() noexcept;
+    static TimePoint ToTimePoint(uint64) noexcept;
+    static Duration ToDuration(uint64) noexcept;
+    template <DurationT D>
+    static uint64 FromDuration(D const&) noexcept;
+
+    static uint64 Frequency() noexcept;
+    static bool Invariant() noexcept;
+
+private:
+    static uint64 FromNanoSeconds(int64) noexcept;
+};
+
+template <DurationT D>
+inline uint64 CycleClock::FromDuration(D const& duration) noexcept
+{
+    return FromNanoSeconds(DurationCast<NanoSeconds>(duration).Count());
+}
+
+} // namespace mini
\ No newline at end of file
@@ -0,0 +1,58 @@
+export module mini.core:frame_pacer;
+
+import :type;
+import :duration;
+import :time_point;
+import :cycle_clock;
+
+namespace mini {
+
+export struct FramePacerStats {
+    uint64 frames;
+    uint64 missed;
+    uint64 resyncs;
+    NanoSeconds maxLateness;
+    NanoSeconds totalLateness;
+};
+
+// Holds a loop to a fixed frame time by waiting for a deadline at the end of every frame.
+// The thread sleeps until the deadline is closer than the spin threshold and spins on CycleClock for the rest,
+// so the wakeup does not depend on the timer slack of the scheduler as long as a sleep oversleeps by less than
+// the threshold. Thread::SleepFor waits on a high resolution timer on windows for that, a plain Sleep rounds up
+// to the 15.6ms timer resolution there and would miss most deadlines. Deadlines advance by the target from the
+// previous deadline instead of from the time Wait returned, a late frame shortens the next one and the rate
+// does not drift. A frame later than a whole target restarts the cadence, the loop does not burst to catch up.
+// A target of zero disables waiting. The pacer is not thread safe and belongs to the thread running the loop.
+export class CORE_API FramePacer {
+public:
+    typedef CycleClock::TimePoint TimePoint;
+
+private:
+    NanoSeconds m_target;
+    NanoSeconds m_spinThreshold;
+    TimePoint m_deadline;
+    FramePacerStats m_stats;
+
+public:
+    explicit FramePacer(NanoSeconds = NanoSeconds::Zero(), NanoSeconds = MilliSeconds(1)) noexcept;
+
+    NanoSeconds Wait() noexcept;
+    void Reset() noexcept;
+
+    void SetTarget(NanoSeconds) noexcept;
+    void SetSpinThreshold(NanoSeconds) noexcept;
+
+    NanoSeconds Target() const noexcept { return m_target; }
+    NanoSeconds SpinThreshold() const noexcept { return m_spinThreshold; }
+    TimePoint Deadline() const noexcept { return m_deadline; }
+    FramePacerStats const& Stats() const noexcept { return m_stats; }
+    bool Enabled() const noexcept { return m_target > NanoSeconds::Zero(); }
+
+    static NanoSeconds FromRate(uint32) noexcept;
+
+private:
+    FramePacer(FramePacer const&) = delete;
+    FramePacer& operator=(FramePacer const&) = delete;
+};
+
+} // namespace mini
\ No newline at end of file
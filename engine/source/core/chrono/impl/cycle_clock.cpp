@@ -0,0 +1,126 @@
+module mini.core;
+
+import :type;
+import :duration;
+import :time_point;
+import :clock;
+import :clock_platform;
+import :cycle_clock;
+
+namespace mini {
+
+struct CycleCalibration {
+public:
+    uint64 frequency;
+    uint64 baseCycles;
+    int64 baseNanoSeconds;
+    uint64 toNanoSeconds;
+    uint64 toCycles;
+    bool invariant;
+};
+
+static constexpr uint64 nanoSecondsPerSecond = 1'000'000'000;
+
+// long enough to keep the measured frequency within about 1e-5 of the real one
+static constexpr MilliSeconds calibrationTime = MilliSeconds(5);
+
+// (value * multiplier) >> 32 without a 128 bit product, exact as long as the result fits into 64 bits
+static uint64 MulShift32(uint64 value, uint64 multiplier) noexcept
+{
+    uint64 vh = value >> 32;
+    uint64 vl = value & 0xFFFF'FFFF;
+    uint64 mh = multiplier >> 32;
+    uint64 ml = multiplier & 0xFFFF'FFFF;
+
+    return ((vh * mh) << 32) + vh * ml + vl * mh + ((vl * ml) >> 32);
+}
+
+static CycleCalibration Calibrate() noexcept
+{
+    CycleCalibration calibration;
+    calibration.invariant = CycleCounterInvariant();
+    calibration.frequency = CycleCounterFrequency();
+
+    Clock::TimePoint start = Clock::Now();
+    uint64 startCycles = CycleCounterOrdered();
+    Clock::TimePoint end = start;
+    uint64 endCycles = startCycles;
+
+    if (calibration.frequency == 0) {
+        do {
+            end = Clock::Now();
+            endCycles = CycleCounterOrdered();
+        } while (end - start < calibrationTime);
+
+        uint64 elapsed = static_cast<uint64>((end - start).Count());
+        calibration.frequency = (endCycles - startCycles) * nanoSecondsPerSecond / elapsed;
+    }
+
+    // a counter that does not advance is useless, keep the conversion defined and rely on Clock instead
+    if (calibration.frequency == 0) {
+        calibration.frequency = nanoSecondsPerSecond;
+        calibration.invariant = false;
+    }
+
+    // both factors are 32.32 fixed point, split up so that no intermediate overflows on counters above 4GHz
+    uint64 frequency = calibration.frequency;
+    calibration.baseCycles = endCycles;
+    calibration.baseNanoSeconds = end.SinceEpoch().Count();
+    calibration.toNanoSeconds = (nanoSecondsPerSecond << 32) / frequency;
+    calibration.toCycles = ((frequency / nanoSecondsPerSecond) << 32) +
+                           ((frequency % nanoSecondsPerSecond) << 32) / nanoSecondsPerSecond;
+
+    return calibration;
+}
+
+static CycleCalibration const& GetCalibration() noexcept
+{
+    static CycleCalibration const calibration = Calibrate();
+    return calibration;
+}
+
+// calibrates while the core is loaded, rather than stalling its first and likely latency sensitive user
+[[maybe_unused]] static CycleCalibration const& startupCalibration = GetCalibration();
+
+CycleClock::TimePoint CycleClock::Now() noexcept
+{
+    CycleCalibration const& calibration = GetCalibration();
+    if (!calibration.invariant) [[unlikely]] {
+        return Clock::Now();
+    }
+
+    return ToTimePoint(CycleCounter());
+}
+
+CycleClock::TimePoint CycleClock::ToTimePoint(uint64 cycles) noexcept
+{
+    CycleCalibration const& calibration = GetCalibration();
+    int64 delta = static_cast<int64>(cycles - calibration.baseCycles);
+
+    // counters read before the calibration land before its base
+    uint64 magnitude = delta < 0 ? static_cast<uint64>(-delta) : static_cast<uint64>(delta);
+    int64 offset = static_cast<int64>(MulShift32(magnitude, calibration.toNanoSeconds));
+    return TimePoint(NanoSeconds(calibration.baseNanoSeconds + (delta < 0 ? -offset : offset)));
+}
+
+CycleClock::Duration CycleClock::ToDuration(uint64 cycles) noexcept
+{
+    return NanoSeconds(static_cast<int64>(MulShift32(cycles, GetCalibration().toNanoSeconds)));
+}
+
+uint64 CycleClock::FromNanoSeconds(int64 nanoSeconds) noexcept
+{
+    return nanoSeconds <= 0 ? 0 : MulShift32(static_cast<uint64>(nanoSeconds), GetCalibration().toCycles);
+}
+
+uint64 CycleClock::Frequency() noexcept
+{
+    return GetCalibration().frequency;
+}
+
+bool CycleClock::Invariant() noexcept
+{
+    return GetCalibration().invariant;
+}
+
+} // namespace mini
\ No newline at end of file
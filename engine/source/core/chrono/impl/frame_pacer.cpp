@@ -0,0 +1,101 @@
+module mini.core;
+
+import :type;
+import :duration;
+import :time_point;
+import :cycle_clock;
+import :thread;
+import :atomic_platform_wait;
+import :frame_pacer;
+
+namespace mini {
+
+FramePacer::FramePacer(NanoSeconds target, NanoSeconds spinThreshold) noexcept
+    : m_target(target)
+    , m_spinThreshold(spinThreshold)
+    , m_deadline()
+    , m_stats()
+{
+    ASSERT(target >= NanoSeconds::Zero(), "target frame time can not be negative");
+    ASSERT(spinThreshold >= NanoSeconds::Zero(), "spin threshold can not be negative");
+
+    Reset();
+}
+
+NanoSeconds FramePacer::Wait() noexcept
+{
+    if (m_target <= NanoSeconds::Zero()) {
+        return NanoSeconds::Zero();
+    }
+
+    ++m_stats.frames;
+    TimePoint now = CycleClock::Now();
+    NanoSeconds lateness = now - m_deadline;
+
+    if (lateness < NanoSeconds::Zero()) {
+        // sleeping wakes up late by the timer slack, the last stretch is spun to hit the deadline
+        NanoSeconds remaining = -lateness;
+        if (remaining > m_spinThreshold) {
+            Thread::SleepFor(remaining - m_spinThreshold);
+            now = CycleClock::Now();
+        }
+
+        // a spin ends within a few nanoseconds of the deadline, only waking up past it from the sleep is late
+        lateness = now - m_deadline;
+        if (lateness < NanoSeconds::Zero()) {
+            while (now < m_deadline) {
+                AtomicRelax();
+                now = CycleClock::Now();
+            }
+
+            lateness = NanoSeconds::Zero();
+        }
+    }
+
+    if (lateness > NanoSeconds::Zero()) {
+        ++m_stats.missed;
+        m_stats.totalLateness += lateness;
+        m_stats.maxLateness = lateness > m_stats.maxLateness ? lateness : m_stats.maxLateness;
+    }
+
+    if (lateness >= m_target) {
+        ++m_stats.resyncs;
+        m_deadline = now + m_target;
+    } else {
+        m_deadline += m_target;
+    }
+
+    return lateness;
+}
+
+void FramePacer::Reset() noexcept
+{
+    m_stats = FramePacerStats();
+    m_deadline = CycleClock::Now() + m_target;
+}
+
+void FramePacer::SetTarget(NanoSeconds target) noexcept
+{
+    ASSERT(target >= NanoSeconds::Zero(), "target frame time can not be negative");
+
+    m_target = target;
+    Reset();
+}
+
+void FramePacer::SetSpinThreshold(NanoSeconds spinThreshold) noexcept
+{
+    ASSERT(spinThreshold >= NanoSeconds::Zero(), "spin threshold can not be negative");
+
+    m_spinThreshold = spinThreshold;
+}
+
+NanoSeconds FramePacer::FromRate(uint32 framesPerSecond) noexcept
+{
+    if (framesPerSecond == 0) {
+        return NanoSeconds::Zero();
+    }
+
+    return NanoSeconds(Seconds(1)) / framesPerSecond;
+}
+
+} // namespace mini
\ No newline at end of file
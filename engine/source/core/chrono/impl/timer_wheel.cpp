@@ -0,0 +1,239 @@
+module mini.core;
+
+import :type;
+import :bit_operation;
+import :array;
+import :duration;
+import :time_point;
+import :clock;
+import :timer_wheel;
+
+namespace mini {
+
+TimerWheel::TimerWheel(NanoSeconds tick, Clock::TimePoint start)
+    : m_start(start)
+    , m_tick(tick)
+    , m_current(0)
+    , m_count(0)
+    , m_entries()
+    , m_free(invalidIndex)
+{
+    ASSERT(tick.Count() > 0, "tick of a timer wheel has to be positive");
+
+    for (uint32& slot : m_slots) {
+        slot = invalidIndex;
+    }
+
+    for (uint64& occupied : m_occupied) {
+        occupied = 0;
+    }
+}
+
+bool TimerWheel::Cancel(TimerHandle handle) noexcept
+{
+    if (!Pending(handle)) {
+        return false;
+    }
+
+    Unlink(handle.index);
+    Release(handle.index);
+    return true;
+}
+
+uint32 TimerWheel::Advance(Clock::TimePoint now)
+{
+    int64 elapsed = (now - m_start).Count();
+    uint64 target = elapsed <= 0 ? 0 : static_cast<uint64>(elapsed / m_tick.Count());
+    uint32 fired = 0;
+
+    while (m_current < target) {
+        if (m_count == 0) {
+            m_current = target;
+            break;
+        }
+
+        // nothing is due before the next cascade while level zero is empty, jump right in front of it
+        if (m_occupied[0] == 0) {
+            uint64 boundary = ((m_current >> slotBits) + 1) << slotBits;
+            if (boundary > target) {
+                m_current = target;
+                break;
+            }
+
+            m_current = boundary - 1;
+        }
+
+        uint64 tick = ++m_current;
+        for (uint32 level = 1; level < levelCount; ++level) {
+            if ((tick & ((uint64(1) << (slotBits * level)) - 1)) != 0) {
+                break;
+            }
+
+            Cascade(level);
+        }
+
+        // timers added by callbacks always land past the current tick, so the slot drains
+        uint32 slot = static_cast<uint32>(tick & (slotCount - 1));
+        while (m_slots[slot] != invalidIndex) {
+            Expire();
+            ++fired;
+        }
+    }
+
+    return fired;
+}
+
+Clock::TimePoint TimerWheel::NextExpiry() const noexcept
+{
+    if (m_count == 0) {
+        return Clock::TimePoint::Max();
+    }
+
+    // level zero is exact, every other level yields the tick its next occupied slot cascades at
+    uint64 next = ~uint64(0);
+    for (uint32 level = 0; level < levelCount; ++level) {
+        uint64 occupied = m_occupied[level];
+        if (occupied == 0) {
+            continue;
+        }
+
+        uint32 shift = slotBits * level;
+        uint64 base = (m_current >> shift) + 1;
+        uint64 rotated = RotateRight(occupied, static_cast<int32>(base & (slotCount - 1)));
+        uint64 tick = (base + CountRightZero(rotated)) << shift;
+        next = tick < next ? tick : next;
+    }
+
+    return m_start + NanoSeconds(static_cast<int64>(next) * m_tick.Count());
+}
+
+TimerHandle TimerWheel::Add(uint64 expires, uint64 interval, Callback callback, void* userData)
+{
+    ASSERT(callback != nullptr, "timer without a callback");
+
+    uint32 index = m_free;
+    if (index != invalidIndex) {
+        m_free = m_entries[index].next;
+    } else {
+        index = static_cast<uint32>(m_entries.Size());
+        m_entries.Push(Entry{ 0, 0, nullptr, nullptr, invalidIndex, invalidIndex, freeList, 0 });
+    }
+
+    // the slot of the current tick has already run
+    Entry& entry = m_entries[index];
+    entry.expires = expires > m_current ? expires : m_current + 1;
+    entry.interval = interval;
+    entry.callback = callback;
+    entry.userData = userData;
+
+    Place(index);
+    ++m_count;
+    return TimerHandle(index, entry.generation);
+}
+
+void TimerWheel::Place(uint32 index) noexcept
+{
+    uint64 expires = m_entries[index].expires;
+    uint64 delta = expires - m_current;
+
+    uint32 level = 0;
+    while (level + 1 < levelCount && delta >= (uint64(1) << (slotBits * (level + 1)))) {
+        ++level;
+    }
+
+    uint32 slot = static_cast<uint32>((expires >> (slotBits * level)) & (slotCount - 1));
+    Link(index, level * slotCount + slot);
+}
+
+void TimerWheel::Link(uint32 index, uint32 list) noexcept
+{
+    Entry& entry = m_entries[index];
+    entry.list = list;
+    entry.prev = invalidIndex;
+    entry.next = m_slots[list];
+
+    if (entry.next != invalidIndex) {
+        m_entries[entry.next].prev = index;
+    }
+
+    m_slots[list] = index;
+    m_occupied[list / slotCount] |= uint64(1) << (list % slotCount);
+}
+
+void TimerWheel::Unlink(uint32 index) noexcept
+{
+    Entry& entry = m_entries[index];
+    uint32 list = entry.list;
+
+    if (entry.prev != invalidIndex) {
+        m_entries[entry.prev].next = entry.next;
+    } else {
+        m_slots[list] = entry.next;
+        if (entry.next == invalidIndex) {
+            m_occupied[list / slotCount] &= ~(uint64(1) << (list % slotCount));
+        }
+    }
+
+    if (entry.next != invalidIndex) {
+        m_entries[entry.next].prev = entry.prev;
+    }
+
+    entry.prev = invalidIndex;
+    entry.next = invalidIndex;
+}
+
+void TimerWheel::Release(uint32 index) noexcept
+{
+    Entry& entry = m_entries[index];
+    ++entry.generation;
+    entry.list = freeList;
+    entry.callback = nullptr;
+    entry.userData = nullptr;
+    entry.next = m_free;
+
+    m_free = index;
+    --m_count;
+}
+
+void TimerWheel::Cascade(uint32 level) noexcept
+{
+    // every timer of the slot is due within the span of the levels below and moves down
+    uint32 list = level * slotCount + static_cast<uint32>((m_current >> (slotBits * level)) & (slotCount - 1));
+    uint32 index = m_slots[list];
+
+    m_slots[list] = invalidIndex;
+    m_occupied[level] &= ~(uint64(1) << (list % slotCount));
+
+    while (index != invalidIndex) {
+        uint32 next = m_entries[index].next;
+        Place(index);
+        index = next;
+    }
+}
+
+void TimerWheel::Expire() noexcept
+{
+    uint32 index = m_slots[m_current & (slotCount - 1)];
+    Unlink(index);
+
+    // the entry is recycled or rescheduled before the callback runs, which may cancel or add timers itself
+    Entry& entry = m_entries[index];
+    Callback callback = entry.callback;
+    void* userData = entry.userData;
+
+    if (entry.interval != 0) {
+        entry.expires = entry.expires + entry.interval > m_current ? entry.expires + entry.interval : m_current + 1;
+        Place(index);
+    } else {
+        Release(index);
+    }
+
+    callback(userData);
+}
+
+uint64 TimerWheel::TicksUntil(Clock::TimePoint deadline) const noexcept
+{
+    return TicksOf(deadline - m_start);
+}
+
+} // namespace mini
\ No newline at end of file
@@ -0,0 +1,163 @@
+export module mini.core:timer_wheel;
+
+import :type;
+import :array;
+import :duration;
+import :time_point;
+import :clock;
+
+namespace mini {
+
+export struct TimerHandle {
+public:
+    static constexpr uint32 invalidIndex = ~uint32(0);
+
+    uint32 index;
+    uint32 generation;
+
+    constexpr TimerHandle() noexcept
+        : index(invalidIndex)
+        , generation(0)
+    {
+    }
+
+    constexpr TimerHandle(uint32 i, uint32 g) noexcept
+        : index(i)
+        , generation(g)
+    {
+    }
+
+    constexpr bool Valid() const noexcept { return index != invalidIndex; }
+};
+
+// Hierarchical timing wheel running callbacks once their deadline passed.
+// Each level holds 64 slots, a slot of a level spans all 64 slots of the level below. Timers are placed on
+// the level matching the distance to their deadline and cascade towards level zero as time advances, so
+// scheduling and cancelling are constant time no matter how many timers are pending.
+// Time only moves in Advance, which the owner calls from its loop, e.g. once per frame or from a job.
+// Deadlines are rounded up to the tick, callbacks never run early but may run up to a tick late. Delays count
+// from the time of the last Advance, and NextExpiry tells a sleeping owner when to advance again at the latest.
+// The wheel is not thread safe, and callbacks run on the thread calling Advance.
+export class CORE_API TimerWheel {
+public:
+    typedef void (*Callback)(void*);
+
+    static constexpr uint32 slotBits = 6;
+    static constexpr uint32 slotCount = 1 << slotBits;
+    static constexpr uint32 levelCount = 6;
+
+private:
+    struct Entry {
+        uint64 expires;
+        uint64 interval;
+        Callback callback;
+        void* userData;
+        uint32 prev;
+        uint32 next;
+        uint32 list;
+        uint32 generation;
+    };
+
+    static constexpr uint32 invalidIndex = TimerHandle::invalidIndex;
+    static constexpr uint32 freeList = levelCount * slotCount;
+
+    Clock::TimePoint m_start;
+    NanoSeconds m_tick;
+    uint64 m_current;
+    uint32 m_count;
+
+    Array<Entry> m_entries;
+    uint32 m_free;
+    uint32 m_slots[levelCount * slotCount];
+    uint64 m_occupied[levelCount];
+
+public:
+    explicit TimerWheel(NanoSeconds = MilliSeconds(1), Clock::TimePoint = Clock::Now());
+
+    template <DurationT D>
+    TimerHandle ScheduleAfter(D const&, Callback, void*);
+    template <DurationT D>
+    TimerHandle ScheduleEvery(D const&, Callback, void*);
+    TimerHandle ScheduleAt(Clock::TimePoint, Callback, void*);
+
+    bool Cancel(TimerHandle) noexcept;
+    bool Pending(TimerHandle) const noexcept;
+
+    uint32 Advance(Clock::TimePoint = Clock::Now());
+    Clock::TimePoint NextExpiry() const noexcept;
+
+    uint32 Size() const noexcept;
+    bool Empty() const noexcept;
+    NanoSeconds Tick() const noexcept;
+
+private:
+    TimerHandle Add(uint64, uint64, Callback, void*);
+    void Place(uint32) noexcept;
+    void Link(uint32, uint32) noexcept;
+    void Unlink(uint32) noexcept;
+    void Release(uint32) noexcept;
+    void Cascade(uint32) noexcept;
+    void Expire() noexcept;
+
+    uint64 TicksUntil(Clock::TimePoint) const noexcept;
+    template <DurationT D>
+    uint64 TicksOf(D const&) const noexcept;
+
+    TimerWheel(TimerWheel const&) = delete;
+    TimerWheel& operator=(TimerWheel const&) = delete;
+};
+
+template <DurationT D>
+inline TimerHandle TimerWheel::ScheduleAfter(D const& delay, Callback callback, void* userData)
+{
+    return Add(m_current + TicksOf(delay), 0, callback, userData);
+}
+
+template <DurationT D>
+inline TimerHandle TimerWheel::ScheduleEvery(D const& interval, Callback callback, void* userData)
+{
+    uint64 ticks = TicksOf(interval);
+    ticks = ticks == 0 ? 1 : ticks;
+    return Add(m_current + ticks, ticks, callback, userData);
+}
+
+inline TimerHandle TimerWheel::ScheduleAt(Clock::TimePoint deadline, Callback callback, void* userData)
+{
+    return Add(TicksUntil(deadline), 0, callback, userData);
+}
+
+inline bool TimerWheel::Pending(TimerHandle handle) const noexcept
+{
+    if (handle.index >= m_entries.Size()) {
+        return false;
+    }
+
+    Entry const& entry = m_entries[handle.index];
+    return entry.generation == handle.generation && entry.list != freeList;
+}
+
+inline uint32 TimerWheel::Size() const noexcept
+{
+    return m_count;
+}
+
+inline bool TimerWheel::Empty() const noexcept
+{
+    return m_count == 0;
+}
+
+inline NanoSeconds TimerWheel::Tick() const noexcept
+{
+    return m_tick;
+}
+
+template <DurationT D>
+inline uint64 TimerWheel::TicksOf(D const& duration) const noexcept
+{
+    // rounded up, a timer must not fire before its delay elapsed
+    int64 count = DurationCast<NanoSeconds>(duration).Count();
+    int64 tick = m_tick.Count();
+    return count <= 0 ? 0 : static_cast<uint64>((count + tick - 1) / tick);
+}
+
+} // namespace mini
\ No newline at end of file
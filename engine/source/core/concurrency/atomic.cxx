@@ -26,9 +26,13 @@ export module mini.core:atomic;
 import :type;
 import :numeric;
 import :memory_operation;
+import :duration;
+import :time_point;
+import :clock;
 import :atomic_base;
 import :atomic_platform;
 import :atomic_wait;
+import :seq_lock;
 
 namespace mini {
 
@@ -103,12 +107,24 @@ public:
     Value FetchSub(offset_t, MemoryOrder) volatile noexcept
         requires(PointerT<Value> && !FunctionPtrT<T>);
 
-    void Wait(Value, MemoryOrder) const noexcept;
-    void Wait(Value, MemoryOrder) const volatile noexcept;
+    void Wait(Value, MemoryOrder, AtomicSpinPolicy const& = AtomicSpinPolicy()) const noexcept;
+    void Wait(Value, MemoryOrder, AtomicSpinPolicy const& = AtomicSpinPolicy()) const volatile noexcept;
+    template <DurationT D>
+    bool WaitFor(Value, D const&, MemoryOrder, AtomicSpinPolicy const& = AtomicSpinPolicy()) const noexcept;
+    template <DurationT D>
+    bool WaitFor(Value, D const&, MemoryOrder, AtomicSpinPolicy const& = AtomicSpinPolicy()) const volatile noexcept;
+    template <DurationT D>
+    bool WaitUntil(Value, TimePoint<D> const&, MemoryOrder, AtomicSpinPolicy const& = AtomicSpinPolicy()) const noexcept;
+    template <DurationT D>
+    bool WaitUntil(Value,
+                   TimePoint<D> const&,
+                   MemoryOrder,
+                   AtomicSpinPolicy const& = AtomicSpinPolicy()) const volatile noexcept;
     void Notify() const noexcept;
     void Notify() const volatile noexcept;
     void NotifyAll() const noexcept;
     void NotifyAll() const volatile noexcept;
+    bool Watch(AtomicWatch*) const noexcept;
 
     bool IsLockFree() const noexcept;
     bool IsLockFree() const volatile noexcept;
@@ -462,15 +478,53 @@ inline Atomic<T>::Value Atomic<T>::FetchSub(offset_t offset, MemoryOrder order)
 }
 
 template <TrivialT T>
-inline void Atomic<T>::Wait(Value old, MemoryOrder order) const noexcept [[diagnose_wait(order)]]
+inline void Atomic<T>::Wait(Value old, MemoryOrder order, AtomicSpinPolicy const& policy) const noexcept
+    [[diagnose_wait(order)]]
 {
-    __atomic_wait(memory::AddressOf(m_value.value), old, static_cast<int32>(order));
+    __atomic_wait(memory::AddressOf(m_value.value), old, static_cast<int32>(order), policy);
 }
 
 template <TrivialT T>
-inline void Atomic<T>::Wait(Value old, MemoryOrder order) const volatile noexcept [[diagnose_wait(order)]]
+inline void Atomic<T>::Wait(Value old, MemoryOrder order, AtomicSpinPolicy const& policy) const volatile noexcept
+    [[diagnose_wait(order)]]
 {
-    __atomic_wait(memory::AddressOf(m_value.value), old, static_cast<int32>(order));
+    __atomic_wait(memory::AddressOf(m_value.value), old, static_cast<int32>(order), policy);
+}
+
+template <TrivialT T>
+template <DurationT D>
+inline bool Atomic<T>::WaitFor(Value old, D const& timeout, MemoryOrder order, AtomicSpinPolicy const& policy)
+    const noexcept [[diagnose_wait(order)]]
+{
+    Clock::TimePoint deadline = AtomicDeadline(timeout);
+    return __atomic_wait_until(memory::AddressOf(m_value.value), old, static_cast<int32>(order), deadline, policy);
+}
+
+template <TrivialT T>
+template <DurationT D>
+inline bool Atomic<T>::WaitFor(Value old, D const& timeout, MemoryOrder order, AtomicSpinPolicy const& policy)
+    const volatile noexcept [[diagnose_wait(order)]]
+{
+    Clock::TimePoint deadline = AtomicDeadline(timeout);
+    return __atomic_wait_until(memory::AddressOf(m_value.value), old, static_cast<int32>(order), deadline, policy);
+}
+
+template <TrivialT T>
+template <DurationT D>
+inline bool Atomic<T>::WaitUntil(Value old, TimePoint<D> const& tp, MemoryOrder order, AtomicSpinPolicy const& policy)
+    const noexcept [[diagnose_wait(order)]]
+{
+    Clock::TimePoint deadline = AtomicDeadline(tp);
+    return __atomic_wait_until(memory::AddressOf(m_value.value), old, static_cast<int32>(order), deadline, policy);
+}
+
+template <TrivialT T>
+template <DurationT D>
+inline bool Atomic<T>::WaitUntil(Value old, TimePoint<D> const& tp, MemoryOrder order, AtomicSpinPolicy const& policy)
+    const volatile noexcept [[diagnose_wait(order)]]
+{
+    Clock::TimePoint deadline = AtomicDeadline(tp);
+    return __atomic_wait_until(memory::AddressOf(m_value.value), old, static_cast<int32>(order), deadline, policy);
 }
 
 template <TrivialT T>
@@ -497,6 +551,14 @@ inline void Atomic<T>::NotifyAll() const volatile noexcept
     __atomic_notify_all(memory::AddressOf(m_value.value));
 }
 
+// Lets a Notify or NotifyAll following a change run the callback of the watch instead of waking a thread,
+// whether the value changed is up to the watch. Returns false without registering when it changed already.
+template <TrivialT T>
+inline bool Atomic<T>::Watch(AtomicWatch* watch) const noexcept
+{
+    return AtomicAddWatch(memory::AddressOf(m_value.value), watch);
+}
+
 template <TrivialT T>
 inline bool Atomic<T>::IsLockFree() const noexcept
 {
@@ -553,4 +615,415 @@ inline void Atomic<T>::SignalFence(MemoryOrder order) noexcept
     __atomic_signal_fence(static_cast<int>(order));
 }
 
+// Types beyond the native atomic width would otherwise fall back to the global lock table of the
+// runtime, which serializes unrelated atomics. These are guarded by a sequence lock of their own:
+// loads retry without ever blocking, and a writer only spins when another writer is in progress.
+// Waiters sleep on the sequence itself, which every write changes.
+template <TrivialT T>
+    requires SeqLockedT<T>
+struct Atomic<T> {
+private:
+    typedef SeqLockBase<T> Base;
+
+public:
+    typedef typename Base::Value Value;
+
+private:
+    mutable Base m_value;
+
+public:
+    constexpr Atomic() noexcept(NoThrowDefaultConstructibleT<T>)
+        requires DefaultConstructibleT<T>;
+    constexpr Atomic(Value) noexcept;
+    constexpr ~Atomic() noexcept = default;
+
+    void Store(Value, MemoryOrder) noexcept;
+    void Store(Value, MemoryOrder) volatile noexcept;
+    Value Load(MemoryOrder) const noexcept;
+    Value Load(MemoryOrder) const volatile noexcept;
+    Value Exchange(Value, MemoryOrder) noexcept;
+    Value Exchange(Value, MemoryOrder) volatile noexcept;
+
+    bool CompareExchangeStrong(Value&, Value, MemoryOrder, MemoryOrder) noexcept;
+    bool CompareExchangeStrong(Value&, Value, MemoryOrder, MemoryOrder) volatile noexcept;
+    bool CompareExchangeStrong(Value&, Value, MemoryOrder) noexcept;
+    bool CompareExchangeWeak(Value&, Value, MemoryOrder, MemoryOrder) noexcept;
+    bool CompareExchangeWeak(Value&, Value, MemoryOrder, MemoryOrder) volatile noexcept;
+    bool CompareExchangeWeak(Value&, Value, MemoryOrder) noexcept;
+    bool CompareExchangeWeak(Value&, Value, MemoryOrder) volatile noexcept;
+
+    void Wait(Value, MemoryOrder, AtomicSpinPolicy const& = AtomicSpinPolicy()) const noexcept;
+    void Wait(Value, MemoryOrder, AtomicSpinPolicy const& = AtomicSpinPolicy()) const volatile noexcept;
+    template <DurationT D>
+    bool WaitFor(Value, D const&, MemoryOrder, AtomicSpinPolicy const& = AtomicSpinPolicy()) const noexcept;
+    template <DurationT D>
+    bool WaitFor(Value, D const&, MemoryOrder, AtomicSpinPolicy const& = AtomicSpinPolicy()) const volatile noexcept;
+    template <DurationT D>
+    bool WaitUntil(Value, TimePoint<D> const&, MemoryOrder, AtomicSpinPolicy const& = AtomicSpinPolicy()) const noexcept;
+    template <DurationT D>
+    bool WaitUntil(Value,
+                   TimePoint<D> const&,
+                   MemoryOrder,
+                   AtomicSpinPolicy const& = AtomicSpinPolicy()) const volatile noexcept;
+    void Notify() const noexcept;
+    void Notify() const volatile noexcept;
+    void NotifyAll() const noexcept;
+    void NotifyAll() const volatile noexcept;
+    bool Watch(AtomicWatch*) const noexcept;
+
+    bool IsLockFree() const noexcept;
+    bool IsLockFree() const volatile noexcept;
+    static constexpr bool IsAlwaysLockFree() noexcept;
+
+    static void ThreadFence(MemoryOrder order) noexcept;
+    static void SignalFence(MemoryOrder order) noexcept;
+
+    explicit operator Value() const noexcept;
+    explicit operator Value() const volatile noexcept;
+    Value operator=(Value) noexcept;
+    Value operator=(Value) volatile noexcept;
+
+private:
+    static Value ExchangeImpl(Base volatile*, Value, MemoryOrder) noexcept;
+    static bool CompareExchangeImpl(Base volatile*, Value&, Value, MemoryOrder, MemoryOrder) noexcept;
+    static bool WaitImpl(Base volatile*, Value, MemoryOrder, Clock::TimePoint, AtomicSpinPolicy const&) noexcept;
+
+    Atomic(Atomic const&) = delete;
+    Atomic& operator=(Atomic const&) = delete;
+    Atomic& operator=(Atomic const&) volatile = delete;
+};
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+constexpr Atomic<T>::Atomic() noexcept(NoThrowDefaultConstructibleT<T>)
+    requires DefaultConstructibleT<T>
+    : m_value(T())
+{
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline constexpr Atomic<T>::Atomic(Value val) noexcept
+    : m_value(val)
+{
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline void Atomic<T>::Store(Value val, MemoryOrder order) noexcept [[diagnose_store(order)]]
+{
+    SeqLockWrite(&m_value, val, static_cast<int32>(order));
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline void Atomic<T>::Store(Value val, MemoryOrder order) volatile noexcept [[diagnose_store(order)]]
+{
+    SeqLockWrite(&m_value, val, static_cast<int32>(order));
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline Atomic<T>::Value Atomic<T>::Load(MemoryOrder order) const noexcept [[diagnose_load(order)]]
+{
+    Value result;
+    SeqLockRead(&m_value, result, static_cast<int32>(order));
+    return result;
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline Atomic<T>::Value Atomic<T>::Load(MemoryOrder order) const volatile noexcept [[diagnose_load(order)]]
+{
+    Value result;
+    SeqLockRead(&m_value, result, static_cast<int32>(order));
+    return result;
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline Atomic<T>::Value Atomic<T>::Exchange(Value val, MemoryOrder order) noexcept
+{
+    return ExchangeImpl(&m_value, val, order);
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline Atomic<T>::Value Atomic<T>::Exchange(Value val, MemoryOrder order) volatile noexcept
+{
+    return ExchangeImpl(&m_value, val, order);
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline bool Atomic<T>::CompareExchangeStrong(Value& expected,
+                                             Value desired,
+                                             MemoryOrder success,
+                                             MemoryOrder failure) noexcept [[diagnose_compare_exchange(failure)]]
+{
+    return CompareExchangeImpl(&m_value, expected, desired, success, failure);
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline bool Atomic<T>::
+    CompareExchangeStrong(Value& expected, Value desired, MemoryOrder success, MemoryOrder failure) volatile noexcept
+    [[diagnose_compare_exchange(failure)]]
+{
+    return CompareExchangeImpl(&m_value, expected, desired, success, failure);
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline bool Atomic<T>::CompareExchangeStrong(Value& expected, Value desired, MemoryOrder order) noexcept
+{
+    return CompareExchangeImpl(&m_value, expected, desired, order, static_cast<MemoryOrder>(FailureOrder(order)));
+}
+
+// the writer lock never fails spuriously, so the weak variants are the same as the strong ones
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline bool Atomic<T>::CompareExchangeWeak(Value& expected,
+                                           Value desired,
+                                           MemoryOrder success,
+                                           MemoryOrder failure) noexcept [[diagnose_compare_exchange(failure)]]
+{
+    return CompareExchangeImpl(&m_value, expected, desired, success, failure);
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline bool Atomic<T>::CompareExchangeWeak(Value& expected,
+                                           Value desired,
+                                           MemoryOrder success,
+                                           MemoryOrder failure) volatile noexcept [[diagnose_compare_exchange(failure)]]
+{
+    return CompareExchangeImpl(&m_value, expected, desired, success, failure);
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline bool Atomic<T>::CompareExchangeWeak(Value& expected, Value desired, MemoryOrder order) noexcept
+{
+    return CompareExchangeImpl(&m_value, expected, desired, order, static_cast<MemoryOrder>(FailureOrder(order)));
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline bool Atomic<T>::CompareExchangeWeak(Value& expected, Value desired, MemoryOrder order) volatile noexcept
+{
+    return CompareExchangeImpl(&m_value, expected, desired, order, static_cast<MemoryOrder>(FailureOrder(order)));
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline void Atomic<T>::Wait(Value old, MemoryOrder order, AtomicSpinPolicy const& policy) const noexcept
+    [[diagnose_wait(order)]]
+{
+    WaitImpl(&m_value, old, order, Clock::TimePoint::Max(), policy);
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline void Atomic<T>::Wait(Value old, MemoryOrder order, AtomicSpinPolicy const& policy) const volatile noexcept
+    [[diagnose_wait(order)]]
+{
+    WaitImpl(&m_value, old, order, Clock::TimePoint::Max(), policy);
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+template <DurationT D>
+inline bool Atomic<T>::WaitFor(Value old, D const& timeout, MemoryOrder order, AtomicSpinPolicy const& policy)
+    const noexcept [[diagnose_wait(order)]]
+{
+    return WaitImpl(&m_value, old, order, AtomicDeadline(timeout), policy);
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+template <DurationT D>
+inline bool Atomic<T>::WaitFor(Value old, D const& timeout, MemoryOrder order, AtomicSpinPolicy const& policy)
+    const volatile noexcept [[diagnose_wait(order)]]
+{
+    return WaitImpl(&m_value, old, order, AtomicDeadline(timeout), policy);
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+template <DurationT D>
+inline bool Atomic<T>::WaitUntil(Value old, TimePoint<D> const& tp, MemoryOrder order, AtomicSpinPolicy const& policy)
+    const noexcept [[diagnose_wait(order)]]
+{
+    return WaitImpl(&m_value, old, order, AtomicDeadline(tp), policy);
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+template <DurationT D>
+inline bool Atomic<T>::WaitUntil(Value old, TimePoint<D> const& tp, MemoryOrder order, AtomicSpinPolicy const& policy)
+    const volatile noexcept [[diagnose_wait(order)]]
+{
+    return WaitImpl(&m_value, old, order, AtomicDeadline(tp), policy);
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline void Atomic<T>::Notify() const noexcept
+{
+    __atomic_notify_one(&m_value.sequence);
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline void Atomic<T>::Notify() const volatile noexcept
+{
+    __atomic_notify_one(&m_value.sequence);
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline void Atomic<T>::NotifyAll() const noexcept
+{
+    __atomic_notify_all(&m_value.sequence);
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline void Atomic<T>::NotifyAll() const volatile noexcept
+{
+    __atomic_notify_all(&m_value.sequence);
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline bool Atomic<T>::Watch(AtomicWatch* watch) const noexcept
+{
+    return AtomicAddWatch(&m_value.sequence, watch);
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline bool Atomic<T>::IsLockFree() const noexcept
+{
+    return false;
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline bool Atomic<T>::IsLockFree() const volatile noexcept
+{
+    return false;
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline constexpr bool Atomic<T>::IsAlwaysLockFree() noexcept
+{
+    return false;
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline Atomic<T>::operator Value() const noexcept
+{
+    return Load(MemoryOrder::sequential);
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline Atomic<T>::operator Value() const volatile noexcept
+{
+    return Load(MemoryOrder::sequential);
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline Atomic<T>::Value Atomic<T>::operator=(Value val) noexcept
+{
+    Store(val, MemoryOrder::sequential);
+    return val;
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline Atomic<T>::Value Atomic<T>::operator=(Value val) volatile noexcept
+{
+    Store(val, MemoryOrder::sequential);
+    return val;
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline void Atomic<T>::ThreadFence(MemoryOrder order) noexcept
+{
+    __atomic_thread_fence(static_cast<int>(order));
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline void Atomic<T>::SignalFence(MemoryOrder order) noexcept
+{
+    __atomic_signal_fence(static_cast<int>(order));
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline Atomic<T>::Value Atomic<T>::ExchangeImpl(Base volatile* base, Value val, MemoryOrder order) noexcept
+{
+    Value result;
+    SeqLockSequence sequence = SeqLockAcquire(base);
+    SeqLockCopyOut(memory::AddressOf(result), &base->value);
+    SeqLockCopyIn(&base->value, memory::AddressOf(val));
+    SeqLockRelease(base, sequence + 2, static_cast<int32>(order));
+    return result;
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline bool Atomic<T>::CompareExchangeImpl(Base volatile* base,
+                                           Value& expected,
+                                           Value desired,
+                                           MemoryOrder success,
+                                           MemoryOrder failure) noexcept
+{
+    Value current;
+    SeqLockSequence sequence = SeqLockAcquire(base);
+    SeqLockCopyOut(memory::AddressOf(current), &base->value);
+
+    if (memory::MemCompare(memory::AddressOf(current), memory::AddressOf(expected), 1) != 0) {
+        // nothing has been written, so the sequence is restored as it was
+        SeqLockRelease(base, sequence, static_cast<int32>(failure));
+        expected = current;
+        return false;
+    }
+
+    SeqLockCopyIn(&base->value, memory::AddressOf(desired));
+    SeqLockRelease(base, sequence + 2, static_cast<int32>(success));
+    return true;
+}
+
+template <TrivialT T>
+    requires SeqLockedT<T>
+inline bool Atomic<T>::WaitImpl(Base volatile* base,
+                                Value old,
+                                MemoryOrder order,
+                                Clock::TimePoint deadline,
+                                AtomicSpinPolicy const& policy) noexcept
+{
+    Value current;
+    for (;;) {
+        SeqLockSequence sequence = SeqLockRead(base, current, static_cast<int32>(order));
+        if (memory::MemCompare(memory::AddressOf(current), memory::AddressOf(old), 1) != 0) {
+            return true;
+        }
+
+        if (deadline == Clock::TimePoint::Max()) {
+            __atomic_wait(&base->sequence, sequence, __ATOMIC_ACQUIRE, policy);
+        } else if (!__atomic_wait_until(&base->sequence, sequence, __ATOMIC_ACQUIRE, deadline, policy)) {
+            return false;
+        }
+    }
+}
+
 } // namespace mini
\ No newline at end of file
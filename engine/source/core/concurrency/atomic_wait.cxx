@@ -10,13 +10,33 @@ export module mini.core:atomic_wait;
 import :type;
 import :memory_operation;
 import :duration;
+import :time_point;
 import :clock;
+import :cycle_clock;
 import :atomic_platform;
 import :atomic_platform_wait;
 
 namespace mini {
 
-constexpr size_t spinWaitCount = 64;
+export struct AtomicSpinPolicy {
+public:
+    size_t count;
+    NanoSeconds budget;
+
+    // spins 64 times in between each cycle counter polls, for at most 4us.
+    // zero count or budget skips spinning entirely and goes straight to the platform wait.
+    constexpr AtomicSpinPolicy() noexcept
+        : count(64)
+        , budget(MicroSeconds(4))
+    {
+    }
+
+    constexpr AtomicSpinPolicy(size_t count, NanoSeconds budget) noexcept
+        : count(count)
+        , budget(budget)
+    {
+    }
+};
 
 template <TrivialT T>
 inline bool AtomicLoadCompare(T const volatile* loc, T val, int32 order) noexcept
@@ -27,11 +47,26 @@ inline bool AtomicLoadCompare(T const volatile* loc, T val, int32 order) noexcep
 }
 
 template <TrivialT T>
-inline bool AtomicSpinWaitLoop(T const volatile* loc, T val, int32 order) noexcept
+inline bool AtomicSpinWaitLoop(T const volatile* loc,
+                               T val,
+                               int32 order,
+                               AtomicSpinPolicy const& policy,
+                               Clock::TimePoint deadline) noexcept
 {
-    Clock::TimePoint start = Clock::Now();
+    if (policy.count == 0 || policy.budget <= NanoSeconds::Zero()) {
+        return true;
+    }
+
+    // the budget is converted to counter cycles once, so that polling never goes through the system clock
+    uint64 budget = CycleClock::FromDuration(policy.budget);
+    if (deadline != Clock::TimePoint::Max()) {
+        uint64 remaining = CycleClock::FromDuration(deadline - Clock::Now());
+        budget = remaining < budget ? remaining : budget;
+    }
+
+    uint64 start = CycleClock::Cycles();
     for (;;) {
-        for (size_t i = 0; i < spinWaitCount; ++i) {
+        for (size_t i = 0; i < policy.count; ++i) {
             AtomicRelax();
 
             if (!AtomicLoadCompare(loc, val, order)) {
@@ -39,8 +74,7 @@ inline bool AtomicSpinWaitLoop(T const volatile* loc, T val, int32 order) noexce
             }
         }
 
-        Clock::TimePoint tp = Clock::Now();
-        if ((tp - start) > MicroSeconds(4)) {
+        if (CycleClock::Cycles() - start > budget) {
             break;
         }
     }
@@ -49,13 +83,43 @@ inline bool AtomicSpinWaitLoop(T const volatile* loc, T val, int32 order) noexce
 }
 
 template <TrivialT T>
-inline bool AtomicSpinWait(T const volatile* loc, T val, int32 order) noexcept
+inline bool AtomicSpinWait(T const volatile* loc,
+                           T val,
+                           int32 order,
+                           AtomicSpinPolicy const& policy,
+                           Clock::TimePoint deadline = Clock::TimePoint::Max()) noexcept
 {
     if (!AtomicLoadCompare(loc, val, order)) {
         return false;
     }
 
-    return AtomicSpinWaitLoop(loc, val, order);
+    return AtomicSpinWaitLoop(loc, val, order, policy, deadline);
+}
+
+template <DurationT D>
+inline Clock::TimePoint AtomicDeadline(D const& timeout) noexcept
+{
+    Clock::TimePoint now = Clock::Now();
+    if (timeout <= D::Zero()) {
+        return now;
+    }
+
+    // saturate instead of overflowing on huge timeouts (e.g. Duration::Max())
+    if (timeout >= DurationCast<D>(Clock::TimePoint::Max() - now)) {
+        return Clock::TimePoint::Max();
+    }
+
+    return now + DurationCast<Clock::Duration>(timeout);
+}
+
+template <DurationT D>
+inline Clock::TimePoint AtomicDeadline(TimePoint<D> const& deadline) noexcept
+{
+    if (deadline.SinceEpoch() >= DurationCast<D>(Clock::Duration::Max())) {
+        return Clock::TimePoint::Max();
+    }
+
+    return TimePointCast<Clock::Duration>(deadline);
 }
 
 inline CORE_API void AtomicPlatformWait(AtomicContention volatile* waiter,
@@ -69,6 +133,24 @@ inline CORE_API void AtomicPlatformWait(AtomicContention volatile* waiter,
     __atomic_fetch_sub(waiter, AtomicContention(1), __ATOMIC_RELEASE);
 }
 
+inline CORE_API bool AtomicPlatformWaitFor(AtomicContention volatile* waiter,
+                                           AtomicContention const volatile* platform,
+                                           AtomicContention value,
+                                           size_t size,
+                                           Clock::TimePoint deadline) noexcept
+{
+    Clock::Duration remain = deadline - Clock::Now();
+    if (remain <= Clock::Duration::Zero()) {
+        return false;
+    }
+
+    __atomic_fetch_add(waiter, AtomicContention(1), __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    bool result = WaitOnAddressFor(platform, value, size, remain.Count());
+    __atomic_fetch_sub(waiter, AtomicContention(1), __ATOMIC_RELEASE);
+    return result;
+}
+
 inline CORE_API void AtomicPlatformNotify(AtomicContention const volatile* waiter,
                                           AtomicContention const volatile* platform,
                                           size_t size) noexcept
@@ -91,14 +173,30 @@ inline CORE_API void AtomicPlatformNotifyAll(AtomicContention const volatile* wa
     }
 }
 
+// Callback registered on an atomic in place of a blocked thread, run by the next Notify or NotifyAll that finds
+// changed to hold. It is unlinked before notify runs, which may hand the watch over to another thread right away.
+export struct AtomicWatch {
+public:
+    AtomicWatch* next;
+    void const volatile* address;
+    bool (*changed)(AtomicWatch const*) noexcept;
+    void (*notify)(AtomicWatch*) noexcept;
+};
+
 struct CORE_API alignas(__ATOMIC_INTERFERENCE_SIZE) AtomicEntry {
 public:
     AtomicContention waiter;
     AtomicContention platform;
+    AtomicContention watchLock;
+    AtomicContention watchCount;
+    AtomicWatch* watches;
 
     constexpr AtomicEntry()
         : waiter(0)
         , platform(0)
+        , watchLock(0)
+        , watchCount(0)
+        , watches(nullptr)
     {
     }
 };
@@ -109,6 +207,83 @@ public:
 constexpr size_t contentionTableSize = 1 << 6;
 CORE_API AtomicEntry g_atomicContentionTable[contentionTableSize];
 
+inline AtomicEntry* AtomicContentionEntry(void const volatile* pointer) noexcept
+{
+    size_t intptr = reinterpret_cast<size_t>(pointer);
+    size_t hash = intptr >> 6;
+    hash ^= hash >> 16;
+    hash &= (contentionTableSize - 1);
+    return &g_atomicContentionTable[hash];
+}
+
+inline void AtomicLockWatches(AtomicEntry* entry) noexcept
+{
+    while (__atomic_exchange_n(&entry->watchLock, AtomicContention(1), __ATOMIC_ACQUIRE) != 0) {
+        AtomicRelax();
+    }
+}
+
+inline void AtomicUnlockWatches(AtomicEntry* entry) noexcept
+{
+    __atomic_store_n(&entry->watchLock, AtomicContention(0), __ATOMIC_RELEASE);
+}
+
+// links the watch unless the value already changed, in which case the caller keeps it and false is returned
+inline CORE_API bool AtomicAddWatch(void const volatile* address, AtomicWatch* watch) noexcept
+{
+    AtomicEntry* entry = AtomicContentionEntry(address);
+    watch->address = address;
+
+    // the value is tested once the watch is counted and under the lock, a notify either sees the count
+    // or its change is seen here, and one that saw the count finds the watch linked once it got the lock
+    AtomicLockWatches(entry);
+    __atomic_fetch_add(&entry->watchCount, AtomicContention(1), __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    if (watch->changed(watch)) {
+        __atomic_fetch_sub(&entry->watchCount, AtomicContention(1), __ATOMIC_RELAXED);
+        AtomicUnlockWatches(entry);
+        return false;
+    }
+
+    watch->next = entry->watches;
+    entry->watches = watch;
+    AtomicUnlockWatches(entry);
+    return true;
+}
+
+// runs the watches on address whose value changed, the others stay linked for the next notify
+inline CORE_API void AtomicNotifyWatches(AtomicEntry* entry, void const volatile* address) noexcept
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&entry->watchCount, __ATOMIC_RELAXED) == 0) {
+        return;
+    }
+
+    AtomicWatch* notified = nullptr;
+    AtomicLockWatches(entry);
+    for (AtomicWatch** link = &entry->watches; *link != nullptr;) {
+        AtomicWatch* watch = *link;
+        if (watch->address != address || !watch->changed(watch)) {
+            link = &watch->next;
+            continue;
+        }
+
+        *link = watch->next;
+        watch->next = notified;
+        notified = watch;
+        __atomic_fetch_sub(&entry->watchCount, AtomicContention(1), __ATOMIC_RELAXED);
+    }
+    AtomicUnlockWatches(entry);
+
+    // a watch may be gone once notified, so the next one is read first
+    while (notified != nullptr) {
+        AtomicWatch* next = notified->next;
+        notified->notify(notified);
+        notified = next;
+    }
+}
+
 template <typename T>
 struct AtomicWaitableContext {
 public:
@@ -118,13 +293,8 @@ public:
 
     AtomicWaitableContext(T const volatile* pointer)
         : pointer(pointer)
+        , entry(AtomicContentionEntry(pointer))
     {
-        size_t intptr = reinterpret_cast<size_t>(pointer);
-        size_t hash = intptr >> 6;
-        hash ^= hash >> 16;
-        hash &= (contentionTableSize - 1);
-        entry = &g_atomicContentionTable[hash];
-
         if constexpr (AtomicWaitableT<T>::value) {
             size = sizeof(T);
         } else {
@@ -141,6 +311,7 @@ inline void __atomic_notify_one(T const volatile* pointer) noexcept
 {
     mini::AtomicWaitableContext context(pointer);
     constexpr mini::AtomicContention contention = 1;
+    mini::AtomicNotifyWatches(context.entry, pointer);
 
     __atomic_fetch_add(&context.entry->platform, contention, __ATOMIC_SEQ_CST);
     mini::AtomicPlatformNotify(&context.entry->waiter, &context.entry->platform, context.size);
@@ -152,6 +323,7 @@ inline void __atomic_notify_all(T const volatile* pointer) noexcept
 {
     mini::AtomicWaitableContext context(pointer);
     constexpr mini::AtomicContention contention = 1;
+    mini::AtomicNotifyWatches(context.entry, pointer);
 
     __atomic_fetch_add(&context.entry->platform, contention, __ATOMIC_SEQ_CST);
     mini::AtomicPlatformNotifyAll(&context.entry->waiter, &context.entry->platform, context.size);
@@ -164,6 +336,7 @@ inline void __atomic_notify_one(T const volatile* pointer) noexcept
     mini::AtomicWaitableContext context(pointer);
     mini::AtomicContention const volatile*
         loc = reinterpret_cast<mini::AtomicContention const volatile*>(context.pointer);
+    mini::AtomicNotifyWatches(context.entry, pointer);
 
     mini::AtomicPlatformNotify(&context.entry->waiter, loc, context.size);
 }
@@ -174,15 +347,23 @@ inline void __atomic_notify_all(T const volatile* pointer) noexcept
     mini::AtomicWaitableContext context(pointer);
     mini::AtomicContention const volatile*
         loc = reinterpret_cast<mini::AtomicContention const volatile*>(context.pointer);
+    mini::AtomicNotifyWatches(context.entry, pointer);
 
     mini::AtomicPlatformNotifyAll(&context.entry->waiter, loc, context.size);
 }
 
 export template <typename T>
-inline void __atomic_wait(T const volatile* pointer, T old, int order) noexcept
+inline void __atomic_wait(T const volatile* pointer,
+                          T old,
+                          int order,
+                          mini::AtomicSpinPolicy const& policy = mini::AtomicSpinPolicy()) noexcept
     requires(!mini::AtomicWaitableT<T>::value)
 {
     mini::AtomicWaitableContext context(pointer);
+    if (!mini::AtomicSpinWait(context.pointer, old, static_cast<mini::int32>(order), policy)) {
+        return;
+    }
+
     mini::AtomicContention contention;
     __atomic_load(&context.entry->platform, &contention, __ATOMIC_ACQUIRE);
 
@@ -194,11 +375,16 @@ inline void __atomic_wait(T const volatile* pointer, T old, int order) noexcept
         if (mini::AtomicLoadCompare(&context.entry->platform, contention, __ATOMIC_ACQUIRE)) {
             mini::AtomicPlatformWait(&context.entry->waiter, &context.entry->platform, contention, context.size);
         }
+
+        __atomic_load(&context.entry->platform, &contention, __ATOMIC_ACQUIRE);
     }
 }
 
 export template <typename T>
-inline void __atomic_wait(T const volatile* pointer, T old, int order) noexcept
+inline void __atomic_wait(T const volatile* pointer,
+                          T old,
+                          int order,
+                          mini::AtomicSpinPolicy const& policy = mini::AtomicSpinPolicy()) noexcept
     requires(mini::AtomicWaitableT<T>::value)
 {
     mini::AtomicWaitableContext context(pointer);
@@ -207,7 +393,74 @@ inline void __atomic_wait(T const volatile* pointer, T old, int order) noexcept
     typename mini::AtomicWaitableT<T>::
         Type* waitable = reinterpret_cast<mini::AtomicWaitableT<T>::Type*>(mini::memory::AddressOf(old));
 
-    if (mini::AtomicSpinWait(context.pointer, old, static_cast<mini::int32>(order))) {
+    if (mini::AtomicSpinWait(context.pointer, old, static_cast<mini::int32>(order), policy)) {
         mini::AtomicPlatformWait(&context.entry->waiter, loc, *waitable, context.size);
     }
+}
+
+export template <typename T>
+inline bool __atomic_wait_until(T const volatile* pointer,
+                                T old,
+                                int order,
+                                mini::Clock::TimePoint deadline,
+                                mini::AtomicSpinPolicy const& policy = mini::AtomicSpinPolicy()) noexcept
+    requires(!mini::AtomicWaitableT<T>::value)
+{
+    mini::AtomicWaitableContext context(pointer);
+    if (!mini::AtomicSpinWait(context.pointer, old, static_cast<mini::int32>(order), policy, deadline)) {
+        return true;
+    }
+
+    for (;;) {
+        // the monitor value must be fetched before comparing the value itself,
+        // otherwise a notify in between would be missed until the deadline.
+        mini::AtomicContention contention;
+        __atomic_load(&context.entry->platform, &contention, __ATOMIC_ACQUIRE);
+
+        if (!mini::AtomicLoadCompare(context.pointer, old, static_cast<mini::int32>(order))) {
+            return true;
+        }
+
+        if (mini::Clock::Now() >= deadline) {
+            return false;
+        }
+
+        if (mini::AtomicLoadCompare(&context.entry->platform, contention, __ATOMIC_ACQUIRE)) {
+            mini::AtomicPlatformWaitFor(&context.entry->waiter,
+                                        &context.entry->platform,
+                                        contention,
+                                        context.size,
+                                        deadline);
+        }
+    }
+}
+
+export template <typename T>
+inline bool __atomic_wait_until(T const volatile* pointer,
+                                T old,
+                                int order,
+                                mini::Clock::TimePoint deadline,
+                                mini::AtomicSpinPolicy const& policy = mini::AtomicSpinPolicy()) noexcept
+    requires(mini::AtomicWaitableT<T>::value)
+{
+    mini::AtomicWaitableContext context(pointer);
+    mini::AtomicContention const volatile*
+        loc = reinterpret_cast<mini::AtomicContention const volatile*>(context.pointer);
+    typename mini::AtomicWaitableT<T>::
+        Type* waitable = reinterpret_cast<mini::AtomicWaitableT<T>::Type*>(mini::memory::AddressOf(old));
+
+    if (!mini::AtomicSpinWait(context.pointer, old, static_cast<mini::int32>(order), policy, deadline)) {
+        return true;
+    }
+
+    // platform waits may wake up spuriously, so keep waiting on the remaining time
+    while (mini::AtomicLoadCompare(context.pointer, old, static_cast<mini::int32>(order))) {
+        if (mini::Clock::Now() >= deadline) {
+            return false;
+        }
+
+        mini::AtomicPlatformWaitFor(&context.entry->waiter, loc, *waitable, context.size, deadline);
+    }
+
+    return true;
 }
\ No newline at end of file
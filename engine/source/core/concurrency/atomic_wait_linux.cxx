@@ -0,0 +1,80 @@
+module;
+
+#include <errno.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#if CLANG || GNUC
+#  if ARCH_ARM64
+#    define PAUSE() asm volatile("isb")
+#  elif ARCH_X86
+#    define PAUSE() __builtin_ia32_pause();
+#  else
+#    define PAUSE() asm volatile("", , , "memory")
+#  endif
+#else
+#  error "unsupported compiler"
+#endif
+
+export module mini.core:atomic_platform_wait;
+
+import :type;
+
+namespace mini {
+
+// futex only operates on 32-bit words, regardless of the architecture
+using AtomicContention = uint32;
+
+template <typename T>
+struct AtomicWaitableT : FalseT { };
+
+template <typename T>
+    requires(sizeof(T) == 4)
+struct AtomicWaitableT<T> : TrueT {
+    typedef uint32 Type;
+};
+
+inline void AtomicRelax()
+{
+    PAUSE();
+}
+
+inline long Futex(AtomicContention const volatile* addr, int32 op, AtomicContention value, timespec const* timeout)
+{
+    void* loc = const_cast<void*>(static_cast<void const volatile*>(addr));
+    return syscall(SYS_futex, loc, op, value, timeout, nullptr, 0);
+}
+
+inline void WaitOnAddress(AtomicContention const volatile* addr, AtomicContention value, size_t)
+{
+    Futex(addr, FUTEX_WAIT_PRIVATE, value, nullptr);
+}
+
+inline bool WaitOnAddressFor(AtomicContention const volatile* addr, AtomicContention value, size_t, int64 timeout)
+{
+    if (timeout <= 0) {
+        return false;
+    }
+
+    // FUTEX_WAIT takes a relative timeout measured against CLOCK_MONOTONIC
+    struct timespec ts;
+    ts.tv_sec = static_cast<time_t>(timeout / 1'000'000'000);
+    ts.tv_nsec = static_cast<long>(timeout % 1'000'000'000);
+
+    return Futex(addr, FUTEX_WAIT_PRIVATE, value, &ts) == 0 || errno != ETIMEDOUT;
+}
+
+inline void NotifyOnAddress(AtomicContention const volatile* addr, size_t)
+{
+    Futex(addr, FUTEX_WAKE_PRIVATE, 1, nullptr);
+}
+
+inline void NotifyAllOnAddress(AtomicContention const volatile* addr, size_t)
+{
+    Futex(addr, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr);
+}
+
+} // namespace mini
\ No newline at end of file
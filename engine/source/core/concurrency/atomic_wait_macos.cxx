@@ -1,5 +1,7 @@
 module;
 
+#include <errno.h>
+#include <os/clock.h>
 #include <os/os_sync_wait_on_address.h>
 
 #if CLANG || GNUC
@@ -48,6 +50,20 @@ inline void WaitOnAddress(AtomicContention const volatile* addr, AtomicContentio
     os_sync_wait_on_address(loc, value, size, OS_SYNC_WAIT_ON_ADDRESS_NONE);
 }
 
+inline bool WaitOnAddressFor(AtomicContention const volatile* addr, AtomicContention value, size_t size, int64 timeout)
+{
+    if (timeout <= 0) {
+        return false;
+    }
+
+    void* loc = const_cast<void*>(static_cast<void const volatile*>(addr));
+    uint64 ns = static_cast<uint64>(timeout);
+    int result = os_sync_wait_on_address_with_timeout(loc, value, size, OS_SYNC_WAIT_ON_ADDRESS_NONE,
+                                                      OS_CLOCK_MACH_ABSOLUTE_TIME, ns);
+
+    return result >= 0 || errno != ETIMEDOUT;
+}
+
 inline void NotifyOnAddress(AtomicContention const volatile* addr, size_t size)
 {
     void* loc = const_cast<void*>(static_cast<void const volatile*>(addr));
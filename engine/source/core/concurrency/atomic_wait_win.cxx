@@ -61,6 +61,7 @@ CORE_API inline void AtomicRelax()
 }
 
 CORE_API void WaitOnAddress(AtomicContention const volatile*, AtomicContention, size_t);
+CORE_API bool WaitOnAddressFor(AtomicContention const volatile*, AtomicContention, size_t, int64);
 CORE_API void NotifyOnAddress(AtomicContention const volatile*, size_t);
 CORE_API void NotifyAllOnAddress(AtomicContention const volatile*, size_t);
 
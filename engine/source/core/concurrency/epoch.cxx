@@ -0,0 +1,147 @@
+export module mini.core:epoch;
+
+import :type;
+import :allocator;
+import :array;
+import :atomic_base;
+import :atomic_platform;
+import :atomic;
+import :mutex;
+import :reclaim;
+
+namespace mini {
+
+// Epoch based reclamation domain.
+// Each participating thread owns an EpochHandle. Readers pin the current global epoch while inside of a
+// critical section, and retired pointers are only reclaimed once the global epoch advanced twice past the
+// epoch they were retired in, which guarantees that no reader can still hold a reference to them.
+// All handles have to be destroyed before their domain.
+export class CORE_API EpochDomain {
+private:
+    friend class EpochHandle;
+
+    // lowest bit marks an active critical section, the rest holds the pinned epoch
+    struct alignas(__ATOMIC_INTERFERENCE_SIZE) Record {
+        Atomic<uint64> state;
+        Atomic<bool> inUse;
+        Record* next;
+    };
+
+    alignas(__ATOMIC_INTERFERENCE_SIZE) Atomic<uint64> m_epoch;
+    Atomic<Record*> m_records;
+
+    Mutex m_orphanLock;
+    uint64 m_orphanEpoch;
+    Array<RetiredPointer> m_orphans;
+
+public:
+    EpochDomain() noexcept;
+    ~EpochDomain();
+
+    uint64 Epoch() const noexcept;
+    bool TryAdvance() noexcept;
+
+private:
+    Record* AcquireRecord();
+    void ReleaseRecord(Record*, Array<RetiredPointer>&, uint64);
+    void ReclaimOrphans(uint64);
+
+    EpochDomain(EpochDomain const&) = delete;
+    EpochDomain& operator=(EpochDomain const&) = delete;
+};
+
+// Per thread participant of an EpochDomain, it must not be shared between threads.
+// Critical sections nest, and only the outermost one touches the shared record.
+export class CORE_API EpochHandle {
+private:
+    typedef EpochDomain::Record Record;
+
+    static constexpr size_t bucketCount = 3;
+    static constexpr size_t collectThreshold = 64;
+
+    EpochDomain* m_domain;
+    Record* m_record;
+    uint32 m_depth;
+    size_t m_retiredCount;
+    uint64 m_bucketEpoch[bucketCount];
+    Array<RetiredPointer> m_buckets[bucketCount];
+
+public:
+    explicit EpochHandle(EpochDomain&);
+    ~EpochHandle();
+
+    void Enter() noexcept;
+    void Exit() noexcept;
+    bool Active() const noexcept;
+
+    template <typename T, AllocatorT<T> AllocT = Allocator<T>>
+    void Retire(T*);
+    void Retire(RetiredPointer);
+    void Collect();
+
+private:
+    void ReclaimBucket(size_t) noexcept;
+
+    EpochHandle(EpochHandle const&) = delete;
+    EpochHandle& operator=(EpochHandle const&) = delete;
+};
+
+export class EpochGuard {
+private:
+    EpochHandle& m_handle;
+
+public:
+    explicit EpochGuard(EpochHandle& handle) noexcept
+        : m_handle(handle)
+    {
+        m_handle.Enter();
+    }
+
+    ~EpochGuard() noexcept { m_handle.Exit(); }
+
+private:
+    EpochGuard(EpochGuard const&) = delete;
+    EpochGuard& operator=(EpochGuard const&) = delete;
+};
+
+inline uint64 EpochDomain::Epoch() const noexcept
+{
+    return m_epoch.Load(MemoryOrder::acquire);
+}
+
+inline void EpochHandle::Enter() noexcept
+{
+    if (m_depth++ != 0) {
+        return;
+    }
+
+    uint64 epoch = m_domain->m_epoch.Load(MemoryOrder::relaxed);
+    m_record->state.Store((epoch << 1) | 1, MemoryOrder::relaxed);
+
+    // the pin has to be visible before any shared pointer is read.
+    // a fence keeps the read side free of read-modify-write operations.
+    Atomic<uint64>::ThreadFence(MemoryOrder::sequential);
+}
+
+inline void EpochHandle::Exit() noexcept
+{
+    ASSERT(m_depth != 0, "unbalanced epoch critical section");
+    if (--m_depth != 0) {
+        return;
+    }
+
+    m_record->state.Store(0, MemoryOrder::release);
+}
+
+inline bool EpochHandle::Active() const noexcept
+{
+    return m_depth != 0;
+}
+
+template <typename T, AllocatorT<T> AllocT>
+inline void EpochHandle::Retire(T* pointer)
+{
+    Retire(MakeRetired<T, AllocT>(pointer));
+}
+
+} // namespace mini
\ No newline at end of file
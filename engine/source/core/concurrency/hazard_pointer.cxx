@@ -0,0 +1,116 @@
+export module mini.core:hazard_pointer;
+
+import :type;
+import :allocator;
+import :atomic_base;
+import :atomic_platform;
+import :atomic;
+import :reclaim;
+
+namespace mini {
+
+// Hazard pointer reclamation domain.
+// Unlike epochs, a protected pointer only pins the single object it points to, so it can be held for
+// an arbitrary long time without holding back the reclamation of everything else.
+// All hazard pointers have to be destroyed before their domain.
+export class CORE_API HazardDomain {
+private:
+    friend class HazardPointer;
+
+    struct alignas(__ATOMIC_INTERFERENCE_SIZE) Record {
+        Atomic<void const*> pointer;
+        Atomic<bool> inUse;
+        Record* next;
+    };
+
+    struct RetiredNode {
+        RetiredPointer retired;
+        RetiredNode* next;
+    };
+
+    static constexpr size_t reclaimThreshold = 64;
+
+    alignas(__ATOMIC_INTERFERENCE_SIZE) Atomic<Record*> m_records;
+    alignas(__ATOMIC_INTERFERENCE_SIZE) Atomic<RetiredNode*> m_retired;
+    Atomic<size_t> m_retiredCount;
+
+public:
+    HazardDomain() noexcept;
+    ~HazardDomain();
+
+    template <typename T, AllocatorT<T> AllocT = Allocator<T>>
+    void Retire(T*);
+    void Retire(RetiredPointer);
+    void Reclaim();
+
+private:
+    Record* AcquireRecord();
+    void ReleaseRecord(Record*) noexcept;
+    void PushRetired(RetiredNode*, RetiredNode*) noexcept;
+
+    HazardDomain(HazardDomain const&) = delete;
+    HazardDomain& operator=(HazardDomain const&) = delete;
+};
+
+// Single protection slot, owned by one thread at a time.
+export class CORE_API HazardPointer {
+private:
+    typedef HazardDomain::Record Record;
+
+    HazardDomain* m_domain;
+    Record* m_record;
+
+public:
+    explicit HazardPointer(HazardDomain&);
+    ~HazardPointer();
+
+    template <typename T>
+    T* Protect(Atomic<T*> const&) noexcept;
+    template <typename T>
+    void Set(T*) noexcept;
+    void Reset() noexcept;
+
+private:
+    HazardPointer(HazardPointer const&) = delete;
+    HazardPointer& operator=(HazardPointer const&) = delete;
+};
+
+template <typename T, AllocatorT<T> AllocT>
+inline void HazardDomain::Retire(T* pointer)
+{
+    Retire(MakeRetired<T, AllocT>(pointer));
+}
+
+template <typename T>
+inline T* HazardPointer::Protect(Atomic<T*> const& source) noexcept
+{
+    T* pointer = source.Load(MemoryOrder::relaxed);
+    for (;;) {
+        m_record->pointer.Store(static_cast<void const*>(pointer), MemoryOrder::relaxed);
+
+        // publish the hazard before validating it, without a read-modify-write operation
+        Atomic<void const*>::ThreadFence(MemoryOrder::sequential);
+
+        T* current = source.Load(MemoryOrder::acquire);
+        if (current == pointer) {
+            return pointer;
+        }
+
+        pointer = current;
+    }
+}
+
+template <typename T>
+inline void HazardPointer::Set(T* pointer) noexcept
+{
+    // caller is responsible of validating the pointer after this returns
+    m_record->pointer.Store(static_cast<void const*>(pointer), MemoryOrder::relaxed);
+    Atomic<void const*>::ThreadFence(MemoryOrder::sequential);
+}
+
+inline void HazardPointer::Reset() noexcept
+{
+    m_record->pointer.Store(nullptr, MemoryOrder::release);
+}
+
+} // namespace mini
\ No newline at end of file
@@ -15,6 +15,25 @@ void WaitOnAddress(AtomicContention const volatile* addr, AtomicContention value
     ::WaitOnAddress(loc, static_cast<void*>(&value), size, INFINITE);
 }
 
+bool WaitOnAddressFor(AtomicContention const volatile* addr, AtomicContention value, size_t size, int64 timeout)
+{
+    if (timeout <= 0) {
+        return false;
+    }
+
+    // round up to milliseconds so that we never wake up before the deadline,
+    // and keep it below INFINITE which would turn this into an unbounded wait
+    int64 ms = (timeout + 999'999) / 1'000'000;
+    DWORD wait = ms >= static_cast<int64>(INFINITE) ? INFINITE - 1 : static_cast<DWORD>(ms);
+
+    void* loc = const_cast<void*>(static_cast<void const volatile*>(addr));
+    if (::WaitOnAddress(loc, static_cast<void*>(&value), size, wait) == FALSE) {
+        return ::GetLastError() != ERROR_TIMEOUT;
+    }
+
+    return true;
+}
+
 void NotifyOnAddress(AtomicContention const volatile* addr, size_t)
 {
     void* loc = const_cast<void*>(static_cast<void const volatile*>(addr));
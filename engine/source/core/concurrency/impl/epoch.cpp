@@ -0,0 +1,186 @@
+module mini.core;
+
+import :type;
+import :allocator;
+import :memory_operation;
+import :array;
+import :atomic_base;
+import :atomic;
+import :mutex;
+import :reclaim;
+import :epoch;
+
+namespace mini {
+
+EpochDomain::EpochDomain() noexcept
+    : m_epoch(0)
+    , m_records(nullptr)
+    , m_orphanEpoch(0)
+{
+}
+
+EpochDomain::~EpochDomain()
+{
+    // every handle is gone by now, so nothing can be referenced anymore
+    for (RetiredPointer& retired : m_orphans) {
+        retired.Reclaim();
+    }
+
+    Record* record = m_records.Load(MemoryOrder::acquire);
+    while (record != nullptr) {
+        ASSERT(!record->inUse.Load(MemoryOrder::relaxed), "epoch handle outlived its domain");
+
+        Record* next = record->next;
+        memory::DestructAt(record);
+        Allocator<Record>().Deallocate(record, 1);
+        record = next;
+    }
+}
+
+bool EpochDomain::TryAdvance() noexcept
+{
+    uint64 epoch = m_epoch.Load(MemoryOrder::relaxed);
+    Atomic<uint64>::ThreadFence(MemoryOrder::sequential);
+
+    for (Record* record = m_records.Load(MemoryOrder::acquire); record != nullptr; record = record->next) {
+        uint64 state = record->state.Load(MemoryOrder::relaxed);
+        if ((state & 1) != 0 && (state >> 1) != epoch) {
+            return false;
+        }
+    }
+
+    return m_epoch.CompareExchangeStrong(epoch, epoch + 1, MemoryOrder::sequential, MemoryOrder::relaxed);
+}
+
+EpochDomain::Record* EpochDomain::AcquireRecord()
+{
+    for (Record* record = m_records.Load(MemoryOrder::acquire); record != nullptr; record = record->next) {
+        bool expected = false;
+        if (!record->inUse.Load(MemoryOrder::relaxed) &&
+            record->inUse.CompareExchangeStrong(expected, true, MemoryOrder::acquire)) {
+            return record;
+        }
+    }
+
+    // records are never unlinked, which keeps traversals on the reclaim side lock free
+    Record* record = Allocator<Record>().Allocate(1).pointer;
+    memory::ConstructAt(record);
+    record->state.Store(0, MemoryOrder::relaxed);
+    record->inUse.Store(true, MemoryOrder::relaxed);
+
+    Record* head = m_records.Load(MemoryOrder::relaxed);
+    do {
+        record->next = head;
+    } while (!m_records.CompareExchangeWeak(head, record, MemoryOrder::release, MemoryOrder::relaxed));
+
+    return record;
+}
+
+void EpochDomain::ReleaseRecord(Record* record, Array<RetiredPointer>& retired, uint64 epoch)
+{
+    if (!retired.Empty()) {
+        m_orphanLock.Lock();
+        for (RetiredPointer& pointer : retired) {
+            m_orphans.Push(pointer);
+        }
+
+        m_orphanEpoch = epoch > m_orphanEpoch ? epoch : m_orphanEpoch;
+        m_orphanLock.Unlock();
+    }
+
+    record->state.Store(0, MemoryOrder::relaxed);
+    record->inUse.Store(false, MemoryOrder::release);
+}
+
+void EpochDomain::ReclaimOrphans(uint64 epoch)
+{
+    if (!m_orphanLock.TryLock()) {
+        return;
+    }
+
+    if (!m_orphans.Empty() && m_orphanEpoch + 2 <= epoch) {
+        for (RetiredPointer& retired : m_orphans) {
+            retired.Reclaim();
+        }
+
+        m_orphans.Clear();
+    }
+
+    m_orphanLock.Unlock();
+}
+
+EpochHandle::EpochHandle(EpochDomain& domain)
+    : m_domain(&domain)
+    , m_record(domain.AcquireRecord())
+    , m_depth(0)
+    , m_retiredCount(0)
+    , m_bucketEpoch{ 0, 0, 0 }
+{
+}
+
+EpochHandle::~EpochHandle()
+{
+    ASSERT(m_depth == 0, "epoch handle destroyed inside of a critical section");
+    Collect();
+
+    // anything left has to outlive this handle, hand them over to the domain
+    Array<RetiredPointer> remains;
+    uint64 epoch = 0;
+    for (size_t i = 0; i < bucketCount; ++i) {
+        for (RetiredPointer& retired : m_buckets[i]) {
+            remains.Push(retired);
+        }
+
+        if (!m_buckets[i].Empty() && m_bucketEpoch[i] > epoch) {
+            epoch = m_bucketEpoch[i];
+        }
+    }
+
+    m_domain->ReleaseRecord(m_record, remains, epoch);
+}
+
+void EpochHandle::Retire(RetiredPointer retired)
+{
+    // the caller unlinked the pointer right before, labeling it with a stale epoch would free it too early
+    Atomic<uint64>::ThreadFence(MemoryOrder::sequential);
+    uint64 epoch = m_domain->m_epoch.Load(MemoryOrder::relaxed);
+    size_t index = static_cast<size_t>(epoch % bucketCount);
+
+    // a bucket of a different epoch is at least three epochs old, which is always safe to reclaim
+    if (m_bucketEpoch[index] != epoch) {
+        ReclaimBucket(index);
+        m_bucketEpoch[index] = epoch;
+    }
+
+    m_buckets[index].Push(retired);
+    if (++m_retiredCount >= collectThreshold) {
+        Collect();
+    }
+}
+
+void EpochHandle::Collect()
+{
+    m_domain->TryAdvance();
+
+    uint64 epoch = m_domain->m_epoch.Load(MemoryOrder::acquire);
+    for (size_t i = 0; i < bucketCount; ++i) {
+        if (m_bucketEpoch[i] + 2 <= epoch) {
+            ReclaimBucket(i);
+        }
+    }
+
+    m_domain->ReclaimOrphans(epoch);
+}
+
+void EpochHandle::ReclaimBucket(size_t index) noexcept
+{
+    Array<RetiredPointer>& bucket = m_buckets[index];
+    for (RetiredPointer& retired : bucket) {
+        retired.Reclaim();
+    }
+
+    m_retiredCount -= bucket.Size();
+    bucket.Clear();
+}
+
+} // namespace mini
\ No newline at end of file
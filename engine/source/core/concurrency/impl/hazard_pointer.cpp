@@ -0,0 +1,151 @@
+module mini.core;
+
+import :type;
+import :allocator;
+import :memory_operation;
+import :array;
+import :algorithm;
+import :atomic_base;
+import :atomic;
+import :reclaim;
+import :hazard_pointer;
+
+namespace mini {
+
+HazardDomain::HazardDomain() noexcept
+    : m_records(nullptr)
+    , m_retired(nullptr)
+    , m_retiredCount(0)
+{
+}
+
+HazardDomain::~HazardDomain()
+{
+    RetiredNode* node = m_retired.Exchange(nullptr, MemoryOrder::acquire);
+    while (node != nullptr) {
+        RetiredNode* next = node->next;
+        node->retired.Reclaim();
+        Allocator<RetiredNode>().Deallocate(node, 1);
+        node = next;
+    }
+
+    Record* record = m_records.Load(MemoryOrder::acquire);
+    while (record != nullptr) {
+        ASSERT(!record->inUse.Load(MemoryOrder::relaxed), "hazard pointer outlived its domain");
+
+        Record* next = record->next;
+        memory::DestructAt(record);
+        Allocator<Record>().Deallocate(record, 1);
+        record = next;
+    }
+}
+
+void HazardDomain::Retire(RetiredPointer retired)
+{
+    RetiredNode* node = Allocator<RetiredNode>().Allocate(1).pointer;
+    memory::ConstructAt(node, retired, nullptr);
+    PushRetired(node, node);
+
+    size_t count = m_retiredCount.FetchAdd(1, MemoryOrder::relaxed) + 1;
+    if (count % reclaimThreshold == 0) {
+        Reclaim();
+    }
+}
+
+void HazardDomain::Reclaim()
+{
+    RetiredNode* node = m_retired.Exchange(nullptr, MemoryOrder::acquire);
+    if (node == nullptr) {
+        return;
+    }
+
+    // retired pointers are unreachable at this point, so any hazard published after this fence
+    // would fail its validation. snapshot the ones published before it.
+    Atomic<void const*>::ThreadFence(MemoryOrder::sequential);
+
+    Array<void const*> hazards;
+    for (Record* record = m_records.Load(MemoryOrder::acquire); record != nullptr; record = record->next) {
+        void const* pointer = record->pointer.Load(MemoryOrder::acquire);
+        if (pointer != nullptr) {
+            hazards.Push(pointer);
+        }
+    }
+
+    RetiredNode* keepFirst = nullptr;
+    RetiredNode* keepLast = nullptr;
+    size_t reclaimed = 0;
+
+    while (node != nullptr) {
+        RetiredNode* next = node->next;
+        void const* pointer = static_cast<void const*>(node->retired.pointer);
+
+        if (Find(hazards.Begin(), hazards.End(), pointer) != hazards.End()) {
+            node->next = keepFirst;
+            keepFirst = node;
+            keepLast = keepLast == nullptr ? node : keepLast;
+        } else {
+            node->retired.Reclaim();
+            Allocator<RetiredNode>().Deallocate(node, 1);
+            ++reclaimed;
+        }
+
+        node = next;
+    }
+
+    if (keepFirst != nullptr) {
+        PushRetired(keepFirst, keepLast);
+    }
+
+    m_retiredCount.FetchSub(reclaimed, MemoryOrder::relaxed);
+}
+
+HazardDomain::Record* HazardDomain::AcquireRecord()
+{
+    for (Record* record = m_records.Load(MemoryOrder::acquire); record != nullptr; record = record->next) {
+        bool expected = false;
+        if (!record->inUse.Load(MemoryOrder::relaxed) &&
+            record->inUse.CompareExchangeStrong(expected, true, MemoryOrder::acquire)) {
+            return record;
+        }
+    }
+
+    // records are never unlinked, which keeps the scan lock free
+    Record* record = Allocator<Record>().Allocate(1).pointer;
+    memory::ConstructAt(record);
+    record->pointer.Store(nullptr, MemoryOrder::relaxed);
+    record->inUse.Store(true, MemoryOrder::relaxed);
+
+    Record* head = m_records.Load(MemoryOrder::relaxed);
+    do {
+        record->next = head;
+    } while (!m_records.CompareExchangeWeak(head, record, MemoryOrder::release, MemoryOrder::relaxed));
+
+    return record;
+}
+
+void HazardDomain::ReleaseRecord(Record* record) noexcept
+{
+    record->pointer.Store(nullptr, MemoryOrder::release);
+    record->inUse.Store(false, MemoryOrder::release);
+}
+
+void HazardDomain::PushRetired(RetiredNode* first, RetiredNode* last) noexcept
+{
+    RetiredNode* head = m_retired.Load(MemoryOrder::relaxed);
+    do {
+        last->next = head;
+    } while (!m_retired.CompareExchangeWeak(head, first, MemoryOrder::release, MemoryOrder::relaxed));
+}
+
+HazardPointer::HazardPointer(HazardDomain& domain)
+    : m_domain(&domain)
+    , m_record(domain.AcquireRecord())
+{
+}
+
+HazardPointer::~HazardPointer()
+{
+    m_domain->ReleaseRecord(m_record);
+}
+
+} // namespace mini
\ No newline at end of file
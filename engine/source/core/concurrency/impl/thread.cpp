@@ -0,0 +1,135 @@
+module mini.core;
+
+import :type;
+import :array;
+import :thread_platform;
+import :thread;
+
+namespace mini {
+
+// raw ids are only unique within their parent (core ids restart on every package),
+// so every distinct pair is renumbered in the order it has been first seen.
+static uint32 Renumber(Array<uint64>& seen, uint64 key)
+{
+    for (size_t i = 0; i < seen.Size(); ++i) {
+        if (seen[i] == key) {
+            return static_cast<uint32>(i);
+        }
+    }
+
+    seen.Push(key);
+    return static_cast<uint32>(seen.Size() - 1);
+}
+
+CpuTopology::CpuTopology()
+    : m_cpus()
+    , m_coreCount(0)
+    , m_packageCount(0)
+    , m_cacheCount(0)
+{
+    Array<PlatformCpu> cpus;
+    PlatformQueryTopology(cpus);
+
+    Array<uint64> cores, packages, caches;
+    for (PlatformCpu const& cpu : cpus) {
+        if (cpu.logical >= ThreadAffinity::maxCpu) {
+            continue;
+        }
+
+        uint64 package = cpu.package;
+        CpuInfo info;
+        info.logical = cpu.logical;
+        info.package = Renumber(packages, package);
+        info.core = Renumber(cores, (package << 32) | cpu.core);
+        info.cache = Renumber(caches, (package << 32) | cpu.cache);
+        m_cpus.Push(info);
+    }
+
+    if (m_cpus.Empty()) {
+        m_cpus.Push(CpuInfo{ 0, 0, 0, 0 });
+        cores.Push(0);
+        packages.Push(0);
+        caches.Push(0);
+    }
+
+    m_coreCount = static_cast<uint32>(cores.Size());
+    m_packageCount = static_cast<uint32>(packages.Size());
+    m_cacheCount = static_cast<uint32>(caches.Size());
+}
+
+CpuTopology const& CpuTopology::Get()
+{
+    static CpuTopology topology;
+    return topology;
+}
+
+ThreadAffinity CpuTopology::All() const noexcept
+{
+    ThreadAffinity affinity;
+    for (CpuInfo const& cpu : m_cpus) {
+        affinity.Set(cpu.logical);
+    }
+
+    return affinity;
+}
+
+ThreadAffinity CpuTopology::PhysicalCores() const noexcept
+{
+    // first logical processor of every core, which keeps pinned workers off each other's smt siblings
+    ThreadAffinity affinity;
+    for (uint32 core = 0; core < m_coreCount; ++core) {
+        for (CpuInfo const& cpu : m_cpus) {
+            if (cpu.core == core) {
+                affinity.Set(cpu.logical);
+                break;
+            }
+        }
+    }
+
+    return affinity;
+}
+
+ThreadAffinity CpuTopology::SiblingsOf(uint32 logical) const noexcept
+{
+    ThreadAffinity affinity;
+    for (CpuInfo const& cpu : m_cpus) {
+        if (cpu.logical != logical) {
+            continue;
+        }
+
+        for (CpuInfo const& sibling : m_cpus) {
+            if (sibling.core == cpu.core) {
+                affinity.Set(sibling.logical);
+            }
+        }
+
+        break;
+    }
+
+    return affinity;
+}
+
+ThreadAffinity CpuTopology::CacheDomain(uint32 index) const noexcept
+{
+    ThreadAffinity affinity;
+    for (CpuInfo const& cpu : m_cpus) {
+        if (cpu.cache == index) {
+            affinity.Set(cpu.logical);
+        }
+    }
+
+    return affinity;
+}
+
+ThreadAffinity CpuTopology::CacheDomainOf(uint32 logical) const noexcept
+{
+    for (CpuInfo const& cpu : m_cpus) {
+        if (cpu.logical == logical) {
+            return CacheDomain(cpu.cache);
+        }
+    }
+
+    return ThreadAffinity();
+}
+
+} // namespace mini
\ No newline at end of file
@@ -0,0 +1,87 @@
+module mini.core;
+
+import :type;
+import :array;
+import :mutex;
+import :thread_local_storage;
+
+namespace mini {
+
+struct ThreadLocalEntry {
+    void* pointer;
+    uint32 generation;
+};
+
+struct ThreadLocalIndices {
+    Mutex lock;
+    Array<uint32> generations;
+    Array<uint32> freeIndices;
+};
+
+static thread_local Array<ThreadLocalEntry> threadLocalSlots;
+
+static ThreadLocalIndices& GetThreadLocalIndices()
+{
+    static ThreadLocalIndices indices;
+    return indices;
+}
+
+ThreadLocalKey ThreadLocalRegistry::Acquire()
+{
+    ThreadLocalIndices& indices = GetThreadLocalIndices();
+    indices.lock.Lock();
+
+    ThreadLocalKey key;
+    if (indices.freeIndices.Empty()) {
+        key.index = static_cast<uint32>(indices.generations.Size());
+        key.generation = 1;
+        indices.generations.Push(key.generation);
+    } else {
+        key.index = indices.freeIndices.Last();
+        key.generation = indices.generations[key.index];
+        indices.freeIndices.RemoveLast();
+    }
+
+    indices.lock.Unlock();
+    return key;
+}
+
+void ThreadLocalRegistry::Release(ThreadLocalKey key) noexcept
+{
+    ThreadLocalIndices& indices = GetThreadLocalIndices();
+    indices.lock.Lock();
+
+    // slots of other threads still point to the released records,
+    // the bumped generation makes the next owner of the index ignore them
+    ++indices.generations[key.index];
+    indices.freeIndices.Push(key.index);
+
+    indices.lock.Unlock();
+}
+
+void*& ThreadLocalRegistry::Slot(ThreadLocalKey key)
+{
+    if (key.index >= threadLocalSlots.Size()) [[unlikely]] {
+        threadLocalSlots.Resize(key.index + 1, ThreadLocalEntry{ nullptr, 0 });
+    }
+
+    ThreadLocalEntry& entry = threadLocalSlots[key.index];
+    if (entry.generation != key.generation) [[unlikely]] {
+        entry.pointer = nullptr;
+        entry.generation = key.generation;
+    }
+
+    return entry.pointer;
+}
+
+void* ThreadLocalRegistry::Find(ThreadLocalKey key) noexcept
+{
+    if (key.index >= threadLocalSlots.Size()) {
+        return nullptr;
+    }
+
+    ThreadLocalEntry const& entry = threadLocalSlots[key.index];
+    return entry.generation == key.generation ? entry.pointer : nullptr;
+}
+
+} // namespace mini
\ No newline at end of file
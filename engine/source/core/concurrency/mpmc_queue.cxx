@@ -0,0 +1,366 @@
+export module mini.core:mpmc_queue;
+
+import :type;
+import :utility_operation;
+import :memory_operation;
+import :iterator;
+import :algorithm;
+import :fixed_buffer;
+import :atomic_base;
+import :atomic_platform;
+import :atomic;
+
+namespace mini {
+
+// Bounded multi producer, multi consumer queue based on Dmitry Vyukov's per-slot sequence numbers.
+// A slot is free for the producer of position p when its sequence equals p, and holds a value for
+// the consumer of position p when it equals p + 1. Consumers hand the slot over to the next lap by
+// storing p + capacity. Blocking operations sleep on the sequence of the slot they are stuck on.
+export template <MovableT T, size_t CapacityN>
+class MpmcQueue {
+private:
+    typedef uint32 Index;
+    typedef int32 IndexDiff;
+
+    static constexpr Index mask = static_cast<Index>(CapacityN - 1);
+    static constexpr size_t interferenceSize = __ATOMIC_INTERFERENCE_SIZE;
+
+    static_assert(CapacityN > 1 && (CapacityN & (CapacityN - 1)) == 0, "capacity must be a power of two");
+    static_assert(CapacityN <= (size_t(1) << 30), "capacity exceeds the index range");
+
+    struct Slot {
+        Atomic<Index> sequence;
+        memory::FixedBuffer<T, 1> storage;
+    };
+
+public:
+    typedef T Value;
+    typedef T* Pointer;
+    typedef T& Reference;
+    typedef T const ConstValue;
+    typedef T const* ConstPointer;
+    typedef T const& ConstReference;
+
+private:
+    alignas(interferenceSize) Atomic<Index> m_enqueue;
+    alignas(interferenceSize) Atomic<Index> m_dequeue;
+    alignas(interferenceSize) Slot m_slots[CapacityN];
+
+public:
+    MpmcQueue() noexcept;
+    ~MpmcQueue();
+
+    template <typename... Args>
+    bool TryEnqueue(Args&&...)
+        requires ConstructibleFromT<T, Args...>;
+    template <typename... Args>
+    void Enqueue(Args&&...)
+        requires ConstructibleFromT<T, Args...>;
+    template <ForwardIteratableByT<T> Iter>
+    size_t TryEnqueueRange(Iter, Iter);
+    template <ForwardIteratableByT<T> Iter>
+    void EnqueueRange(Iter, Iter);
+
+    bool TryDequeue(T&);
+    T Dequeue();
+    template <ForwardIteratorT Iter>
+    size_t TryDequeueRange(Iter, Iter);
+    template <ForwardIteratorT Iter>
+    size_t DequeueRange(Iter, Iter);
+
+    size_t Capacity() const noexcept;
+    size_t Size() const noexcept;
+    bool Empty() const noexcept;
+
+private:
+    size_t ClaimEnqueue(Index&, size_t, Index&) noexcept;
+    size_t ClaimDequeue(Index&, size_t, Index&) noexcept;
+
+    Slot& SlotAt(Index) noexcept;
+    static void Publish(Slot&, Index) noexcept;
+
+    MpmcQueue(MpmcQueue const&) = delete;
+    MpmcQueue& operator=(MpmcQueue const&) = delete;
+};
+
+template <MovableT T, size_t N>
+inline MpmcQueue<T, N>::MpmcQueue() noexcept
+    : m_enqueue(0)
+    , m_dequeue(0)
+{
+    for (Index i = 0; i < N; ++i) {
+        m_slots[i].sequence.Store(i, MemoryOrder::relaxed);
+    }
+}
+
+template <MovableT T, size_t N>
+inline MpmcQueue<T, N>::~MpmcQueue()
+{
+    Index pos = m_dequeue.Load(MemoryOrder::relaxed);
+    Index end = m_enqueue.Load(MemoryOrder::acquire);
+
+    for (; pos != end; ++pos) {
+        memory::DestructAt(SlotAt(pos).storage.Data());
+    }
+}
+
+template <MovableT T, size_t N>
+template <typename... Args>
+inline bool MpmcQueue<T, N>::TryEnqueue(Args&&... args)
+    requires ConstructibleFromT<T, Args...>
+{
+    Index pos, observed;
+    if (ClaimEnqueue(pos, 1, observed) == 0) {
+        return false;
+    }
+
+    Slot& slot = SlotAt(pos);
+    memory::ConstructAt(slot.storage.Data(), ForwardArg<Args>(args)...);
+    Publish(slot, pos + 1);
+    return true;
+}
+
+template <MovableT T, size_t N>
+template <typename... Args>
+inline void MpmcQueue<T, N>::Enqueue(Args&&... args)
+    requires ConstructibleFromT<T, Args...>
+{
+    Index pos, observed;
+    while (ClaimEnqueue(pos, 1, observed) == 0) {
+        SlotAt(pos).sequence.Wait(observed, MemoryOrder::acquire);
+    }
+
+    Slot& slot = SlotAt(pos);
+    memory::ConstructAt(slot.storage.Data(), ForwardArg<Args>(args)...);
+    Publish(slot, pos + 1);
+}
+
+template <MovableT T, size_t N>
+template <ForwardIteratableByT<T> Iter>
+inline size_t MpmcQueue<T, N>::TryEnqueueRange(Iter first, Iter last)
+{
+    size_t distance = Distance(first, last);
+    if (distance == 0) [[unlikely]] {
+        return 0;
+    }
+
+    Index pos, observed;
+    size_t count = ClaimEnqueue(pos, distance, observed);
+    for (size_t i = 0; i < count; ++i, ++first) {
+        Slot& slot = SlotAt(pos + static_cast<Index>(i));
+        memory::ConstructAt(slot.storage.Data(), *first);
+        Publish(slot, pos + static_cast<Index>(i) + 1);
+    }
+
+    return count;
+}
+
+template <MovableT T, size_t N>
+template <ForwardIteratableByT<T> Iter>
+inline void MpmcQueue<T, N>::EnqueueRange(Iter first, Iter last)
+{
+    size_t distance = Distance(first, last);
+    while (distance != 0) {
+        Index pos, observed;
+        size_t count = ClaimEnqueue(pos, distance, observed);
+        if (count == 0) {
+            SlotAt(pos).sequence.Wait(observed, MemoryOrder::acquire);
+            continue;
+        }
+
+        for (size_t i = 0; i < count; ++i, ++first) {
+            Slot& slot = SlotAt(pos + static_cast<Index>(i));
+            memory::ConstructAt(slot.storage.Data(), *first);
+            Publish(slot, pos + static_cast<Index>(i) + 1);
+        }
+
+        distance -= count;
+    }
+}
+
+template <MovableT T, size_t N>
+inline bool MpmcQueue<T, N>::TryDequeue(T& out)
+{
+    Index pos, observed;
+    if (ClaimDequeue(pos, 1, observed) == 0) {
+        return false;
+    }
+
+    Slot& slot = SlotAt(pos);
+    Pointer ele = slot.storage.Data();
+    out = MoveArg(*ele);
+    memory::DestructAt(ele);
+    Publish(slot, pos + static_cast<Index>(N));
+    return true;
+}
+
+template <MovableT T, size_t N>
+inline T MpmcQueue<T, N>::Dequeue()
+{
+    Index pos, observed;
+    while (ClaimDequeue(pos, 1, observed) == 0) {
+        SlotAt(pos).sequence.Wait(observed, MemoryOrder::acquire);
+    }
+
+    Slot& slot = SlotAt(pos);
+    Pointer ele = slot.storage.Data();
+    T result = MoveArg(*ele);
+    memory::DestructAt(ele);
+    Publish(slot, pos + static_cast<Index>(N));
+    return result;
+}
+
+template <MovableT T, size_t N>
+template <ForwardIteratorT Iter>
+inline size_t MpmcQueue<T, N>::TryDequeueRange(Iter first, Iter last)
+{
+    size_t distance = Distance(first, last);
+    if (distance == 0) [[unlikely]] {
+        return 0;
+    }
+
+    Index pos, observed;
+    size_t count = ClaimDequeue(pos, distance, observed);
+    for (size_t i = 0; i < count; ++i, ++first) {
+        Slot& slot = SlotAt(pos + static_cast<Index>(i));
+        Pointer ele = slot.storage.Data();
+        *first = MoveArg(*ele);
+        memory::DestructAt(ele);
+        Publish(slot, pos + static_cast<Index>(i + N));
+    }
+
+    return count;
+}
+
+template <MovableT T, size_t N>
+template <ForwardIteratorT Iter>
+inline size_t MpmcQueue<T, N>::DequeueRange(Iter first, Iter last)
+{
+    size_t distance = Distance(first, last);
+    if (distance == 0) [[unlikely]] {
+        return 0;
+    }
+
+    // blocks until at least one element is available, then drains as many as fits
+    Index pos, observed;
+    size_t count;
+    while ((count = ClaimDequeue(pos, distance, observed)) == 0) {
+        SlotAt(pos).sequence.Wait(observed, MemoryOrder::acquire);
+    }
+
+    for (size_t i = 0; i < count; ++i, ++first) {
+        Slot& slot = SlotAt(pos + static_cast<Index>(i));
+        Pointer ele = slot.storage.Data();
+        *first = MoveArg(*ele);
+        memory::DestructAt(ele);
+        Publish(slot, pos + static_cast<Index>(i + N));
+    }
+
+    return count;
+}
+
+template <MovableT T, size_t N>
+inline size_t MpmcQueue<T, N>::Capacity() const noexcept
+{
+    return N;
+}
+
+template <MovableT T, size_t N>
+inline size_t MpmcQueue<T, N>::Size() const noexcept
+{
+    // only a snapshot, both ends may move while reading them
+    Index dequeue = m_dequeue.Load(MemoryOrder::acquire);
+    Index enqueue = m_enqueue.Load(MemoryOrder::acquire);
+    IndexDiff diff = static_cast<IndexDiff>(enqueue - dequeue);
+    return diff < 0 ? 0 : static_cast<size_t>(diff) > N ? N : static_cast<size_t>(diff);
+}
+
+template <MovableT T, size_t N>
+inline bool MpmcQueue<T, N>::Empty() const noexcept
+{
+    return Size() == 0;
+}
+
+template <MovableT T, size_t N>
+inline size_t MpmcQueue<T, N>::ClaimEnqueue(Index& pos, size_t max, Index& observed) noexcept
+{
+    pos = m_enqueue.Load(MemoryOrder::relaxed);
+    for (;;) {
+        // count the consecutive slots that are ready for this lap, and claim all of them at once
+        size_t count = 0;
+        for (; count < max; ++count) {
+            Index target = pos + static_cast<Index>(count);
+            Index sequence = SlotAt(target).sequence.Load(MemoryOrder::acquire);
+            if (sequence != target) {
+                if (count == 0) {
+                    observed = sequence;
+                }
+                break;
+            }
+        }
+
+        if (count == 0) {
+            // slot still holds a value of the previous lap, the queue is full
+            if (static_cast<IndexDiff>(observed - pos) < 0) {
+                return 0;
+            }
+
+            pos = m_enqueue.Load(MemoryOrder::relaxed);
+            continue;
+        }
+
+        if (m_enqueue.CompareExchangeWeak(pos, pos + static_cast<Index>(count), MemoryOrder::relaxed)) {
+            return count;
+        }
+    }
+}
+
+template <MovableT T, size_t N>
+inline size_t MpmcQueue<T, N>::ClaimDequeue(Index& pos, size_t max, Index& observed) noexcept
+{
+    pos = m_dequeue.Load(MemoryOrder::relaxed);
+    for (;;) {
+        size_t count = 0;
+        for (; count < max; ++count) {
+            Index target = pos + static_cast<Index>(count);
+            Index sequence = SlotAt(target).sequence.Load(MemoryOrder::acquire);
+            if (sequence != target + 1) {
+                if (count == 0) {
+                    observed = sequence;
+                }
+                break;
+            }
+        }
+
+        if (count == 0) {
+            // slot has not been filled for this lap yet, the queue is empty
+            if (static_cast<IndexDiff>(observed - (pos + 1)) < 0) {
+                return 0;
+            }
+
+            pos = m_dequeue.Load(MemoryOrder::relaxed);
+            continue;
+        }
+
+        if (m_dequeue.CompareExchangeWeak(pos, pos + static_cast<Index>(count), MemoryOrder::relaxed)) {
+            return count;
+        }
+    }
+}
+
+template <MovableT T, size_t N>
+inline MpmcQueue<T, N>::Slot& MpmcQueue<T, N>::SlotAt(Index pos) noexcept
+{
+    return m_slots[pos & mask];
+}
+
+template <MovableT T, size_t N>
+inline void MpmcQueue<T, N>::Publish(Slot& slot, Index sequence) noexcept
+{
+    // several threads may sleep on the same slot when the queue is full or empty,
+    // and the store has to be ordered with the waiter check inside of notify.
+    slot.sequence.Store(sequence, MemoryOrder::sequential);
+    slot.sequence.NotifyAll();
+}
+
+} // namespace mini
\ No newline at end of file
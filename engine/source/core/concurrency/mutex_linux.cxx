@@ -0,0 +1,87 @@
+module;
+
+#include <pthread.h>
+
+export module mini.core:mutex_platform;
+
+import :type;
+
+namespace mini {
+
+using PlatformMutex = pthread_mutex_t;
+using PlatformRecursiveMutex = pthread_mutex_t;
+
+inline void MutexInitialize(PlatformMutex& mutex)
+{
+    // default attributes give a plain futex backed lock without owner tracking
+    mutex = PTHREAD_MUTEX_INITIALIZER;
+}
+
+inline void MutexLock(PlatformMutex& mutex)
+{
+    VERIFY(pthread_mutex_lock(&mutex) == 0, "failed to lock pthread_mutex");
+}
+
+inline void MutexUnlock(PlatformMutex& mutex)
+{
+    VERIFY(pthread_mutex_unlock(&mutex) == 0, "failed to unlock pthread_mutex");
+}
+
+inline bool MutexTryLock(PlatformMutex& mutex)
+{
+    return pthread_mutex_trylock(&mutex) == 0;
+}
+
+inline void RecursiveMutexInitialize(PlatformRecursiveMutex& mutex)
+{
+    pthread_mutexattr_t attr;
+    int32 error = pthread_mutexattr_init(&attr);
+    if (error) {
+        goto init_error;
+    }
+
+    error = pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    if (error) {
+        pthread_mutexattr_destroy(&attr);
+        goto init_error;
+    }
+
+    error = pthread_mutex_init(&mutex, &attr);
+    if (error) {
+        pthread_mutexattr_destroy(&attr);
+        goto init_error;
+    }
+
+    error = pthread_mutexattr_destroy(&attr);
+    if (error) {
+        pthread_mutex_destroy(&mutex);
+        goto init_error;
+    }
+
+    return;
+
+init_error:
+    ASSERT(error, "failed to initialize mutex");
+}
+
+inline void RecursiveMutexLock(PlatformRecursiveMutex& mutex)
+{
+    VERIFY(pthread_mutex_lock(&mutex) == 0, "failed to lock pthread_mutex");
+}
+
+inline void RecursiveMutexUnlock(PlatformRecursiveMutex& mutex)
+{
+    VERIFY(pthread_mutex_unlock(&mutex) == 0, "failed to unlock pthread_mutex");
+}
+
+inline bool RecursiveMutexTryLock(PlatformRecursiveMutex& mutex)
+{
+    return pthread_mutex_trylock(&mutex) == 0;
+}
+
+inline void RecursiveMutexDestroy(PlatformRecursiveMutex& mutex)
+{
+    VERIFY(pthread_mutex_destroy(&mutex) == 0, "failed to destroy pthread_mutex");
+}
+
+} // namespace mini
\ No newline at end of file
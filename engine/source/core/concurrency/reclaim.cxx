@@ -0,0 +1,35 @@
+export module mini.core:reclaim;
+
+import :type;
+import :memory_operation;
+import :allocator;
+
+namespace mini {
+
+// Type erased pointer waiting for reclamation, shared by the epoch and hazard pointer domains.
+export struct RetiredPointer {
+public:
+    typedef void (*Deleter)(void*) noexcept;
+
+    void* pointer;
+    Deleter deleter;
+
+    void Reclaim() const noexcept { deleter(pointer); }
+};
+
+template <typename T, AllocatorT<T> AllocT>
+inline void ReclaimWithAllocator(void* pointer) noexcept
+{
+    T* object = static_cast<T*>(pointer);
+    memory::DestructAt(object);
+    AllocT().Deallocate(object, 1);
+}
+
+// Object must have been allocated with a default constructed instance of the given allocator.
+export template <typename T, AllocatorT<T> AllocT = Allocator<T>>
+inline RetiredPointer MakeRetired(T* pointer) noexcept
+{
+    return RetiredPointer{ .pointer = static_cast<void*>(pointer), .deleter = &ReclaimWithAllocator<T, AllocT> };
+}
+
+} // namespace mini
\ No newline at end of file
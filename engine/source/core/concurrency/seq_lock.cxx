@@ -0,0 +1,246 @@
+export module mini.core:seq_lock;
+
+import :type;
+import :memory_operation;
+import :atomic_platform;
+import :atomic_platform_wait;
+
+namespace mini {
+
+typedef uint32 SeqLockSequence;
+
+template <typename T>
+concept SeqLockedT = sizeof(T) > __ATOMIC_MAX_SUPPORT_SIZE;
+
+// Value is copied word by word with relaxed atomics, so it is at least aligned to a machine word.
+// Sequence is odd while a writer is in the middle of an update, and bumped by two on every write.
+// It is kept as a 32-bit word so that waiters can sleep on it natively on every platform.
+template <typename T>
+struct SeqLockBase {
+public:
+    typedef T Value;
+
+    static constexpr size_t alignment = alignof(T) > alignof(size_t) ? alignof(T) : alignof(size_t);
+
+    alignas(alignment) Value value;
+    SeqLockSequence sequence;
+};
+
+template <typename T>
+inline void SeqLockCopyOut(T* dst, T const volatile* src) noexcept
+{
+    constexpr size_t wordCount = sizeof(T) / sizeof(size_t);
+    constexpr size_t byteOffset = wordCount * sizeof(size_t);
+
+    size_t const volatile* srcWord = reinterpret_cast<size_t const volatile*>(src);
+    size_t* dstWord = reinterpret_cast<size_t*>(memory::AddressOf(*dst));
+    for (size_t i = 0; i < wordCount; ++i) {
+        __atomic_load(srcWord + i, dstWord + i, __ATOMIC_RELAXED);
+    }
+
+    uint8 const volatile* srcByte = reinterpret_cast<uint8 const volatile*>(src);
+    uint8* dstByte = reinterpret_cast<uint8*>(memory::AddressOf(*dst));
+    for (size_t i = byteOffset; i < sizeof(T); ++i) {
+        __atomic_load(srcByte + i, dstByte + i, __ATOMIC_RELAXED);
+    }
+}
+
+template <typename T>
+inline void SeqLockCopyIn(T volatile* dst, T const* src) noexcept
+{
+    constexpr size_t wordCount = sizeof(T) / sizeof(size_t);
+    constexpr size_t byteOffset = wordCount * sizeof(size_t);
+
+    size_t volatile* dstWord = reinterpret_cast<size_t volatile*>(dst);
+    size_t const* srcWord = reinterpret_cast<size_t const*>(memory::AddressOf(*src));
+    for (size_t i = 0; i < wordCount; ++i) {
+        __atomic_store(dstWord + i, const_cast<size_t*>(srcWord + i), __ATOMIC_RELAXED);
+    }
+
+    uint8 volatile* dstByte = reinterpret_cast<uint8 volatile*>(dst);
+    uint8 const* srcByte = reinterpret_cast<uint8 const*>(memory::AddressOf(*src));
+    for (size_t i = byteOffset; i < sizeof(T); ++i) {
+        __atomic_store(dstByte + i, const_cast<uint8*>(srcByte + i), __ATOMIC_RELAXED);
+    }
+}
+
+// retries until a copy has been taken without any writer in between, returns the sequence it was read at.
+template <typename T>
+inline SeqLockSequence SeqLockRead(SeqLockBase<T> const volatile* base, T& out, int32 order) noexcept
+{
+    int32 loadOrder = order == __ATOMIC_SEQ_CST ? __ATOMIC_SEQ_CST : __ATOMIC_ACQUIRE;
+    for (;;) {
+        SeqLockSequence begin, end;
+        __atomic_load(&base->sequence, &begin, loadOrder);
+
+        if ((begin & 1) == 0) {
+            SeqLockCopyOut(memory::AddressOf(out), &base->value);
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+            __atomic_load(&base->sequence, &end, __ATOMIC_RELAXED);
+            if (begin == end) {
+                return begin;
+            }
+        }
+
+        AtomicRelax();
+    }
+}
+
+// marks the sequence odd, which excludes the other writers. with a single writer it never retries.
+template <typename T>
+inline SeqLockSequence SeqLockAcquire(SeqLockBase<T> volatile* base) noexcept
+{
+    SeqLockSequence current;
+    __atomic_load(&base->sequence, &current, __ATOMIC_RELAXED);
+
+    for (;;) {
+        if ((current & 1) == 0) {
+            SeqLockSequence locked = current + 1;
+            if (__atomic_compare_exchange(&base->sequence,
+                                          &current,
+                                          &locked,
+                                          false,
+                                          __ATOMIC_ACQUIRE,
+                                          __ATOMIC_RELAXED)) {
+                break;
+            }
+
+            continue;
+        }
+
+        AtomicRelax();
+        __atomic_load(&base->sequence, &current, __ATOMIC_RELAXED);
+    }
+
+    // the odd sequence must be visible before any of the value is
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    return current;
+}
+
+// publishes the new sequence. passing the acquired one back releases without marking a change.
+template <typename T>
+inline void SeqLockRelease(SeqLockBase<T> volatile* base, SeqLockSequence sequence, int32 order) noexcept
+{
+    int32 storeOrder = order == __ATOMIC_SEQ_CST ? __ATOMIC_SEQ_CST : __ATOMIC_RELEASE;
+    __atomic_store(&base->sequence, &sequence, storeOrder);
+}
+
+template <typename T>
+inline void SeqLockWrite(SeqLockBase<T> volatile* base, T const& value, int32 order) noexcept
+{
+    SeqLockSequence sequence = SeqLockAcquire(base);
+    SeqLockCopyIn(&base->value, memory::AddressOf(value));
+    SeqLockRelease(base, sequence + 2, order);
+}
+
+// Sequence lock for read mostly data. Readers never write to shared memory and retry only when a
+// write overlapped with their copy. Writers are serialized with each other, a single writer never waits.
+export template <TrivialT T>
+class SeqLock {
+public:
+    typedef T Value;
+    typedef SeqLockSequence Sequence;
+
+private:
+    mutable SeqLockBase<T> m_base;
+
+public:
+    constexpr SeqLock() noexcept(NoThrowDefaultConstructibleT<T>)
+        requires DefaultConstructibleT<T>;
+    constexpr SeqLock(T const&) noexcept;
+
+    T Load() const noexcept;
+    bool TryLoad(T&) const noexcept;
+    void Store(T const&) noexcept;
+    template <typename Func>
+    void Update(Func&&);
+
+    Sequence CurrentSequence() const noexcept;
+    bool Changed(Sequence) const noexcept;
+
+private:
+    SeqLock(SeqLock const&) = delete;
+    SeqLock& operator=(SeqLock const&) = delete;
+};
+
+template <TrivialT T>
+inline constexpr SeqLock<T>::SeqLock() noexcept(NoThrowDefaultConstructibleT<T>)
+    requires DefaultConstructibleT<T>
+    : m_base(T())
+{
+}
+
+template <TrivialT T>
+inline constexpr SeqLock<T>::SeqLock(T const& value) noexcept
+    : m_base(value)
+{
+}
+
+template <TrivialT T>
+inline T SeqLock<T>::Load() const noexcept
+{
+    T result;
+    SeqLockRead(&m_base, result, __ATOMIC_ACQUIRE);
+    return result;
+}
+
+template <TrivialT T>
+inline bool SeqLock<T>::TryLoad(T& out) const noexcept
+{
+    // single attempt, fails when a writer is active or finished while copying
+    SeqLockSequence begin, end;
+    __atomic_load(&m_base.sequence, &begin, __ATOMIC_ACQUIRE);
+    if ((begin & 1) != 0) {
+        return false;
+    }
+
+    T result;
+    SeqLockCopyOut(memory::AddressOf(result), &m_base.value);
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    __atomic_load(&m_base.sequence, &end, __ATOMIC_RELAXED);
+    if (begin != end) {
+        return false;
+    }
+
+    out = result;
+    return true;
+}
+
+template <TrivialT T>
+inline void SeqLock<T>::Store(T const& value) noexcept
+{
+    SeqLockWrite(&m_base, value, __ATOMIC_RELEASE);
+}
+
+template <TrivialT T>
+template <typename Func>
+inline void SeqLock<T>::Update(Func&& func)
+{
+    // the writer owns the value while the sequence is odd, so it can be modified from a private copy
+    SeqLockSequence sequence = SeqLockAcquire(&m_base);
+
+    T value;
+    SeqLockCopyOut(memory::AddressOf(value), &m_base.value);
+    func(value);
+
+    SeqLockCopyIn(&m_base.value, memory::AddressOf(value));
+    SeqLockRelease(&m_base, sequence + 2, __ATOMIC_RELEASE);
+}
+
+template <TrivialT T>
+inline SeqLock<T>::Sequence SeqLock<T>::CurrentSequence() const noexcept
+{
+    SeqLockSequence sequence;
+    __atomic_load(&m_base.sequence, &sequence, __ATOMIC_ACQUIRE);
+    return sequence;
+}
+
+template <TrivialT T>
+inline bool SeqLock<T>::Changed(Sequence sequence) const noexcept
+{
+    return CurrentSequence() != sequence;
+}
+
+} // namespace mini
\ No newline at end of file
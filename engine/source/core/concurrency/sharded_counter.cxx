@@ -0,0 +1,158 @@
+export module mini.core:sharded_counter;
+
+import :type;
+import :allocator;
+import :memory_operation;
+import :atomic_base;
+import :atomic;
+import :thread;
+import :thread_local_storage;
+
+namespace mini {
+
+// Counter split into one slot per thread.
+// Only the owning thread writes its slot, so Add is a plain load and store on a line no other writer touches,
+// and Load sums every slot lazily. Reset is not synchronized with concurrent Add, which may overwrite it.
+export class ShardedCounter {
+private:
+    struct Shard {
+        Atomic<int64> value;
+
+        Shard() noexcept
+            : value(0)
+        {
+        }
+    };
+
+    ThreadLocal<Shard> m_shards;
+
+public:
+    ShardedCounter() = default;
+
+    void Add(int64 = 1);
+    void Sub(int64 = 1);
+    int64 Load() const noexcept;
+    void Reset() noexcept;
+
+private:
+    ShardedCounter(ShardedCounter const&) = delete;
+    ShardedCounter& operator=(ShardedCounter const&) = delete;
+};
+
+// Counter split into one slot per logical processor.
+// Unlike ShardedCounter the memory is bounded by the processor count, not by every thread that ever counted.
+// A thread can be preempted between picking its slot and writing to it, so slots are still updated with an
+// atomic add, which stays uncontended and local to the cache of that processor in the common case.
+export class PerCpuCounter {
+private:
+    struct alignas(__ATOMIC_INTERFERENCE_SIZE) Slot {
+        Atomic<int64> value;
+    };
+
+    Slot* m_slots;
+    uint32 m_slotCount;
+
+public:
+    PerCpuCounter();
+    ~PerCpuCounter();
+
+    void Add(int64 = 1) noexcept;
+    void Sub(int64 = 1) noexcept;
+    int64 Load() const noexcept;
+    void Reset() noexcept;
+
+private:
+    uint32 CurrentSlot() const noexcept;
+
+    PerCpuCounter(PerCpuCounter const&) = delete;
+    PerCpuCounter& operator=(PerCpuCounter const&) = delete;
+};
+
+inline void ShardedCounter::Add(int64 value)
+{
+    Atomic<int64>& shard = m_shards.Get().value;
+    shard.Store(shard.Load(MemoryOrder::relaxed) + value, MemoryOrder::relaxed);
+}
+
+inline void ShardedCounter::Sub(int64 value)
+{
+    Add(-value);
+}
+
+inline int64 ShardedCounter::Load() const noexcept
+{
+    int64 sum = 0;
+    m_shards.ForEach([&sum](Shard const& shard) { sum += shard.value.Load(MemoryOrder::relaxed); });
+    return sum;
+}
+
+inline void ShardedCounter::Reset() noexcept
+{
+    m_shards.ForEach([](Shard& shard) { shard.value.Store(0, MemoryOrder::relaxed); });
+}
+
+inline PerCpuCounter::PerCpuCounter()
+    : m_slots(nullptr)
+    , m_slotCount(1)
+{
+    CpuTopology const& topology = CpuTopology::Get();
+    for (size_t i = 0; i < topology.LogicalCount(); ++i) {
+        uint32 logical = topology.At(i).logical;
+        m_slotCount = logical >= m_slotCount ? logical + 1 : m_slotCount;
+    }
+
+    m_slots = Allocator<Slot>().Allocate(m_slotCount).pointer;
+    for (uint32 i = 0; i < m_slotCount; ++i) {
+        memory::ConstructAt(m_slots + i);
+        m_slots[i].value.Store(0, MemoryOrder::relaxed);
+    }
+}
+
+inline PerCpuCounter::~PerCpuCounter()
+{
+    for (uint32 i = 0; i < m_slotCount; ++i) {
+        memory::DestructAt(m_slots + i);
+    }
+
+    Allocator<Slot>().Deallocate(m_slots, m_slotCount);
+}
+
+inline void PerCpuCounter::Add(int64 value) noexcept
+{
+    m_slots[CurrentSlot()].value.FetchAdd(value, MemoryOrder::relaxed);
+}
+
+inline void PerCpuCounter::Sub(int64 value) noexcept
+{
+    m_slots[CurrentSlot()].value.FetchSub(value, MemoryOrder::relaxed);
+}
+
+inline int64 PerCpuCounter::Load() const noexcept
+{
+    int64 sum = 0;
+    for (uint32 i = 0; i < m_slotCount; ++i) {
+        sum += m_slots[i].value.Load(MemoryOrder::relaxed);
+    }
+
+    return sum;
+}
+
+inline void PerCpuCounter::Reset() noexcept
+{
+    for (uint32 i = 0; i < m_slotCount; ++i) {
+        m_slots[i].value.Store(0, MemoryOrder::relaxed);
+    }
+}
+
+inline uint32 PerCpuCounter::CurrentSlot() const noexcept
+{
+#if PLATFORM_MACOS
+    // darwin does not expose the current processor, spread by thread instead
+    uint64 id = Thread::CurrentId();
+    return static_cast<uint32>((id ^ (id >> 17)) % m_slotCount);
+#else
+    return Thread::CurrentCpu() % m_slotCount;
+#endif
+}
+
+} // namespace mini
\ No newline at end of file
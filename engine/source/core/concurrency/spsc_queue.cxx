@@ -0,0 +1,334 @@
+export module mini.core:spsc_queue;
+
+import :type;
+import :utility_operation;
+import :memory_operation;
+import :iterator;
+import :fixed_buffer;
+import :duration;
+import :atomic_base;
+import :atomic_platform;
+import :atomic;
+
+namespace mini {
+
+// Bounded single producer, single consumer ring buffer.
+// Indices are free running 32-bit counters masked into the buffer, which keeps them natively waitable
+// on every platform. Capacity has to be a power of two, so that the wrap around stays consistent.
+export template <MovableT T, size_t CapacityN>
+class SpscQueue {
+private:
+    typedef memory::FixedBuffer<T, CapacityN> Buffer;
+    typedef uint32 Index;
+
+    static constexpr Index mask = static_cast<Index>(CapacityN - 1);
+    static constexpr size_t interferenceSize = __ATOMIC_INTERFERENCE_SIZE;
+
+    static_assert(CapacityN > 1 && (CapacityN & (CapacityN - 1)) == 0, "capacity must be a power of two");
+    static_assert(CapacityN <= (size_t(1) << 31), "capacity exceeds the index range");
+
+public:
+    typedef T Value;
+    typedef T* Pointer;
+    typedef T& Reference;
+    typedef T const ConstValue;
+    typedef T const* ConstPointer;
+    typedef T const& ConstReference;
+
+private:
+    // consumer owned, the cached tail avoids touching the producer's cache line on every dequeue
+    alignas(interferenceSize) Atomic<Index> m_head;
+    Index m_tailCache;
+
+    // producer owned, the cached head avoids touching the consumer's cache line on every enqueue
+    alignas(interferenceSize) Atomic<Index> m_tail;
+    Index m_headCache;
+
+    alignas(interferenceSize) Buffer m_buffer;
+
+public:
+    SpscQueue() noexcept;
+    ~SpscQueue();
+
+    template <typename... Args>
+    bool TryEnqueue(Args&&...)
+        requires ConstructibleFromT<T, Args...>;
+    template <typename... Args>
+    void Enqueue(Args&&...)
+        requires ConstructibleFromT<T, Args...>;
+    template <ForwardIteratableByT<T> Iter>
+    size_t TryEnqueueRange(Iter, Iter);
+    template <ForwardIteratableByT<T> Iter>
+    void EnqueueRange(Iter, Iter);
+
+    bool TryDequeue(T&);
+    template <DurationT D>
+    bool TryDequeueFor(T&, D const&);
+    T Dequeue();
+    template <ForwardIteratorT Iter>
+    size_t TryDequeueRange(Iter, Iter);
+    template <ForwardIteratorT Iter>
+    size_t DequeueRange(Iter, Iter);
+
+    size_t Capacity() const noexcept;
+    size_t Size() const noexcept;
+    bool Empty() const noexcept;
+    bool Full() const noexcept;
+
+private:
+    template <typename Iter>
+    size_t EnqueueRangeFrom(Iter&, Iter);
+    template <typename Iter>
+    size_t DequeueRangeTo(Iter, Iter);
+
+    static void Publish(Atomic<Index>&, Index) noexcept;
+
+    SpscQueue(SpscQueue const&) = delete;
+    SpscQueue& operator=(SpscQueue const&) = delete;
+};
+
+template <MovableT T, size_t N>
+inline SpscQueue<T, N>::SpscQueue() noexcept
+    : m_head(0)
+    , m_tailCache(0)
+    , m_tail(0)
+    , m_headCache(0)
+    , m_buffer()
+{
+}
+
+template <MovableT T, size_t N>
+inline SpscQueue<T, N>::~SpscQueue()
+{
+    Index head = m_head.Load(MemoryOrder::relaxed);
+    Index tail = m_tail.Load(MemoryOrder::acquire);
+
+    for (; head != tail; ++head) {
+        memory::DestructAt(m_buffer.Data() + (head & mask));
+    }
+}
+
+template <MovableT T, size_t N>
+template <typename... Args>
+inline bool SpscQueue<T, N>::TryEnqueue(Args&&... args)
+    requires ConstructibleFromT<T, Args...>
+{
+    Index tail = m_tail.Load(MemoryOrder::relaxed);
+    if (static_cast<Index>(tail - m_headCache) == N) {
+        m_headCache = m_head.Load(MemoryOrder::acquire);
+        if (static_cast<Index>(tail - m_headCache) == N) {
+            return false;
+        }
+    }
+
+    memory::ConstructAt(m_buffer.Data() + (tail & mask), ForwardArg<Args>(args)...);
+    Publish(m_tail, tail + 1);
+    return true;
+}
+
+template <MovableT T, size_t N>
+template <typename... Args>
+inline void SpscQueue<T, N>::Enqueue(Args&&... args)
+    requires ConstructibleFromT<T, Args...>
+{
+    Index tail = m_tail.Load(MemoryOrder::relaxed);
+    while (static_cast<Index>(tail - m_headCache) == N) {
+        m_headCache = m_head.Load(MemoryOrder::acquire);
+        if (static_cast<Index>(tail - m_headCache) != N) {
+            break;
+        }
+
+        m_head.Wait(m_headCache, MemoryOrder::acquire);
+    }
+
+    memory::ConstructAt(m_buffer.Data() + (tail & mask), ForwardArg<Args>(args)...);
+    Publish(m_tail, tail + 1);
+}
+
+template <MovableT T, size_t N>
+template <ForwardIteratableByT<T> Iter>
+inline size_t SpscQueue<T, N>::TryEnqueueRange(Iter first, Iter last)
+{
+    return EnqueueRangeFrom(first, last);
+}
+
+template <MovableT T, size_t N>
+template <ForwardIteratableByT<T> Iter>
+inline void SpscQueue<T, N>::EnqueueRange(Iter first, Iter last)
+{
+    while (first != last) {
+        if (EnqueueRangeFrom(first, last) == 0) {
+            m_head.Wait(m_headCache, MemoryOrder::acquire);
+        }
+    }
+}
+
+template <MovableT T, size_t N>
+inline bool SpscQueue<T, N>::TryDequeue(T& out)
+{
+    Index head = m_head.Load(MemoryOrder::relaxed);
+    if (head == m_tailCache) {
+        m_tailCache = m_tail.Load(MemoryOrder::acquire);
+        if (head == m_tailCache) {
+            return false;
+        }
+    }
+
+    Pointer ele = m_buffer.Data() + (head & mask);
+    out = MoveArg(*ele);
+    memory::DestructAt(ele);
+    Publish(m_head, head + 1);
+    return true;
+}
+
+template <MovableT T, size_t N>
+template <DurationT D>
+inline bool SpscQueue<T, N>::TryDequeueFor(T& out, D const& timeout)
+{
+    if (TryDequeue(out)) {
+        return true;
+    }
+
+    // the failed try refreshed the cached tail, the wait ends as soon as the producer publishes past it
+    m_tail.WaitFor(m_tailCache, timeout, MemoryOrder::acquire);
+    return TryDequeue(out);
+}
+
+template <MovableT T, size_t N>
+inline T SpscQueue<T, N>::Dequeue()
+{
+    Index head = m_head.Load(MemoryOrder::relaxed);
+    while (head == m_tailCache) {
+        m_tailCache = m_tail.Load(MemoryOrder::acquire);
+        if (head != m_tailCache) {
+            break;
+        }
+
+        m_tail.Wait(m_tailCache, MemoryOrder::acquire);
+    }
+
+    Pointer ele = m_buffer.Data() + (head & mask);
+    T result = MoveArg(*ele);
+    memory::DestructAt(ele);
+    Publish(m_head, head + 1);
+    return result;
+}
+
+template <MovableT T, size_t N>
+template <ForwardIteratorT Iter>
+inline size_t SpscQueue<T, N>::TryDequeueRange(Iter first, Iter last)
+{
+    return DequeueRangeTo(first, last);
+}
+
+template <MovableT T, size_t N>
+template <ForwardIteratorT Iter>
+inline size_t SpscQueue<T, N>::DequeueRange(Iter first, Iter last)
+{
+    if (first == last) [[unlikely]] {
+        return 0;
+    }
+
+    // blocks until at least one element is available, then drains as many as fits
+    for (;;) {
+        size_t count = DequeueRangeTo(first, last);
+        if (count != 0) {
+            return count;
+        }
+
+        m_tail.Wait(m_tailCache, MemoryOrder::acquire);
+    }
+}
+
+template <MovableT T, size_t N>
+inline size_t SpscQueue<T, N>::Capacity() const noexcept
+{
+    return N;
+}
+
+template <MovableT T, size_t N>
+inline size_t SpscQueue<T, N>::Size() const noexcept
+{
+    Index head = m_head.Load(MemoryOrder::acquire);
+    Index tail = m_tail.Load(MemoryOrder::acquire);
+    return static_cast<Index>(tail - head);
+}
+
+template <MovableT T, size_t N>
+inline bool SpscQueue<T, N>::Empty() const noexcept
+{
+    return Size() == 0;
+}
+
+template <MovableT T, size_t N>
+inline bool SpscQueue<T, N>::Full() const noexcept
+{
+    return Size() == N;
+}
+
+template <MovableT T, size_t N>
+template <typename Iter>
+inline size_t SpscQueue<T, N>::EnqueueRangeFrom(Iter& first, Iter last)
+{
+    Index tail = m_tail.Load(MemoryOrder::relaxed);
+    size_t space = N - static_cast<Index>(tail - m_headCache);
+    size_t count = 0;
+
+    for (; first != last; ++first, ++count) {
+        if (count == space) {
+            m_headCache = m_head.Load(MemoryOrder::acquire);
+            space = N - static_cast<Index>(tail - m_headCache);
+            if (count == space) {
+                break;
+            }
+        }
+
+        memory::ConstructAt(m_buffer.Data() + ((tail + count) & mask), *first);
+    }
+
+    if (count != 0) {
+        Publish(m_tail, tail + static_cast<Index>(count));
+    }
+
+    return count;
+}
+
+template <MovableT T, size_t N>
+template <typename Iter>
+inline size_t SpscQueue<T, N>::DequeueRangeTo(Iter first, Iter last)
+{
+    Index head = m_head.Load(MemoryOrder::relaxed);
+    size_t available = static_cast<Index>(m_tailCache - head);
+    size_t count = 0;
+
+    for (; first != last; ++first, ++count) {
+        if (count == available) {
+            m_tailCache = m_tail.Load(MemoryOrder::acquire);
+            available = static_cast<Index>(m_tailCache - head);
+            if (count == available) {
+                break;
+            }
+        }
+
+        Pointer ele = m_buffer.Data() + ((head + count) & mask);
+        *first = MoveArg(*ele);
+        memory::DestructAt(ele);
+    }
+
+    if (count != 0) {
+        Publish(m_head, head + static_cast<Index>(count));
+    }
+
+    return count;
+}
+
+template <MovableT T, size_t N>
+inline void SpscQueue<T, N>::Publish(Atomic<Index>& index, Index value) noexcept
+{
+    // the store has to be sequentially consistent with the waiter check inside of notify,
+    // otherwise a thread going to sleep in between the two could miss the wake up.
+    index.Store(value, MemoryOrder::sequential);
+    index.Notify();
+}
+
+} // namespace mini
\ No newline at end of file
@@ -0,0 +1,428 @@
+export module mini.core:thread;
+
+import :type;
+import :utility_operation;
+import :memory_operation;
+import :allocator;
+import :array;
+import :string_view;
+import :duration;
+import :thread_platform;
+
+namespace mini {
+
+export class ThreadAffinity {
+public:
+    static constexpr uint32 maxCpu = 256;
+
+private:
+    static constexpr uint32 wordBits = 64;
+    static constexpr uint32 wordCount = maxCpu / wordBits;
+
+    uint64 m_mask[wordCount];
+
+public:
+    constexpr ThreadAffinity() noexcept;
+    constexpr explicit ThreadAffinity(uint32) noexcept;
+
+    constexpr void Set(uint32) noexcept;
+    constexpr void Reset(uint32) noexcept;
+    constexpr void Clear() noexcept;
+
+    constexpr bool Test(uint32) const noexcept;
+    constexpr uint32 Count() const noexcept;
+    constexpr bool Empty() const noexcept;
+
+    constexpr uint64 const* Data() const noexcept;
+    static constexpr size_t WordCount() noexcept;
+
+    constexpr ThreadAffinity& operator|=(ThreadAffinity const&) noexcept;
+    constexpr ThreadAffinity& operator&=(ThreadAffinity const&) noexcept;
+};
+
+// realtime maps to the fifo scheduler on linux, which needs elevated privileges.
+export enum class ThreadPriority : int32 {
+    lowest = -2,
+    low = -1,
+    normal = 0,
+    high = 1,
+    highest = 2,
+    realtime = 3
+};
+
+// zero stack size keeps the platform default, empty affinity leaves the thread free to migrate.
+export struct ThreadOptions {
+public:
+    StringView name;
+    size_t stackSize;
+    ThreadAffinity affinity;
+    ThreadPriority priority;
+
+    constexpr ThreadOptions() noexcept
+        : name()
+        , stackSize(0)
+        , affinity()
+        , priority(ThreadPriority::normal)
+    {
+    }
+};
+
+// core and cache are indices over the whole system, not the raw ids of the platform,
+// so that they can be used directly to group logical processors.
+export struct CpuInfo {
+public:
+    uint32 logical;
+    uint32 core;
+    uint32 package;
+    uint32 cache;
+};
+
+export class CORE_API CpuTopology {
+private:
+    Array<CpuInfo> m_cpus;
+    uint32 m_coreCount;
+    uint32 m_packageCount;
+    uint32 m_cacheCount;
+
+public:
+    static CpuTopology const& Get();
+
+    size_t LogicalCount() const noexcept { return m_cpus.Size(); }
+    size_t PhysicalCount() const noexcept { return m_coreCount; }
+    size_t PackageCount() const noexcept { return m_packageCount; }
+    size_t CacheDomainCount() const noexcept { return m_cacheCount; }
+    CpuInfo const& At(size_t index) const { return m_cpus[index]; }
+
+    ThreadAffinity All() const noexcept;
+    ThreadAffinity PhysicalCores() const noexcept;
+    ThreadAffinity SiblingsOf(uint32) const noexcept;
+    ThreadAffinity CacheDomain(uint32) const noexcept;
+    ThreadAffinity CacheDomainOf(uint32) const noexcept;
+
+private:
+    CpuTopology();
+
+    CpuTopology(CpuTopology const&) = delete;
+    CpuTopology& operator=(CpuTopology const&) = delete;
+};
+
+constexpr size_t threadNameSize = 64;
+
+template <typename Func>
+struct ThreadStart : public PlatformThreadStart {
+public:
+    Func func;
+    char name[threadNameSize];
+    ThreadAffinity affinity;
+    ThreadPriority priority;
+
+    template <typename F>
+    ThreadStart(F&&, ThreadOptions const&);
+
+    static void Run(PlatformThreadStart*);
+};
+
+export class Thread {
+public:
+    typedef uint64 Id;
+    typedef PlatformThread NativeHandle;
+
+private:
+    NativeHandle m_thread;
+    bool m_joinable;
+
+public:
+    Thread() noexcept;
+    template <typename Func>
+        requires CallableT<DecayT<Func>>
+    explicit Thread(Func&&, ThreadOptions const& = ThreadOptions());
+    Thread(Thread&&) noexcept;
+    ~Thread() noexcept;
+
+    void Join();
+    void Detach();
+    bool Joinable() const noexcept;
+
+    bool SetName(StringView) noexcept;
+    bool SetAffinity(ThreadAffinity const&) noexcept;
+    NativeHandle GetNativeHandle() noexcept;
+
+    static Id CurrentId() noexcept;
+    static uint32 CurrentCpu() noexcept;
+    static bool SetCurrentName(StringView) noexcept;
+    static bool SetCurrentAffinity(ThreadAffinity const&) noexcept;
+    static bool SetCurrentPriority(ThreadPriority) noexcept;
+
+    static void YieldNow() noexcept;
+    template <DurationT D>
+    static void SleepFor(D const&) noexcept;
+
+    Thread& operator=(Thread&&) noexcept;
+
+private:
+    Thread(Thread const&) = delete;
+    Thread& operator=(Thread const&) = delete;
+};
+
+template <size_t N>
+inline void CopyThreadName(char (&dst)[N], StringView name) noexcept
+{
+    size_t length = name.Size() < N - 1 ? name.Size() : N - 1;
+    for (size_t i = 0; i < length; ++i) {
+        dst[i] = name.Data()[i];
+    }
+
+    dst[length] = '\0';
+}
+
+inline constexpr ThreadAffinity::ThreadAffinity() noexcept
+    : m_mask{}
+{
+}
+
+inline constexpr ThreadAffinity::ThreadAffinity(uint32 cpu) noexcept
+    : m_mask{}
+{
+    Set(cpu);
+}
+
+inline constexpr void ThreadAffinity::Set(uint32 cpu) noexcept
+{
+    ASSERT(cpu < maxCpu, "cpu index exceeds the affinity mask");
+    m_mask[cpu / wordBits] |= uint64(1) << (cpu % wordBits);
+}
+
+inline constexpr void ThreadAffinity::Reset(uint32 cpu) noexcept
+{
+    ASSERT(cpu < maxCpu, "cpu index exceeds the affinity mask");
+    m_mask[cpu / wordBits] &= ~(uint64(1) << (cpu % wordBits));
+}
+
+inline constexpr void ThreadAffinity::Clear() noexcept
+{
+    for (uint64& word : m_mask) {
+        word = 0;
+    }
+}
+
+inline constexpr bool ThreadAffinity::Test(uint32 cpu) const noexcept
+{
+    return cpu < maxCpu && (m_mask[cpu / wordBits] & (uint64(1) << (cpu % wordBits))) != 0;
+}
+
+inline constexpr uint32 ThreadAffinity::Count() const noexcept
+{
+    uint32 count = 0;
+    for (uint64 word : m_mask) {
+        for (; word != 0; word &= word - 1) {
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+inline constexpr bool ThreadAffinity::Empty() const noexcept
+{
+    for (uint64 word : m_mask) {
+        if (word != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+inline constexpr uint64 const* ThreadAffinity::Data() const noexcept
+{
+    return m_mask;
+}
+
+inline constexpr size_t ThreadAffinity::WordCount() noexcept
+{
+    return wordCount;
+}
+
+inline constexpr ThreadAffinity& ThreadAffinity::operator|=(ThreadAffinity const& other) noexcept
+{
+    for (uint32 i = 0; i < wordCount; ++i) {
+        m_mask[i] |= other.m_mask[i];
+    }
+
+    return *this;
+}
+
+inline constexpr ThreadAffinity& ThreadAffinity::operator&=(ThreadAffinity const& other) noexcept
+{
+    for (uint32 i = 0; i < wordCount; ++i) {
+        m_mask[i] &= other.m_mask[i];
+    }
+
+    return *this;
+}
+
+template <typename Func>
+template <typename F>
+inline ThreadStart<Func>::ThreadStart(F&& f, ThreadOptions const& options)
+    : PlatformThreadStart{ &ThreadStart::Run }
+    , func(ForwardArg<F>(f))
+    , affinity(options.affinity)
+    , priority(options.priority)
+{
+    CopyThreadName(name, options.name);
+}
+
+template <typename Func>
+inline void ThreadStart<Func>::Run(PlatformThreadStart* base)
+{
+    ThreadStart* start = static_cast<ThreadStart*>(base);
+
+    // options are applied by the thread itself before running any user code,
+    // so none of it runs outside of the requested affinity or under the default name.
+    PlatformThread self = ThreadCurrentHandle();
+    if (start->name[0] != '\0') {
+        ThreadSetName(self, start->name);
+    }
+
+    if (!start->affinity.Empty()) {
+        ThreadSetAffinity(self, start->affinity.Data(), ThreadAffinity::WordCount());
+    }
+
+    if (start->priority != ThreadPriority::normal) {
+        ThreadSetCurrentPriority(static_cast<int32>(start->priority));
+    }
+
+    Func func = MoveArg(start->func);
+    memory::DestructAt(start);
+    Allocator<ThreadStart>().Deallocate(start, 1);
+
+    func();
+}
+
+inline Thread::Thread() noexcept
+    : m_thread()
+    , m_joinable(false)
+{
+}
+
+template <typename Func>
+    requires CallableT<DecayT<Func>>
+inline Thread::Thread(Func&& func, ThreadOptions const& options)
+    : m_thread()
+    , m_joinable(false)
+{
+    typedef ThreadStart<DecayT<Func>> Start;
+
+    Start* start = Allocator<Start>().Allocate(1).pointer;
+    memory::ConstructAt(start, ForwardArg<Func>(func), options);
+
+    m_joinable = ThreadCreate(m_thread, start, options.stackSize);
+    if (!m_joinable) {
+        memory::DestructAt(start);
+        Allocator<Start>().Deallocate(start, 1);
+    }
+
+    VERIFY(m_joinable, "failed to create thread");
+}
+
+inline Thread::Thread(Thread&& other) noexcept
+    : m_thread(other.m_thread)
+    , m_joinable(other.m_joinable)
+{
+    other.m_thread = NativeHandle();
+    other.m_joinable = false;
+}
+
+inline Thread::~Thread() noexcept
+{
+    ASSERT(!m_joinable, "thread has to be joined or detached before destruction");
+}
+
+inline void Thread::Join()
+{
+    ASSERT(m_joinable, "thread is not joinable");
+    ThreadJoin(m_thread);
+    m_thread = NativeHandle();
+    m_joinable = false;
+}
+
+inline void Thread::Detach()
+{
+    ASSERT(m_joinable, "thread is not joinable");
+    ThreadDetach(m_thread);
+    m_thread = NativeHandle();
+    m_joinable = false;
+}
+
+inline bool Thread::Joinable() const noexcept
+{
+    return m_joinable;
+}
+
+inline bool Thread::SetName(StringView name) noexcept
+{
+    char buffer[threadNameSize];
+    CopyThreadName(buffer, name);
+    return m_joinable && ThreadSetName(m_thread, buffer);
+}
+
+inline bool Thread::SetAffinity(ThreadAffinity const& affinity) noexcept
+{
+    return m_joinable && ThreadSetAffinity(m_thread, affinity.Data(), ThreadAffinity::WordCount());
+}
+
+inline Thread::NativeHandle Thread::GetNativeHandle() noexcept
+{
+    return m_thread;
+}
+
+inline Thread::Id Thread::CurrentId() noexcept
+{
+    return ThreadCurrentId();
+}
+
+inline uint32 Thread::CurrentCpu() noexcept
+{
+    return ThreadCurrentCpu();
+}
+
+inline bool Thread::SetCurrentName(StringView name) noexcept
+{
+    char buffer[threadNameSize];
+    CopyThreadName(buffer, name);
+    return ThreadSetName(ThreadCurrentHandle(), buffer);
+}
+
+inline bool Thread::SetCurrentAffinity(ThreadAffinity const& affinity) noexcept
+{
+    return ThreadSetAffinity(ThreadCurrentHandle(), affinity.Data(), ThreadAffinity::WordCount());
+}
+
+inline bool Thread::SetCurrentPriority(ThreadPriority priority) noexcept
+{
+    return ThreadSetCurrentPriority(static_cast<int32>(priority));
+}
+
+inline void Thread::YieldNow() noexcept
+{
+    ThreadYield();
+}
+
+template <DurationT D>
+inline void Thread::SleepFor(D const& duration) noexcept
+{
+    ThreadSleep(DurationCast<NanoSeconds>(duration).Count());
+}
+
+inline Thread& Thread::operator=(Thread&& other) noexcept
+{
+    ASSERT(!m_joinable, "thread has to be joined or detached before being replaced");
+
+    m_thread = other.m_thread;
+    m_joinable = other.m_joinable;
+    other.m_thread = NativeHandle();
+    other.m_joinable = false;
+    return *this;
+}
+
+} // namespace mini
\ No newline at end of file
@@ -0,0 +1,241 @@
+module;
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <time.h>
+#include <unistd.h>
+
+export module mini.core:thread_platform;
+
+import :type;
+import :array;
+
+namespace mini {
+
+using PlatformThread = pthread_t;
+
+// entry of every thread, the owner derives from it to carry the function and start options
+struct PlatformThreadStart {
+    void (*run)(PlatformThreadStart*);
+};
+
+struct PlatformCpu {
+    uint32 logical;
+    uint32 core;
+    uint32 package;
+    uint32 cache;
+};
+
+inline void* PlatformThreadMain(void* arg)
+{
+    PlatformThreadStart* start = static_cast<PlatformThreadStart*>(arg);
+    start->run(start);
+    return nullptr;
+}
+
+inline bool ThreadCreate(PlatformThread& thread, PlatformThreadStart* start, size_t stackSize)
+{
+    pthread_attr_t attr;
+    if (pthread_attr_init(&attr) != 0) {
+        return false;
+    }
+
+    if (stackSize != 0) {
+        size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        size_t size = (stackSize + pageSize - 1) & ~(pageSize - 1);
+        if (size < PTHREAD_STACK_MIN) {
+            size = PTHREAD_STACK_MIN;
+        }
+
+        VERIFY(pthread_attr_setstacksize(&attr, size) == 0, "failed to set thread stack size");
+    }
+
+    int32 error = pthread_create(&thread, &attr, PlatformThreadMain, start);
+    pthread_attr_destroy(&attr);
+    return error == 0;
+}
+
+inline void ThreadJoin(PlatformThread& thread)
+{
+    VERIFY(pthread_join(thread, nullptr) == 0, "failed to join pthread");
+}
+
+inline void ThreadDetach(PlatformThread& thread)
+{
+    VERIFY(pthread_detach(thread) == 0, "failed to detach pthread");
+}
+
+inline PlatformThread ThreadCurrentHandle()
+{
+    return pthread_self();
+}
+
+inline uint64 ThreadCurrentId()
+{
+    return static_cast<uint64>(gettid());
+}
+
+inline void ThreadYield()
+{
+    sched_yield();
+}
+
+inline void ThreadSleep(int64 ns)
+{
+    if (ns <= 0) {
+        return;
+    }
+
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(ns / 1'000'000'000);
+    ts.tv_nsec = static_cast<long>(ns % 1'000'000'000);
+
+    // resume the remaining time when interrupted by a signal
+    while (nanosleep(&ts, &ts) != 0) { }
+}
+
+inline bool ThreadSetName(PlatformThread thread, char const* name)
+{
+    // kernel keeps at most 15 characters, longer names are rejected instead of truncated
+    char buffer[16];
+    size_t length = 0;
+    for (; length < sizeof(buffer) - 1 && name[length] != '\0'; ++length) {
+        buffer[length] = name[length];
+    }
+
+    buffer[length] = '\0';
+    return pthread_setname_np(thread, buffer) == 0;
+}
+
+inline bool ThreadGetCurrentName(char* buffer, size_t size)
+{
+    return pthread_getname_np(pthread_self(), buffer, size) == 0;
+}
+
+inline bool ThreadSetAffinity(PlatformThread thread, uint64 const* mask, size_t words)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    for (size_t i = 0; i < words; ++i) {
+        for (size_t bit = 0; bit < 64; ++bit) {
+            size_t cpu = i * 64 + bit;
+            if ((mask[i] & (uint64(1) << bit)) != 0 && cpu < CPU_SETSIZE) {
+                CPU_SET(cpu, &set);
+            }
+        }
+    }
+
+    return pthread_setaffinity_np(thread, sizeof(set), &set) == 0;
+}
+
+inline bool ThreadSetCurrentPriority(int32 level)
+{
+    // realtime goes to the fifo scheduler, which requires CAP_SYS_NICE.
+    // everything else stays on the fair scheduler and is expressed as a per-thread nice value.
+    if (level > 2) {
+        sched_param param;
+        param.sched_priority = sched_get_priority_min(SCHED_FIFO) + 1;
+        return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+    }
+
+    sched_param param;
+    param.sched_priority = 0;
+    if (pthread_setschedparam(pthread_self(), SCHED_OTHER, &param) != 0) {
+        return false;
+    }
+
+    int32 nice = -5 * level;
+    return setpriority(PRIO_PROCESS, static_cast<id_t>(gettid()), nice) == 0;
+}
+
+inline uint32 ThreadCurrentCpu()
+{
+    // served from the rseq area of the thread on glibc 2.35 and later, without entering the kernel
+    int32 cpu = sched_getcpu();
+    return cpu < 0 ? 0 : static_cast<uint32>(cpu);
+}
+
+inline bool ReadSysValue(char const* path, uint32& value)
+{
+    int32 fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    char buffer[32];
+    ssize_t length = read(fd, buffer, sizeof(buffer) - 1);
+    close(fd);
+
+    if (length <= 0 || buffer[0] < '0' || buffer[0] > '9') {
+        return false;
+    }
+
+    value = 0;
+    for (ssize_t i = 0; i < length && buffer[i] >= '0' && buffer[i] <= '9'; ++i) {
+        value = value * 10 + static_cast<uint32>(buffer[i] - '0');
+    }
+
+    return true;
+}
+
+inline bool ReadCpuValue(uint32 cpu, char const* leaf, uint32& value)
+{
+    char path[128];
+    char const prefix[] = "/sys/devices/system/cpu/cpu";
+
+    size_t length = 0;
+    for (; prefix[length] != '\0'; ++length) {
+        path[length] = prefix[length];
+    }
+
+    char digits[10];
+    size_t count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + cpu % 10);
+        cpu /= 10;
+    } while (cpu != 0);
+
+    while (count != 0) {
+        path[length++] = digits[--count];
+    }
+
+    for (size_t i = 0; leaf[i] != '\0' && length < sizeof(path) - 1; ++i) {
+        path[length++] = leaf[i];
+    }
+
+    path[length] = '\0';
+    return ReadSysValue(path, value);
+}
+
+inline void PlatformQueryTopology(Array<PlatformCpu>& cpus)
+{
+    // cpus may be offline or missing in between, the possible range is the upper bound
+    long configured = sysconf(_SC_NPROCESSORS_CONF);
+    uint32 count = configured > 0 ? static_cast<uint32>(configured) : 1;
+
+    for (uint32 cpu = 0; cpu < count; ++cpu) {
+        uint32 online = 1;
+        if (cpu != 0 && ReadCpuValue(cpu, "/online", online) && online == 0) {
+            continue;
+        }
+
+        PlatformCpu info = { cpu, cpu, 0, 0 };
+        if (!ReadCpuValue(cpu, "/topology/core_id", info.core)) {
+            info.core = cpu;
+        }
+
+        ReadCpuValue(cpu, "/topology/physical_package_id", info.package);
+
+        // index3 is the last level cache on every x86 and most arm parts, fall back to the package
+        if (!ReadCpuValue(cpu, "/cache/index3/id", info.cache)) {
+            info.cache = info.package;
+        }
+
+        cpus.Push(info);
+    }
+}
+
+} // namespace mini
\ No newline at end of file
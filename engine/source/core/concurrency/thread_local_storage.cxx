@@ -0,0 +1,146 @@
+export module mini.core:thread_local_storage;
+
+import :type;
+import :utility_operation;
+import :allocator;
+import :memory_operation;
+import :atomic_base;
+import :atomic;
+
+namespace mini {
+
+// Identifies a ThreadLocal in the slot table of every thread.
+// Indices are recycled, the generation tells them apart from a slot left behind by a previous owner.
+struct ThreadLocalKey {
+    uint32 index;
+    uint32 generation;
+};
+
+class CORE_API ThreadLocalRegistry {
+public:
+    static ThreadLocalKey Acquire();
+    static void Release(ThreadLocalKey) noexcept;
+
+    static void*& Slot(ThreadLocalKey);
+    static void* Find(ThreadLocalKey) noexcept;
+};
+
+// Storage with one instance of T per thread, created on the first access of each thread.
+// Instances live as long as the ThreadLocal itself, even after their thread exited,
+// which lets ForEach still observe everything written by threads that are already gone.
+// ForEach runs concurrently with the owners, so T has to tolerate being read while it is written.
+export template <typename T>
+    requires DefaultConstructibleT<T>
+class ThreadLocal {
+private:
+    struct alignas(__ATOMIC_INTERFERENCE_SIZE) Record {
+        T value;
+        Record* next;
+    };
+
+    ThreadLocalKey m_key;
+    Atomic<Record*> m_records;
+
+public:
+    ThreadLocal();
+    ~ThreadLocal();
+
+    T& Get();
+    T* TryGet() noexcept;
+
+    template <typename Func>
+        requires CallableT<Func, T&>
+    void ForEach(Func&&);
+    template <typename Func>
+        requires CallableT<Func, T const&>
+    void ForEach(Func&&) const;
+
+private:
+    Record* Create();
+
+    ThreadLocal(ThreadLocal const&) = delete;
+    ThreadLocal& operator=(ThreadLocal const&) = delete;
+};
+
+template <typename T>
+    requires DefaultConstructibleT<T>
+inline ThreadLocal<T>::ThreadLocal()
+    : m_key(ThreadLocalRegistry::Acquire())
+    , m_records(nullptr)
+{
+}
+
+template <typename T>
+    requires DefaultConstructibleT<T>
+inline ThreadLocal<T>::~ThreadLocal()
+{
+    ThreadLocalRegistry::Release(m_key);
+
+    Record* record = m_records.Load(MemoryOrder::acquire);
+    while (record != nullptr) {
+        Record* next = record->next;
+        memory::DestructAt(record);
+        Allocator<Record>().Deallocate(record, 1);
+        record = next;
+    }
+}
+
+template <typename T>
+    requires DefaultConstructibleT<T>
+inline T& ThreadLocal<T>::Get()
+{
+    void*& slot = ThreadLocalRegistry::Slot(m_key);
+    if (slot == nullptr) [[unlikely]] {
+        slot = Create();
+    }
+
+    return static_cast<Record*>(slot)->value;
+}
+
+template <typename T>
+    requires DefaultConstructibleT<T>
+inline T* ThreadLocal<T>::TryGet() noexcept
+{
+    Record* record = static_cast<Record*>(ThreadLocalRegistry::Find(m_key));
+    return record != nullptr ? &record->value : nullptr;
+}
+
+template <typename T>
+    requires DefaultConstructibleT<T>
+template <typename Func>
+    requires CallableT<Func, T&>
+inline void ThreadLocal<T>::ForEach(Func&& func)
+{
+    for (Record* record = m_records.Load(MemoryOrder::acquire); record != nullptr; record = record->next) {
+        func(record->value);
+    }
+}
+
+template <typename T>
+    requires DefaultConstructibleT<T>
+template <typename Func>
+    requires CallableT<Func, T const&>
+inline void ThreadLocal<T>::ForEach(Func&& func) const
+{
+    for (Record* record = m_records.Load(MemoryOrder::acquire); record != nullptr; record = record->next) {
+        func(static_cast<T const&>(record->value));
+    }
+}
+
+template <typename T>
+    requires DefaultConstructibleT<T>
+inline typename ThreadLocal<T>::Record* ThreadLocal<T>::Create()
+{
+    Record* record = Allocator<Record>().Allocate(1).pointer;
+    memory::ConstructAt(record);
+
+    // records are only unlinked on destruction, which keeps ForEach free of any lock
+    Record* head = m_records.Load(MemoryOrder::relaxed);
+    do {
+        record->next = head;
+    } while (!m_records.CompareExchangeWeak(head, record, MemoryOrder::release, MemoryOrder::relaxed));
+
+    return record;
+}
+
+} // namespace mini
\ No newline at end of file
@@ -0,0 +1,166 @@
+module;
+
+#include <pthread.h>
+#include <pthread/qos.h>
+#include <sched.h>
+#include <sys/sysctl.h>
+#include <time.h>
+#include <unistd.h>
+
+export module mini.core:thread_platform;
+
+import :type;
+import :array;
+
+namespace mini {
+
+using PlatformThread = pthread_t;
+
+// entry of every thread, the owner derives from it to carry the function and start options
+struct PlatformThreadStart {
+    void (*run)(PlatformThreadStart*);
+};
+
+struct PlatformCpu {
+    uint32 logical;
+    uint32 core;
+    uint32 package;
+    uint32 cache;
+};
+
+inline void* PlatformThreadMain(void* arg)
+{
+    PlatformThreadStart* start = static_cast<PlatformThreadStart*>(arg);
+    start->run(start);
+    return nullptr;
+}
+
+inline bool ThreadCreate(PlatformThread& thread, PlatformThreadStart* start, size_t stackSize)
+{
+    pthread_attr_t attr;
+    if (pthread_attr_init(&attr) != 0) {
+        return false;
+    }
+
+    if (stackSize != 0) {
+        size_t pageSize = static_cast<size_t>(getpagesize());
+        size_t size = (stackSize + pageSize - 1) & ~(pageSize - 1);
+        if (size < PTHREAD_STACK_MIN) {
+            size = PTHREAD_STACK_MIN;
+        }
+
+        VERIFY(pthread_attr_setstacksize(&attr, size) == 0, "failed to set thread stack size");
+    }
+
+    int32 error = pthread_create(&thread, &attr, PlatformThreadMain, start);
+    pthread_attr_destroy(&attr);
+    return error == 0;
+}
+
+inline void ThreadJoin(PlatformThread& thread)
+{
+    VERIFY(pthread_join(thread, nullptr) == 0, "failed to join pthread");
+}
+
+inline void ThreadDetach(PlatformThread& thread)
+{
+    VERIFY(pthread_detach(thread) == 0, "failed to detach pthread");
+}
+
+inline PlatformThread ThreadCurrentHandle()
+{
+    return pthread_self();
+}
+
+inline uint64 ThreadCurrentId()
+{
+    uint64 id = 0;
+    pthread_threadid_np(nullptr, &id);
+    return id;
+}
+
+inline void ThreadYield()
+{
+    sched_yield();
+}
+
+inline void ThreadSleep(int64 ns)
+{
+    if (ns <= 0) {
+        return;
+    }
+
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(ns / 1'000'000'000);
+    ts.tv_nsec = static_cast<long>(ns % 1'000'000'000);
+
+    while (nanosleep(&ts, &ts) != 0) { }
+}
+
+inline bool ThreadSetName(PlatformThread thread, char const* name)
+{
+    // darwin can only name the calling thread
+    if (pthread_equal(thread, pthread_self()) == 0) {
+        return false;
+    }
+
+    return pthread_setname_np(name) == 0;
+}
+
+inline bool ThreadGetCurrentName(char* buffer, size_t size)
+{
+    return pthread_getname_np(pthread_self(), buffer, size) == 0;
+}
+
+inline bool ThreadSetAffinity(PlatformThread, uint64 const*, size_t)
+{
+    // there is no way to pin a thread on darwin, the affinity tag policy is only a hint on intel
+    // and has been removed entirely on apple silicon.
+    return false;
+}
+
+inline bool ThreadSetCurrentPriority(int32 level)
+{
+    qos_class_t qos;
+    switch (level) {
+        case -2: qos = QOS_CLASS_BACKGROUND; break;
+        case -1: qos = QOS_CLASS_UTILITY; break;
+        case 0:  qos = QOS_CLASS_DEFAULT; break;
+        case 1:  qos = QOS_CLASS_USER_INITIATED; break;
+        default: qos = QOS_CLASS_USER_INTERACTIVE; break;
+    }
+
+    return pthread_set_qos_class_self_np(qos, 0) == 0;
+}
+
+inline uint32 ThreadCurrentCpu()
+{
+    // not exposed to user space, callers only use it as a sharding hint
+    return 0;
+}
+
+inline uint32 SysctlValue(char const* name, uint32 fallback)
+{
+    int32 value = 0;
+    size_t size = sizeof(value);
+    if (sysctlbyname(name, &value, &size, nullptr, 0) != 0 || value <= 0) {
+        return fallback;
+    }
+
+    return static_cast<uint32>(value);
+}
+
+inline void PlatformQueryTopology(Array<PlatformCpu>& cpus)
+{
+    // apple silicon has no smt, logical and physical counts only differ on intel with hyper-threading,
+    // where the siblings of a core are enumerated next to each other.
+    uint32 logical = SysctlValue("hw.logicalcpu", 1);
+    uint32 physical = SysctlValue("hw.physicalcpu", logical);
+    uint32 smt = physical < logical ? logical / physical : 1;
+
+    for (uint32 cpu = 0; cpu < logical; ++cpu) {
+        cpus.Push(PlatformCpu{ cpu, cpu / smt, 0, 0 });
+    }
+}
+
+} // namespace mini
\ No newline at end of file
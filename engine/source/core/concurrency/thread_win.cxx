@@ -0,0 +1,220 @@
+module;
+
+#include "win_include.h"
+
+// available from windows 10 1803, older sdks do not define it yet
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#  define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+export module mini.core:thread_platform;
+
+import :type;
+import :array;
+
+namespace mini {
+
+using PlatformThread = HANDLE;
+
+// entry of every thread, the owner derives from it to carry the function and start options
+struct PlatformThreadStart {
+    void (*run)(PlatformThreadStart*);
+};
+
+struct PlatformCpu {
+    uint32 logical;
+    uint32 core;
+    uint32 package;
+    uint32 cache;
+};
+
+inline DWORD WINAPI PlatformThreadMain(void* arg)
+{
+    PlatformThreadStart* start = static_cast<PlatformThreadStart*>(arg);
+    start->run(start);
+    return 0;
+}
+
+inline bool ThreadCreate(PlatformThread& thread, PlatformThreadStart* start, size_t stackSize)
+{
+    // reserve the requested size instead of committing all of it upfront
+    DWORD flags = stackSize != 0 ? STACK_SIZE_PARAM_IS_A_RESERVATION : 0;
+    thread = CreateThread(nullptr, stackSize, PlatformThreadMain, start, flags, nullptr);
+    return thread != nullptr;
+}
+
+inline void ThreadJoin(PlatformThread& thread)
+{
+    VERIFY(WaitForSingleObject(thread, INFINITE) == WAIT_OBJECT_0, "failed to join thread");
+    CloseHandle(thread);
+}
+
+inline void ThreadDetach(PlatformThread& thread)
+{
+    CloseHandle(thread);
+}
+
+inline PlatformThread ThreadCurrentHandle()
+{
+    return GetCurrentThread();
+}
+
+inline uint64 ThreadCurrentId()
+{
+    return static_cast<uint64>(GetCurrentThreadId());
+}
+
+inline void ThreadYield()
+{
+    SwitchToThread();
+}
+
+inline void ThreadSleep(int64 ns)
+{
+    if (ns <= 0) {
+        return;
+    }
+
+    // Sleep rounds up to the timer resolution, about 15.6ms unless raised process wide. A high resolution
+    // timer wakes up within a fraction of a millisecond, systems without one fall back to Sleep.
+    HANDLE timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    if (timer != nullptr) {
+        LARGE_INTEGER due;
+        due.QuadPart = -((ns + 99) / 100);
+
+        bool waited = SetWaitableTimer(timer, &due, 0, nullptr, nullptr, FALSE) &&
+                      WaitForSingleObject(timer, INFINITE) == WAIT_OBJECT_0;
+        CloseHandle(timer);
+        if (waited) {
+            return;
+        }
+    }
+
+    int64 ms = (ns + 999'999) / 1'000'000;
+    Sleep(ms >= static_cast<int64>(INFINITE) ? INFINITE - 1 : static_cast<DWORD>(ms));
+}
+
+inline bool ThreadSetName(PlatformThread thread, char const* name)
+{
+    wchar_t buffer[64];
+    size_t length = 0;
+    for (; length < 63 && name[length] != '\0'; ++length) {
+        buffer[length] = static_cast<wchar_t>(static_cast<unsigned char>(name[length]));
+    }
+
+    buffer[length] = L'\0';
+    return SUCCEEDED(SetThreadDescription(thread, buffer));
+}
+
+inline bool ThreadGetCurrentName(char* buffer, size_t size)
+{
+    wchar_t* description = nullptr;
+    if (FAILED(GetThreadDescription(GetCurrentThread(), &description))) {
+        return false;
+    }
+
+    // names are set from narrow strings, so only ascii is expected to come back
+    size_t length = 0;
+    for (; length < size - 1 && description[length] != L'\0'; ++length) {
+        buffer[length] = description[length] < 0x80 ? static_cast<char>(description[length]) : '?';
+    }
+
+    buffer[length] = '\0';
+    LocalFree(description);
+    return true;
+}
+
+inline bool ThreadSetAffinity(PlatformThread thread, uint64 const* mask, size_t words)
+{
+    // only the first processor group is addressable through the plain affinity mask
+    DWORD_PTR affinity = words != 0 ? static_cast<DWORD_PTR>(mask[0]) : 0;
+    return affinity != 0 && SetThreadAffinityMask(thread, affinity) != 0;
+}
+
+inline bool ThreadSetCurrentPriority(int32 level)
+{
+    int32 priority;
+    switch (level) {
+        case -2: priority = THREAD_PRIORITY_LOWEST; break;
+        case -1: priority = THREAD_PRIORITY_BELOW_NORMAL; break;
+        case 0:  priority = THREAD_PRIORITY_NORMAL; break;
+        case 1:  priority = THREAD_PRIORITY_ABOVE_NORMAL; break;
+        case 2:  priority = THREAD_PRIORITY_HIGHEST; break;
+        default: priority = THREAD_PRIORITY_TIME_CRITICAL; break;
+    }
+
+    return SetThreadPriority(GetCurrentThread(), priority) != 0;
+}
+
+inline uint32 ThreadCurrentCpu()
+{
+    return static_cast<uint32>(GetCurrentProcessorNumber());
+}
+
+inline void PlatformQueryTopology(Array<PlatformCpu>& cpus)
+{
+    DWORD size = 0;
+    GetLogicalProcessorInformationEx(RelationAll, nullptr, &size);
+
+    HANDLE heap = GetProcessHeap();
+    byte* buffer = static_cast<byte*>(HeapAlloc(heap, 0, size));
+    if (buffer == nullptr ||
+        !GetLogicalProcessorInformationEx(RelationAll,
+                                          reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer),
+                                          &size)) {
+        HeapFree(heap, 0, buffer);
+        cpus.Push(PlatformCpu{ 0, 0, 0, 0 });
+        return;
+    }
+
+    // the order of the records is unspecified, so cores are collected first and tagged afterwards
+    uint32 core = 0;
+    for (DWORD offset = 0; offset < size;) {
+        auto info = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer + offset);
+        offset += info->Size;
+
+        if (info->Relationship != RelationProcessorCore) {
+            continue;
+        }
+
+        KAFFINITY mask = info->Processor.GroupMask[0].Mask;
+        for (uint32 bit = 0; bit < sizeof(KAFFINITY) * 8; ++bit) {
+            if ((mask & (KAFFINITY(1) << bit)) != 0) {
+                cpus.Push(PlatformCpu{ bit, core, 0, 0 });
+            }
+        }
+
+        ++core;
+    }
+
+    uint32 package = 0, cache = 0;
+    for (DWORD offset = 0; offset < size;) {
+        auto info = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer + offset);
+        offset += info->Size;
+
+        bool isPackage = info->Relationship == RelationProcessorPackage;
+        bool isCache = info->Relationship == RelationCache && info->Cache.Level == 3;
+        if (!isPackage && !isCache) {
+            continue;
+        }
+
+        KAFFINITY mask = isPackage ? info->Processor.GroupMask[0].Mask : info->Cache.GroupMask.Mask;
+        for (PlatformCpu& cpu : cpus) {
+            if ((mask & (KAFFINITY(1) << cpu.logical)) == 0) {
+                continue;
+            }
+
+            if (isPackage) {
+                cpu.package = package;
+            } else {
+                cpu.cache = cache;
+            }
+        }
+
+        isPackage ? ++package : ++cache;
+    }
+
+    HeapFree(heap, 0, buffer);
+}
+
+} // namespace mini
\ No newline at end of file
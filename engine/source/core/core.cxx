@@ -8,6 +8,7 @@ export import :ignore;
 export import :initializer_list;
 export import :source_location;
 export import :utility_operation;
+export import :environment;
 
 export import :allocator;
 export import :deleter;
@@ -15,6 +16,7 @@ export import :memory_operation;
 export import :unique_ptr;
 export import :shared_ptr;
 export import :weak_ptr;
+export import :atomic_shared_ptr;
 
 export import :bit_operation;
 
@@ -45,20 +47,51 @@ export import :string_view;
 export import :string;
 export import :format;
 
+export import :log_binary;
+export import :log_limit;
+export import :log_queue;
+export import :logger_platform;
 export import :logger;
+export import :profiler;
+export import :histogram;
+export import :metrics;
 
 export import :atomic_base;
 export import :atomic_platform;
 export import :atomic_platform_wait;
+export import :atomic_wait;
+export import :seq_lock;
 export import :atomic;
 export import :mutex;
+export import :thread;
+export import :thread_local_storage;
+export import :sharded_counter;
+export import :spsc_queue;
+export import :mpmc_queue;
+export import :reclaim;
+export import :epoch;
+export import :hazard_pointer;
+
+export import :frame_pool;
+export import :task;
+export import :generator;
+export import :scheduler;
+
+export import :async_file;
+export import :mapped_file;
+export import :io_queue;
 
 export import :module_system;
+export import :module_loader;
+export import :module_startup;
 export import :module_initializer;
 
 export import :duration;
 export import :time_point;
 export import :clock;
+export import :cycle_clock;
+export import :timer_wheel;
+export import :frame_pacer;
 
 export import :algorithm_memory;
 export import :algorithm;
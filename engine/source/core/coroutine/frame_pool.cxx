@@ -0,0 +1,41 @@
+export module mini.core:frame_pool;
+
+import :type;
+
+namespace mini {
+
+// Allocator of coroutine frames.
+// Frames are binned into power of two size classes and recycled through a cache owned by each thread,
+// so that spawning a coroutine does not reach the global heap once the cache of the thread is warm.
+// A frame freed on another thread than the one that allocated it simply joins the cache of the freeing thread,
+// caches that grow beyond their limit hand half of their frames back to a shared list.
+export class CORE_API FramePool {
+public:
+    static constexpr size_t minClassSize = 64;
+    static constexpr size_t maxClassSize = 4096;
+    static constexpr size_t classCount = 7;
+    static constexpr size_t cacheLimit = 64;
+
+    static void* Allocate(size_t);
+    static void Deallocate(void*, size_t) noexcept;
+
+    static constexpr size_t ClassOf(size_t) noexcept;
+    static constexpr size_t ClassSize(size_t) noexcept;
+};
+
+inline constexpr size_t FramePool::ClassOf(size_t size) noexcept
+{
+    size_t index = 0;
+    for (size_t classSize = minClassSize; classSize < size; classSize <<= 1) {
+        ++index;
+    }
+
+    return index;
+}
+
+inline constexpr size_t FramePool::ClassSize(size_t index) noexcept
+{
+    return minClassSize << index;
+}
+
+} // namespace mini
\ No newline at end of file
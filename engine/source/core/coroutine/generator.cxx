@@ -0,0 +1,216 @@
+module;
+
+#include <coroutine>
+
+export module mini.core:generator;
+
+import :type;
+import :utility_operation;
+import :memory_operation;
+import :task;
+
+namespace mini {
+
+export template <typename T>
+class Generator;
+
+template <typename T>
+struct GeneratorPromise : public PooledPromise {
+public:
+    typedef RemoveRefT<T> Value;
+
+    // yielded values stay alive in the frame of the generator until it is resumed again
+    Value* current;
+
+    Generator<T> get_return_object() noexcept;
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    std::suspend_always final_suspend() const noexcept { return {}; }
+    void return_void() const noexcept { }
+
+    std::suspend_always yield_value(Value& value) noexcept
+    {
+        current = memory::AddressOf(value);
+        return {};
+    }
+
+    std::suspend_always yield_value(Value&& value) noexcept
+    {
+        current = memory::AddressOf(value);
+        return {};
+    }
+
+    void unhandled_exception() const
+    {
+        ASSERT(false, "unhandled exception escaped a generator");
+        throw;
+    }
+
+    // generators produce values, awaiting inside of one would suspend without anyone to resume it
+    template <typename U>
+    void await_transform(U&&) = delete;
+};
+
+// Single pass iterator over a generator, it only supports being compared against the end.
+template <typename T>
+class GeneratorIterator {
+public:
+    typedef RemoveRefT<T> Value;
+    typedef Value* Pointer;
+    typedef Value& Reference;
+    typedef CoroutineHandle<GeneratorPromise<T>> Handle;
+
+private:
+    Handle m_handle;
+
+public:
+    GeneratorIterator() noexcept
+        : m_handle(nullptr)
+    {
+    }
+
+    explicit GeneratorIterator(Handle handle) noexcept
+        : m_handle(handle)
+    {
+    }
+
+    Reference operator*() const noexcept { return *m_handle.promise().current; }
+    Pointer operator->() const noexcept { return m_handle.promise().current; }
+
+    GeneratorIterator& operator++()
+    {
+        m_handle.resume();
+        return *this;
+    }
+
+    bool operator==(GeneratorIterator const&) const noexcept { return !m_handle || m_handle.done(); }
+};
+
+// Lazily evaluated sequence, the body runs up to the next co_yield every time a value is requested.
+// It can be consumed either through Next and Current, or by a range based for loop.
+export template <typename T>
+class Generator {
+public:
+    typedef GeneratorPromise<T> promise_type;
+    typedef CoroutineHandle<promise_type> Handle;
+    typedef GeneratorIterator<T> Iterator;
+    typedef RemoveRefT<T> Value;
+
+private:
+    Handle m_handle;
+
+public:
+    Generator() noexcept;
+    explicit Generator(Handle) noexcept;
+    Generator(Generator&&) noexcept;
+    ~Generator();
+
+    bool Next();
+    Value& Current() const noexcept;
+    bool Done() const noexcept;
+
+    Iterator Begin();
+    Iterator End() noexcept;
+
+    Generator& operator=(Generator&&) noexcept;
+
+private:
+    Generator(Generator const&) = delete;
+    Generator& operator=(Generator const&) = delete;
+};
+
+// the iterator is single pass, so the generic begin and end of mini do not apply
+export template <typename T>
+inline GeneratorIterator<T> begin(Generator<T>& generator)
+{
+    return generator.Begin();
+}
+
+export template <typename T>
+inline GeneratorIterator<T> end(Generator<T>& generator) noexcept
+{
+    return generator.End();
+}
+
+template <typename T>
+inline Generator<T> GeneratorPromise<T>::get_return_object() noexcept
+{
+    return Generator<T>(CoroutineHandle<GeneratorPromise>::from_promise(*this));
+}
+
+template <typename T>
+inline Generator<T>::Generator() noexcept
+    : m_handle(nullptr)
+{
+}
+
+template <typename T>
+inline Generator<T>::Generator(Handle handle) noexcept
+    : m_handle(handle)
+{
+}
+
+template <typename T>
+inline Generator<T>::Generator(Generator&& other) noexcept
+    : m_handle(other.m_handle)
+{
+    other.m_handle = nullptr;
+}
+
+template <typename T>
+inline Generator<T>::~Generator()
+{
+    if (m_handle) {
+        m_handle.destroy();
+    }
+}
+
+template <typename T>
+inline bool Generator<T>::Next()
+{
+    if (!m_handle || m_handle.done()) {
+        return false;
+    }
+
+    m_handle.resume();
+    return !m_handle.done();
+}
+
+template <typename T>
+inline typename Generator<T>::Value& Generator<T>::Current() const noexcept
+{
+    ASSERT(m_handle && !m_handle.done(), "generator has no current value");
+    return *m_handle.promise().current;
+}
+
+template <typename T>
+inline bool Generator<T>::Done() const noexcept
+{
+    return !m_handle || m_handle.done();
+}
+
+template <typename T>
+inline typename Generator<T>::Iterator Generator<T>::Begin()
+{
+    Next();
+    return Iterator(m_handle);
+}
+
+template <typename T>
+inline typename Generator<T>::Iterator Generator<T>::End() noexcept
+{
+    return Iterator();
+}
+
+template <typename T>
+inline Generator<T>& Generator<T>::operator=(Generator&& other) noexcept
+{
+    if (m_handle) {
+        m_handle.destroy();
+    }
+
+    m_handle = other.m_handle;
+    other.m_handle = nullptr;
+    return *this;
+}
+
+} // namespace mini
\ No newline at end of file
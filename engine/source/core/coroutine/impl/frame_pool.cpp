@@ -0,0 +1,115 @@
+module mini.core;
+
+import :type;
+import :allocator;
+import :mutex;
+import :frame_pool;
+
+namespace mini {
+
+struct FrameBlock {
+    FrameBlock* next;
+};
+
+struct FrameList {
+    FrameBlock* head;
+    size_t count;
+};
+
+struct SharedFrameLists {
+    Mutex lock;
+    FrameList lists[FramePool::classCount];
+};
+
+static SharedFrameLists& GetSharedFrameLists()
+{
+    static SharedFrameLists shared;
+    return shared;
+}
+
+static void Push(FrameList& list, FrameBlock* block) noexcept
+{
+    block->next = list.head;
+    list.head = block;
+    ++list.count;
+}
+
+static FrameBlock* Pop(FrameList& list) noexcept
+{
+    FrameBlock* block = list.head;
+    list.head = block->next;
+    --list.count;
+    return block;
+}
+
+static void Spill(FrameList& list, size_t index, size_t count) noexcept
+{
+    SharedFrameLists& shared = GetSharedFrameLists();
+    shared.lock.Lock();
+
+    for (; count != 0 && list.head != nullptr; --count) {
+        Push(shared.lists[index], Pop(list));
+    }
+
+    shared.lock.Unlock();
+}
+
+static bool Refill(FrameList& list, size_t index) noexcept
+{
+    SharedFrameLists& shared = GetSharedFrameLists();
+    shared.lock.Lock();
+
+    for (size_t count = FramePool::cacheLimit / 2; count != 0 && shared.lists[index].head != nullptr; --count) {
+        Push(list, Pop(shared.lists[index]));
+    }
+
+    shared.lock.Unlock();
+    return list.head != nullptr;
+}
+
+struct FrameCache {
+    FrameList lists[FramePool::classCount];
+
+    ~FrameCache()
+    {
+        // frames cached by an exiting thread stay available to the others
+        for (size_t i = 0; i < FramePool::classCount; ++i) {
+            Spill(lists[i], i, lists[i].count);
+        }
+    }
+};
+
+static thread_local FrameCache frameCache;
+
+void* FramePool::Allocate(size_t size)
+{
+    if (size > maxClassSize) {
+        return Allocator<byte>().Allocate(size).pointer;
+    }
+
+    size_t index = ClassOf(size);
+    FrameList& list = frameCache.lists[index];
+    if (list.head != nullptr || Refill(list, index)) {
+        return Pop(list);
+    }
+
+    return Allocator<byte>().Allocate(ClassSize(index)).pointer;
+}
+
+void FramePool::Deallocate(void* pointer, size_t size) noexcept
+{
+    if (size > maxClassSize) {
+        Allocator<byte>().Deallocate(static_cast<byte*>(pointer), size);
+        return;
+    }
+
+    size_t index = ClassOf(size);
+    FrameList& list = frameCache.lists[index];
+    Push(list, static_cast<FrameBlock*>(pointer));
+
+    if (list.count > cacheLimit) {
+        Spill(list, index, cacheLimit / 2);
+    }
+}
+
+} // namespace mini
\ No newline at end of file
@@ -0,0 +1,199 @@
+module;
+
+#include <coroutine>
+
+module mini.core;
+
+import :type;
+import :utility_operation;
+import :array;
+import :duration;
+import :clock;
+import :atomic_base;
+import :atomic;
+import :mutex;
+import :thread;
+import :task;
+import :scheduler;
+
+namespace mini {
+
+// Coroutine owning a spawned task, it frees its own frame once the task completed.
+struct DetachedTask {
+public:
+    struct promise_type : public PooledPromise {
+    public:
+        DetachedTask get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept { }
+
+        void unhandled_exception() const
+        {
+            ASSERT(false, "unhandled exception escaped a spawned task");
+            throw;
+        }
+    };
+};
+
+static DetachedTask RunDetached(Scheduler& scheduler, Task<void> task)
+{
+    co_await scheduler.Schedule();
+    co_await task;
+}
+
+Scheduler::Scheduler(uint32 threadCount, ThreadOptions const& options)
+    : m_workers()
+    , m_timer()
+    , m_head(nullptr)
+    , m_tail(nullptr)
+    , m_signal(0)
+    , m_sleeping(0)
+    , m_timers()
+    , m_timerSignal(0)
+    , m_stop(false)
+{
+    if (threadCount == 0) {
+        threadCount = static_cast<uint32>(CpuTopology::Get().PhysicalCount());
+    }
+
+    m_workers.Reserve(threadCount);
+    for (uint32 i = 0; i < threadCount; ++i) {
+        m_workers.Push(Thread([this]() { RunWorker(); }, options));
+    }
+
+    ThreadOptions timerOptions;
+    timerOptions.name = "mini.scheduler.timer";
+    timerOptions.priority = ThreadPriority::high;
+    m_timer = Thread([this]() { RunTimer(); }, timerOptions);
+}
+
+Scheduler::~Scheduler()
+{
+    m_stop.Store(true, MemoryOrder::sequential);
+
+    m_signal.FetchAdd(1, MemoryOrder::sequential);
+    m_signal.NotifyAll();
+    m_timerSignal.FetchAdd(1, MemoryOrder::sequential);
+    m_timerSignal.Notify();
+
+    for (Thread& worker : m_workers) {
+        worker.Join();
+    }
+
+    m_timer.Join();
+
+    ASSERT(m_head == nullptr, "scheduler destroyed with queued coroutines");
+    ASSERT(m_timers.Empty(), "scheduler destroyed with pending timers");
+}
+
+void Scheduler::Spawn(Task<void>&& task)
+{
+    RunDetached(*this, MoveArg(task));
+}
+
+void Scheduler::Enqueue(ScheduleNode* node) noexcept
+{
+    node->next = nullptr;
+
+    m_queueLock.Lock();
+    if (m_tail == nullptr) {
+        m_head = node;
+    } else {
+        m_tail->next = node;
+    }
+
+    m_tail = node;
+    m_queueLock.Unlock();
+
+    // a worker registers as sleeping before its last look at the queue,
+    // so either it sees the node or the notification below sees the worker.
+    m_signal.FetchAdd(1, MemoryOrder::sequential);
+    if (m_sleeping.Load(MemoryOrder::sequential) != 0) {
+        m_signal.Notify();
+    }
+}
+
+ScheduleNode* Scheduler::Dequeue() noexcept
+{
+    m_queueLock.Lock();
+
+    ScheduleNode* node = m_head;
+    if (node != nullptr) {
+        m_head = node->next;
+        m_tail = m_head == nullptr ? nullptr : m_tail;
+    }
+
+    m_queueLock.Unlock();
+    return node;
+}
+
+void Scheduler::AddTimer(TimerNode* node) noexcept
+{
+    m_timerLock.Lock();
+
+    // kept sorted by descending deadline, so the next one to expire is popped from the back
+    size_t index = m_timers.Size();
+    while (index != 0 && m_timers[index - 1]->deadline < node->deadline) {
+        --index;
+    }
+
+    m_timers.Insert(index, node);
+    bool earliest = index == m_timers.Size() - 1;
+    m_timerLock.Unlock();
+
+    if (earliest) {
+        m_timerSignal.FetchAdd(1, MemoryOrder::release);
+        m_timerSignal.Notify();
+    }
+}
+
+void Scheduler::RunWorker() noexcept
+{
+    while (true) {
+        ScheduleNode* node = Dequeue();
+        if (node != nullptr) {
+            node->handle.resume();
+            continue;
+        }
+
+        m_sleeping.FetchAdd(1, MemoryOrder::sequential);
+        uint32 signal = m_signal.Load(MemoryOrder::sequential);
+
+        node = Dequeue();
+        if (node == nullptr && !m_stop.Load(MemoryOrder::sequential)) {
+            m_signal.Wait(signal, MemoryOrder::acquire);
+        }
+
+        m_sleeping.FetchSub(1, MemoryOrder::relaxed);
+        if (node != nullptr) {
+            node->handle.resume();
+        } else if (m_stop.Load(MemoryOrder::acquire)) {
+            return;
+        }
+    }
+}
+
+void Scheduler::RunTimer() noexcept
+{
+    while (!m_stop.Load(MemoryOrder::acquire)) {
+        uint32 signal = m_timerSignal.Load(MemoryOrder::acquire);
+        Clock::TimePoint now = Clock::Now();
+        Clock::TimePoint wake = now + DurationCast<Clock::Duration>(Seconds(1));
+
+        m_timerLock.Lock();
+        while (!m_timers.Empty() && m_timers.Last()->deadline <= now) {
+            Enqueue(m_timers.Last());
+            m_timers.RemoveLast();
+        }
+
+        if (!m_timers.Empty()) {
+            wake = m_timers.Last()->deadline;
+        }
+
+        m_timerLock.Unlock();
+        m_timerSignal.WaitUntil(signal, wake, MemoryOrder::acquire);
+    }
+}
+
+} // namespace mini
\ No newline at end of file
@@ -0,0 +1,209 @@
+module;
+
+#include <coroutine>
+
+export module mini.core:scheduler;
+
+import :type;
+import :utility_operation;
+import :memory_operation;
+import :array;
+import :duration;
+import :time_point;
+import :clock;
+import :atomic_base;
+import :atomic_wait;
+import :atomic;
+import :mutex;
+import :thread;
+import :task;
+
+namespace mini {
+
+// Suspended coroutine queued on a scheduler.
+// Nodes live inside of the awaiter, which is part of the suspended frame, so queueing never allocates.
+struct ScheduleNode {
+public:
+    ScheduleNode* next;
+    CoroutineHandle<> handle;
+};
+
+struct TimerNode : public ScheduleNode {
+public:
+    Clock::TimePoint deadline;
+};
+
+// Pool of worker threads resuming coroutines, together with a timer thread serving delays.
+// Awaiting Schedule moves the coroutine onto a worker, ScheduleAfter resumes it on a worker once the delay
+// elapsed, and WaitChange resumes it once an atomic no longer holds the given value.
+// Atomic waits are watches on the atomic, the Notify or NotifyAll following the change queues the coroutine
+// from the notifying thread, so a change has to be notified just like for Atomic::Wait.
+// The scheduler has to outlive every coroutine it resumes.
+export class CORE_API Scheduler {
+public:
+    class ScheduleAwaiter;
+    class TimerAwaiter;
+    template <typename T>
+    class AtomicAwaiter;
+
+private:
+    Array<Thread> m_workers;
+    Thread m_timer;
+
+    Mutex m_queueLock;
+    ScheduleNode* m_head;
+    ScheduleNode* m_tail;
+    alignas(__ATOMIC_INTERFERENCE_SIZE) Atomic<uint32> m_signal;
+    Atomic<uint32> m_sleeping;
+
+    Mutex m_timerLock;
+    Array<TimerNode*> m_timers;
+    Atomic<uint32> m_timerSignal;
+
+    Atomic<bool> m_stop;
+
+public:
+    explicit Scheduler(uint32 = 0, ThreadOptions const& = ThreadOptions());
+    ~Scheduler();
+
+    ScheduleAwaiter Schedule() noexcept;
+    template <DurationT D>
+    TimerAwaiter ScheduleAfter(D const&) noexcept;
+    TimerAwaiter ScheduleAt(Clock::TimePoint) noexcept;
+    template <typename T>
+    AtomicAwaiter<T> WaitChange(Atomic<T> const&, T) noexcept;
+
+    void Spawn(Task<void>&&);
+    uint32 ThreadCount() const noexcept;
+
+private:
+    void Enqueue(ScheduleNode*) noexcept;
+    void AddTimer(TimerNode*) noexcept;
+
+    ScheduleNode* Dequeue() noexcept;
+    void RunWorker() noexcept;
+    void RunTimer() noexcept;
+
+    Scheduler(Scheduler const&) = delete;
+    Scheduler& operator=(Scheduler const&) = delete;
+};
+
+class Scheduler::ScheduleAwaiter {
+private:
+    Scheduler* m_scheduler;
+    ScheduleNode m_node;
+
+public:
+    explicit ScheduleAwaiter(Scheduler* scheduler) noexcept
+        : m_scheduler(scheduler)
+        , m_node{ nullptr, nullptr }
+    {
+    }
+
+    bool await_ready() const noexcept { return false; }
+    void await_resume() const noexcept { }
+
+    void await_suspend(CoroutineHandle<> handle) noexcept
+    {
+        m_node.handle = handle;
+        m_scheduler->Enqueue(&m_node);
+    }
+};
+
+class Scheduler::TimerAwaiter {
+private:
+    Scheduler* m_scheduler;
+    TimerNode m_node;
+
+public:
+    TimerAwaiter(Scheduler* scheduler, Clock::TimePoint deadline) noexcept
+        : m_scheduler(scheduler)
+        , m_node{ { nullptr, nullptr }, deadline }
+    {
+    }
+
+    bool await_ready() const noexcept { return m_node.deadline <= Clock::Now(); }
+    void await_resume() const noexcept { }
+
+    void await_suspend(CoroutineHandle<> handle) noexcept
+    {
+        m_node.handle = handle;
+        m_scheduler->AddTimer(&m_node);
+    }
+};
+
+template <typename T>
+class Scheduler::AtomicAwaiter {
+private:
+    struct Node : public ScheduleNode, public AtomicWatch {
+    public:
+        Scheduler* scheduler;
+        Atomic<T> const* atomic;
+        T old;
+    };
+
+    Node m_node;
+
+public:
+    AtomicAwaiter(Scheduler* scheduler, Atomic<T> const& atomic, T old) noexcept
+        : m_node{ { nullptr, nullptr },
+                  { nullptr, nullptr, &AtomicAwaiter::Changed, &AtomicAwaiter::Resume },
+                  scheduler,
+                  memory::AddressOf(atomic),
+                  old }
+    {
+    }
+
+    bool await_ready() const noexcept { return Changed(&m_node); }
+    void await_resume() const noexcept { }
+
+    // a change in between resumes right away, once watched the node may be queued before this returns
+    bool await_suspend(CoroutineHandle<> handle) noexcept
+    {
+        m_node.handle = handle;
+        return m_node.atomic->Watch(&m_node);
+    }
+
+private:
+    static bool Changed(AtomicWatch const* watch) noexcept
+    {
+        Node const* node = static_cast<Node const*>(watch);
+        T value = node->atomic->Load(MemoryOrder::acquire);
+        return memory::MemCompare(&value, &node->old, 1) != 0;
+    }
+
+    static void Resume(AtomicWatch* watch) noexcept
+    {
+        Node* node = static_cast<Node*>(watch);
+        node->scheduler->Enqueue(node);
+    }
+};
+
+inline Scheduler::ScheduleAwaiter Scheduler::Schedule() noexcept
+{
+    return ScheduleAwaiter(this);
+}
+
+template <DurationT D>
+inline Scheduler::TimerAwaiter Scheduler::ScheduleAfter(D const& delay) noexcept
+{
+    return TimerAwaiter(this, Clock::Now() + DurationCast<Clock::Duration>(delay));
+}
+
+inline Scheduler::TimerAwaiter Scheduler::ScheduleAt(Clock::TimePoint deadline) noexcept
+{
+    return TimerAwaiter(this, deadline);
+}
+
+template <typename T>
+inline Scheduler::AtomicAwaiter<T> Scheduler::WaitChange(Atomic<T> const& atomic, T old) noexcept
+{
+    return AtomicAwaiter<T>(this, atomic, old);
+}
+
+inline uint32 Scheduler::ThreadCount() const noexcept
+{
+    return static_cast<uint32>(m_workers.Size());
+}
+
+} // namespace mini
\ No newline at end of file
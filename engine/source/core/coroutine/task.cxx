@@ -0,0 +1,335 @@
+module;
+
+#include <coroutine>
+
+export module mini.core:task;
+
+import :type;
+import :utility_operation;
+import :memory_operation;
+import :atomic_base;
+import :atomic;
+import :frame_pool;
+
+// the compiler looks these up by name in every coroutine, so importers must be able to see them
+export namespace std {
+
+using std::coroutine_handle;
+using std::coroutine_traits;
+using std::noop_coroutine;
+using std::suspend_always;
+using std::suspend_never;
+
+} // namespace std
+
+namespace mini {
+
+export template <typename PromiseT = void>
+using CoroutineHandle = std::coroutine_handle<PromiseT>;
+
+export template <typename T = void>
+class Task;
+
+// Frames of every coroutine type of mini are drawn from the FramePool.
+struct PooledPromise {
+public:
+    static void* operator new(size_t size) { return FramePool::Allocate(size); }
+    static void operator delete(void* pointer, size_t size) noexcept { FramePool::Deallocate(pointer, size); }
+};
+
+// Resumes the awaiting coroutine in place of returning to the resumer, which keeps the stack flat
+// no matter how deep a chain of tasks awaiting each other gets.
+template <typename PromiseT>
+struct TaskFinalAwaiter {
+public:
+    bool await_ready() const noexcept { return false; }
+    void await_resume() const noexcept { }
+
+    CoroutineHandle<> await_suspend(CoroutineHandle<PromiseT> handle) const noexcept
+    {
+        CoroutineHandle<> continuation = handle.promise().continuation;
+        return continuation ? continuation : std::noop_coroutine();
+    }
+};
+
+struct TaskPromiseBase : public PooledPromise {
+public:
+    CoroutineHandle<> continuation;
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+
+    void unhandled_exception() const
+    {
+        ASSERT(false, "unhandled exception escaped a task");
+        throw;
+    }
+};
+
+template <typename T>
+struct TaskPromise : public TaskPromiseBase {
+public:
+    union {
+        T value;
+    };
+    bool hasValue;
+
+    TaskPromise() noexcept
+        : hasValue(false)
+    {
+    }
+
+    ~TaskPromise()
+    {
+        if (hasValue) {
+            memory::DestructAt(&value);
+        }
+    }
+
+    Task<T> get_return_object() noexcept;
+    TaskFinalAwaiter<TaskPromise> final_suspend() const noexcept { return {}; }
+
+    template <typename U>
+        requires ConstructibleFromT<T, U>
+    void return_value(U&& result)
+    {
+        memory::ConstructAt(&value, ForwardArg<U>(result));
+        hasValue = true;
+    }
+
+    T TakeValue()
+    {
+        ASSERT(hasValue, "task finished without a value");
+        return MoveArg(value);
+    }
+};
+
+template <>
+struct TaskPromise<void> : public TaskPromiseBase {
+public:
+    Task<void> get_return_object() noexcept;
+    TaskFinalAwaiter<TaskPromise> final_suspend() const noexcept { return {}; }
+
+    void return_void() const noexcept { }
+    void TakeValue() const noexcept { }
+};
+
+template <typename T>
+struct TaskAwaiter {
+public:
+    CoroutineHandle<TaskPromise<T>> handle;
+
+    bool await_ready() const noexcept { return !handle || handle.done(); }
+    T await_resume() { return handle.promise().TakeValue(); }
+
+    CoroutineHandle<> await_suspend(CoroutineHandle<> awaiting) const noexcept
+    {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+};
+
+// Lazily started coroutine producing a single value.
+// The body runs once the task is awaited, and the awaiting coroutine is resumed right where the task completes,
+// on whichever thread that happens to be. The result is moved out on resume, so a task is awaited at most once.
+export template <typename T>
+class Task {
+public:
+    typedef TaskPromise<T> promise_type;
+    typedef CoroutineHandle<promise_type> Handle;
+
+private:
+    Handle m_handle;
+
+public:
+    Task() noexcept;
+    explicit Task(Handle) noexcept;
+    Task(Task&&) noexcept;
+    ~Task();
+
+    bool Valid() const noexcept;
+    bool Done() const noexcept;
+    Handle Release() noexcept;
+
+    TaskAwaiter<T> operator co_await() const& noexcept;
+    TaskAwaiter<T> operator co_await() const&& noexcept;
+
+    Task& operator=(Task&&) noexcept;
+
+private:
+    Task(Task const&) = delete;
+    Task& operator=(Task const&) = delete;
+};
+
+template <typename T>
+inline Task<T> TaskPromise<T>::get_return_object() noexcept
+{
+    return Task<T>(CoroutineHandle<TaskPromise>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept
+{
+    return Task<void>(CoroutineHandle<TaskPromise>::from_promise(*this));
+}
+
+template <typename T>
+inline Task<T>::Task() noexcept
+    : m_handle(nullptr)
+{
+}
+
+template <typename T>
+inline Task<T>::Task(Handle handle) noexcept
+    : m_handle(handle)
+{
+}
+
+template <typename T>
+inline Task<T>::Task(Task&& other) noexcept
+    : m_handle(other.m_handle)
+{
+    other.m_handle = nullptr;
+}
+
+template <typename T>
+inline Task<T>::~Task()
+{
+    if (m_handle) {
+        m_handle.destroy();
+    }
+}
+
+template <typename T>
+inline bool Task<T>::Valid() const noexcept
+{
+    return static_cast<bool>(m_handle);
+}
+
+template <typename T>
+inline bool Task<T>::Done() const noexcept
+{
+    return !m_handle || m_handle.done();
+}
+
+template <typename T>
+inline typename Task<T>::Handle Task<T>::Release() noexcept
+{
+    Handle handle = m_handle;
+    m_handle = nullptr;
+    return handle;
+}
+
+template <typename T>
+inline TaskAwaiter<T> Task<T>::operator co_await() const& noexcept
+{
+    return TaskAwaiter<T>{ m_handle };
+}
+
+template <typename T>
+inline TaskAwaiter<T> Task<T>::operator co_await() const&& noexcept
+{
+    return TaskAwaiter<T>{ m_handle };
+}
+
+template <typename T>
+inline Task<T>& Task<T>::operator=(Task&& other) noexcept
+{
+    if (m_handle) {
+        m_handle.destroy();
+    }
+
+    m_handle = other.m_handle;
+    other.m_handle = nullptr;
+    return *this;
+}
+
+// Coroutine driving a task to completion for SyncWait, it signals a flag instead of resuming anyone.
+struct SyncWaitPromise;
+
+struct SyncWaitTask {
+public:
+    typedef SyncWaitPromise promise_type;
+
+    CoroutineHandle<SyncWaitPromise> handle;
+};
+
+struct SyncWaitPromise : public PooledPromise {
+public:
+    Atomic<bool>* done;
+
+    struct FinalAwaiter {
+    public:
+        bool await_ready() const noexcept { return false; }
+        void await_resume() const noexcept { }
+
+        void await_suspend(CoroutineHandle<SyncWaitPromise> handle) const noexcept
+        {
+            // the waiting thread can return as soon as the flag is set, waking an address that just went
+            // out of scope is harmless as the wait table is keyed by address and never dereferences it.
+            Atomic<bool>* done = handle.promise().done;
+            done->Store(true, MemoryOrder::release);
+            done->Notify();
+        }
+    };
+
+    SyncWaitTask get_return_object() noexcept { return { CoroutineHandle<SyncWaitPromise>::from_promise(*this) }; }
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void return_void() const noexcept { }
+
+    void unhandled_exception() const
+    {
+        ASSERT(false, "unhandled exception escaped a task");
+        throw;
+    }
+};
+
+template <typename T, typename StorageT>
+inline SyncWaitTask MakeSyncWaitTask(Task<T>& task, StorageT& storage)
+{
+    if constexpr (SameAsT<T, void>) {
+        co_await task;
+    } else {
+        memory::ConstructAt(&storage.value, co_await task);
+    }
+}
+
+template <typename T>
+struct SyncWaitStorage {
+public:
+    union {
+        T value;
+    };
+
+    SyncWaitStorage() noexcept { }
+    ~SyncWaitStorage() { }
+};
+
+template <>
+struct SyncWaitStorage<void> { };
+
+// Runs the task and blocks the calling thread until it completed.
+// The task may hop to other threads in between, the calling thread simply sleeps until it is done.
+export template <typename T>
+inline T SyncWait(Task<T> task)
+{
+    Atomic<bool> done(false);
+    SyncWaitStorage<T> storage;
+
+    SyncWaitTask waiter = MakeSyncWaitTask(task, storage);
+    waiter.handle.promise().done = &done;
+    waiter.handle.resume();
+
+    while (!done.Load(MemoryOrder::acquire)) {
+        done.Wait(false, MemoryOrder::acquire);
+    }
+
+    waiter.handle.destroy();
+
+    if constexpr (!SameAsT<T, void>) {
+        T result = MoveArg(storage.value);
+        memory::DestructAt(&storage.value);
+        return result;
+    }
+}
+
+} // namespace mini
\ No newline at end of file
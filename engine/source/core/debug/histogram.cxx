@@ -0,0 +1,173 @@
+export module mini.core:histogram;
+
+import :type;
+import :bit_operation;
+import :array;
+import :duration;
+import :atomic_base;
+import :atomic;
+import :thread_local_storage;
+
+namespace mini {
+
+// Log linear bucketing shared by Histogram and its snapshots.
+// Values below 2 * subBucketCount get a bucket each, above that every power of two is split into
+// subBucketCount linear buckets, so a bucket is never wider than 1 / subBucketCount of its values.
+export struct HistogramBuckets {
+public:
+    static constexpr uint32 subBucketBits = 5;
+    static constexpr uint32 subBucketCount = 1 << subBucketBits;
+    static constexpr uint32 count = (64 - subBucketBits + 1) * subBucketCount;
+
+    static constexpr uint32 Index(uint64) noexcept;
+    static constexpr uint64 Lowest(uint32) noexcept;
+    static constexpr uint64 Highest(uint32) noexcept;
+};
+
+// Plain copy of a histogram, cheap to merge and to query.
+export class CORE_API HistogramSnapshot {
+private:
+    friend class Histogram;
+
+    Array<uint64> m_counts;
+    uint64 m_count;
+    uint64 m_sum;
+    uint64 m_min;
+    uint64 m_max;
+
+public:
+    HistogramSnapshot();
+
+    void Record(uint64, uint64 = 1);
+    void Merge(HistogramSnapshot const&);
+    void Clear() noexcept;
+
+    uint64 Percentile(double) const noexcept;
+    uint64 Count() const noexcept;
+    uint64 Sum() const noexcept;
+    uint64 Min() const noexcept;
+    uint64 Max() const noexcept;
+    double Mean() const noexcept;
+
+    uint64 BucketCount(uint32) const noexcept;
+};
+
+// Histogram of unsigned values with bounded relative error, durations are recorded in nanoseconds.
+// Every thread records into its own shard with plain loads and stores, Snapshot merges the shards lazily
+// into the given snapshot, which also merges several histograms into one. A snapshot taken while other
+// threads record may miss their latest values. Reset is not synchronized with concurrent Record.
+export class CORE_API Histogram {
+private:
+    struct Shard {
+        Atomic<uint64> counts[HistogramBuckets::count];
+        Atomic<uint64> sum;
+        Atomic<uint64> min;
+        Atomic<uint64> max;
+
+        Shard() noexcept;
+    };
+
+    ThreadLocal<Shard> m_shards;
+
+public:
+    Histogram() = default;
+
+    void Record(uint64);
+    template <DurationT D>
+    void Record(D const&);
+
+    void Snapshot(HistogramSnapshot&) const;
+    void Reset() noexcept;
+
+private:
+    Histogram(Histogram const&) = delete;
+    Histogram& operator=(Histogram const&) = delete;
+};
+
+inline constexpr uint32 HistogramBuckets::Index(uint64 value) noexcept
+{
+    uint32 msb = 63 - CountLeftZero(value | 1);
+    uint32 shift = msb > subBucketBits ? msb - subBucketBits : 0;
+    return shift * subBucketCount + static_cast<uint32>(value >> shift);
+}
+
+inline constexpr uint64 HistogramBuckets::Lowest(uint32 index) noexcept
+{
+    if (index < 2 * subBucketCount) {
+        return index;
+    }
+
+    uint32 shift = index / subBucketCount - 1;
+    return uint64(index % subBucketCount + subBucketCount) << shift;
+}
+
+inline constexpr uint64 HistogramBuckets::Highest(uint32 index) noexcept
+{
+    return index + 1 < count ? Lowest(index + 1) - 1 : ~uint64(0);
+}
+
+inline uint64 HistogramSnapshot::Count() const noexcept
+{
+    return m_count;
+}
+
+inline uint64 HistogramSnapshot::Sum() const noexcept
+{
+    return m_sum;
+}
+
+inline uint64 HistogramSnapshot::Min() const noexcept
+{
+    return m_count != 0 ? m_min : 0;
+}
+
+inline uint64 HistogramSnapshot::Max() const noexcept
+{
+    return m_max;
+}
+
+inline double HistogramSnapshot::Mean() const noexcept
+{
+    return m_count != 0 ? static_cast<double>(m_sum) / static_cast<double>(m_count) : 0.0;
+}
+
+inline uint64 HistogramSnapshot::BucketCount(uint32 index) const noexcept
+{
+    return m_counts[index];
+}
+
+inline Histogram::Shard::Shard() noexcept
+    : sum(0)
+    , min(~uint64(0))
+    , max(0)
+{
+    for (Atomic<uint64>& bucket : counts) {
+        bucket.Store(0, MemoryOrder::relaxed);
+    }
+}
+
+inline void Histogram::Record(uint64 value)
+{
+    Shard& shard = m_shards.Get();
+
+    Atomic<uint64>& bucket = shard.counts[HistogramBuckets::Index(value)];
+    bucket.Store(bucket.Load(MemoryOrder::relaxed) + 1, MemoryOrder::relaxed);
+    shard.sum.Store(shard.sum.Load(MemoryOrder::relaxed) + value, MemoryOrder::relaxed);
+
+    if (value < shard.min.Load(MemoryOrder::relaxed)) {
+        shard.min.Store(value, MemoryOrder::relaxed);
+    }
+
+    if (value > shard.max.Load(MemoryOrder::relaxed)) {
+        shard.max.Store(value, MemoryOrder::relaxed);
+    }
+}
+
+template <DurationT D>
+inline void Histogram::Record(D const& duration)
+{
+    int64 nanoSeconds = DurationCast<NanoSeconds>(duration).Count();
+    Record(nanoSeconds > 0 ? static_cast<uint64>(nanoSeconds) : 0);
+}
+
+} // namespace mini
\ No newline at end of file
@@ -0,0 +1,119 @@
+module mini.core;
+
+import :type;
+import :array;
+import :atomic_base;
+import :atomic;
+import :histogram;
+
+namespace mini {
+
+HistogramSnapshot::HistogramSnapshot()
+    : m_counts()
+    , m_count(0)
+    , m_sum(0)
+    , m_min(~uint64(0))
+    , m_max(0)
+{
+    m_counts.Resize(HistogramBuckets::count, uint64(0));
+}
+
+void HistogramSnapshot::Record(uint64 value, uint64 count)
+{
+    if (count == 0) {
+        return;
+    }
+
+    m_counts[HistogramBuckets::Index(value)] += count;
+    m_count += count;
+    m_sum += value * count;
+    m_min = value < m_min ? value : m_min;
+    m_max = value > m_max ? value : m_max;
+}
+
+void HistogramSnapshot::Merge(HistogramSnapshot const& other)
+{
+    for (uint32 i = 0; i < HistogramBuckets::count; ++i) {
+        m_counts[i] += other.m_counts[i];
+    }
+
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+    m_min = other.m_min < m_min ? other.m_min : m_min;
+    m_max = other.m_max > m_max ? other.m_max : m_max;
+}
+
+void HistogramSnapshot::Clear() noexcept
+{
+    for (uint64& count : m_counts) {
+        count = 0;
+    }
+
+    m_count = 0;
+    m_sum = 0;
+    m_min = ~uint64(0);
+    m_max = 0;
+}
+
+uint64 HistogramSnapshot::Percentile(double percent) const noexcept
+{
+    if (m_count == 0) {
+        return 0;
+    }
+
+    percent = percent < 0.0 ? 0.0 : (percent > 100.0 ? 100.0 : percent);
+    uint64 rank = static_cast<uint64>(percent / 100.0 * static_cast<double>(m_count) + 0.5);
+    rank = rank == 0 ? 1 : (rank > m_count ? m_count : rank);
+
+    // reports the upper bound of the bucket, clamped to what was actually recorded
+    uint64 seen = 0;
+    for (uint32 i = 0; i < HistogramBuckets::count; ++i) {
+        seen += m_counts[i];
+        if (seen >= rank) {
+            uint64 value = HistogramBuckets::Highest(i);
+            value = value > m_max ? m_max : value;
+            return value < m_min ? m_min : value;
+        }
+    }
+
+    return m_max;
+}
+
+void Histogram::Snapshot(HistogramSnapshot& snapshot) const
+{
+    m_shards.ForEach([&snapshot](Shard const& shard) {
+        // the count is summed from the buckets, so it always agrees with the percentiles
+        uint64 count = 0;
+        for (uint32 i = 0; i < HistogramBuckets::count; ++i) {
+            uint64 bucket = shard.counts[i].Load(MemoryOrder::relaxed);
+            snapshot.m_counts[i] += bucket;
+            count += bucket;
+        }
+
+        if (count == 0) {
+            return;
+        }
+
+        uint64 min = shard.min.Load(MemoryOrder::relaxed);
+        uint64 max = shard.max.Load(MemoryOrder::relaxed);
+        snapshot.m_count += count;
+        snapshot.m_sum += shard.sum.Load(MemoryOrder::relaxed);
+        snapshot.m_min = min < snapshot.m_min ? min : snapshot.m_min;
+        snapshot.m_max = max > snapshot.m_max ? max : snapshot.m_max;
+    });
+}
+
+void Histogram::Reset() noexcept
+{
+    m_shards.ForEach([](Shard& shard) {
+        for (Atomic<uint64>& bucket : shard.counts) {
+            bucket.Store(0, MemoryOrder::relaxed);
+        }
+
+        shard.sum.Store(0, MemoryOrder::relaxed);
+        shard.min.Store(~uint64(0), MemoryOrder::relaxed);
+        shard.max.Store(0, MemoryOrder::relaxed);
+    });
+}
+
+} // namespace mini
\ No newline at end of file
@@ -0,0 +1,337 @@
+module mini.core;
+
+import :type;
+import :allocator;
+import :memory_operation;
+import :utility_operation;
+import :source_location;
+import :array;
+import :string_view;
+import :string;
+import :format;
+import :atomic_base;
+import :atomic;
+import :mutex;
+import :mapped_file;
+import :log_binary;
+
+namespace mini {
+
+// twice the capacity, so probing always ends on an empty slot
+static constexpr uint32 logSiteSlotCount = LogSiteTable::capacity * 2;
+
+static constexpr StringView logLevelNames[] = { "debug", "info", "warn", "error", "fatal" };
+
+struct LogSiteRegistry {
+    Atomic<LogSite*> slots[logSiteSlotCount];
+    Atomic<uint32> count;
+    Mutex lock;
+};
+
+static LogSiteRegistry& GetLogSiteRegistry()
+{
+    static LogSiteRegistry registry;
+    return registry;
+}
+
+static bool MatchesLogSite(LogSite const* site, SourceLocation const& location, LogArgType const* argTypes) noexcept
+{
+    // a file whose name is not merged into one address only costs a duplicate site
+    return site->argTypes == argTypes && SameLogLocation(site->location, location);
+}
+
+static LogSite const* ProbeLogSite(LogSiteRegistry& registry,
+                                   SourceLocation const& location,
+                                   LogArgType const* argTypes,
+                                   uint32& index) noexcept
+{
+    for (;; index = (index + 1) % logSiteSlotCount) {
+        LogSite const* site = registry.slots[index].Load(MemoryOrder::acquire);
+        if (site == nullptr || MatchesLogSite(site, location, argTypes)) {
+            return site;
+        }
+    }
+}
+
+LogSite const* LogSiteTable::Find(SourceLocation const& location,
+                                  StringView format,
+                                  LogArgType const* argTypes,
+                                  uint32 argCount)
+{
+    LogSiteRegistry& registry = GetLogSiteRegistry();
+    uint32 hash = LogLocationHash(location) % logSiteSlotCount;
+
+    uint32 index = hash;
+    if (LogSite const* site = ProbeLogSite(registry, location, argTypes, index); site != nullptr) [[likely]] {
+        return site;
+    }
+
+    registry.lock.Lock();
+
+    // another thread may have added the site, or a colliding one, since the probe above
+    index = hash;
+    LogSite const* site = ProbeLogSite(registry, location, argTypes, index);
+    uint32 count = registry.count.Load(MemoryOrder::relaxed);
+
+    if (site == nullptr && count < capacity) {
+        // the format is copied once, a call site has to pass the same format every time, which a literal does
+        char* text = Allocator<char>().Allocate(format.Size() + 1).pointer;
+        memory::MemCopy(text, format.Data(), format.Size());
+        text[format.Size()] = '\0';
+
+        LogSite* created = Allocator<LogSite>().Allocate(1).pointer;
+        memory::ConstructAt(created, LogSite{ StringView(text, format.Size()), location, argTypes, argCount, count });
+
+        registry.slots[index].Store(created, MemoryOrder::release);
+        registry.count.Store(count + 1, MemoryOrder::relaxed);
+        site = created;
+    }
+
+    registry.lock.Unlock();
+    return site;
+}
+
+uint32 LogSiteTable::Count() noexcept
+{
+    return GetLogSiteRegistry().count.Load(MemoryOrder::relaxed);
+}
+
+template <TrivialT T>
+static bool ReadLogArg(byte const*& data, byte const* end, T& value) noexcept
+{
+    if (static_cast<size_t>(end - data) < sizeof(T)) {
+        return false;
+    }
+
+    memory::MemCopy(reinterpret_cast<byte*>(&value), data, sizeof(T));
+    data += sizeof(T);
+    return true;
+}
+
+typedef fmt::dynamic_format_arg_store<fmt::format_context> LogArgStore;
+
+template <TrivialT T, typename U = T>
+static bool PushLogArg(LogArgStore& store, byte const*& data, byte const* end)
+{
+    T value = T();
+    if (!ReadLogArg(data, end, value)) {
+        return false;
+    }
+
+    store.push_back(static_cast<U>(value));
+    return true;
+}
+
+static bool PushLogArg(LogArgStore& store, LogArgType type, byte const*& data, byte const* end)
+{
+    switch (type) {
+        case LogArgType::signedInt: return PushLogArg<int64>(store, data, end);
+        case LogArgType::unsignedInt: return PushLogArg<uint64>(store, data, end);
+        case LogArgType::floating: return PushLogArg<double>(store, data, end);
+        case LogArgType::floating32: return PushLogArg<float32>(store, data, end);
+        case LogArgType::boolean: return PushLogArg<byte, bool>(store, data, end);
+        case LogArgType::character: return PushLogArg<byte, char>(store, data, end);
+
+        case LogArgType::pointer: {
+            uint64 address = 0;
+            if (!ReadLogArg(data, end, address)) {
+                return false;
+            }
+
+            store.push_back(reinterpret_cast<void const*>(static_cast<size_t>(address)));
+            return true;
+        }
+
+        case LogArgType::string: {
+            uint32 size = 0;
+            if (!ReadLogArg(data, end, size) || static_cast<size_t>(end - data) < size) {
+                return false;
+            }
+
+            // a view is not copied by the store, the payload outlives the formatting
+            store.push_back(fmt::string_view(reinterpret_cast<char const*>(data), size));
+            data += size;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void FormatLogArgs(String& out,
+                   StringView format,
+                   LogArgType const* argTypes,
+                   uint32 argCount,
+                   byte const* data,
+                   size_t size)
+{
+    if (argCount == 0) {
+        out.Append(format);
+        return;
+    }
+
+    LogArgStore store;
+    store.reserve(argCount, 0);
+
+    byte const* end = data + size;
+    for (uint32 i = 0; i < argCount; ++i) {
+        if (!PushLogArg(store, argTypes[i], data, end)) {
+            out.Append(format);
+            out.Append(" (format failed with error: truncated arguments)");
+            return;
+        }
+    }
+
+    auto buf = fmt::memory_buffer();
+    try {
+        fmt::vformat_to(fmt::appender(buf), fmt::string_view(format.Data(), format.Size()), store);
+    } catch (fmt::format_error const& error) {
+        WriteFormatError(out, format, error);
+        return;
+    }
+
+    out.Append(buf.data(), buf.size());
+}
+
+void AppendLogLine(String& line, int64 nanoSeconds, StringView category, byte level, StringView message)
+{
+    StringView levelName = level < 5 ? logLevelNames[level] : StringView("?");
+
+    FormatTo(line, "[{}.{:06}] [{}] [{}] ", nanoSeconds / 1'000'000'000, nanoSeconds % 1'000'000'000 / 1000,
+             category, levelName);
+    line.Append(message);
+    line.Push('\n');
+}
+
+bool BinaryLogReader::Open(StringView path)
+{
+    m_categories.Clear();
+    m_sites.Clear();
+    m_offset = 0;
+    m_corrupted = false;
+
+    if (!m_file.Open(path)) {
+        return false;
+    }
+
+    char fileMagic[4] = {};
+    uint32 fileVersion = 0;
+    if (!Read(fileMagic, sizeof(fileMagic)) || !Read(&fileVersion, sizeof(fileVersion)) ||
+        StringView(fileMagic, 4) != StringView(magic, 4) || fileVersion != version) {
+        m_corrupted = true;
+        m_file.Close();
+        return false;
+    }
+
+    return true;
+}
+
+bool BinaryLogReader::Next(String& line)
+{
+    while (m_file.IsOpen() && !m_corrupted && m_offset < m_file.Size()) {
+        char tag = 0;
+        Read(&tag, 1);
+
+        switch (tag) {
+            case 'C': {
+                String name;
+                if (!ReadString(name)) {
+                    break;
+                }
+
+                m_categories.Push(MoveArg(name));
+                continue;
+            }
+
+            case 'S': {
+                Site site;
+                uint32 argCount = 0;
+                if (!Read(&site.line, sizeof(site.line)) || !Read(&argCount, sizeof(argCount))) {
+                    break;
+                }
+
+                // a corrupt count must not size the allocation, every type takes a byte of the record
+                if (argCount > m_file.Size() - m_offset) {
+                    break;
+                }
+
+                site.argTypes.Resize(argCount, LogArgType::signedInt);
+                if (!Read(site.argTypes.Data(), argCount) || !ReadString(site.file) || !ReadString(site.format)) {
+                    break;
+                }
+
+                m_sites.Push(MoveArg(site));
+                continue;
+            }
+
+            case 'R':
+            case 'M': {
+                uint32 site = 0;
+                uint32 category = 0;
+                byte level = 0;
+                int64 time = 0;
+                uint32 size = 0;
+
+                bool valid = (tag == 'M' || Read(&site, sizeof(site))) && Read(&category, sizeof(category)) &&
+                             Read(&level, sizeof(level)) && Read(&time, sizeof(time)) &&
+                             Read(&size, sizeof(size)) && size <= m_file.Size() - m_offset &&
+                             (tag == 'M' || site < m_sites.Size()) &&
+                             (category == ~uint32(0) || category < m_categories.Size());
+                if (!valid) {
+                    break;
+                }
+
+                byte const* payload = m_file.Data() + m_offset;
+                m_offset += size;
+
+                StringView categoryName = category != ~uint32(0) ? StringView(m_categories[category]) : "log";
+                if (tag == 'M') {
+                    AppendLogLine(line, time, categoryName, level,
+                                  StringView(reinterpret_cast<char const*>(payload), size));
+                    return true;
+                }
+
+                Site const& entry = m_sites[site];
+                String message;
+                FormatLogArgs(message, entry.format, entry.argTypes.Data(),
+                              static_cast<uint32>(entry.argTypes.Size()), payload, size);
+
+                AppendLogLine(line, time, categoryName, level, message);
+                return true;
+            }
+
+            default: break;
+        }
+
+        // only reached by a break out of the switch, the rest of the file cannot be trusted
+        m_corrupted = true;
+    }
+
+    return false;
+}
+
+bool BinaryLogReader::Read(void* data, size_t size) noexcept
+{
+    if (m_file.Size() - m_offset < size) {
+        m_offset = m_file.Size();
+        return false;
+    }
+
+    memory::MemCopy(static_cast<byte*>(data), m_file.Data() + m_offset, size);
+    m_offset += size;
+    return true;
+}
+
+bool BinaryLogReader::ReadString(String& out)
+{
+    uint32 size = 0;
+    if (!Read(&size, sizeof(size)) || m_file.Size() - m_offset < size) {
+        return false;
+    }
+
+    out.Append(StringView(reinterpret_cast<char const*>(m_file.Data() + m_offset), size));
+    m_offset += size;
+    return true;
+}
+
+} // namespace mini
\ No newline at end of file
@@ -0,0 +1,135 @@
+module mini.core;
+
+import :type;
+import :allocator;
+import :memory_operation;
+import :source_location;
+import :atomic_base;
+import :atomic;
+import :mutex;
+import :time_point;
+import :cycle_clock;
+import :log_binary;
+import :log_limit;
+
+namespace mini {
+
+// twice the capacity, so probing always ends on an empty slot
+static constexpr uint32 logRateSlotCount = LogRateLimit::capacity * 2;
+
+struct LogRateSite {
+    SourceLocation location;
+
+    // time the bucket is full again, every message pushes it one interval further
+    Atomic<int64> full;
+    Atomic<uint32> suppressed;
+};
+
+struct LogRateRegistry {
+    Atomic<LogRateSite*> slots[logRateSlotCount];
+    Atomic<uint32> count;
+    Atomic<int64> interval;
+    Atomic<int64> tolerance;
+    Mutex lock;
+};
+
+static LogRateRegistry& GetLogRateRegistry()
+{
+    static LogRateRegistry registry;
+    return registry;
+}
+
+static LogRateSite* ProbeLogRateSite(LogRateRegistry& registry, SourceLocation const& location, uint32& index) noexcept
+{
+    for (;; index = (index + 1) % logRateSlotCount) {
+        LogRateSite* site = registry.slots[index].Load(MemoryOrder::acquire);
+        if (site == nullptr || SameLogLocation(site->location, location)) {
+            return site;
+        }
+    }
+}
+
+static LogRateSite* FindLogRateSite(LogRateRegistry& registry, SourceLocation const& location)
+{
+    uint32 hash = LogLocationHash(location) % logRateSlotCount;
+
+    uint32 index = hash;
+    if (LogRateSite* site = ProbeLogRateSite(registry, location, index); site != nullptr) [[likely]] {
+        return site;
+    }
+
+    registry.lock.Lock();
+
+    index = hash;
+    LogRateSite* site = ProbeLogRateSite(registry, location, index);
+    uint32 count = registry.count.Load(MemoryOrder::relaxed);
+
+    if (site == nullptr && count < LogRateLimit::capacity) {
+        // never freed, like the sites of deferred messages
+        site = Allocator<LogRateSite>().Allocate(1).pointer;
+        memory::ConstructAt(site);
+        site->location = location;
+
+        registry.slots[index].Store(site, MemoryOrder::release);
+        registry.count.Store(count + 1, MemoryOrder::relaxed);
+    }
+
+    registry.lock.Unlock();
+    return site;
+}
+
+void LogRateLimit::Configure(uint32 rate, uint32 burst)
+{
+    LogRateRegistry& registry = GetLogRateRegistry();
+
+    int64 interval = rate != 0 ? 1'000'000'000 / static_cast<int64>(rate) : 0;
+    int64 tolerance = interval * static_cast<int64>(burst > 1 ? burst - 1 : 0);
+
+    registry.tolerance.Store(tolerance, MemoryOrder::relaxed);
+    registry.interval.Store(interval, MemoryOrder::relaxed);
+}
+
+bool LogRateLimit::Enabled() noexcept
+{
+    return GetLogRateRegistry().interval.Load(MemoryOrder::relaxed) != 0;
+}
+
+bool LogRateLimit::Acquire(SourceLocation const& location, uint32& suppressed)
+{
+    LogRateRegistry& registry = GetLogRateRegistry();
+    int64 interval = registry.interval.Load(MemoryOrder::relaxed);
+    int64 tolerance = registry.tolerance.Load(MemoryOrder::relaxed);
+
+    suppressed = 0;
+    if (interval == 0) {
+        return true;
+    }
+
+    LogRateSite* site = FindLogRateSite(registry, location);
+    if (site == nullptr) [[unlikely]] {
+        return true;
+    }
+
+    // generic cell rate form of the token bucket, a single time stamp instead of a token count and a refill time
+    int64 now = CycleClock::Now().SinceEpoch().Count();
+    int64 full = site->full.Load(MemoryOrder::relaxed);
+    for (;;) {
+        int64 start = full > now ? full : now;
+        if (start - now > tolerance) {
+            site->suppressed.FetchAdd(1, MemoryOrder::relaxed);
+            return false;
+        }
+
+        if (site->full.CompareExchangeWeak(full, start + interval, MemoryOrder::relaxed)) {
+            break;
+        }
+    }
+
+    if (site->suppressed.Load(MemoryOrder::relaxed) != 0) [[unlikely]] {
+        suppressed = site->suppressed.Exchange(0, MemoryOrder::relaxed);
+    }
+
+    return true;
+}
+
+} // namespace mini
\ No newline at end of file
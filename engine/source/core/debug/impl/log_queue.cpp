@@ -0,0 +1,407 @@
+module;
+
+#include <cstdio>
+
+module mini.core;
+
+import :type;
+import :utility_operation;
+import :memory_operation;
+import :unique_ptr;
+import :array;
+import :string_view;
+import :string;
+import :format;
+import :atomic_base;
+import :atomic;
+import :mutex;
+import :thread;
+import :time_point;
+import :cycle_clock;
+import :async_file;
+import :logger_platform;
+import :log_binary;
+import :log_queue;
+
+namespace mini {
+
+// lines are buffered by the file sink up to this size, or until the queue runs dry
+static constexpr size_t fileSinkBufferSize = 64 * 1024;
+
+static Atomic<LogQueue*> currentLogQueue(nullptr);
+
+static void AppendLogLine(String& line, LogRecord const& record)
+{
+    StringView category = record.Source() != nullptr ? record.Source()->Category() : StringView("log");
+    AppendLogLine(line, record.Time().SinceEpoch().Count(), category, record.Level(), record.Message());
+}
+
+void LogRecord::Materialize()
+{
+    if (m_kind != Kind::deferred) {
+        return;
+    }
+
+    String text;
+    FormatLogArgs(text, m_site->format, m_site->argTypes, m_site->argCount, Payload(), PayloadSize());
+
+    Release();
+    char* data = Reserve(text.Size());
+    memory::MemCopy(data, text.Data(), text.Size());
+    m_kind = Kind::message;
+}
+
+void PlatformLogSink::Write(LogRecord const& record)
+{
+    record.Source()->PrintMessage(record.Level(), record.Message());
+}
+
+void PlatformLogSink::Flush()
+{
+    LoggerBase::FlushMessages();
+}
+
+void StreamLogSink::Write(LogRecord const& record)
+{
+    String line;
+    AppendLogLine(line, record);
+    std::fwrite(line.Data(), 1, line.Size(), stderr);
+}
+
+void StreamLogSink::Flush()
+{
+    std::fflush(stderr);
+}
+
+FileLogSink::FileLogSink() noexcept
+    : m_file()
+    , m_offset(0)
+    , m_line()
+{
+}
+
+bool FileLogSink::Open(StringView path)
+{
+    FileOpenOptions options;
+    options.write = true;
+    options.create = true;
+
+    m_offset = 0;
+    m_line.Clear();
+    return m_file.Open(path, options);
+}
+
+void FileLogSink::Write(LogRecord const& record)
+{
+    AppendLogLine(m_line, record);
+    if (m_line.Size() >= fileSinkBufferSize) {
+        Flush();
+    }
+}
+
+void FileLogSink::Flush()
+{
+    if (m_line.Empty() || !m_file.IsOpen()) {
+        return;
+    }
+
+    int64 written = m_file.WriteAt(m_offset, m_line.Data(), m_line.Size());
+    m_offset += written > 0 ? static_cast<uint64>(written) : 0;
+    m_line.Clear();
+}
+
+BinaryLogSink::BinaryLogSink() noexcept
+    : m_file()
+    , m_offset(0)
+    , m_buffer()
+    , m_sites()
+    , m_siteCount(0)
+    , m_categories()
+{
+}
+
+bool BinaryLogSink::Open(StringView path)
+{
+    FileOpenOptions options;
+    options.write = true;
+    options.create = true;
+
+    m_offset = 0;
+    m_buffer.Clear();
+    m_sites.Clear();
+    m_siteCount = 0;
+    m_categories.Clear();
+
+    if (!m_file.Open(path, options)) {
+        return false;
+    }
+
+    AppendBytes(BinaryLogReader::magic, sizeof(BinaryLogReader::magic));
+    Append(BinaryLogReader::version);
+    return true;
+}
+
+void BinaryLogSink::Write(LogRecord const& record)
+{
+    uint32 category = CategoryId(record.Source());
+    int64 time = record.Time().SinceEpoch().Count();
+
+    if (record.GetKind() == LogRecord::Kind::deferred) {
+        uint32 site = SiteId(record.Site());
+        Append('R');
+        Append(site);
+        Append(category);
+        Append(record.Level());
+        Append(time);
+        Append(static_cast<uint32>(record.PayloadSize()));
+        AppendBytes(record.Payload(), record.PayloadSize());
+    } else {
+        StringView message = record.Message();
+        Append('M');
+        Append(category);
+        Append(record.Level());
+        Append(time);
+        Append(static_cast<uint32>(message.Size()));
+        AppendBytes(message.Data(), message.Size());
+    }
+
+    if (m_buffer.Size() >= fileSinkBufferSize) {
+        Flush();
+    }
+}
+
+void BinaryLogSink::Flush()
+{
+    if (m_buffer.Empty() || !m_file.IsOpen()) {
+        return;
+    }
+
+    int64 written = m_file.WriteAt(m_offset, m_buffer.Data(), m_buffer.Size());
+    m_offset += written > 0 ? static_cast<uint64>(written) : 0;
+    m_buffer.Clear();
+}
+
+void BinaryLogSink::AppendBytes(void const* data, size_t size)
+{
+    m_buffer.Append(StringView(static_cast<char const*>(data), size));
+}
+
+uint32 BinaryLogSink::CategoryId(LoggerBase* logger)
+{
+    if (logger == nullptr) {
+        return ~uint32(0);
+    }
+
+    for (uint32 i = 0; i < m_categories.Size(); ++i) {
+        if (m_categories[i] == logger) {
+            return i;
+        }
+    }
+
+    StringView name = logger->Category();
+    Append('C');
+    Append(static_cast<uint32>(name.Size()));
+    AppendBytes(name.Data(), name.Size());
+
+    m_categories.Push(logger);
+    return static_cast<uint32>(m_categories.Size() - 1);
+}
+
+uint32 BinaryLogSink::SiteId(LogSite const* site)
+{
+    // sites are numbered in the order this sink first sees them, which keeps the ids of a file dense
+    if (site->id >= m_sites.Size()) {
+        m_sites.Resize(site->id + 1, ~uint32(0));
+    }
+
+    if (m_sites[site->id] != ~uint32(0)) {
+        return m_sites[site->id];
+    }
+
+    SourceLocation const& location = site->location;
+    StringView file = location.file_name();
+
+    Append('S');
+    Append(static_cast<uint32>(location.line()));
+    Append(site->argCount);
+    AppendBytes(site->argTypes, site->argCount);
+    Append(static_cast<uint32>(file.Size()));
+    AppendBytes(file.Data(), file.Size());
+    Append(static_cast<uint32>(site->format.Size()));
+    AppendBytes(site->format.Data(), site->format.Size());
+
+    m_sites[site->id] = m_siteCount;
+    return m_siteCount++;
+}
+
+LogQueue::LogQueue(UniquePtr<LogSink> sink, LogOverflow overflow, bool deferred)
+    : m_queue()
+    , m_sink(MoveArg(sink))
+    , m_overflow(overflow)
+    , m_deferred(deferred)
+    , m_dropped(0)
+    , m_spillLock()
+    , m_spill()
+    , m_spilled(false)
+    , m_pending()
+    , m_pendingIndex(0)
+    , m_thread()
+{
+    if (!m_sink.Valid()) {
+        m_sink = MakeUnique<PlatformLogSink>();
+    }
+
+    ThreadOptions sinkOptions;
+    sinkOptions.name = "mini.log.sink";
+    m_thread = Thread([this]() { Run(); }, sinkOptions);
+}
+
+LogQueue::~LogQueue()
+{
+    m_queue.Enqueue(LogRecord::Kind::stop);
+    m_thread.Join();
+}
+
+void LogQueue::Flush()
+{
+    Atomic<uint32> done(0);
+    m_queue.Enqueue(LogRecord::Kind::flush, &done);
+
+    while (done.Load(MemoryOrder::acquire) == 0) {
+        done.Wait(0, MemoryOrder::acquire);
+    }
+}
+
+bool LogQueue::Start(UniquePtr<LogSink> sink, LogOverflow overflow, bool deferred)
+{
+    if (currentLogQueue.Load(MemoryOrder::acquire) != nullptr) {
+        return false;
+    }
+
+    // a queue losing the race to another Start is destroyed on return
+    UniquePtr<LogQueue> queue = MakeUnique<LogQueue>(MoveArg(sink), overflow, deferred);
+    LogQueue* expected = nullptr;
+    if (!currentLogQueue.CompareExchangeStrong(expected, queue.Get(), MemoryOrder::release, MemoryOrder::relaxed)) {
+        return false;
+    }
+
+    queue.Detach();
+    return true;
+}
+
+void LogQueue::Stop()
+{
+    // loggers fall back to printing synchronously right away, the destructor writes out the rest
+    UniquePtr<LogQueue> queue(currentLogQueue.Exchange(nullptr, MemoryOrder::acquireRelease));
+}
+
+LogQueue* LogQueue::Current() noexcept
+{
+    return currentLogQueue.Load(MemoryOrder::acquire);
+}
+
+void LogQueue::Run()
+{
+    LogRecord record;
+    for (;;) {
+        if (!m_queue.TryDequeue(record)) {
+            if (DrainSpill()) {
+                continue;
+            }
+
+            // about to sleep, buffered lines go out now rather than with the next burst
+            m_sink->Flush();
+            record = m_queue.Dequeue();
+        }
+
+        switch (record.GetKind()) {
+            case LogRecord::Kind::message:
+            case LogRecord::Kind::deferred:
+                DeliverSpill(record.Time());
+                Deliver(record);
+                break;
+
+            case LogRecord::Kind::wake: break;
+
+            case LogRecord::Kind::flush:
+                DeliverSpill(CycleClock::Now());
+                m_sink->Flush();
+
+                record.Signal()->Store(1, MemoryOrder::release);
+                record.Signal()->NotifyAll();
+                break;
+
+            case LogRecord::Kind::stop:
+                while (m_queue.TryDequeue(record)) {
+                    LogRecord::Kind kind = record.GetKind();
+                    if (kind == LogRecord::Kind::message || kind == LogRecord::Kind::deferred) {
+                        DeliverSpill(record.Time());
+                        Deliver(record);
+                    }
+                }
+
+                DrainSpill();
+                m_sink->Flush();
+                return;
+        }
+    }
+}
+
+void LogQueue::Deliver(LogRecord& record)
+{
+    if (record.GetKind() == LogRecord::Kind::deferred && !m_sink->AcceptsDeferred()) {
+        record.Materialize();
+    }
+
+    m_sink->Write(record);
+}
+
+void LogQueue::CollectSpill()
+{
+    if (!m_spilled.Load(MemoryOrder::relaxed)) {
+        return;
+    }
+
+    m_spillLock.Lock();
+    Array<LogRecord> spill(MoveArg(m_spill));
+    m_spilled.Store(false, MemoryOrder::relaxed);
+    m_spillLock.Unlock();
+
+    // producers take their time before the spill lock, so the spill is only nearly sorted
+    for (LogRecord& spilled : spill) {
+        m_pending.Push(MoveArg(spilled));
+        for (size_t i = m_pending.Size() - 1; i > m_pendingIndex && m_pending[i - 1].Time() > m_pending[i].Time();
+             --i) {
+            LogRecord swap(MoveArg(m_pending[i]));
+            m_pending[i] = MoveArg(m_pending[i - 1]);
+            m_pending[i - 1] = MoveArg(swap);
+        }
+    }
+}
+
+void LogQueue::DeliverSpill(CycleClock::TimePoint before)
+{
+    CollectSpill();
+
+    while (m_pendingIndex < m_pending.Size() && m_pending[m_pendingIndex].Time() <= before) {
+        Deliver(m_pending[m_pendingIndex++]);
+    }
+
+    if (m_pendingIndex == m_pending.Size() && m_pendingIndex != 0) {
+        m_pending.Clear();
+        m_pendingIndex = 0;
+    }
+}
+
+bool LogQueue::DrainSpill()
+{
+    CollectSpill();
+    if (m_pending.Empty()) {
+        return false;
+    }
+
+    DeliverSpill(CycleClock::TimePoint::Max());
+    return true;
+}
+
+} // namespace mini
\ No newline at end of file
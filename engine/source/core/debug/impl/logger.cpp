@@ -0,0 +1,90 @@
+module mini.core;
+
+import :type;
+import :array;
+import :string_view;
+import :string;
+import :atomic_base;
+import :atomic;
+import :mutex;
+import :logger;
+
+namespace mini {
+
+struct CategoryLevel {
+    String category;
+    Logger::Level level;
+};
+
+struct LoggerRegistry {
+    Mutex lock;
+    Array<Logger*> loggers;
+    Array<CategoryLevel> levels;
+};
+
+static LoggerRegistry& GetLoggerRegistry()
+{
+    // never freed, loggers are statics of every module and may well be destroyed after the core
+    static LoggerRegistry* registry = new LoggerRegistry();
+    return *registry;
+}
+
+Logger::Logger(StringView category)
+    : LoggerBase(category)
+    , m_level(static_cast<byte>(minLevel))
+{
+    LoggerRegistry& registry = GetLoggerRegistry();
+    registry.lock.Lock();
+
+    for (CategoryLevel const& entry : registry.levels) {
+        if (StringView(entry.category) == category) {
+            SetLevel(entry.level);
+        }
+    }
+
+    registry.loggers.Push(this);
+    registry.lock.Unlock();
+}
+
+Logger::~Logger()
+{
+    LoggerRegistry& registry = GetLoggerRegistry();
+    registry.lock.Lock();
+
+    for (size_t i = 0; i < registry.loggers.Size(); ++i) {
+        if (registry.loggers[i] == this) {
+            registry.loggers.RemoveAt(i);
+            break;
+        }
+    }
+
+    registry.lock.Unlock();
+}
+
+void Logger::SetCategoryLevel(StringView category, Level level)
+{
+    LoggerRegistry& registry = GetLoggerRegistry();
+    registry.lock.Lock();
+
+    bool found = false;
+    for (CategoryLevel& entry : registry.levels) {
+        if (StringView(entry.category) == category) {
+            entry.level = level;
+            found = true;
+        }
+    }
+
+    if (!found) {
+        registry.levels.Push(CategoryLevel{ String(category), level });
+    }
+
+    for (Logger* logger : registry.loggers) {
+        if (logger->Category() == category) {
+            logger->SetLevel(level);
+        }
+    }
+
+    registry.lock.Unlock();
+}
+
+} // namespace mini
\ No newline at end of file
@@ -0,0 +1,393 @@
+module;
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+module mini.core;
+
+import :type;
+import :utility_operation;
+import :memory_operation;
+import :unique_ptr;
+import :string_view;
+import :string;
+import :duration;
+import :clock;
+import :format;
+import :mutex;
+import :file_platform;
+import :logger_platform;
+
+namespace mini {
+
+static constexpr StringView levelPrefixes[] = { "] [debug] ", "] [info] ", "] [warn] ", "] [error] ", "] [fatal] " };
+
+// syslog priorities, debug, info, warning, error and critical
+static constexpr char journalPriorities[] = { '7', '6', '4', '3', '2' };
+
+static constexpr char const* journalSocketPath = "/run/systemd/journal/socket";
+
+struct PlatformLogState {
+    Mutex lock;
+    UniquePtr<PlatformLogWriter> writer;
+};
+
+static void FlushPlatformLogAtExit()
+{
+    LoggerBase::FlushMessages();
+}
+
+static PlatformLogState& GetPlatformLogState()
+{
+    // never freed, loggers print from the destructors of statics in every module
+    static PlatformLogState* state = []() {
+        PlatformLogState* created = new PlatformLogState();
+        created->writer = MakeUnique<StderrLogWriter>();
+        std::atexit(FlushPlatformLogAtExit);
+        return created;
+    }();
+
+    return *state;
+}
+
+static StringView LevelPrefix(byte level) noexcept
+{
+    return level < 5 ? levelPrefixes[level] : levelPrefixes[4];
+}
+
+static iovec MakeVector(StringView text) noexcept
+{
+    return iovec{ const_cast<char*>(text.Data()), text.Size() };
+}
+
+// writes every vector, resuming after partial writes and interrupts
+static void WriteVectors(int32 file, iovec* vectors, int32 count) noexcept
+{
+    while (count > 0) {
+        ssize_t written = writev(file, vectors, count);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return;
+        }
+
+        size_t remaining = static_cast<size_t>(written);
+        while (count > 0 && remaining >= vectors->iov_len) {
+            remaining -= vectors->iov_len;
+            ++vectors;
+            --count;
+        }
+
+        if (count > 0) {
+            vectors->iov_base = static_cast<char*>(vectors->iov_base) + remaining;
+            vectors->iov_len -= remaining;
+        }
+    }
+}
+
+static void WriteLine(int32 file, byte level, StringView category, StringView message) noexcept
+{
+    iovec vectors[] = { MakeVector("["), MakeVector(category), MakeVector(LevelPrefix(level)), MakeVector(message),
+                        MakeVector("\n") };
+    WriteVectors(file, vectors, 5);
+}
+
+StderrLogWriter::StderrLogWriter()
+    : m_buffer()
+    , m_oldest()
+    , m_interactive(isatty(STDERR_FILENO) != 0)
+{
+    m_buffer.Reserve(bufferSize);
+}
+
+StderrLogWriter::~StderrLogWriter()
+{
+    Flush();
+}
+
+void StderrLogWriter::Write(byte level, StringView category, StringView message)
+{
+    if (m_interactive) {
+        WriteLine(STDERR_FILENO, level, category, message);
+        return;
+    }
+
+    StringView prefix = LevelPrefix(level);
+    size_t size = 1 + category.Size() + prefix.Size() + message.Size() + 1;
+
+    if (m_buffer.Size() + size <= bufferSize) {
+        CoarseClock::TimePoint now = CoarseClock::Now();
+        if (m_buffer.Empty()) {
+            m_oldest = now;
+        }
+
+        m_buffer.Push('[');
+        m_buffer.Append(category);
+        m_buffer.Append(prefix);
+        m_buffer.Append(message);
+        m_buffer.Push('\n');
+
+        if (now - m_oldest >= maxDelay) {
+            Flush();
+        }
+        return;
+    }
+
+    // the buffered lines and the new one leave with the same call, the message is never copied
+    iovec vectors[] = { MakeVector(m_buffer), MakeVector("["),     MakeVector(category),
+                        MakeVector(prefix),   MakeVector(message), MakeVector("\n") };
+    WriteVectors(STDERR_FILENO, vectors, 6);
+    m_buffer.Clear();
+}
+
+void StderrLogWriter::Flush()
+{
+    if (m_buffer.Empty()) {
+        return;
+    }
+
+    iovec vector = MakeVector(m_buffer);
+    WriteVectors(STDERR_FILENO, &vector, 1);
+    m_buffer.Clear();
+}
+
+JournalLogWriter::JournalLogWriter()
+    : m_socket(socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0))
+{
+    if (m_socket < 0) {
+        return;
+    }
+
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    memory::MemCopy(address.sun_path, journalSocketPath, StringView(journalSocketPath).Size() + 1);
+
+    if (connect(m_socket, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) != 0) {
+        close(m_socket);
+        m_socket = -1;
+    }
+}
+
+JournalLogWriter::~JournalLogWriter()
+{
+    if (m_socket >= 0) {
+        close(m_socket);
+    }
+}
+
+void JournalLogWriter::Write(byte level, StringView category, StringView message)
+{
+    char priority = journalPriorities[level < 5 ? level : 4];
+
+    if (m_socket >= 0) {
+        // fields with a line break are sent as name, newline, 64 bit little endian size and the raw value
+        uint64 messageSize = message.Size();
+        char priorityField[] = { 'P', 'R', 'I', 'O', 'R', 'I', 'T', 'Y', '=', priority, '\n' };
+
+        iovec vectors[] = {
+            MakeVector(StringView(priorityField, sizeof(priorityField))),
+            MakeVector("SYSLOG_IDENTIFIER=" ENGINE_PROJECT_NAME "\nMINI_CATEGORY="),
+            MakeVector(category),
+            MakeVector("\nMESSAGE\n"),
+            iovec{ &messageSize, sizeof(messageSize) },
+            MakeVector(message),
+            MakeVector("\n"),
+        };
+
+        msghdr header = {};
+        header.msg_iov = vectors;
+        header.msg_iovlen = sizeof(vectors) / sizeof(iovec);
+
+        ssize_t sent = -1;
+        do {
+            sent = sendmsg(m_socket, &header, MSG_NOSIGNAL);
+        } while (sent < 0 && errno == EINTR);
+
+        if (sent >= 0) {
+            return;
+        }
+    }
+
+    char priorityPrefix[] = { '<', priority, '>', '[' };
+    iovec vectors[] = { MakeVector(StringView(priorityPrefix, sizeof(priorityPrefix))), MakeVector(category),
+                        MakeVector(LevelPrefix(level)), MakeVector(message), MakeVector("\n") };
+    WriteVectors(STDERR_FILENO, vectors, 5);
+}
+
+RotatingFileLogWriter::RotatingFileLogWriter() noexcept
+    : m_path()
+    , m_file(invalidPlatformFile)
+    , m_data(nullptr)
+    , m_size(0)
+    , m_used(0)
+    , m_backupCount(0)
+{
+}
+
+RotatingFileLogWriter::~RotatingFileLogWriter()
+{
+    Close();
+}
+
+bool RotatingFileLogWriter::Open(StringView path, size_t maxSize, uint32 backupCount)
+{
+    Close();
+
+    size_t pageSize = FileMapPageSize();
+    m_path = String(path);
+    m_size = (maxSize + pageSize - 1) / pageSize * pageSize;
+    m_backupCount = backupCount;
+    return m_size != 0 && Map();
+}
+
+void RotatingFileLogWriter::Close() noexcept
+{
+    if (m_data != nullptr) {
+        FileUnmap(m_data, m_size);
+        m_data = nullptr;
+    }
+
+    if (m_file != invalidPlatformFile) {
+        // the mapping grew the file to its full size, only what was written is kept
+        [[maybe_unused]] int32 result = ftruncate(m_file, static_cast<off_t>(m_used));
+        FileClose(m_file);
+        m_file = invalidPlatformFile;
+    }
+
+    m_used = 0;
+}
+
+void RotatingFileLogWriter::Write(byte level, StringView category, StringView message)
+{
+    // lines are not lost while no file could be mapped, e.g. the disk is full
+    if (m_data == nullptr) {
+        WriteLine(STDERR_FILENO, level, category, message);
+        return;
+    }
+
+    StringView prefix = LevelPrefix(level);
+    size_t size = 1 + category.Size() + prefix.Size() + message.Size() + 1;
+    if (m_used + size > m_size && m_used != 0) {
+        Rotate();
+        if (m_data == nullptr) {
+            WriteLine(STDERR_FILENO, level, category, message);
+            return;
+        }
+    }
+
+    // a single line larger than a whole file is cut to fit
+    if (size > m_size) {
+        message = message.SubString(0, message.Size() - (size - m_size));
+        size = m_size;
+    }
+
+    char* line = m_data + m_used;
+    *line++ = '[';
+    memory::MemCopy(line, category.Data(), category.Size());
+    line += category.Size();
+    memory::MemCopy(line, prefix.Data(), prefix.Size());
+    line += prefix.Size();
+    memory::MemCopy(line, message.Data(), message.Size());
+    line += message.Size();
+    *line = '\n';
+
+    m_used += size;
+}
+
+void RotatingFileLogWriter::Flush()
+{
+    // lines reach the page cache as they are copied, writing them back is left to the kernel
+}
+
+bool RotatingFileLogWriter::Map()
+{
+    bool direct = false;
+    m_file = FileOpen(m_path.Data(), true, true, direct);
+    if (m_file == invalidPlatformFile) {
+        return false;
+    }
+
+    // a sparse file maps fine and raises SIGBUS on the first page the disk has no room for
+    if (posix_fallocate(m_file, 0, static_cast<off_t>(m_size)) != 0) {
+        FileClose(m_file);
+        m_file = invalidPlatformFile;
+        return false;
+    }
+
+    m_data = static_cast<char*>(FileMap(m_file, m_size, true));
+    if (m_data == nullptr) {
+        FileClose(m_file);
+        m_file = invalidPlatformFile;
+        return false;
+    }
+
+    m_used = 0;
+    return true;
+}
+
+void RotatingFileLogWriter::Rotate()
+{
+    Close();
+
+    String from;
+    String to;
+    for (uint32 index = m_backupCount; index > 0; --index) {
+        from.Clear();
+        to.Clear();
+
+        from.Append(m_path);
+        if (index > 1) {
+            FormatTo(from, ".{}", index - 1);
+        }
+
+        to.Append(m_path);
+        FormatTo(to, ".{}", index);
+        std::rename(from.Data(), to.Data());
+    }
+
+    Map();
+}
+
+LoggerBase::LoggerBase(StringView category)
+    : m_category(category)
+{
+}
+
+void LoggerBase::PrintMessage(byte level, StringView msg)
+{
+    PlatformLogState& state = GetPlatformLogState();
+    state.lock.Lock();
+    state.writer->Write(level, m_category, msg);
+    state.lock.Unlock();
+}
+
+void LoggerBase::FlushMessages()
+{
+    PlatformLogState& state = GetPlatformLogState();
+    state.lock.Lock();
+    state.writer->Flush();
+    state.lock.Unlock();
+}
+
+void LoggerBase::SetWriter(UniquePtr<PlatformLogWriter> writer)
+{
+    if (!writer.Valid()) {
+        writer = MakeUnique<StderrLogWriter>();
+    }
+
+    PlatformLogState& state = GetPlatformLogState();
+    state.lock.Lock();
+    state.writer->Flush();
+    state.writer = MoveArg(writer);
+    state.lock.Unlock();
+}
+
+} // namespace mini
\ No newline at end of file
@@ -0,0 +1,180 @@
+module mini.core;
+
+import :type;
+import :allocator;
+import :memory_operation;
+import :array;
+import :string_view;
+import :string;
+import :format;
+import :mutex;
+import :logger;
+import :sharded_counter;
+import :histogram;
+import :async_file;
+import :metrics;
+
+namespace mini {
+
+template <typename T>
+struct NamedMetric {
+    String name;
+    T* metric;
+};
+
+struct MetricRegistry {
+    Mutex lock;
+    Array<NamedMetric<ShardedCounter>> counters;
+    Array<NamedMetric<Gauge>> gauges;
+    Array<NamedMetric<Histogram>> histograms;
+};
+
+static MetricRegistry& GetMetricRegistry()
+{
+    static MetricRegistry registry;
+    return registry;
+}
+
+template <typename T>
+static bool ContainsMetric(Array<NamedMetric<T>> const& metrics, StringView name) noexcept
+{
+    for (NamedMetric<T> const& entry : metrics) {
+        if (StringView(entry.name) == name) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template <typename T>
+static T& FindOrCreateMetric(Array<NamedMetric<T>>& metrics, StringView name)
+{
+    for (NamedMetric<T>& entry : metrics) {
+        if (StringView(entry.name) == name) {
+            return *entry.metric;
+        }
+    }
+
+    // never freed, references handed out stay valid even while statics are destroyed at exit
+    T* metric = Allocator<T>().Allocate(1).pointer;
+    memory::ConstructAt(metric);
+
+    metrics.Push(NamedMetric<T>{ String(name), metric });
+    return *metric;
+}
+
+static void AppendHistogram(String& out, StringView name, Histogram const& histogram)
+{
+    HistogramSnapshot snapshot;
+    histogram.Snapshot(snapshot);
+
+    FormatTo(out,
+             "histogram {} count={} min={} p50={} p90={} p99={} p999={} max={} mean={:.1f}",
+             name,
+             snapshot.Count(),
+             snapshot.Min(),
+             snapshot.Percentile(50.0),
+             snapshot.Percentile(90.0),
+             snapshot.Percentile(99.0),
+             snapshot.Percentile(99.9),
+             snapshot.Max(),
+             snapshot.Mean());
+}
+
+template <typename Func>
+static void ForEachMetricLine(Func&& func)
+{
+    MetricRegistry& registry = GetMetricRegistry();
+    registry.lock.Lock();
+
+    String line;
+    for (NamedMetric<ShardedCounter> const& entry : registry.counters) {
+        line.Clear();
+        FormatTo(line, "counter {} {}", StringView(entry.name), entry.metric->Load());
+        func(line);
+    }
+
+    for (NamedMetric<Gauge> const& entry : registry.gauges) {
+        line.Clear();
+        FormatTo(line, "gauge {} {}", StringView(entry.name), entry.metric->Load());
+        func(line);
+    }
+
+    for (NamedMetric<Histogram> const& entry : registry.histograms) {
+        line.Clear();
+        AppendHistogram(line, entry.name, *entry.metric);
+        func(line);
+    }
+
+    registry.lock.Unlock();
+}
+
+ShardedCounter& Metrics::GetCounter(StringView name)
+{
+    MetricRegistry& registry = GetMetricRegistry();
+    registry.lock.Lock();
+
+    ASSERT(!ContainsMetric(registry.gauges, name) && !ContainsMetric(registry.histograms, name),
+           "metric is already registered as another kind");
+    ShardedCounter& counter = FindOrCreateMetric(registry.counters, name);
+
+    registry.lock.Unlock();
+    return counter;
+}
+
+Gauge& Metrics::GetGauge(StringView name)
+{
+    MetricRegistry& registry = GetMetricRegistry();
+    registry.lock.Lock();
+
+    ASSERT(!ContainsMetric(registry.counters, name) && !ContainsMetric(registry.histograms, name),
+           "metric is already registered as another kind");
+    Gauge& gauge = FindOrCreateMetric(registry.gauges, name);
+
+    registry.lock.Unlock();
+    return gauge;
+}
+
+Histogram& Metrics::GetHistogram(StringView name)
+{
+    MetricRegistry& registry = GetMetricRegistry();
+    registry.lock.Lock();
+
+    ASSERT(!ContainsMetric(registry.counters, name) && !ContainsMetric(registry.gauges, name),
+           "metric is already registered as another kind");
+    Histogram& histogram = FindOrCreateMetric(registry.histograms, name);
+
+    registry.lock.Unlock();
+    return histogram;
+}
+
+void Metrics::Snapshot(String& out)
+{
+    ForEachMetricLine([&out](String const& line) {
+        out.Append(line);
+        out.Push('\n');
+    });
+}
+
+void Metrics::Log()
+{
+    static Logger logger("Metrics");
+    ForEachMetricLine([](String const& line) { logger.Info("{}", StringView(line)); });
+}
+
+bool Metrics::WriteToFile(StringView path)
+{
+    String snapshot;
+    Snapshot(snapshot);
+
+    FileOpenOptions options;
+    options.write = true;
+    options.create = true;
+
+    AsyncFile file;
+    return file.Open(path, options) &&
+           file.WriteAt(0, snapshot.Data(), snapshot.Size()) == static_cast<int64>(snapshot.Size());
+}
+
+} // namespace mini
\ No newline at end of file
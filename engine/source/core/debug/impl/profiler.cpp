@@ -0,0 +1,259 @@
+module mini.core;
+
+import :type;
+import :memory_operation;
+import :allocator;
+import :array;
+import :string_view;
+import :string;
+import :format;
+import :atomic_base;
+import :atomic;
+import :mutex;
+import :thread;
+import :thread_platform;
+import :duration;
+import :cycle_clock;
+import :async_file;
+import :profiler;
+
+namespace mini {
+
+struct ProfileRecord {
+    char const* name;
+    uint64 begin;
+    uint64 end;
+};
+
+// Written by its owner only. head counts every zone ever recorded, the slot of a zone is its count modulo
+// the capacity, so the newest bufferCapacity zones are the ones still around.
+struct ProfileBuffer {
+public:
+    Atomic<uint64> head;
+    ProfileRecord* records;
+    ProfileBuffer* next;
+    uint64 thread;
+    char name[threadNameSize];
+};
+
+struct ProfilerState {
+    Atomic<ProfileBuffer*> buffers;
+    Atomic<uint64> clearedAt;
+    Atomic<bool> enabled;
+    Mutex nameLock;
+
+    ProfilerState()
+        : buffers(nullptr)
+        , clearedAt(0)
+        , enabled(true)
+        , nameLock()
+    {
+    }
+};
+
+static constexpr uint64 profileMask = Profiler::bufferCapacity - 1;
+
+static thread_local ProfileBuffer* profileBuffer = nullptr;
+
+static ProfilerState& GetProfilerState()
+{
+    static ProfilerState state;
+    return state;
+}
+
+static ProfileBuffer* CreateProfileBuffer()
+{
+    // buffers are never freed, zones of exited threads stay readable until the process ends
+    ProfileBuffer* buffer = Allocator<ProfileBuffer>().Allocate(1).pointer;
+    memory::ConstructAt(buffer);
+
+    buffer->head.Store(0, MemoryOrder::relaxed);
+    buffer->records = Allocator<ProfileRecord>().Allocate(Profiler::bufferCapacity).pointer;
+    buffer->thread = ThreadCurrentId();
+    if (!ThreadGetCurrentName(buffer->name, threadNameSize)) {
+        buffer->name[0] = '\0';
+    }
+
+    ProfilerState& state = GetProfilerState();
+    ProfileBuffer* head = state.buffers.Load(MemoryOrder::relaxed);
+    do {
+        buffer->next = head;
+    } while (!state.buffers.CompareExchangeWeak(head, buffer, MemoryOrder::release, MemoryOrder::relaxed));
+
+    profileBuffer = buffer;
+    return buffer;
+}
+
+static void CopyZones(ProfileBuffer const& buffer, uint64 clearedAt, Array<ProfileZone>& zones)
+{
+    uint64 head = buffer.head.Load(MemoryOrder::acquire);
+    uint64 first = head > Profiler::bufferCapacity ? head - Profiler::bufferCapacity : 0;
+    size_t offset = zones.Size();
+
+    for (uint64 i = first; i < head; ++i) {
+        ProfileRecord const& record = buffer.records[i & profileMask];
+        zones.Push(ProfileZone{ record.name, record.begin, record.end, buffer.thread });
+    }
+
+    // the owner kept writing during the copy, everything it may have overwritten since is dropped,
+    // including the slot of the zone it is in the middle of writing
+    Atomic<uint64>::ThreadFence(MemoryOrder::acquire);
+    uint64 last = buffer.head.Load(MemoryOrder::relaxed);
+    uint64 valid = last + 1 > Profiler::bufferCapacity ? last + 1 - Profiler::bufferCapacity : 0;
+
+    size_t count = offset;
+    for (size_t i = offset; i < zones.Size(); ++i) {
+        uint64 index = first + (i - offset);
+        if (index >= valid && zones[i].begin >= clearedAt) {
+            zones[count++] = zones[i];
+        }
+    }
+
+    while (zones.Size() > count) {
+        zones.RemoveLast();
+    }
+}
+
+static void AppendEscaped(String& out, char const* text)
+{
+    static constexpr char hex[] = "0123456789abcdef";
+
+    for (; *text != '\0'; ++text) {
+        char c = *text;
+        if (c == '"' || c == '\\') {
+            out.Push('\\');
+            out.Push(c);
+        } else if (static_cast<uint8>(c) < 0x20) {
+            out.Append(StringView("\\u00"));
+            out.Push(hex[static_cast<uint8>(c) >> 4]);
+            out.Push(hex[static_cast<uint8>(c) & 0xf]);
+        } else {
+            out.Push(c);
+        }
+    }
+}
+
+static void AppendMicroSeconds(String& out, uint64 cycles)
+{
+    // trace timestamps are in microseconds, printed with nanosecond precision
+    int64 nanoSeconds = CycleClock::ToDuration(cycles).Count();
+    FormatTo(out, "{}.{:03}", nanoSeconds / 1000, nanoSeconds % 1000);
+}
+
+void Profiler::Record(char const* name, uint64 begin, uint64 end) noexcept
+{
+    if (!GetProfilerState().enabled.Load(MemoryOrder::relaxed)) {
+        return;
+    }
+
+    ProfileBuffer* buffer = profileBuffer;
+    if (buffer == nullptr) [[unlikely]] {
+        buffer = CreateProfileBuffer();
+    }
+
+    uint64 head = buffer->head.Load(MemoryOrder::relaxed);
+    buffer->records[head & profileMask] = ProfileRecord{ name, begin, end };
+    buffer->head.Store(head + 1, MemoryOrder::release);
+}
+
+void Profiler::SetThreadName(StringView name) noexcept
+{
+    ProfileBuffer* buffer = profileBuffer;
+    if (buffer == nullptr) {
+        buffer = CreateProfileBuffer();
+    }
+
+    ProfilerState& state = GetProfilerState();
+    state.nameLock.Lock();
+    CopyThreadName(buffer->name, name);
+    state.nameLock.Unlock();
+}
+
+void Profiler::SetEnabled(bool enabled) noexcept
+{
+    GetProfilerState().enabled.Store(enabled, MemoryOrder::relaxed);
+}
+
+bool Profiler::Enabled() noexcept
+{
+    return GetProfilerState().enabled.Load(MemoryOrder::relaxed);
+}
+
+void Profiler::Clear() noexcept
+{
+    // buffers belong to their threads, zones begun before now are skipped by readers instead
+    GetProfilerState().clearedAt.Store(CycleClock::Cycles(), MemoryOrder::relaxed);
+}
+
+void Profiler::Collect(Array<ProfileZone>& zones)
+{
+    ProfilerState& state = GetProfilerState();
+    uint64 clearedAt = state.clearedAt.Load(MemoryOrder::relaxed);
+
+    for (ProfileBuffer* buffer = state.buffers.Load(MemoryOrder::acquire); buffer != nullptr;
+         buffer = buffer->next) {
+        CopyZones(*buffer, clearedAt, zones);
+    }
+}
+
+void Profiler::Export(String& out)
+{
+    ProfilerState& state = GetProfilerState();
+    Array<ProfileZone> zones;
+    Collect(zones);
+
+    // timestamps start at the earliest zone, which keeps them short and the trace readable
+    uint64 origin = ~uint64(0);
+    for (ProfileZone const& zone : zones) {
+        origin = zone.begin < origin ? zone.begin : origin;
+    }
+
+    out.Append(StringView("{\"traceEvents\":["));
+    bool first = true;
+
+    state.nameLock.Lock();
+    for (ProfileBuffer* buffer = state.buffers.Load(MemoryOrder::acquire); buffer != nullptr;
+         buffer = buffer->next) {
+        if (buffer->name[0] == '\0') {
+            continue;
+        }
+
+        out.Append(StringView(first ? "\n" : ",\n"));
+        FormatTo(out, "{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":{},\"args\":{{\"name\":\"",
+                 buffer->thread);
+        AppendEscaped(out, buffer->name);
+        out.Append(StringView("\"}}"));
+        first = false;
+    }
+    state.nameLock.Unlock();
+
+    for (ProfileZone const& zone : zones) {
+        out.Append(StringView(first ? "\n" : ",\n"));
+        out.Append(StringView("{\"name\":\""));
+        AppendEscaped(out, zone.name);
+        FormatTo(out, "\",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":0,\"tid\":{},\"ts\":", zone.thread);
+        AppendMicroSeconds(out, zone.begin - origin);
+        out.Append(StringView(",\"dur\":"));
+        AppendMicroSeconds(out, zone.end > zone.begin ? zone.end - zone.begin : 0);
+        out.Push('}');
+        first = false;
+    }
+
+    out.Append(StringView("\n],\"displayTimeUnit\":\"ns\"}\n"));
+}
+
+bool Profiler::ExportToFile(StringView path)
+{
+    String trace;
+    Export(trace);
+
+    FileOpenOptions options;
+    options.write = true;
+    options.create = true;
+
+    AsyncFile file;
+    return file.Open(path, options) &&
+           file.WriteAt(0, trace.Data(), trace.Size()) == static_cast<int64>(trace.Size());
+}
+
+} // namespace mini
\ No newline at end of file
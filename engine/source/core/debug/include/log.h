@@ -0,0 +1,21 @@
+#ifndef LOG_H
+#define LOG_H
+
+// Log calls checked against the compile time level before their arguments are evaluated.
+// They call the log functions of the module they are used in, which every module but the core has.
+#define LOG_ENABLED(level) ((level) >= LOG_MIN_LEVEL)
+
+#define LOG_IF_ENABLED(level, call)         \
+    do {                                    \
+        if constexpr (LOG_ENABLED(level)) { \
+            call;                           \
+        }                                   \
+    } while (false)
+
+#define LOG_DEBUG(...)   LOG_IF_ENABLED(0, LogDebug(__VA_ARGS__))
+#define LOG_INFO(...)    LOG_IF_ENABLED(1, LogInfo(__VA_ARGS__))
+#define LOG_WARNING(...) LOG_IF_ENABLED(2, LogWarning(__VA_ARGS__))
+#define LOG_ERROR(...)   LOG_IF_ENABLED(3, LogError(__VA_ARGS__))
+#define LOG_FATAL(...)   LogFatal(__VA_ARGS__)
+
+#endif // LOG_H
\ No newline at end of file
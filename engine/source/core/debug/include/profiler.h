@@ -0,0 +1,18 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#define PROFILE_CONCAT_IN(x, y) x##y
+#define PROFILE_CONCAT(x, y)    PROFILE_CONCAT_IN(x, y)
+
+#if NOPROFILE
+#  define PROFILE_SCOPE(name)  ((void)0)
+#  define PROFILE_FUNCTION()   ((void)0)
+#  define PROFILE_THREAD(name) ((void)0)
+#else
+// zone names are kept by pointer, they must be string literals or otherwise outlive the profiler
+#  define PROFILE_SCOPE(name)  mini::ProfileScope PROFILE_CONCAT(profile_, __COUNTER__)(name)
+#  define PROFILE_FUNCTION()   PROFILE_SCOPE(__func__)
+#  define PROFILE_THREAD(name) mini::Profiler::SetThreadName(name)
+#endif // NOPROFILE
+
+#endif // PROFILER_H
\ No newline at end of file
@@ -0,0 +1,277 @@
+export module mini.core:log_binary;
+
+import :type;
+import :memory_operation;
+import :source_location;
+import :array;
+import :string_view;
+import :string;
+import :mapped_file;
+
+namespace mini {
+
+// Type tag of a deferred log argument, recorded once per call site instead of with every message.
+export enum class LogArgType : uint8 {
+    signedInt,
+    unsignedInt,
+    floating,
+    boolean,
+    character,
+    pointer,
+    string,
+    floating32
+};
+
+// How an argument is copied into a deferred record and read back by the formatter.
+// Integers and doubles are widened to 64 bits, floats keep their 32 bits so they format as they would eagerly.
+// Strings are copied as a 32 bit length followed by their characters, so a record never refers to memory of
+// its producer.
+export template <typename T>
+struct LogArgTraits {};
+
+export template <typename T>
+concept LogArgT = requires { LogArgTraits<DecayT<T>>::type; };
+
+template <typename T>
+    requires SignedIntegralT<T> && (!CharT<T>)
+struct LogArgTraits<T> {
+    static constexpr LogArgType type = LogArgType::signedInt;
+    static constexpr size_t Size(T) noexcept { return sizeof(int64); }
+    static byte* Encode(byte*, T) noexcept;
+};
+
+template <typename T>
+    requires UnsignedIntegralT<T> && (!CharT<T>)
+struct LogArgTraits<T> {
+    static constexpr LogArgType type = LogArgType::unsignedInt;
+    static constexpr size_t Size(T) noexcept { return sizeof(uint64); }
+    static byte* Encode(byte*, T) noexcept;
+};
+
+template <>
+struct LogArgTraits<float32> {
+    static constexpr LogArgType type = LogArgType::floating32;
+    static constexpr size_t Size(float32) noexcept { return sizeof(float32); }
+    static byte* Encode(byte*, float32) noexcept;
+};
+
+template <FloatingT T>
+struct LogArgTraits<T> {
+    static constexpr LogArgType type = LogArgType::floating;
+    static constexpr size_t Size(T) noexcept { return sizeof(double); }
+    static byte* Encode(byte*, T) noexcept;
+};
+
+template <>
+struct LogArgTraits<bool> {
+    static constexpr LogArgType type = LogArgType::boolean;
+    static constexpr size_t Size(bool) noexcept { return 1; }
+    static byte* Encode(byte*, bool) noexcept;
+};
+
+template <>
+struct LogArgTraits<char> {
+    static constexpr LogArgType type = LogArgType::character;
+    static constexpr size_t Size(char) noexcept { return 1; }
+    static byte* Encode(byte*, char) noexcept;
+};
+
+template <typename T>
+    requires (!CharT<T>)
+struct LogArgTraits<T*> {
+    static constexpr LogArgType type = LogArgType::pointer;
+    static constexpr size_t Size(T const*) noexcept { return sizeof(uint64); }
+    static byte* Encode(byte*, T const*) noexcept;
+};
+
+template <>
+struct LogArgTraits<StringView> {
+    static constexpr LogArgType type = LogArgType::string;
+    static constexpr size_t Size(StringView value) noexcept { return sizeof(uint32) + value.Size(); }
+    static byte* Encode(byte*, StringView) noexcept;
+};
+
+template <>
+struct LogArgTraits<char const*> : LogArgTraits<StringView> {
+    static constexpr size_t Size(char const*) noexcept;
+    static byte* Encode(byte*, char const*) noexcept;
+};
+
+template <>
+struct LogArgTraits<char*> : LogArgTraits<char const*> {};
+
+template <>
+struct LogArgTraits<String> : LogArgTraits<StringView> {};
+
+// argument types of a site, padded by one entry so a site without arguments has an address as well
+export template <typename... Args>
+inline constexpr LogArgType logArgTypes[sizeof...(Args) + 1] = { LogArgTraits<Args>::type..., LogArgType() };
+
+// Static part of a deferred message, created the first time its call site logs and never freed.
+// The format has to be a string literal, records only carry the id of their site.
+export struct LogSite {
+    StringView format;
+    SourceLocation location;
+    LogArgType const* argTypes;
+    uint32 argCount;
+    uint32 id;
+};
+
+// Lock free table of every call site that logged deferred so far, keyed by its source location.
+// Sites of the same location that differ in their argument types, such as in templates, get a site each.
+// Find returns null once capacity sites are registered, the caller formats right away then.
+export class CORE_API LogSiteTable {
+public:
+    static constexpr uint32 capacity = 4096;
+
+    static LogSite const* Find(SourceLocation const&, StringView, LogArgType const*, uint32);
+    static uint32 Count() noexcept;
+};
+
+// Reads a file written by BinaryLogSink back into the lines a StreamLogSink would have written.
+// The file has to be decoded on a machine with the same byte order as the one that wrote it.
+export class CORE_API BinaryLogReader {
+private:
+    struct Site {
+        String format;
+        String file;
+        uint32 line;
+        Array<LogArgType> argTypes;
+    };
+
+    MappedFile m_file;
+    Array<String> m_categories;
+    Array<Site> m_sites;
+    size_t m_offset;
+    bool m_corrupted;
+
+public:
+    static constexpr char magic[4] = { 'M', 'L', 'O', 'G' };
+    static constexpr uint32 version = 2;
+
+    BinaryLogReader() noexcept;
+
+    bool Open(StringView);
+    bool Next(String&);
+
+    bool Corrupted() const noexcept;
+
+private:
+    bool Read(void*, size_t) noexcept;
+    bool ReadString(String&);
+};
+
+template <TrivialT T>
+inline byte* WriteLogArg(byte* data, T const& value) noexcept
+{
+    memory::MemCopy(data, reinterpret_cast<byte const*>(&value), sizeof(T));
+    return data + sizeof(T);
+}
+
+template <LogArgT... Args>
+inline constexpr size_t LogArgsSize(Args const&... args) noexcept
+{
+    return (LogArgTraits<DecayT<Args>>::Size(args) + ... + 0);
+}
+
+template <LogArgT... Args>
+inline byte* EncodeLogArgs(byte* data, Args const&... args) noexcept
+{
+    ((data = LogArgTraits<DecayT<Args>>::Encode(data, args)), ...);
+    return data;
+}
+
+// call sites are told apart by location, file names by address since every site refers to the same literal
+inline uint32 LogLocationHash(SourceLocation const& location) noexcept
+{
+    uint64 hash = static_cast<uint64>(reinterpret_cast<size_t>(location.file_name()));
+    hash ^= (static_cast<uint64>(location.line()) << 32) | location.column();
+    hash *= 0x9e37'79b9'7f4a'7c15ull;
+    return static_cast<uint32>(hash >> 32);
+}
+
+inline bool SameLogLocation(SourceLocation const& left, SourceLocation const& right) noexcept
+{
+    return left.line() == right.line() && left.column() == right.column() && left.file_name() == right.file_name();
+}
+
+// formats the encoded arguments the way FormatTo would have formatted the originals
+void FormatLogArgs(String&, StringView, LogArgType const*, uint32, byte const*, size_t);
+
+// one line of the text sinks, time in nanoseconds of the cycle clock
+void AppendLogLine(String&, int64, StringView, byte, StringView);
+
+template <typename T>
+    requires SignedIntegralT<T> && (!CharT<T>)
+inline byte* LogArgTraits<T>::Encode(byte* data, T value) noexcept
+{
+    return WriteLogArg(data, static_cast<int64>(value));
+}
+
+template <typename T>
+    requires UnsignedIntegralT<T> && (!CharT<T>)
+inline byte* LogArgTraits<T>::Encode(byte* data, T value) noexcept
+{
+    return WriteLogArg(data, static_cast<uint64>(value));
+}
+
+inline byte* LogArgTraits<float32>::Encode(byte* data, float32 value) noexcept
+{
+    return WriteLogArg(data, value);
+}
+
+template <FloatingT T>
+inline byte* LogArgTraits<T>::Encode(byte* data, T value) noexcept
+{
+    return WriteLogArg(data, static_cast<double>(value));
+}
+
+inline byte* LogArgTraits<bool>::Encode(byte* data, bool value) noexcept
+{
+    return WriteLogArg(data, static_cast<byte>(value ? 1 : 0));
+}
+
+inline byte* LogArgTraits<char>::Encode(byte* data, char value) noexcept
+{
+    return WriteLogArg(data, static_cast<byte>(value));
+}
+
+template <typename T>
+    requires (!CharT<T>)
+inline byte* LogArgTraits<T*>::Encode(byte* data, T const* value) noexcept
+{
+    return WriteLogArg(data, static_cast<uint64>(reinterpret_cast<size_t>(value)));
+}
+
+inline byte* LogArgTraits<StringView>::Encode(byte* data, StringView value) noexcept
+{
+    data = WriteLogArg(data, static_cast<uint32>(value.Size()));
+    memory::MemCopy(reinterpret_cast<char*>(data), value.Data(), value.Size());
+    return data + value.Size();
+}
+
+inline constexpr size_t LogArgTraits<char const*>::Size(char const* value) noexcept
+{
+    return LogArgTraits<StringView>::Size(value != nullptr ? StringView(value) : StringView());
+}
+
+inline byte* LogArgTraits<char const*>::Encode(byte* data, char const* value) noexcept
+{
+    return LogArgTraits<StringView>::Encode(data, value != nullptr ? StringView(value) : StringView());
+}
+
+inline BinaryLogReader::BinaryLogReader() noexcept
+    : m_file()
+    , m_categories()
+    , m_sites()
+    , m_offset(0)
+    , m_corrupted(false)
+{
+}
+
+inline bool BinaryLogReader::Corrupted() const noexcept
+{
+    return m_corrupted;
+}
+
+} // namespace mini
\ No newline at end of file
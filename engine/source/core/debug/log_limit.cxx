@@ -0,0 +1,25 @@
+export module mini.core:log_limit;
+
+import :type;
+import :source_location;
+import :atomic_base;
+import :atomic;
+
+namespace mini {
+
+// Token bucket per call site, shared by every logger.
+// A site may log burst messages at once and rate messages per second after that, anything above is dropped
+// and counted. Acquire hands the count to the next message of the site that passes, which reports it.
+// Sites are keyed by source location, once capacity sites are tracked any further site is not limited.
+// Limiting is off until Configure is called with a non zero rate.
+export class CORE_API LogRateLimit {
+public:
+    static constexpr uint32 capacity = 4096;
+
+    static void Configure(uint32, uint32);
+    static bool Enabled() noexcept;
+
+    static bool Acquire(SourceLocation const&, uint32&);
+};
+
+} // namespace mini
\ No newline at end of file
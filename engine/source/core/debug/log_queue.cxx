@@ -0,0 +1,459 @@
+export module mini.core:log_queue;
+
+import :type;
+import :utility_operation;
+import :memory_operation;
+import :allocator;
+import :source_location;
+import :unique_ptr;
+import :array;
+import :string_view;
+import :string;
+import :format;
+import :atomic_base;
+import :atomic;
+import :mutex;
+import :thread;
+import :mpmc_queue;
+import :time_point;
+import :cycle_clock;
+import :async_file;
+import :logger_platform;
+import :log_binary;
+
+namespace mini {
+
+// What a producer does when the queue is full.
+// drop discards the message and counts it, block waits for the sink to make room,
+// grow moves the message to an unbounded side list, which the sink merges back in by the time of the messages.
+export enum class LogOverflow : uint8 {
+    drop,
+    block,
+    grow
+};
+
+// Message formatted by its producer, together with everything a sink needs to write it later.
+// Text up to inlineSize bytes is stored in the record itself, only longer messages allocate.
+// A deferred record holds the encoded arguments of its site instead, and is formatted by Materialize.
+export class CORE_API LogRecord {
+public:
+    enum class Kind : uint8 {
+        message,
+        deferred,
+        wake,
+        flush,
+        stop
+    };
+
+    static constexpr size_t inlineSize = 192;
+
+private:
+    LoggerBase* m_logger;
+    LogSite const* m_site;
+    Atomic<uint32>* m_signal;
+    char* m_heap;
+    CycleClock::TimePoint m_time;
+    SourceLocation m_location;
+    uint32 m_size;
+    byte m_level;
+    Kind m_kind;
+    char m_text[inlineSize];
+
+public:
+    LogRecord() noexcept;
+    LogRecord(Kind, Atomic<uint32>* = nullptr) noexcept;
+    template <typename... Args>
+    LogRecord(LoggerBase*, byte, SourceLocation const&, StringView, Args&&...);
+    template <LogArgT... Args>
+    LogRecord(LoggerBase*, byte, LogSite const*, Args const&...);
+    LogRecord(LogRecord&&) noexcept;
+    ~LogRecord();
+
+    LoggerBase* Source() const noexcept { return m_logger; }
+    LogSite const* Site() const noexcept { return m_site; }
+    CycleClock::TimePoint Time() const noexcept { return m_time; }
+    SourceLocation const& Location() const noexcept { return m_location; }
+    byte Level() const noexcept { return m_level; }
+    Kind GetKind() const noexcept { return m_kind; }
+    Atomic<uint32>* Signal() const noexcept { return m_signal; }
+    StringView Message() const noexcept;
+    byte const* Payload() const noexcept;
+    size_t PayloadSize() const noexcept;
+
+    void Materialize();
+
+    LogRecord& operator=(LogRecord&&) noexcept;
+
+private:
+    char* Reserve(size_t);
+    void Release() noexcept;
+
+    LogRecord(LogRecord const&) = delete;
+    LogRecord& operator=(LogRecord const&) = delete;
+};
+
+// Destination of the records drained by the sink thread, only ever called from that thread.
+// Deferred records are materialized before they are written, unless the sink accepts them as they are.
+export class CORE_API LogSink {
+public:
+    virtual ~LogSink() = default;
+
+    virtual void Write(LogRecord const&) = 0;
+    virtual void Flush() {}
+    virtual bool AcceptsDeferred() const noexcept { return false; }
+};
+
+// Hands records to the platform logger of their category, as the synchronous path does.
+export class CORE_API PlatformLogSink final : public LogSink {
+public:
+    void Write(LogRecord const&) final;
+    void Flush() final;
+};
+
+// Writes one line per record to stderr, prefixed with the monotonic time, category and level.
+export class CORE_API StreamLogSink final : public LogSink {
+public:
+    void Write(LogRecord const&) final;
+    void Flush() final;
+};
+
+// Writes the same lines as StreamLogSink into a file, which is truncated on open.
+export class CORE_API FileLogSink final : public LogSink {
+private:
+    AsyncFile m_file;
+    uint64 m_offset;
+    String m_line;
+
+public:
+    FileLogSink() noexcept;
+
+    bool Open(StringView);
+
+    void Write(LogRecord const&) final;
+    void Flush() final;
+};
+
+// Writes records into a file without formatting them, BinaryLogReader turns the file back into text.
+// Sites and categories are written the first time a record refers to them, records carry their ids only.
+export class CORE_API BinaryLogSink final : public LogSink {
+private:
+    AsyncFile m_file;
+    uint64 m_offset;
+    String m_buffer;
+    Array<uint32> m_sites;
+    uint32 m_siteCount;
+    Array<LoggerBase*> m_categories;
+
+public:
+    BinaryLogSink() noexcept;
+
+    bool Open(StringView);
+
+    void Write(LogRecord const&) final;
+    void Flush() final;
+    bool AcceptsDeferred() const noexcept final { return true; }
+
+private:
+    template <TrivialT T>
+    void Append(T const&);
+    void AppendBytes(void const*, size_t);
+    uint32 CategoryId(LoggerBase*);
+    uint32 SiteId(LogSite const*);
+};
+
+// Queue moving log messages off the threads producing them.
+// Producers format into a record of a bounded multi producer queue and return, a dedicated sink thread
+// drains the records into a LogSink in the order they were queued. Messages spilled by the grow policy are
+// written before the first queued message younger than them, so a full queue does not reorder the log.
+// Once started, every Logger goes through the queue until Stop, which writes out everything still queued.
+// Loggers have to outlive the queue, and no thread may log while Stop runs.
+// A deferred queue takes messages with a literal format and arguments of LogArgT through PushDeferred,
+// which only copies the arguments, the sink thread formats them or hands them to a binary sink as they are.
+export class CORE_API LogQueue {
+public:
+    static constexpr size_t capacity = 4096;
+
+private:
+    MpmcQueue<LogRecord, capacity> m_queue;
+    UniquePtr<LogSink> m_sink;
+    LogOverflow m_overflow;
+    bool m_deferred;
+    Atomic<uint64> m_dropped;
+
+    Mutex m_spillLock;
+    Array<LogRecord> m_spill;
+    Atomic<bool> m_spilled;
+    Array<LogRecord> m_pending;
+    size_t m_pendingIndex;
+
+    Thread m_thread;
+
+public:
+    LogQueue(UniquePtr<LogSink>, LogOverflow, bool = true);
+    ~LogQueue();
+
+    template <typename... Args>
+    void Push(LoggerBase*, byte, SourceLocation const&, StringView, Args&&...);
+    template <LogArgT... Args>
+    void PushDeferred(LoggerBase*, byte, SourceLocation const&, StringView, Args const&...);
+    void Flush();
+
+    uint64 Dropped() const noexcept;
+    LogOverflow Overflow() const noexcept;
+    bool Deferred() const noexcept;
+
+    static bool Start(UniquePtr<LogSink> = UniquePtr<LogSink>(), LogOverflow = LogOverflow::drop, bool = true);
+    static void Stop();
+    static LogQueue* Current() noexcept;
+
+private:
+    template <typename... Args>
+    void Emplace(Args&&...);
+
+    void Run();
+    void Deliver(LogRecord&);
+    void CollectSpill();
+    void DeliverSpill(CycleClock::TimePoint);
+    bool DrainSpill();
+
+    LogQueue(LogQueue const&) = delete;
+    LogQueue& operator=(LogQueue const&) = delete;
+};
+
+inline LogRecord::LogRecord() noexcept
+    : LogRecord(Kind::wake)
+{
+}
+
+inline LogRecord::LogRecord(Kind kind, Atomic<uint32>* signal) noexcept
+    : m_logger(nullptr)
+    , m_site(nullptr)
+    , m_signal(signal)
+    , m_heap(nullptr)
+    , m_time()
+    , m_location()
+    , m_size(0)
+    , m_level(0)
+    , m_kind(kind)
+{
+    m_text[0] = '\0';
+}
+
+template <typename... Args>
+inline LogRecord::LogRecord(LoggerBase* logger,
+                            byte level,
+                            SourceLocation const& location,
+                            StringView format,
+                            Args&&... args)
+    : m_logger(logger)
+    , m_site(nullptr)
+    , m_signal(nullptr)
+    , m_heap(nullptr)
+    , m_time(CycleClock::Now())
+    , m_location(location)
+    , m_size(0)
+    , m_level(level)
+    , m_kind(Kind::message)
+{
+    if constexpr (sizeof...(args) == 0) {
+        char* text = Reserve(format.Size());
+        memory::MemCopy(text, format.Data(), format.Size());
+        return;
+    } else {
+        auto fmtMsg = fmt::string_view(format.Data(), format.Size());
+
+        try {
+            // formatted straight into the record, only a message longer than the inline buffer is formatted twice
+            auto result = fmt::vformat_to_n(m_text, inlineSize - 1, fmtMsg, fmt::make_format_args(args...));
+            if (result.size < inlineSize) {
+                m_size = static_cast<uint32>(result.size);
+                m_text[m_size] = '\0';
+                return;
+            }
+
+            char* text = Reserve(result.size);
+            fmt::vformat_to(text, fmtMsg, fmt::make_format_args(args...));
+        } catch (fmt::format_error const& error) {
+            String message;
+            WriteFormatError(message, format, error);
+
+            Release();
+            char* text = Reserve(message.Size());
+            memory::MemCopy(text, message.Data(), message.Size());
+        }
+    }
+}
+
+template <LogArgT... Args>
+inline LogRecord::LogRecord(LoggerBase* logger, byte level, LogSite const* site, Args const&... args)
+    : m_logger(logger)
+    , m_site(site)
+    , m_signal(nullptr)
+    , m_heap(nullptr)
+    , m_time(CycleClock::Now())
+    , m_location(site->location)
+    , m_size(0)
+    , m_level(level)
+    , m_kind(Kind::deferred)
+{
+    char* payload = Reserve(LogArgsSize(args...));
+    EncodeLogArgs(reinterpret_cast<byte*>(payload), args...);
+}
+
+inline LogRecord::LogRecord(LogRecord&& other) noexcept
+    : m_logger(other.m_logger)
+    , m_site(other.m_site)
+    , m_signal(other.m_signal)
+    , m_heap(other.m_heap)
+    , m_time(other.m_time)
+    , m_location(other.m_location)
+    , m_size(other.m_size)
+    , m_level(other.m_level)
+    , m_kind(other.m_kind)
+{
+    if (m_heap == nullptr) {
+        memory::MemCopy(m_text, other.m_text, m_size + 1);
+    }
+
+    other.m_heap = nullptr;
+    other.m_size = 0;
+}
+
+inline LogRecord::~LogRecord()
+{
+    Release();
+}
+
+inline StringView LogRecord::Message() const noexcept
+{
+    return StringView(m_heap != nullptr ? m_heap : m_text, m_size);
+}
+
+inline byte const* LogRecord::Payload() const noexcept
+{
+    return reinterpret_cast<byte const*>(m_heap != nullptr ? m_heap : m_text);
+}
+
+inline size_t LogRecord::PayloadSize() const noexcept
+{
+    return m_size;
+}
+
+inline LogRecord& LogRecord::operator=(LogRecord&& other) noexcept
+{
+    Release();
+
+    m_logger = other.m_logger;
+    m_site = other.m_site;
+    m_signal = other.m_signal;
+    m_heap = other.m_heap;
+    m_time = other.m_time;
+    m_location = other.m_location;
+    m_size = other.m_size;
+    m_level = other.m_level;
+    m_kind = other.m_kind;
+
+    if (m_heap == nullptr) {
+        memory::MemCopy(m_text, other.m_text, m_size + 1);
+    }
+
+    other.m_heap = nullptr;
+    other.m_size = 0;
+    return *this;
+}
+
+inline char* LogRecord::Reserve(size_t size)
+{
+    // messages are always null terminated, platform loggers take them as c strings
+    char* text = size < inlineSize ? m_text : Allocator<char>().Allocate(size + 1).pointer;
+    m_heap = text != m_text ? text : nullptr;
+    m_size = static_cast<uint32>(size);
+    text[size] = '\0';
+    return text;
+}
+
+inline void LogRecord::Release() noexcept
+{
+    if (m_heap != nullptr) {
+        Allocator<char>().Deallocate(m_heap, m_size + 1);
+        m_heap = nullptr;
+    }
+}
+
+template <typename... Args>
+inline void LogQueue::Push(LoggerBase* logger,
+                           byte level,
+                           SourceLocation const& location,
+                           StringView format,
+                           Args&&... args)
+{
+    Emplace(logger, level, location, format, args...);
+}
+
+template <LogArgT... Args>
+inline void LogQueue::PushDeferred(LoggerBase* logger,
+                                   byte level,
+                                   SourceLocation const& location,
+                                   StringView format,
+                                   Args const&... args)
+{
+    LogSite const* site = LogSiteTable::Find(location, format, logArgTypes<DecayT<Args>...>, sizeof...(Args));
+    if (site == nullptr) [[unlikely]] {
+        Emplace(logger, level, location, format, args...);
+        return;
+    }
+
+    Emplace(logger, level, site, args...);
+}
+
+template <typename... Args>
+inline void LogQueue::Emplace(Args&&... args)
+{
+    if (m_queue.TryEnqueue(args...)) [[likely]] {
+        return;
+    }
+
+    switch (m_overflow) {
+        case LogOverflow::drop:
+            m_dropped.FetchAdd(1, MemoryOrder::relaxed);
+            break;
+
+        case LogOverflow::block:
+            m_queue.Enqueue(args...);
+            break;
+
+        case LogOverflow::grow:
+            m_spillLock.Lock();
+            m_spill.Push(args...);
+            m_spilled.Store(true, MemoryOrder::relaxed);
+            m_spillLock.Unlock();
+
+            // a sink sleeping on an empty queue would not notice the spill otherwise,
+            // and when the queue is full again it is awake anyway
+            m_queue.TryEnqueue(LogRecord::Kind::wake);
+            break;
+    }
+}
+
+inline uint64 LogQueue::Dropped() const noexcept
+{
+    return m_dropped.Load(MemoryOrder::relaxed);
+}
+
+inline LogOverflow LogQueue::Overflow() const noexcept
+{
+    return m_overflow;
+}
+
+inline bool LogQueue::Deferred() const noexcept
+{
+    return m_deferred;
+}
+
+template <TrivialT T>
+inline void BinaryLogSink::Append(T const& value)
+{
+    AppendBytes(&value, sizeof(T));
+}
+
+} // namespace mini
\ No newline at end of file
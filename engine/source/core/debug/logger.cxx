@@ -4,29 +4,51 @@ import :type;
 import :utility_operation;
 import :source_location;
 import :string;
+import :atomic_base;
+import :atomic;
 import :logger_platform;
+import :log_binary;
+import :log_limit;
+import :log_queue;
 
 namespace mini {
 
+// Logger of one category.
+// Levels below minLevel are removed at compile time, the LOG_ macros of log.h also skip evaluating their
+// arguments. Above that every logger filters by its own level, which SetCategoryLevel sets by category name
+// for loggers created later as well. Once LogRateLimit is configured, every call site is rate limited on top,
+// except for fatal messages.
 export class CORE_API Logger final : public LoggerBase {
 public:
     enum class Level {
+        debug = 0,
         info = 1,
         warn = 2,
         error = 3,
         fatal = 4,
     };
 
+    // literal is set for a message given as a constant character array, which is taken for a string literal,
+    // a mutable array is a buffer of the caller whose text may change between two messages of the same site
     struct MessageContext {
         StringView const message;
         SourceLocation const location;
+        bool const literal;
 
         template <StringLikeT<char> T>
         MessageContext(T const&, SourceLocation = SourceLocation::current());
+        template <size_t N>
+        MessageContext(char (&)[N], SourceLocation = SourceLocation::current());
     };
 
+    static constexpr Level minLevel = static_cast<Level>(LOG_MIN_LEVEL);
+
+private:
+    Atomic<byte> m_level;
+
 public:
     Logger(StringView);
+    ~Logger();
 
     template <typename... Args>
     void Log(Level, MessageContext, Args&&...);
@@ -45,57 +67,90 @@ public:
 
     template <typename... Args>
     void Fatal(MessageContext, Args&&...);
+
+    void SetLevel(Level) noexcept;
+    Level GetLevel() const noexcept;
+    bool Enabled(Level) const noexcept;
+
+    static void SetCategoryLevel(StringView, Level);
+
+private:
+    template <typename... Args>
+    void Emit(Level, MessageContext const&, Args&&...);
+
+    Logger(Logger const&) = delete;
+    Logger& operator=(Logger const&) = delete;
 };
 
 template <StringLikeT<char> T>
 Logger::MessageContext::MessageContext(T const& msg, SourceLocation loc)
     : message(msg)
     , location(loc)
+    , literal(ArrT<T>)
 {
 }
 
-Logger::Logger(StringView category)
-    : LoggerBase(category)
+template <size_t N>
+Logger::MessageContext::MessageContext(char (&msg)[N], SourceLocation loc)
+    : message(static_cast<char const*>(msg))
+    , location(loc)
+    , literal(false)
 {
 }
 
 template <typename... Args>
 inline void Logger::Log(Level level, MessageContext context, Args&&... args)
 {
-    String log;
-    if constexpr (sizeof...(args) == 0) {
-        log.Append(context.message);
-    } else {
-        FormatTo(log, context.message, ForwardArg<Args>(args)...);
+    if (!Enabled(level)) {
+        return;
     }
 
-    LoggerBase::PrintMessage(static_cast<byte>(level), log);
+    // a fatal message is never dropped, whatever its site logged before
+    if (level != Level::fatal && LogRateLimit::Enabled()) {
+        uint32 suppressed = 0;
+        if (!LogRateLimit::Acquire(context.location, suppressed)) {
+            return;
+        }
+
+        if (suppressed != 0) [[unlikely]] {
+            // not a literal, the summary shares the location of the site but not its deferred format
+            Emit(level, MessageContext(StringView("{} messages suppressed"), context.location), suppressed);
+        }
+    }
+
+    Emit(level, context, ForwardArg<Args>(args)...);
 }
 
 template <typename... Args>
 inline void Logger::Debug([[maybe_unused]] MessageContext context, [[maybe_unused]] Args&&... args)
 {
-#if DEBUG
-    Log(Level(0), context, ForwardArg<Args>(args)...);
-#endif
+    if constexpr (Level::debug >= minLevel) {
+        Log(Level::debug, context, ForwardArg<Args>(args)...);
+    }
 }
 
 template <typename... Args>
-inline void Logger::Info(MessageContext context, Args&&... args)
+inline void Logger::Info([[maybe_unused]] MessageContext context, [[maybe_unused]] Args&&... args)
 {
-    Log(Level::info, context, ForwardArg<Args>(args)...);
+    if constexpr (Level::info >= minLevel) {
+        Log(Level::info, context, ForwardArg<Args>(args)...);
+    }
 }
 
 template <typename... Args>
-inline void Logger::Warn(MessageContext context, Args&&... args)
+inline void Logger::Warn([[maybe_unused]] MessageContext context, [[maybe_unused]] Args&&... args)
 {
-    Log(Level::warn, context, ForwardArg<Args>(args)...);
+    if constexpr (Level::warn >= minLevel) {
+        Log(Level::warn, context, ForwardArg<Args>(args)...);
+    }
 }
 
 template <typename... Args>
-inline void Logger::Error(MessageContext context, Args&&... args)
+inline void Logger::Error([[maybe_unused]] MessageContext context, [[maybe_unused]] Args&&... args)
 {
-    Log(Level::error, context, ForwardArg<Args>(args)...);
+    if constexpr (Level::error >= minLevel) {
+        Log(Level::error, context, ForwardArg<Args>(args)...);
+    }
 }
 
 template <typename... Args>
@@ -104,4 +159,60 @@ inline void Logger::Fatal(MessageContext context, Args&&... args)
     Log(Level::fatal, context, ForwardArg<Args>(args)...);
 }
 
+inline void Logger::SetLevel(Level level) noexcept
+{
+    m_level.Store(static_cast<byte>(level), MemoryOrder::relaxed);
+}
+
+inline Logger::Level Logger::GetLevel() const noexcept
+{
+    return static_cast<Level>(m_level.Load(MemoryOrder::relaxed));
+}
+
+inline bool Logger::Enabled(Level level) const noexcept
+{
+    return level >= minLevel && static_cast<byte>(level) >= m_level.Load(MemoryOrder::relaxed);
+}
+
+template <typename... Args>
+inline void Logger::Emit(Level level, MessageContext const& context, Args&&... args)
+{
+    if (LogQueue* queue = LogQueue::Current(); queue != nullptr) {
+        byte rawLevel = static_cast<byte>(level);
+
+        // only a literal lives long enough to be formatted later, anything else is formatted right here
+        if constexpr ((LogArgT<Args> && ...)) {
+            if (context.literal && queue->Deferred()) {
+                queue->PushDeferred(this, rawLevel, context.location, context.message, args...);
+            } else {
+                queue->Push(this, rawLevel, context.location, context.message, ForwardArg<Args>(args)...);
+            }
+        } else {
+            queue->Push(this, rawLevel, context.location, context.message, ForwardArg<Args>(args)...);
+        }
+
+        // the process is likely about to go down, which must not take the message with it
+        if (level == Level::fatal) {
+            queue->Flush();
+        }
+
+        return;
+    }
+
+    String log;
+    if constexpr (sizeof...(args) == 0) {
+        log.Append(context.message);
+    } else {
+        FormatTo(log, context.message, ForwardArg<Args>(args)...);
+    }
+
+    LoggerBase::PrintMessage(static_cast<byte>(level), log);
+
+    // other lines wait at most the delay of the writer, an error is written at once so a crash right after it still
+    // leaves its cause behind
+    if (level >= Level::error) {
+        LoggerBase::FlushMessages();
+    }
+}
+
 } // namespace mini
@@ -0,0 +1,122 @@
+export module mini.core:logger_platform;
+
+import :type;
+import :unique_ptr;
+import :string_view;
+import :string;
+import :duration;
+import :clock;
+import :file_platform;
+
+namespace mini {
+
+// Destination of LoggerBase on linux, replaced through LoggerBase::SetWriter.
+// Writes may be buffered until Flush, which the synchronous path of Logger calls after errors and fatal
+// messages, the log queue once it ran dry, and LoggerBase::FlushMessages on request, on the engine timer and at
+// exit.
+// Calls are serialized by LoggerBase.
+export class CORE_API PlatformLogWriter {
+public:
+    virtual ~PlatformLogWriter() = default;
+
+    virtual void Write(byte, StringView, StringView) = 0;
+    virtual void Flush() {}
+};
+
+// Writes "[category] [level] message" lines to stderr, which is the default writer.
+// Lines are gathered in a buffer, a message that does not fit is written along with the buffer by a single
+// writev instead of being copied. The buffer is written once its oldest line is maxDelay old, which bounds the
+// delay while lines keep coming, the engine flushes on a timer of the same interval for the idle case.
+// A terminal gets every line as it is written.
+export class CORE_API StderrLogWriter final : public PlatformLogWriter {
+public:
+    static constexpr size_t bufferSize = 64 * 1024;
+    static constexpr MilliSeconds maxDelay = MilliSeconds(100);
+
+private:
+    String m_buffer;
+    CoarseClock::TimePoint m_oldest;
+    bool m_interactive;
+
+public:
+    StderrLogWriter();
+    ~StderrLogWriter() final;
+
+    void Write(byte, StringView, StringView) final;
+    void Flush() final;
+};
+
+// Sends every message to journald with its native protocol, the level as PRIORITY and the category as
+// MINI_CATEGORY field. Without a journal socket messages go to stderr with the syslog priority prefix
+// "<n>", which journald parses from the output of the services it runs.
+export class CORE_API JournalLogWriter final : public PlatformLogWriter {
+private:
+    int32 m_socket;
+
+public:
+    JournalLogWriter();
+    ~JournalLogWriter() final;
+
+    bool Connected() const noexcept;
+
+    void Write(byte, StringView, StringView) final;
+};
+
+// Writes lines into a file mapped as a whole, a write is a copy into the page cache without a system call.
+// Once a file reaches maxSize it is trimmed to its contents and rotated, path becomes path.1, path.1 becomes
+// path.2 and so on, keeping at most backupCount old files. A file of a crashed process keeps the zeroed tail
+// of its mapping. The blocks of a file are allocated before it is mapped, when that fails, e.g. on a full disk,
+// lines go to stderr rather than faulting on a page with no block behind it.
+export class CORE_API RotatingFileLogWriter final : public PlatformLogWriter {
+private:
+    String m_path;
+    PlatformFile m_file;
+    char* m_data;
+    size_t m_size;
+    size_t m_used;
+    uint32 m_backupCount;
+
+public:
+    RotatingFileLogWriter() noexcept;
+    ~RotatingFileLogWriter() final;
+
+    bool Open(StringView, size_t, uint32);
+    void Close() noexcept;
+    bool IsOpen() const noexcept;
+
+    void Write(byte, StringView, StringView) final;
+    void Flush() final;
+
+private:
+    bool Map();
+    void Rotate();
+};
+
+class CORE_API LoggerBase {
+private:
+    String m_category;
+
+public:
+    // also called by the sink thread of the log queue, which prints on behalf of the logger
+    void PrintMessage(byte, StringView);
+    StringView Category() const noexcept { return m_category; }
+
+    static void FlushMessages();
+    static void SetWriter(UniquePtr<PlatformLogWriter>);
+
+protected:
+    LoggerBase(StringView);
+    ~LoggerBase() noexcept = default;
+};
+
+inline bool JournalLogWriter::Connected() const noexcept
+{
+    return m_socket >= 0;
+}
+
+inline bool RotatingFileLogWriter::IsOpen() const noexcept
+{
+    return m_data != nullptr;
+}
+
+} // namespace mini
\ No newline at end of file
@@ -17,12 +17,18 @@ private:
     String m_category;
     Logger m_logger;
 
+public:
+    // also called by the sink thread of the log queue, which prints on behalf of the logger
+    void PrintMessage(byte, StringView);
+    StringView Category() const noexcept { return m_category; }
+
+    // messages are handed to the system as they are printed
+    static void FlushMessages() {}
+
 protected:
     LoggerBase(StringView);
     ~LoggerBase();
 
-    void PrintMessage(byte, StringView);
-
 private:
     LogLevel GetLogType(byte);
 };
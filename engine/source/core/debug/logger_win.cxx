@@ -9,11 +9,17 @@ class CORE_API LoggerBase {
 private:
     String m_category;
 
+public:
+    // also called by the sink thread of the log queue, which prints on behalf of the logger
+    void PrintMessage(byte, StringView);
+    StringView Category() const noexcept { return m_category; }
+
+    // messages are handed to the system as they are printed
+    static void FlushMessages() {}
+
 protected:
     LoggerBase(StringView);
     ~LoggerBase() noexcept = default;
-
-    void PrintMessage(byte, StringView);
 };
 
 } // namespace mini
\ No newline at end of file
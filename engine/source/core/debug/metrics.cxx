@@ -0,0 +1,71 @@
+export module mini.core:metrics;
+
+import :type;
+import :string_view;
+import :string;
+import :atomic_base;
+import :atomic;
+import :sharded_counter;
+import :histogram;
+
+namespace mini {
+
+// Value set from anywhere and read as is, e.g. a queue depth or the number of loaded resources.
+export class Gauge {
+private:
+    Atomic<int64> m_value;
+
+public:
+    Gauge() noexcept;
+
+    void Set(int64) noexcept;
+    void Add(int64 = 1) noexcept;
+    void Sub(int64 = 1) noexcept;
+    int64 Load() const noexcept;
+
+private:
+    Gauge(Gauge const&) = delete;
+    Gauge& operator=(Gauge const&) = delete;
+};
+
+// Process wide registry of named counters, gauges and histograms.
+// Metrics are created on the first lookup of their name and live until the process ends, so callers keep
+// the returned reference instead of looking the name up on every update. A name belongs to a single kind.
+// Snapshot writes one line per metric, histograms report their count, min, p50, p90, p99, p999 and max.
+export class CORE_API Metrics {
+public:
+    static ShardedCounter& GetCounter(StringView);
+    static Gauge& GetGauge(StringView);
+    static Histogram& GetHistogram(StringView);
+
+    static void Snapshot(String&);
+    static void Log();
+    static bool WriteToFile(StringView);
+};
+
+inline Gauge::Gauge() noexcept
+    : m_value(0)
+{
+}
+
+inline void Gauge::Set(int64 value) noexcept
+{
+    m_value.Store(value, MemoryOrder::relaxed);
+}
+
+inline void Gauge::Add(int64 value) noexcept
+{
+    m_value.FetchAdd(value, MemoryOrder::relaxed);
+}
+
+inline void Gauge::Sub(int64 value) noexcept
+{
+    m_value.FetchSub(value, MemoryOrder::relaxed);
+}
+
+inline int64 Gauge::Load() const noexcept
+{
+    return m_value.Load(MemoryOrder::relaxed);
+}
+
+} // namespace mini
\ No newline at end of file
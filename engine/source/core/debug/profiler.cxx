@@ -0,0 +1,69 @@
+export module mini.core:profiler;
+
+import :type;
+import :array;
+import :string_view;
+import :string;
+import :cycle_clock;
+
+namespace mini {
+
+// Zone measured on a single thread, begin and end are raw counts of the CycleClock.
+export struct ProfileZone {
+public:
+    char const* name;
+    uint64 begin;
+    uint64 end;
+    uint64 thread;
+};
+
+// Instrumenting cpu profiler, recording zones into a ring buffer owned by each thread.
+// Recording never locks or allocates after the first zone of a thread, the owner is the only writer of its
+// buffer and the oldest zones are overwritten once it wraps. Buffers outlive their thread, so zones of
+// threads which already exited are still exported. Readers copy the buffers while they are written,
+// zones overwritten during the copy are detected and dropped instead of being reported torn.
+// Export writes the Chrome trace event format, which loads in chrome://tracing and Perfetto.
+export class CORE_API Profiler {
+public:
+    static constexpr size_t bufferCapacity = 1 << 16;
+
+public:
+    static void Record(char const*, uint64, uint64) noexcept;
+    static void SetThreadName(StringView) noexcept;
+
+    static void SetEnabled(bool) noexcept;
+    static bool Enabled() noexcept;
+    static void Clear() noexcept;
+
+    static void Collect(Array<ProfileZone>&);
+    static void Export(String&);
+    static bool ExportToFile(StringView);
+};
+
+// Measures the lifetime of the scope as one zone, use PROFILE_SCOPE to have it compiled out with the profiler.
+export class ProfileScope {
+private:
+    char const* m_name;
+    uint64 m_begin;
+
+public:
+    explicit ProfileScope(char const*) noexcept;
+    ~ProfileScope();
+
+private:
+    ProfileScope(ProfileScope const&) = delete;
+    ProfileScope& operator=(ProfileScope const&) = delete;
+};
+
+inline ProfileScope::ProfileScope(char const* name) noexcept
+    : m_name(name)
+    , m_begin(CycleClock::Cycles())
+{
+}
+
+inline ProfileScope::~ProfileScope()
+{
+    Profiler::Record(m_name, m_begin, CycleClock::Cycles());
+}
+
+} // namespace mini
\ No newline at end of file
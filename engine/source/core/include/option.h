@@ -17,6 +17,13 @@ inline constexpr bool resizableWindow = true;
 inline constexpr unsigned char vsync = 0;
 inline constexpr unsigned char bufferCount = 2;
 
+// frames in flight between the main and the render thread, one renders on the main thread
+inline constexpr unsigned char framePipelineDepth = 2;
+
+// frames per second the main loop is held to, zero runs unlimited
+inline constexpr unsigned int targetFrameRate = 0;
+inline constexpr unsigned int pacerSpinMicroSeconds = 1000;
+
 #if PLATFORM_WINDOWS
 inline constexpr char const* graphicsModule = "mini.d3d12";
 inline constexpr char const* platformModule = "mini.windows";
@@ -24,7 +31,8 @@ inline constexpr char const* platformModule = "mini.windows";
 inline constexpr char const* graphicsModule = "mini.metal4";
 inline constexpr char const* platformModule = "mini.macos";
 #else
-inline constexpr char const* graphicsAPI = nullptr;
+inline constexpr char const* graphicsModule = "mini.null_graphics";
+inline constexpr char const* platformModule = "mini.null_platform";
 #endif
 
 inline constexpr bool debugLayer = true;
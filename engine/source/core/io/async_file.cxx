@@ -0,0 +1,204 @@
+export module mini.core:async_file;
+
+import :type;
+import :string_view;
+import :file_platform;
+
+namespace mini {
+
+// Buffer aligned for direct io, both its address and its size are multiples of the alignment.
+export class IoBuffer {
+public:
+    static constexpr size_t alignment = directIoAlignment;
+
+private:
+    byte* m_data;
+    size_t m_size;
+
+public:
+    IoBuffer() noexcept;
+    explicit IoBuffer(size_t);
+    IoBuffer(IoBuffer&&) noexcept;
+    ~IoBuffer();
+
+    byte* Data() noexcept { return m_data; }
+    byte const* Data() const noexcept { return m_data; }
+    size_t Size() const noexcept { return m_size; }
+    bool Empty() const noexcept { return m_data == nullptr; }
+
+    static constexpr size_t AlignSize(size_t) noexcept;
+
+    IoBuffer& operator=(IoBuffer&&) noexcept;
+
+private:
+    IoBuffer(IoBuffer const&) = delete;
+    IoBuffer& operator=(IoBuffer const&) = delete;
+};
+
+// direct bypasses the page cache, every transfer then needs an offset, size and address aligned to
+// IoBuffer::alignment. it silently falls back to cached io where the file system does not support it.
+export struct FileOpenOptions {
+public:
+    bool write;
+    bool create;
+    bool direct;
+
+    constexpr FileOpenOptions() noexcept
+        : write(false)
+        , create(false)
+        , direct(false)
+    {
+    }
+};
+
+// File addressed by explicit offsets, which makes it safe to share between concurrent requests of an IoQueue.
+// Read and Write block the calling thread, use an IoQueue to run them asynchronously.
+// Both return the number of bytes transferred, or the negated error code of the platform.
+export class CORE_API AsyncFile {
+public:
+    typedef PlatformFile NativeHandle;
+
+private:
+    PlatformFile m_file;
+    bool m_direct;
+
+public:
+    AsyncFile() noexcept;
+    AsyncFile(AsyncFile&&) noexcept;
+    ~AsyncFile();
+
+    bool Open(StringView, FileOpenOptions const& = FileOpenOptions());
+    void Close() noexcept;
+
+    bool IsOpen() const noexcept;
+    bool IsDirect() const noexcept;
+    int64 Size() const noexcept;
+
+    int64 ReadAt(uint64, void*, size_t) const noexcept;
+    int64 WriteAt(uint64, void const*, size_t) const noexcept;
+
+    NativeHandle GetNativeHandle() const noexcept;
+
+    AsyncFile& operator=(AsyncFile&&) noexcept;
+
+private:
+    AsyncFile(AsyncFile const&) = delete;
+    AsyncFile& operator=(AsyncFile const&) = delete;
+};
+
+inline IoBuffer::IoBuffer() noexcept
+    : m_data(nullptr)
+    , m_size(0)
+{
+}
+
+inline IoBuffer::IoBuffer(size_t size)
+    : m_data(nullptr)
+    , m_size(AlignSize(size))
+{
+    m_data = static_cast<byte*>(FileAllocateAligned(m_size, alignment));
+    VERIFY(m_data != nullptr, "failed to allocate io buffer");
+}
+
+inline IoBuffer::IoBuffer(IoBuffer&& other) noexcept
+    : m_data(other.m_data)
+    , m_size(other.m_size)
+{
+    other.m_data = nullptr;
+    other.m_size = 0;
+}
+
+inline IoBuffer::~IoBuffer()
+{
+    if (m_data != nullptr) {
+        FileFreeAligned(m_data);
+    }
+}
+
+inline constexpr size_t IoBuffer::AlignSize(size_t size) noexcept
+{
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+inline IoBuffer& IoBuffer::operator=(IoBuffer&& other) noexcept
+{
+    if (m_data != nullptr) {
+        FileFreeAligned(m_data);
+    }
+
+    m_data = other.m_data;
+    m_size = other.m_size;
+    other.m_data = nullptr;
+    other.m_size = 0;
+    return *this;
+}
+
+inline AsyncFile::AsyncFile() noexcept
+    : m_file(invalidPlatformFile)
+    , m_direct(false)
+{
+}
+
+inline AsyncFile::AsyncFile(AsyncFile&& other) noexcept
+    : m_file(other.m_file)
+    , m_direct(other.m_direct)
+{
+    other.m_file = invalidPlatformFile;
+    other.m_direct = false;
+}
+
+inline AsyncFile::~AsyncFile()
+{
+    Close();
+}
+
+inline void AsyncFile::Close() noexcept
+{
+    if (m_file != invalidPlatformFile) {
+        FileClose(m_file);
+        m_file = invalidPlatformFile;
+    }
+}
+
+inline bool AsyncFile::IsOpen() const noexcept
+{
+    return m_file != invalidPlatformFile;
+}
+
+inline bool AsyncFile::IsDirect() const noexcept
+{
+    return m_direct;
+}
+
+inline int64 AsyncFile::Size() const noexcept
+{
+    return FileSize(m_file);
+}
+
+inline int64 AsyncFile::ReadAt(uint64 offset, void* buffer, size_t size) const noexcept
+{
+    return FileReadAt(m_file, buffer, size, offset);
+}
+
+inline int64 AsyncFile::WriteAt(uint64 offset, void const* buffer, size_t size) const noexcept
+{
+    return FileWriteAt(m_file, buffer, size, offset);
+}
+
+inline AsyncFile::NativeHandle AsyncFile::GetNativeHandle() const noexcept
+{
+    return m_file;
+}
+
+inline AsyncFile& AsyncFile::operator=(AsyncFile&& other) noexcept
+{
+    Close();
+
+    m_file = other.m_file;
+    m_direct = other.m_direct;
+    other.m_file = invalidPlatformFile;
+    other.m_direct = false;
+    return *this;
+}
+
+} // namespace mini
\ No newline at end of file
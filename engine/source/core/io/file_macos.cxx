@@ -0,0 +1,104 @@
+module;
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+export module mini.core:file_platform;
+
+import :type;
+
+namespace mini {
+
+using PlatformFile = int32;
+
+inline constexpr PlatformFile invalidPlatformFile = -1;
+
+// logical block size of every common block device, direct transfers have to be aligned to it
+inline constexpr size_t directIoAlignment = 4096;
+
+inline PlatformFile FileOpen(char const* path, bool write, bool create, bool& direct)
+{
+    int32 flags = O_CLOEXEC | (write ? O_RDWR : O_RDONLY) | (create ? O_CREAT | O_TRUNC : 0);
+    int32 file = open(path, flags, 0644);
+
+    // darwin has no O_DIRECT, disabling the cache on the descriptor is the closest equivalent
+    if (file >= 0 && direct && fcntl(file, F_NOCACHE, 1) != 0) {
+        direct = false;
+    }
+
+    return file;
+}
+
+inline void FileClose(PlatformFile file)
+{
+    close(file);
+}
+
+inline int64 FileSize(PlatformFile file)
+{
+    struct stat info;
+    return fstat(file, &info) == 0 ? static_cast<int64>(info.st_size) : -static_cast<int64>(errno);
+}
+
+inline int64 FileReadAt(PlatformFile file, void* buffer, size_t size, uint64 offset)
+{
+    ssize_t result = pread(file, buffer, size, static_cast<off_t>(offset));
+    return result >= 0 ? static_cast<int64>(result) : -static_cast<int64>(errno);
+}
+
+inline int64 FileWriteAt(PlatformFile file, void const* buffer, size_t size, uint64 offset)
+{
+    ssize_t result = pwrite(file, buffer, size, static_cast<off_t>(offset));
+    return result >= 0 ? static_cast<int64>(result) : -static_cast<int64>(errno);
+}
+
+inline void* FileAllocateAligned(size_t size, size_t alignment)
+{
+    void* pointer = nullptr;
+    return posix_memalign(&pointer, alignment, size) == 0 ? pointer : nullptr;
+}
+
+inline void FileFreeAligned(void* pointer)
+{
+    free(pointer);
+}
+
+inline void* FileMap(PlatformFile file, size_t size, bool write)
+{
+    int32 protection = PROT_READ | (write ? PROT_WRITE : 0);
+    void* pointer = mmap(nullptr, size, protection, MAP_SHARED, file, 0);
+    return pointer == MAP_FAILED ? nullptr : pointer;
+}
+
+inline void FileUnmap(void* pointer, size_t size)
+{
+    munmap(pointer, size);
+}
+
+inline bool FileMapFlush(void* pointer, size_t size)
+{
+    return msync(pointer, size, MS_SYNC) == 0;
+}
+
+inline size_t FileMapPageSize()
+{
+    return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+// advice follows the order of MapAdvice: normal, sequential, random, will need, dont need, huge page
+inline bool FileMapAdvise(void* pointer, size_t size, int32 advice)
+{
+    // darwin has no huge pages for file mappings
+    static constexpr int32 advices[] = { MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM, MADV_WILLNEED, MADV_DONTNEED };
+    if (advice >= static_cast<int32>(sizeof(advices) / sizeof(advices[0]))) {
+        return false;
+    }
+
+    return madvise(pointer, size, advices[advice]) == 0;
+}
+
+} // namespace mini
\ No newline at end of file
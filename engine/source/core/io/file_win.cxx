@@ -0,0 +1,129 @@
+module;
+
+#include <malloc.h>
+
+#include "win_include.h"
+
+export module mini.core:file_platform;
+
+import :type;
+
+namespace mini {
+
+using PlatformFile = HANDLE;
+
+inline PlatformFile const invalidPlatformFile = INVALID_HANDLE_VALUE;
+
+// logical block size of every common block device, direct transfers have to be aligned to it
+inline constexpr size_t directIoAlignment = 4096;
+
+inline PlatformFile FileOpen(char const* path, bool write, bool create, bool& direct)
+{
+    DWORD access = GENERIC_READ | (write ? GENERIC_WRITE : 0);
+    DWORD share = FILE_SHARE_READ | FILE_SHARE_WRITE;
+    DWORD disposition = create ? CREATE_ALWAYS : OPEN_EXISTING;
+    DWORD flags = FILE_ATTRIBUTE_NORMAL | (direct ? FILE_FLAG_NO_BUFFERING : 0);
+
+    return CreateFileA(path, access, share, nullptr, disposition, flags, nullptr);
+}
+
+inline void FileClose(PlatformFile file)
+{
+    CloseHandle(file);
+}
+
+inline int64 FileSize(PlatformFile file)
+{
+    LARGE_INTEGER size;
+    return GetFileSizeEx(file, &size) ? static_cast<int64>(size.QuadPart) : -static_cast<int64>(GetLastError());
+}
+
+inline int64 FileReadAt(PlatformFile file, void* buffer, size_t size, uint64 offset)
+{
+    // the offset of a synchronous handle can be given through the overlapped structure
+    OVERLAPPED overlapped = {};
+    overlapped.Offset = static_cast<DWORD>(offset);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+    DWORD read = 0;
+    if (!ReadFile(file, buffer, static_cast<DWORD>(size), &read, &overlapped)) {
+        DWORD error = GetLastError();
+        return error == ERROR_HANDLE_EOF ? 0 : -static_cast<int64>(error);
+    }
+
+    return static_cast<int64>(read);
+}
+
+inline int64 FileWriteAt(PlatformFile file, void const* buffer, size_t size, uint64 offset)
+{
+    OVERLAPPED overlapped = {};
+    overlapped.Offset = static_cast<DWORD>(offset);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+    DWORD written = 0;
+    if (!WriteFile(file, buffer, static_cast<DWORD>(size), &written, &overlapped)) {
+        return -static_cast<int64>(GetLastError());
+    }
+
+    return static_cast<int64>(written);
+}
+
+inline void* FileAllocateAligned(size_t size, size_t alignment)
+{
+    return _aligned_malloc(size, alignment);
+}
+
+inline void FileFreeAligned(void* pointer)
+{
+    _aligned_free(pointer);
+}
+
+inline void* FileMap(PlatformFile file, size_t size, bool write)
+{
+    // the view keeps the mapping object alive, so its handle is not needed past this point
+    HANDLE mapping = CreateFileMappingA(file, nullptr, write ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        return nullptr;
+    }
+
+    void* pointer = MapViewOfFile(mapping, write ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size);
+    CloseHandle(mapping);
+    return pointer;
+}
+
+inline void FileUnmap(void* pointer, size_t)
+{
+    UnmapViewOfFile(pointer);
+}
+
+inline bool FileMapFlush(void* pointer, size_t size)
+{
+    return FlushViewOfFile(pointer, size) != 0;
+}
+
+inline size_t FileMapPageSize()
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return static_cast<size_t>(info.dwPageSize);
+}
+
+// advice follows the order of MapAdvice: normal, sequential, random, will need, dont need, huge page
+inline bool FileMapAdvise(void* pointer, size_t size, int32 advice)
+{
+    // access patterns are only taken at CreateFile, the sole hint applicable to a mapped view is prefetching
+    if (advice == 0) {
+        return true;
+    }
+
+    if (advice != 3) {
+        return false;
+    }
+
+    WIN32_MEMORY_RANGE_ENTRY range;
+    range.VirtualAddress = pointer;
+    range.NumberOfBytes = size;
+    return PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0) != 0;
+}
+
+} // namespace mini
\ No newline at end of file
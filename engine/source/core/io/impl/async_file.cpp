@@ -0,0 +1,24 @@
+module mini.core;
+
+import :type;
+import :string_view;
+import :string;
+import :file_platform;
+import :async_file;
+
+namespace mini {
+
+bool AsyncFile::Open(StringView path, FileOpenOptions const& options)
+{
+    Close();
+
+    // the platform expects a null terminated path
+    String terminated(path);
+    bool direct = options.direct;
+    m_file = FileOpen(terminated.Data(), options.write, options.create, direct);
+    m_direct = m_file != invalidPlatformFile && direct;
+
+    return m_file != invalidPlatformFile;
+}
+
+} // namespace mini
\ No newline at end of file
@@ -0,0 +1,264 @@
+module mini.core;
+
+import :type;
+import :array;
+import :atomic_base;
+import :atomic;
+import :mutex;
+import :thread;
+import :file_platform;
+import :async_file;
+import :io_queue;
+import :io_ring;
+
+namespace mini {
+
+IoQueue::IoQueue(IoQueueOptions const& options)
+    : m_backend(IoBackend::threadPool)
+    , m_ring(nullptr)
+    , m_inFlight(0)
+    , m_inKernel(0)
+    , m_completion()
+    , m_refused(nullptr)
+    , m_workers()
+    , m_head(nullptr)
+    , m_tail(nullptr)
+    , m_signal(0)
+    , m_sleeping(0)
+    , m_stop(false)
+{
+    if (!options.forceThreadPool) {
+        m_ring = IoRingCreate(options.queueDepth);
+    }
+
+    if (m_ring != nullptr) {
+        ThreadOptions completionOptions;
+        completionOptions.name = "mini.io.completion";
+
+        m_backend = IoBackend::ioUring;
+        m_completion = Thread([this]() { RunCompletion(); }, completionOptions);
+        return;
+    }
+
+    ThreadOptions workerOptions;
+    workerOptions.name = "mini.io.worker";
+
+    uint32 threadCount = options.threadCount != 0 ? options.threadCount : 1;
+    m_workers.Reserve(threadCount);
+    for (uint32 i = 0; i < threadCount; ++i) {
+        m_workers.Push(Thread([this]() { RunWorker(); }, workerOptions));
+    }
+}
+
+IoQueue::~IoQueue()
+{
+    Flush();
+
+    for (uint32 count = m_inFlight.Load(MemoryOrder::acquire); count != 0;) {
+        m_inFlight.Wait(count, MemoryOrder::acquire);
+        count = m_inFlight.Load(MemoryOrder::acquire);
+    }
+
+    m_stop.Store(true, MemoryOrder::sequential);
+
+    if (m_ring != nullptr) {
+        // nothing is left in the kernel, moving the count off zero wakes the completion thread to see the stop
+        // without submitting anything, so a ring the kernel stopped accepting entries on still shuts down
+        m_inKernel.FetchSub(1, MemoryOrder::sequential);
+        m_inKernel.NotifyAll();
+
+        m_completion.Join();
+        IoRingDestroy(m_ring);
+        return;
+    }
+
+    m_signal.FetchAdd(1, MemoryOrder::sequential);
+    m_signal.NotifyAll();
+
+    for (Thread& worker : m_workers) {
+        worker.Join();
+    }
+}
+
+bool IoQueue::RegisterBuffers(IoBuffer const* buffers, size_t count)
+{
+    // the thread pool reads into the buffer address directly, buffer indices are simply ignored there
+    if (m_ring == nullptr) {
+        return true;
+    }
+
+    m_submitLock.Lock();
+    bool registered = IoRingRegisterBuffers(m_ring, buffers, count);
+    m_submitLock.Unlock();
+
+    return registered;
+}
+
+void IoQueue::Submit(IoRequest& request) noexcept
+{
+    ASSERT(request.m_state.Load(MemoryOrder::relaxed) != IoRequest::pending, "request is already in flight");
+
+    request.m_state.Store(IoRequest::pending, MemoryOrder::relaxed);
+    request.m_next = nullptr;
+    m_inFlight.FetchAdd(1, MemoryOrder::relaxed);
+
+    if (m_ring != nullptr) {
+        m_submitLock.Lock();
+
+        // a full submission queue hands the current batch to the kernel to make room
+        while (!IoRingPush(m_ring, request)) {
+            SubmitRing();
+        }
+
+        IoRequest* refused = m_refused;
+        m_refused = nullptr;
+        m_submitLock.Unlock();
+
+        CompleteRefused(refused);
+        return;
+    }
+
+    m_queueLock.Lock();
+    if (m_tail == nullptr) {
+        m_head = &request;
+    } else {
+        m_tail->m_next = &request;
+    }
+
+    m_tail = &request;
+    m_queueLock.Unlock();
+}
+
+void IoQueue::Flush() noexcept
+{
+    if (m_ring != nullptr) {
+        m_submitLock.Lock();
+        SubmitRing();
+        IoRequest* refused = m_refused;
+        m_refused = nullptr;
+        m_submitLock.Unlock();
+
+        CompleteRefused(refused);
+        return;
+    }
+
+    // a worker registers as sleeping before its last look at the queue,
+    // so either it sees the batch or the notification below sees the worker.
+    m_signal.FetchAdd(1, MemoryOrder::sequential);
+    if (m_sleeping.Load(MemoryOrder::sequential) != 0) {
+        m_signal.NotifyAll();
+    }
+}
+
+void IoQueue::OnComplete(IoRequest& request, int64 result, void* context) noexcept
+{
+    IoQueue* queue = static_cast<IoQueue*>(context);
+    request.Complete(result);
+
+    if (queue->m_inFlight.FetchSub(1, MemoryOrder::acquireRelease) == 1) {
+        queue->m_inFlight.NotifyAll();
+    }
+}
+
+void IoQueue::OnReaped(IoRequest& request, int64 result, void* context) noexcept
+{
+    IoQueue* queue = static_cast<IoQueue*>(context);
+    queue->m_inKernel.FetchSub(1, MemoryOrder::relaxed);
+    OnComplete(request, result, context);
+}
+
+void IoQueue::OnRefused(IoRequest& request, int64 result, void* context) noexcept
+{
+    // called under the submit lock, a completion may submit again and is deferred until the lock is released
+    IoQueue* queue = static_cast<IoQueue*>(context);
+    request.m_result = result;
+    request.m_next = queue->m_refused;
+    queue->m_refused = &request;
+}
+
+void IoQueue::SubmitRing() noexcept
+{
+    // entries may be reaped before they are counted here, the count only reads as outstanding above zero
+    int32 submitted = static_cast<int32>(IoRingSubmit(m_ring, &IoQueue::OnRefused, this));
+    if (submitted != 0 && m_inKernel.FetchAdd(submitted, MemoryOrder::sequential) <= 0) {
+        m_inKernel.NotifyAll();
+    }
+}
+
+void IoQueue::CompleteRefused(IoRequest* request) noexcept
+{
+    while (request != nullptr) {
+        IoRequest* next = request->m_next;
+        OnComplete(*request, request->m_result, this);
+        request = next;
+    }
+}
+
+void IoQueue::RunCompletion() noexcept
+{
+    // the kernel is only waited on while it holds entries, so stopping never depends on it taking another one
+    for (;;) {
+        int32 inKernel = m_inKernel.Load(MemoryOrder::sequential);
+        if (inKernel > 0) {
+            if (!IoRingReap(m_ring, &IoQueue::OnReaped, this)) {
+                return;
+            }
+
+            continue;
+        }
+
+        if (m_stop.Load(MemoryOrder::sequential)) {
+            return;
+        }
+
+        m_inKernel.Wait(inKernel, MemoryOrder::acquire);
+    }
+}
+
+IoRequest* IoQueue::Dequeue() noexcept
+{
+    m_queueLock.Lock();
+
+    IoRequest* request = m_head;
+    if (request != nullptr) {
+        m_head = request->m_next;
+        m_tail = m_head == nullptr ? nullptr : m_tail;
+    }
+
+    m_queueLock.Unlock();
+    return request;
+}
+
+void IoQueue::RunWorker() noexcept
+{
+    while (true) {
+        IoRequest* request = Dequeue();
+        if (request == nullptr) {
+            m_sleeping.FetchAdd(1, MemoryOrder::sequential);
+            uint32 signal = m_signal.Load(MemoryOrder::sequential);
+
+            request = Dequeue();
+            if (request == nullptr && !m_stop.Load(MemoryOrder::sequential)) {
+                m_signal.Wait(signal, MemoryOrder::acquire);
+            }
+
+            m_sleeping.FetchSub(1, MemoryOrder::relaxed);
+        }
+
+        if (request == nullptr) {
+            if (m_stop.Load(MemoryOrder::acquire)) {
+                return;
+            }
+
+            continue;
+        }
+
+        int64 result = request->Operation() == IoOperation::read
+                           ? FileReadAt(request->File(), request->Buffer(), request->Size(), request->Offset())
+                           : FileWriteAt(request->File(), request->Buffer(), request->Size(), request->Offset());
+
+        OnComplete(*request, result, this);
+    }
+}
+
+} // namespace mini
\ No newline at end of file
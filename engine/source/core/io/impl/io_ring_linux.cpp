@@ -0,0 +1,289 @@
+module;
+
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+module mini.core;
+
+import :type;
+import :allocator;
+import :memory_operation;
+import :array;
+import :thread;
+import :async_file;
+import :io_queue;
+import :io_ring;
+
+namespace mini {
+
+struct IoRing {
+public:
+    int32 fd;
+
+    void* sqRing;
+    size_t sqRingSize;
+    uint32* sqHead;
+    uint32* sqTail;
+    uint32* sqArray;
+    uint32 sqMask;
+    uint32 sqEntries;
+    uint32 sqLocalTail;
+    uint32 sqSubmitted;
+    io_uring_sqe* sqes;
+    size_t sqesSize;
+
+    void* cqRing;
+    size_t cqRingSize;
+    uint32* cqHead;
+    uint32* cqTail;
+    uint32 cqMask;
+    io_uring_cqe* cqes;
+};
+
+static int32 IoUringSetup(uint32 entries, io_uring_params* params)
+{
+    return static_cast<int32>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int32 IoUringEnter(int32 fd, uint32 submit, uint32 complete, uint32 flags)
+{
+    return static_cast<int32>(syscall(__NR_io_uring_enter, fd, submit, complete, flags, nullptr, 0));
+}
+
+static int32 IoUringRegister(int32 fd, uint32 opcode, void const* args, uint32 count)
+{
+    return static_cast<int32>(syscall(__NR_io_uring_register, fd, opcode, args, count));
+}
+
+static void* MapRing(int32 fd, size_t size, off_t offset)
+{
+    void* pointer = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+    return pointer == MAP_FAILED ? nullptr : pointer;
+}
+
+template <typename T>
+static T* RingAt(void* ring, uint32 offset)
+{
+    return reinterpret_cast<T*>(static_cast<byte*>(ring) + offset);
+}
+
+IoRing* IoRingCreate(uint32 entries)
+{
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+
+    // seccomp profiles of containers commonly answer with EPERM or ENOSYS here
+    int32 fd = IoUringSetup(entries, &params);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    // plain read and write opcodes arrived together with current position support in 5.6
+    if ((params.features & IORING_FEAT_RW_CUR_POS) == 0) {
+        close(fd);
+        return nullptr;
+    }
+
+    IoRing* ring = Allocator<IoRing>().Allocate(1).pointer;
+    memset(ring, 0, sizeof(IoRing));
+    ring->fd = fd;
+
+    ring->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32);
+    ring->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if ((params.features & IORING_FEAT_SINGLE_MMAP) != 0) {
+        ring->sqRingSize = ring->sqRingSize > ring->cqRingSize ? ring->sqRingSize : ring->cqRingSize;
+        ring->cqRingSize = ring->sqRingSize;
+    }
+
+    ring->sqRing = MapRing(fd, ring->sqRingSize, IORING_OFF_SQ_RING);
+    if ((params.features & IORING_FEAT_SINGLE_MMAP) != 0) {
+        ring->cqRing = ring->sqRing;
+    } else if (ring->sqRing != nullptr) {
+        ring->cqRing = MapRing(fd, ring->cqRingSize, IORING_OFF_CQ_RING);
+    }
+
+    ring->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    if (ring->cqRing != nullptr) {
+        ring->sqes = static_cast<io_uring_sqe*>(MapRing(fd, ring->sqesSize, IORING_OFF_SQES));
+    }
+
+    if (ring->sqes == nullptr) {
+        IoRingDestroy(ring);
+        return nullptr;
+    }
+
+    ring->sqHead = RingAt<uint32>(ring->sqRing, params.sq_off.head);
+    ring->sqTail = RingAt<uint32>(ring->sqRing, params.sq_off.tail);
+    ring->sqArray = RingAt<uint32>(ring->sqRing, params.sq_off.array);
+    ring->sqMask = *RingAt<uint32>(ring->sqRing, params.sq_off.ring_mask);
+    ring->sqEntries = params.sq_entries;
+    ring->sqLocalTail = *ring->sqTail;
+    ring->sqSubmitted = ring->sqLocalTail;
+
+    ring->cqHead = RingAt<uint32>(ring->cqRing, params.cq_off.head);
+    ring->cqTail = RingAt<uint32>(ring->cqRing, params.cq_off.tail);
+    ring->cqMask = *RingAt<uint32>(ring->cqRing, params.cq_off.ring_mask);
+    ring->cqes = RingAt<io_uring_cqe>(ring->cqRing, params.cq_off.cqes);
+
+    return ring;
+}
+
+void IoRingDestroy(IoRing* ring) noexcept
+{
+    if (ring->sqes != nullptr) {
+        munmap(ring->sqes, ring->sqesSize);
+    }
+
+    if (ring->cqRing != nullptr && ring->cqRing != ring->sqRing) {
+        munmap(ring->cqRing, ring->cqRingSize);
+    }
+
+    if (ring->sqRing != nullptr) {
+        munmap(ring->sqRing, ring->sqRingSize);
+    }
+
+    close(ring->fd);
+    Allocator<IoRing>().Deallocate(ring, 1);
+}
+
+bool IoRingRegisterBuffers(IoRing* ring, IoBuffer const* buffers, size_t count)
+{
+    Array<iovec> vectors;
+    vectors.Reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        vectors.Push(iovec{ const_cast<byte*>(buffers[i].Data()), buffers[i].Size() });
+    }
+
+    return IoUringRegister(ring->fd, IORING_REGISTER_BUFFERS, vectors.Data(), static_cast<uint32>(count)) == 0;
+}
+
+static io_uring_sqe* NextEntry(IoRing* ring) noexcept
+{
+    uint32 head = __atomic_load_n(ring->sqHead, __ATOMIC_ACQUIRE);
+    if (ring->sqLocalTail - head >= ring->sqEntries) {
+        return nullptr;
+    }
+
+    uint32 index = ring->sqLocalTail & ring->sqMask;
+    ring->sqArray[index] = index;
+    ++ring->sqLocalTail;
+
+    io_uring_sqe* entry = &ring->sqes[index];
+    memset(entry, 0, sizeof(io_uring_sqe));
+    return entry;
+}
+
+bool IoRingPush(IoRing* ring, IoRequest& request) noexcept
+{
+    io_uring_sqe* entry = NextEntry(ring);
+    if (entry == nullptr) {
+        return false;
+    }
+
+    bool read = request.Operation() == IoOperation::read;
+    bool fixed = request.BufferIndex() >= 0;
+    if (fixed) {
+        entry->opcode = read ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+        entry->buf_index = static_cast<uint16>(request.BufferIndex());
+    } else {
+        entry->opcode = read ? IORING_OP_READ : IORING_OP_WRITE;
+    }
+
+    entry->fd = request.File();
+    entry->off = request.Offset();
+    entry->addr = reinterpret_cast<size_t>(request.Buffer());
+    entry->len = request.Size();
+    entry->user_data = reinterpret_cast<size_t>(&request);
+    return true;
+}
+
+static void WaitForReap(IoRing* ring) noexcept
+{
+    // the completion thread is the only consumer of completions, the submitter steps aside until it took some
+    uint32 head = __atomic_load_n(ring->cqHead, __ATOMIC_ACQUIRE);
+    do {
+        Thread::YieldNow();
+    } while (head == __atomic_load_n(ring->cqHead, __ATOMIC_ACQUIRE) &&
+             head != __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE));
+}
+
+static void RefuseEntries(IoRing* ring, int64 error, IoRingComplete refuse, void* context) noexcept
+{
+    // the kernel only reads the tail while submitting, entries it did not take are pulled back out of the queue
+    for (uint32 i = ring->sqSubmitted; i != ring->sqLocalTail; ++i) {
+        uint64 userData = ring->sqes[ring->sqArray[i & ring->sqMask]].user_data;
+        refuse(*reinterpret_cast<IoRequest*>(static_cast<size_t>(userData)), error, context);
+    }
+
+    ring->sqLocalTail = ring->sqSubmitted;
+    __atomic_store_n(ring->sqTail, ring->sqLocalTail, __ATOMIC_RELEASE);
+}
+
+uint32 IoRingSubmit(IoRing* ring, IoRingComplete refuse, void* context) noexcept
+{
+    uint32 count = ring->sqLocalTail - ring->sqSubmitted;
+    if (count == 0) {
+        return 0;
+    }
+
+    __atomic_store_n(ring->sqTail, ring->sqLocalTail, __ATOMIC_RELEASE);
+
+    uint32 submitted = 0;
+    int32 error = 0;
+    while (submitted < count) {
+        int32 result = IoUringEnter(ring->fd, count - submitted, 0, 0);
+        if (result >= 0) {
+            submitted += static_cast<uint32>(result);
+            continue;
+        }
+
+        if (errno == EINTR) {
+            continue;
+        }
+
+        // out of request memory or overflowing completions, both clear up once completions were reaped
+        if (errno == EAGAIN || errno == EBUSY) {
+            WaitForReap(ring);
+            continue;
+        }
+
+        error = errno;
+        break;
+    }
+
+    ring->sqSubmitted += submitted;
+    if (submitted < count) {
+        RefuseEntries(ring, -static_cast<int64>(error), refuse, context);
+    }
+
+    return submitted;
+}
+
+bool IoRingReap(IoRing* ring, IoRingComplete complete, void* context) noexcept
+{
+    uint32 head = *ring->cqHead;
+    while (head == __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE)) {
+        if (IoUringEnter(ring->fd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+            return false;
+        }
+    }
+
+    for (uint32 tail = __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE); head != tail; ++head) {
+        io_uring_cqe const& entry = ring->cqes[head & ring->cqMask];
+        uint64 userData = entry.user_data;
+        int64 result = entry.res;
+
+        // hand the entry back before completing, the request may submit again from its completion
+        __atomic_store_n(ring->cqHead, head + 1, __ATOMIC_RELEASE);
+        complete(*reinterpret_cast<IoRequest*>(static_cast<size_t>(userData)), result, context);
+    }
+
+    return true;
+}
+
+} // namespace mini
\ No newline at end of file
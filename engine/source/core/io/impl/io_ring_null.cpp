@@ -0,0 +1,40 @@
+module mini.core;
+
+import :type;
+import :async_file;
+import :io_queue;
+import :io_ring;
+
+namespace mini {
+
+// no kernel ring on this platform, every IoQueue runs on its thread pool
+struct IoRing { };
+
+IoRing* IoRingCreate(uint32)
+{
+    return nullptr;
+}
+
+void IoRingDestroy(IoRing*) noexcept { }
+
+bool IoRingRegisterBuffers(IoRing*, IoBuffer const*, size_t)
+{
+    return false;
+}
+
+bool IoRingPush(IoRing*, IoRequest&) noexcept
+{
+    return false;
+}
+
+uint32 IoRingSubmit(IoRing*, IoRingComplete, void*) noexcept
+{
+    return 0;
+}
+
+bool IoRingReap(IoRing*, IoRingComplete, void*) noexcept
+{
+    return false;
+}
+
+} // namespace mini
\ No newline at end of file
@@ -0,0 +1,40 @@
+module mini.core;
+
+import :type;
+import :string_view;
+import :string;
+import :file_platform;
+import :mapped_file;
+
+namespace mini {
+
+bool MappedFile::Open(StringView path, MapAccess access)
+{
+    Close();
+
+    bool write = access == MapAccess::readWrite;
+    bool direct = false;
+    String terminated(path);
+
+    PlatformFile file = FileOpen(terminated.Data(), write, false, direct);
+    if (file == invalidPlatformFile) {
+        return false;
+    }
+
+    // the mapping holds its own reference to the file, the descriptor is closed right after
+    int64 size = FileSize(file);
+    void* data = size > 0 ? FileMap(file, static_cast<size_t>(size), write) : nullptr;
+    FileClose(file);
+
+    if (size < 0 || (size > 0 && data == nullptr)) {
+        return false;
+    }
+
+    m_data = static_cast<byte*>(data);
+    m_size = static_cast<size_t>(size);
+    m_open = true;
+    m_writable = write;
+    return true;
+}
+
+} // namespace mini
\ No newline at end of file
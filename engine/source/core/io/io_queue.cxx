@@ -0,0 +1,304 @@
+module;
+
+#include <coroutine>
+
+export module mini.core:io_queue;
+
+import :type;
+import :array;
+import :atomic_base;
+import :atomic;
+import :mutex;
+import :thread;
+import :task;
+import :file_platform;
+import :async_file;
+
+namespace mini {
+
+struct IoRing;
+
+export enum class IoBackend : uint8 {
+    threadPool,
+    ioUring
+};
+
+export enum class IoOperation : uint8 {
+    read,
+    write
+};
+
+// Single read or write, owned by the caller until it completed.
+// Completion is delivered in up to three ways at once: Wait blocks on the request itself, a callback runs on
+// the thread that completed it, and a suspended coroutine is resumed there. The callback runs before the
+// request reports Done, so a waiting owner always observes its effects.
+// The result is the number of bytes transferred, or the negated error code of the platform.
+export class IoRequest {
+public:
+    typedef void (*Callback)(IoRequest&, void*);
+
+private:
+    friend class IoQueue;
+
+    enum State : uint32 {
+        idle,
+        pending,
+        done
+    };
+
+    PlatformFile m_file;
+    uint64 m_offset;
+    void* m_buffer;
+    uint32 m_size;
+    int32 m_bufferIndex;
+    IoOperation m_operation;
+
+    Callback m_callback;
+    void* m_userData;
+    CoroutineHandle<> m_continuation;
+
+    Atomic<uint32> m_state;
+    int64 m_result;
+    IoRequest* m_next;
+
+public:
+    IoRequest() noexcept;
+
+    void PrepareRead(AsyncFile const&, uint64, void*, uint32) noexcept;
+    void PrepareWrite(AsyncFile const&, uint64, void const*, uint32) noexcept;
+    void SetBufferIndex(int32) noexcept;
+    void SetCallback(Callback, void*) noexcept;
+    void SetContinuation(CoroutineHandle<>) noexcept;
+
+    bool Done() const noexcept;
+    void Wait() const noexcept;
+    int64 Result() const noexcept;
+
+    PlatformFile File() const noexcept { return m_file; }
+    uint64 Offset() const noexcept { return m_offset; }
+    void* Buffer() const noexcept { return m_buffer; }
+    uint32 Size() const noexcept { return m_size; }
+    int32 BufferIndex() const noexcept { return m_bufferIndex; }
+    IoOperation Operation() const noexcept { return m_operation; }
+
+    void Complete(int64) noexcept;
+
+private:
+    IoRequest(IoRequest const&) = delete;
+    IoRequest& operator=(IoRequest const&) = delete;
+};
+
+// thread count only applies to the thread pool backend, which also serves as the fallback
+// for kernels without io_uring or where it is blocked by a sandbox.
+export struct IoQueueOptions {
+public:
+    uint32 queueDepth;
+    uint32 threadCount;
+    bool forceThreadPool;
+
+    constexpr IoQueueOptions() noexcept
+        : queueDepth(256)
+        , threadCount(2)
+        , forceThreadPool(false)
+    {
+    }
+};
+
+// Queue running file requests asynchronously.
+// Submitted requests are batched until Flush, so that a whole batch reaches the kernel with a single system call.
+// Buffers registered upfront are pinned once instead of on every request, requests opt into them through
+// their buffer index. The queue has to outlive every request submitted to it, and waits for all of them on
+// destruction.
+export class CORE_API IoQueue {
+public:
+    class Awaiter;
+
+private:
+    IoBackend m_backend;
+    IoRing* m_ring;
+    Mutex m_submitLock;
+    Atomic<uint32> m_inFlight;
+    Atomic<int32> m_inKernel;
+    Thread m_completion;
+    IoRequest* m_refused;
+
+    Array<Thread> m_workers;
+    Mutex m_queueLock;
+    IoRequest* m_head;
+    IoRequest* m_tail;
+    alignas(__ATOMIC_INTERFERENCE_SIZE) Atomic<uint32> m_signal;
+    Atomic<uint32> m_sleeping;
+    Atomic<bool> m_stop;
+
+public:
+    explicit IoQueue(IoQueueOptions const& = IoQueueOptions());
+    ~IoQueue();
+
+    IoBackend Backend() const noexcept;
+    bool RegisterBuffers(IoBuffer const*, size_t);
+
+    void Submit(IoRequest&) noexcept;
+    void Flush() noexcept;
+
+    Awaiter Read(AsyncFile const&, uint64, void*, uint32) noexcept;
+    Awaiter Write(AsyncFile const&, uint64, void const*, uint32) noexcept;
+
+private:
+    static void OnComplete(IoRequest&, int64, void*) noexcept;
+    static void OnReaped(IoRequest&, int64, void*) noexcept;
+    static void OnRefused(IoRequest&, int64, void*) noexcept;
+
+    void SubmitRing() noexcept;
+    void CompleteRefused(IoRequest*) noexcept;
+
+    void RunCompletion() noexcept;
+    void RunWorker() noexcept;
+    IoRequest* Dequeue() noexcept;
+
+    IoQueue(IoQueue const&) = delete;
+    IoQueue& operator=(IoQueue const&) = delete;
+};
+
+// Submits its request and resumes the coroutine once it completed, the request lives in the suspended frame.
+class IoQueue::Awaiter {
+private:
+    IoQueue* m_queue;
+    IoRequest m_request;
+
+public:
+    Awaiter(IoQueue* queue, AsyncFile const& file, uint64 offset, void* buffer, uint32 size, IoOperation operation)
+        noexcept
+        : m_queue(queue)
+        , m_request()
+    {
+        if (operation == IoOperation::read) {
+            m_request.PrepareRead(file, offset, buffer, size);
+        } else {
+            m_request.PrepareWrite(file, offset, buffer, size);
+        }
+    }
+
+    bool await_ready() const noexcept { return false; }
+    int64 await_resume() const noexcept { return m_request.Result(); }
+
+    void await_suspend(CoroutineHandle<> handle) noexcept
+    {
+        // the coroutine may already run again on the completion thread once submitted, along with the awaiter
+        IoQueue* queue = m_queue;
+        m_request.SetContinuation(handle);
+        queue->Submit(m_request);
+        queue->Flush();
+    }
+};
+
+inline IoRequest::IoRequest() noexcept
+    : m_file(invalidPlatformFile)
+    , m_offset(0)
+    , m_buffer(nullptr)
+    , m_size(0)
+    , m_bufferIndex(-1)
+    , m_operation(IoOperation::read)
+    , m_callback(nullptr)
+    , m_userData(nullptr)
+    , m_continuation(nullptr)
+    , m_state(idle)
+    , m_result(0)
+    , m_next(nullptr)
+{
+}
+
+inline void IoRequest::PrepareRead(AsyncFile const& file, uint64 offset, void* buffer, uint32 size) noexcept
+{
+    ASSERT(m_state.Load(MemoryOrder::relaxed) != pending, "request is still in flight");
+    ASSERT(!file.IsDirect() || ((offset | size | reinterpret_cast<size_t>(buffer)) & (IoBuffer::alignment - 1)) == 0,
+           "direct io requires aligned offset, size and buffer");
+
+    m_file = file.GetNativeHandle();
+    m_offset = offset;
+    m_buffer = buffer;
+    m_size = size;
+    m_operation = IoOperation::read;
+    m_state.Store(idle, MemoryOrder::relaxed);
+}
+
+inline void IoRequest::PrepareWrite(AsyncFile const& file, uint64 offset, void const* buffer, uint32 size) noexcept
+{
+    ASSERT(m_state.Load(MemoryOrder::relaxed) != pending, "request is still in flight");
+    ASSERT(!file.IsDirect() || ((offset | size | reinterpret_cast<size_t>(buffer)) & (IoBuffer::alignment - 1)) == 0,
+           "direct io requires aligned offset, size and buffer");
+
+    m_file = file.GetNativeHandle();
+    m_offset = offset;
+    m_buffer = const_cast<void*>(buffer);
+    m_size = size;
+    m_operation = IoOperation::write;
+    m_state.Store(idle, MemoryOrder::relaxed);
+}
+
+inline void IoRequest::SetBufferIndex(int32 index) noexcept
+{
+    m_bufferIndex = index;
+}
+
+inline void IoRequest::SetCallback(Callback callback, void* userData) noexcept
+{
+    m_callback = callback;
+    m_userData = userData;
+}
+
+inline void IoRequest::SetContinuation(CoroutineHandle<> continuation) noexcept
+{
+    m_continuation = continuation;
+}
+
+inline bool IoRequest::Done() const noexcept
+{
+    return m_state.Load(MemoryOrder::acquire) == done;
+}
+
+inline void IoRequest::Wait() const noexcept
+{
+    for (uint32 state = m_state.Load(MemoryOrder::acquire); state == pending;) {
+        m_state.Wait(state, MemoryOrder::acquire);
+        state = m_state.Load(MemoryOrder::acquire);
+    }
+}
+
+inline int64 IoRequest::Result() const noexcept
+{
+    return m_result;
+}
+
+inline void IoRequest::Complete(int64 result) noexcept
+{
+    // the callback runs before publishing, the owner may free the request as soon as it observes completion
+    m_result = result;
+    if (m_callback != nullptr) {
+        m_callback(*this, m_userData);
+    }
+
+    CoroutineHandle<> continuation = m_continuation;
+    m_state.Store(done, MemoryOrder::release);
+    m_state.NotifyAll();
+
+    if (continuation) {
+        continuation.resume();
+    }
+}
+
+inline IoBackend IoQueue::Backend() const noexcept
+{
+    return m_backend;
+}
+
+inline IoQueue::Awaiter IoQueue::Read(AsyncFile const& file, uint64 offset, void* buffer, uint32 size) noexcept
+{
+    return Awaiter(this, file, offset, buffer, size, IoOperation::read);
+}
+
+inline IoQueue::Awaiter IoQueue::Write(AsyncFile const& file, uint64 offset, void const* buffer, uint32 size) noexcept
+{
+    return Awaiter(this, file, offset, const_cast<void*>(buffer), size, IoOperation::write);
+}
+
+} // namespace mini
\ No newline at end of file
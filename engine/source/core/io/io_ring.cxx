@@ -0,0 +1,28 @@
+export module mini.core:io_ring;
+
+import :type;
+import :async_file;
+import :io_queue;
+
+namespace mini {
+
+// Kernel submission and completion queue pair, only backed by io_uring on linux.
+// Elsewhere creating one always fails and the IoQueue falls back to its thread pool.
+struct IoRing;
+
+typedef void (*IoRingComplete)(IoRequest&, int64, void*) noexcept;
+
+// Push is not thread safe and has to be serialized by the caller, it fails once the submission queue is full.
+// Submit hands every pushed entry to the kernel. Requests it refused are taken back out of the queue and passed
+// to the refuse function with the negated error, the caller completes them once it released its lock.
+// Reap blocks for at least one completion and hands every available one to the completion function, it returns
+// false when waiting on the kernel failed. It never returns without a completion, so the caller only reaps while
+// entries it counted from the result of Submit are still outstanding.
+IoRing* IoRingCreate(uint32);
+void IoRingDestroy(IoRing*) noexcept;
+bool IoRingRegisterBuffers(IoRing*, IoBuffer const*, size_t);
+bool IoRingPush(IoRing*, IoRequest&) noexcept;
+uint32 IoRingSubmit(IoRing*, IoRingComplete, void*) noexcept;
+bool IoRingReap(IoRing*, IoRingComplete, void*) noexcept;
+
+} // namespace mini
\ No newline at end of file
@@ -0,0 +1,189 @@
+export module mini.core:mapped_file;
+
+import :type;
+import :string_view;
+import :file_platform;
+
+namespace mini {
+
+export enum class MapAccess : uint8 {
+    readOnly,
+    readWrite
+};
+
+// Hints on how a mapped range is about to be touched, applied by the kernel to its readahead and reclaim.
+// hugePage asks for the range to be backed by huge pages where the file system supports it.
+export enum class MapAdvice : int32 {
+    normal,
+    sequential,
+    random,
+    willNeed,
+    dontNeed,
+    hugePage
+};
+
+// File mapped into the address space as a whole, its contents are accessed in place without copying.
+// Views stay valid until the file is closed, and a read only mapping must never be written through.
+// Changes to a read write mapping reach the file eventually, Flush writes them back synchronously.
+export class CORE_API MappedFile {
+private:
+    byte* m_data;
+    size_t m_size;
+    bool m_open;
+    bool m_writable;
+
+public:
+    MappedFile() noexcept;
+    MappedFile(MappedFile&&) noexcept;
+    ~MappedFile();
+
+    bool Open(StringView, MapAccess = MapAccess::readOnly);
+    void Close() noexcept;
+    bool Flush() noexcept;
+
+    bool Advise(MapAdvice) noexcept;
+    bool Advise(size_t, size_t, MapAdvice) noexcept;
+    bool Prefetch(size_t, size_t) noexcept;
+
+    byte const* Data() const noexcept;
+    byte* MutableData() noexcept;
+    StringView View() const noexcept;
+    StringView View(size_t, size_t) const noexcept;
+
+    size_t Size() const noexcept;
+    bool Empty() const noexcept;
+    bool IsOpen() const noexcept;
+    bool IsWritable() const noexcept;
+
+    MappedFile& operator=(MappedFile&&) noexcept;
+
+private:
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+};
+
+inline MappedFile::MappedFile() noexcept
+    : m_data(nullptr)
+    , m_size(0)
+    , m_open(false)
+    , m_writable(false)
+{
+}
+
+inline MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data(other.m_data)
+    , m_size(other.m_size)
+    , m_open(other.m_open)
+    , m_writable(other.m_writable)
+{
+    other.m_data = nullptr;
+    other.m_size = 0;
+    other.m_open = false;
+    other.m_writable = false;
+}
+
+inline MappedFile::~MappedFile()
+{
+    Close();
+}
+
+inline void MappedFile::Close() noexcept
+{
+    // an empty file is open without a mapping, since no platform maps zero bytes
+    if (m_data != nullptr) {
+        FileUnmap(m_data, m_size);
+    }
+
+    m_data = nullptr;
+    m_size = 0;
+    m_open = false;
+    m_writable = false;
+}
+
+inline bool MappedFile::Flush() noexcept
+{
+    ASSERT(m_writable, "only a read write mapping has changes to flush");
+    return m_data == nullptr || FileMapFlush(m_data, m_size);
+}
+
+inline bool MappedFile::Advise(MapAdvice advice) noexcept
+{
+    return Advise(0, m_size, advice);
+}
+
+inline bool MappedFile::Advise(size_t offset, size_t size, MapAdvice advice) noexcept
+{
+    ASSERT(offset <= m_size && size <= m_size - offset, "advised range is out of the mapping");
+    if (size == 0) {
+        return true;
+    }
+
+    // the platform takes whole pages, the mapping itself always starts on a page boundary
+    size_t pageMask = FileMapPageSize() - 1;
+    size_t first = offset & ~pageMask;
+    return FileMapAdvise(m_data + first, offset + size - first, static_cast<int32>(advice));
+}
+
+inline bool MappedFile::Prefetch(size_t offset, size_t size) noexcept
+{
+    return Advise(offset, size, MapAdvice::willNeed);
+}
+
+inline byte const* MappedFile::Data() const noexcept
+{
+    return m_data;
+}
+
+inline byte* MappedFile::MutableData() noexcept
+{
+    ASSERT(m_writable, "writing through a read only mapping");
+    return m_data;
+}
+
+inline StringView MappedFile::View() const noexcept
+{
+    return StringView(reinterpret_cast<char const*>(m_data), m_size);
+}
+
+inline StringView MappedFile::View(size_t offset, size_t size) const noexcept
+{
+    ASSERT(offset <= m_size && size <= m_size - offset, "view is out of the mapping");
+    return StringView(reinterpret_cast<char const*>(m_data) + offset, size);
+}
+
+inline size_t MappedFile::Size() const noexcept
+{
+    return m_size;
+}
+
+inline bool MappedFile::Empty() const noexcept
+{
+    return m_size == 0;
+}
+
+inline bool MappedFile::IsOpen() const noexcept
+{
+    return m_open;
+}
+
+inline bool MappedFile::IsWritable() const noexcept
+{
+    return m_writable;
+}
+
+inline MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    Close();
+
+    m_data = other.m_data;
+    m_size = other.m_size;
+    m_open = other.m_open;
+    m_writable = other.m_writable;
+    other.m_data = nullptr;
+    other.m_size = 0;
+    other.m_open = false;
+    other.m_writable = false;
+    return *this;
+}
+
+} // namespace mini
\ No newline at end of file
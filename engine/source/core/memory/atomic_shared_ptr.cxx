@@ -0,0 +1,318 @@
+export module mini.core:atomic_shared_ptr;
+
+import :type;
+import :utility_operation;
+import :shared_counter;
+import :shared_ptr;
+import :weak_ptr;
+import :atomic_base;
+import :atomic;
+
+namespace mini {
+
+// Pointer and control block are swapped together with a single double word compare exchange.
+// Upper bits of the control block word count the readers that borrowed the block without owning a
+// reference yet, and upper bits of the pointer word hold a generation bumped on every store.
+// Whoever replaces the value pays a reference for each outstanding borrow, so a reader that finds
+// its slot replaced drops that reference instead of giving the borrow back (split reference counting).
+struct AtomicSplitState {
+    uint64 pointer;
+    uint64 counter;
+};
+
+template <typename PtrT>
+class AtomicSplitPtr {
+private:
+    typedef typename PtrT::Value Value;
+    typedef typename PtrT::Pointer Pointer;
+
+    static constexpr bool isWeak = SameAsT<PtrT, WeakPtr<Value>>;
+    static constexpr uint64 tagShift = sizeof(void*) == 8 ? 48 : 32;
+    static constexpr uint64 addressMask = (uint64(1) << tagShift) - 1;
+    static constexpr uint64 borrowUnit = uint64(1) << tagShift;
+    static constexpr uint64 borrowLimit = (uint64(1) << (64 - tagShift)) - 1;
+
+    mutable Atomic<AtomicSplitState> m_state;
+
+public:
+    AtomicSplitPtr() noexcept;
+    AtomicSplitPtr(PtrT) noexcept;
+    ~AtomicSplitPtr() noexcept;
+
+    PtrT Load(MemoryOrder) const noexcept;
+    void Store(PtrT, MemoryOrder) noexcept;
+    PtrT Exchange(PtrT, MemoryOrder) noexcept;
+    bool CompareExchange(PtrT&, PtrT, MemoryOrder) noexcept;
+
+    void Wait(PtrT const&, MemoryOrder) const noexcept;
+    void Notify() const noexcept;
+    void NotifyAll() const noexcept;
+
+    bool IsLockFree() const noexcept;
+
+private:
+    static AtomicSplitState MakeState(PtrT const&, uint64) noexcept;
+    static PtrT AdoptState(AtomicSplitState) noexcept;
+    static PtrT SettleState(AtomicSplitState) noexcept;
+    static void Disown(PtrT&) noexcept;
+
+    static Pointer GetPointer(AtomicSplitState) noexcept;
+    static SharedCounter* GetCounter(AtomicSplitState) noexcept;
+    static uint64 GetBorrowed(AtomicSplitState) noexcept;
+    static uint64 GetGeneration(AtomicSplitState) noexcept;
+    static bool SameSlot(AtomicSplitState, AtomicSplitState) noexcept;
+    static bool Holds(AtomicSplitState, PtrT const&) noexcept;
+
+    static void Retain(SharedCounter*, size_t) noexcept;
+    static void Release(SharedCounter*, size_t) noexcept;
+
+    AtomicSplitPtr(AtomicSplitPtr const&) = delete;
+    AtomicSplitPtr& operator=(AtomicSplitPtr const&) = delete;
+};
+
+export template <NonRefT T>
+class AtomicSharedPtr : public AtomicSplitPtr<SharedPtr<T>> {
+public:
+    using AtomicSplitPtr<SharedPtr<T>>::AtomicSplitPtr;
+};
+
+export template <NonRefT T>
+class AtomicWeakPtr : public AtomicSplitPtr<WeakPtr<T>> {
+public:
+    using AtomicSplitPtr<WeakPtr<T>>::AtomicSplitPtr;
+};
+
+template <typename PtrT>
+inline AtomicSplitPtr<PtrT>::AtomicSplitPtr() noexcept
+    : m_state(AtomicSplitState{ 0, 0 })
+{
+}
+
+template <typename PtrT>
+inline AtomicSplitPtr<PtrT>::AtomicSplitPtr(PtrT ptr) noexcept
+    : m_state(MakeState(ptr, 0))
+{
+    Disown(ptr);
+}
+
+template <typename PtrT>
+inline AtomicSplitPtr<PtrT>::~AtomicSplitPtr() noexcept
+{
+    AtomicSplitState state = m_state.Load(MemoryOrder::acquire);
+    ASSERT(GetBorrowed(state) == 0, "atomic pointer destroyed while being loaded");
+
+    if (SharedCounter* counter = GetCounter(state); counter != nullptr) {
+        Release(counter, 1);
+    }
+}
+
+template <typename PtrT>
+inline PtrT AtomicSplitPtr<PtrT>::Load(MemoryOrder order) const noexcept
+{
+    AtomicSplitState state = m_state.Load(MemoryOrder::relaxed);
+    AtomicSplitState borrowed;
+
+    // borrow the block, which keeps it alive until we own a reference of it
+    for (;;) {
+        if (GetCounter(state) == nullptr) {
+            return AdoptState(state);
+        }
+
+        ASSERT(GetBorrowed(state) < borrowLimit, "too many concurrent loads on atomic pointer");
+        borrowed = state;
+        borrowed.counter += borrowUnit;
+
+        if (m_state.CompareExchangeWeak(state, borrowed, order, MemoryOrder::relaxed)) {
+            break;
+        }
+    }
+
+    SharedCounter* counter = GetCounter(borrowed);
+    Retain(counter, 1);
+
+    // give the borrow back, unless the slot has been replaced and the borrow was paid for
+    AtomicSplitState current = borrowed;
+    for (;;) {
+        if (!SameSlot(current, borrowed)) {
+            Release(counter, 1);
+            break;
+        }
+
+        AtomicSplitState returned = current;
+        returned.counter -= borrowUnit;
+
+        if (m_state.CompareExchangeWeak(current, returned, MemoryOrder::relaxed, MemoryOrder::relaxed)) {
+            break;
+        }
+    }
+
+    return AdoptState(borrowed);
+}
+
+template <typename PtrT>
+inline void AtomicSplitPtr<PtrT>::Store(PtrT desired, MemoryOrder order) noexcept
+{
+    Exchange(MoveArg(desired), order);
+}
+
+template <typename PtrT>
+inline PtrT AtomicSplitPtr<PtrT>::Exchange(PtrT desired, MemoryOrder order) noexcept
+{
+    AtomicSplitState state = m_state.Load(MemoryOrder::relaxed);
+    AtomicSplitState next;
+
+    do {
+        next = MakeState(desired, GetGeneration(state) + 1);
+    } while (!m_state.CompareExchangeWeak(state, next, order, MemoryOrder::relaxed));
+
+    Disown(desired);
+    return SettleState(state);
+}
+
+template <typename PtrT>
+inline bool AtomicSplitPtr<PtrT>::CompareExchange(PtrT& expected, PtrT desired, MemoryOrder order) noexcept
+{
+    AtomicSplitState state = m_state.Load(MemoryOrder::relaxed);
+
+    // borrow count may change under us, so only a change of the slot itself fails the exchange
+    for (;;) {
+        if (!Holds(state, expected)) {
+            expected = Load(order == MemoryOrder::release ? MemoryOrder::relaxed : order);
+            return false;
+        }
+
+        AtomicSplitState next = MakeState(desired, GetGeneration(state) + 1);
+        if (m_state.CompareExchangeWeak(state, next, order, MemoryOrder::relaxed)) {
+            break;
+        }
+    }
+
+    Disown(desired);
+    SettleState(state);
+    return true;
+}
+
+template <typename PtrT>
+inline void AtomicSplitPtr<PtrT>::Wait(PtrT const& old, MemoryOrder order) const noexcept
+{
+    AtomicSplitState state = m_state.Load(order);
+    while (Holds(state, old)) {
+        m_state.Wait(state, order);
+        state = m_state.Load(order);
+    }
+}
+
+template <typename PtrT>
+inline void AtomicSplitPtr<PtrT>::Notify() const noexcept
+{
+    m_state.Notify();
+}
+
+template <typename PtrT>
+inline void AtomicSplitPtr<PtrT>::NotifyAll() const noexcept
+{
+    m_state.NotifyAll();
+}
+
+template <typename PtrT>
+inline bool AtomicSplitPtr<PtrT>::IsLockFree() const noexcept
+{
+    return m_state.IsLockFree();
+}
+
+template <typename PtrT>
+inline AtomicSplitState AtomicSplitPtr<PtrT>::MakeState(PtrT const& ptr, uint64 generation) noexcept
+{
+    uint64 pointer = static_cast<uint64>(reinterpret_cast<size_t>(ptr.m_ptr));
+    uint64 counter = static_cast<uint64>(reinterpret_cast<size_t>(ptr.m_counter));
+    ASSERT((pointer & ~addressMask) == 0 && (counter & ~addressMask) == 0, "address exceeds the tagging range");
+
+    return AtomicSplitState{ pointer | (generation << tagShift), counter };
+}
+
+template <typename PtrT>
+inline PtrT AtomicSplitPtr<PtrT>::AdoptState(AtomicSplitState state) noexcept
+{
+    PtrT result;
+    result.m_ptr = GetPointer(state);
+    result.m_counter = GetCounter(state);
+    return result;
+}
+
+template <typename PtrT>
+inline PtrT AtomicSplitPtr<PtrT>::SettleState(AtomicSplitState state) noexcept
+{
+    // pay for the loads that borrowed the block but did not give it back yet
+    SharedCounter* counter = GetCounter(state);
+    uint64 borrowed = GetBorrowed(state);
+    if (counter != nullptr && borrowed != 0) {
+        Retain(counter, static_cast<size_t>(borrowed));
+    }
+
+    return AdoptState(state);
+}
+
+template <typename PtrT>
+inline void AtomicSplitPtr<PtrT>::Disown(PtrT& ptr) noexcept
+{
+    ptr.m_ptr = nullptr;
+    ptr.m_counter = nullptr;
+}
+
+template <typename PtrT>
+inline AtomicSplitPtr<PtrT>::Pointer AtomicSplitPtr<PtrT>::GetPointer(AtomicSplitState state) noexcept
+{
+    return reinterpret_cast<Pointer>(static_cast<size_t>(state.pointer & addressMask));
+}
+
+template <typename PtrT>
+inline SharedCounter* AtomicSplitPtr<PtrT>::GetCounter(AtomicSplitState state) noexcept
+{
+    return reinterpret_cast<SharedCounter*>(static_cast<size_t>(state.counter & addressMask));
+}
+
+template <typename PtrT>
+inline uint64 AtomicSplitPtr<PtrT>::GetBorrowed(AtomicSplitState state) noexcept
+{
+    return state.counter >> tagShift;
+}
+
+template <typename PtrT>
+inline uint64 AtomicSplitPtr<PtrT>::GetGeneration(AtomicSplitState state) noexcept
+{
+    return state.pointer >> tagShift;
+}
+
+template <typename PtrT>
+inline bool AtomicSplitPtr<PtrT>::SameSlot(AtomicSplitState l, AtomicSplitState r) noexcept
+{
+    return l.pointer == r.pointer && (l.counter & addressMask) == (r.counter & addressMask);
+}
+
+template <typename PtrT>
+inline bool AtomicSplitPtr<PtrT>::Holds(AtomicSplitState state, PtrT const& ptr) noexcept
+{
+    return GetPointer(state) == ptr.m_ptr && GetCounter(state) == ptr.m_counter;
+}
+
+template <typename PtrT>
+inline void AtomicSplitPtr<PtrT>::Retain(SharedCounter* counter, size_t count) noexcept
+{
+    if constexpr (isWeak) {
+        counter->RetainWeak(count);
+    } else {
+        counter->Retain(count);
+    }
+}
+
+template <typename PtrT>
+inline void AtomicSplitPtr<PtrT>::Release(SharedCounter* counter, size_t count) noexcept
+{
+    if constexpr (isWeak) {
+        counter->ReleaseWeak(count);
+    } else {
+        counter->Release(count);
+    }
+}
+
+} // namespace mini
\ No newline at end of file
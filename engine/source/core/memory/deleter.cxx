@@ -10,6 +10,14 @@ concept DeleterT = NoThrowCopyableT<T> && requires(T del, Value* ptr) { del(ptr)
 export template <NonArrT T>
 struct DefaultDeleter {
 public:
+    constexpr DefaultDeleter() noexcept = default;
+
+    // lets an owner of a derived object be moved into an owner of its base
+    template <PtrConvertibleToT<T> U>
+    constexpr DefaultDeleter(DefaultDeleter<U> const&) noexcept
+    {
+    }
+
     inline constexpr void operator()(T* ptr) { delete ptr; }
 };
 
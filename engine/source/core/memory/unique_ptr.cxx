@@ -31,7 +31,7 @@ public:
     constexpr UniquePtr(nullptr_t) noexcept;
 
     template <PtrConvertibleToT<T> U, DeleterT<U> DelU>
-    constexpr UniquePtr(UniquePtr<T, DelU>&&) noexcept
+    constexpr UniquePtr(UniquePtr<U, DelU>&&) noexcept
         requires ConvertibleToT<DelU, DelT>;
 
     constexpr Pointer Get() const noexcept;
@@ -58,7 +58,7 @@ public:
 
 private:
     template <PtrConvertibleToT<T> U, DeleterT<U> DelU>
-    UniquePtr(UniquePtr<T, DelU> const&) = delete;
+    UniquePtr(UniquePtr<U, DelU> const&) = delete;
     UniquePtr(UniquePtr const&) = delete;
 
     template <PtrConvertibleToT<T> U, DeleterT<U> DelU>
@@ -118,11 +118,12 @@ inline constexpr UniquePtr<T, DelT>::UniquePtr(nullptr_t) noexcept
 
 template <NonRefT T, DeleterT<T> DelT>
 template <PtrConvertibleToT<T> U, DeleterT<U> DelU>
-inline constexpr UniquePtr<T, DelT>::UniquePtr(UniquePtr<T, DelU>&& other) noexcept
+inline constexpr UniquePtr<T, DelT>::UniquePtr(UniquePtr<U, DelU>&& other) noexcept
     requires ConvertibleToT<DelU, DelT>
     : m_ptr(static_cast<Pointer>(other.m_ptr))
     , m_deleter(MoveArg(other.m_deleter))
 {
+    other.m_ptr = nullptr;
 }
 
 template <NonRefT T, DeleterT<T> DelT>
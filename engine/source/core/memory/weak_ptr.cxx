@@ -13,6 +13,8 @@ private:
     friend class SharedPtr;
     template <NonRefT U>
     friend class WeakPtr;
+    template <typename U>
+    friend class AtomicSplitPtr;
 
 public:
     typedef T Value;
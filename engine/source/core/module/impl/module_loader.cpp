@@ -0,0 +1,498 @@
+module;
+
+#include <coroutine>
+
+module mini.core;
+
+import :type;
+import :utility_operation;
+import :array;
+import :string_view;
+import :string;
+import :initializer_list;
+import :unique_ptr;
+import :shared_ptr;
+import :weak_ptr;
+import :atomic_base;
+import :atomic;
+import :mutex;
+import :thread;
+import :duration;
+import :time_point;
+import :cycle_clock;
+import :task;
+import :scheduler;
+import :profiler;
+import :histogram;
+import :metrics;
+import :logger;
+import :module_platform;
+import :module_system;
+import :module_loader;
+import :module_startup;
+
+namespace mini {
+
+static constexpr uint32 moduleIdle = 0;
+static constexpr uint32 moduleLoading = 1;
+
+static constexpr size_t minSlotCount = 16;
+
+struct ModuleGraphNode {
+public:
+    ModuleEntry* entry;
+    Array<ModuleGraphNode*> dependencies;
+    Array<ModuleGraphNode*> dependents;
+    Atomic<uint32> waiting;
+    SharedPtr<ModuleHandle> handle;
+    bool mainThread;
+    bool visited;
+};
+
+// State of a single LoadGraph call. Nodes are released once all of their dependencies finished, main thread
+// nodes are queued for the calling thread and every other node is spawned on the scheduler.
+struct ModuleGraph {
+public:
+    Array<UniquePtr<ModuleGraphNode>> nodes;
+    Array<ModuleGraphNode*> mainReady;
+    Array<SharedPtr<ModuleHandle>>* handles;
+    Scheduler* scheduler;
+    CycleClock::TimePoint begin;
+    Mutex lock;
+    Atomic<uint32> remaining;
+    Atomic<uint32> signal;
+};
+
+static Mutex& GetModuleLock()
+{
+    // never freed, static modules register while the statics of the core are still being initialized
+    static Mutex* lock = new Mutex();
+    return *lock;
+}
+
+static uint64 HashModuleName(StringView name) noexcept
+{
+    uint64 hash = 0xcbf2'9ce4'8422'2325ull;
+    for (size_t i = 0; i < name.Size(); ++i) {
+        hash ^= static_cast<uint8>(name[i]);
+        hash *= 0x0000'0100'0000'01b3ull;
+    }
+
+    return hash;
+}
+
+static void InsertSlot(Array<ModuleEntry*>& slots, ModuleEntry* entry) noexcept
+{
+    size_t mask = slots.Size() - 1;
+    size_t slot = static_cast<size_t>(entry->hash) & mask;
+    while (slots[slot] != nullptr) {
+        slot = (slot + 1) & mask;
+    }
+
+    slots[slot] = entry;
+}
+
+static void ReleaseGraphNode(ModuleGraph&, ModuleGraphNode*);
+
+static void RunGraphNode(ModuleGraph& graph, ModuleGraphNode* node)
+{
+    // a module is never initialized without its dependencies, it fails along with them
+    bool ready = true;
+    for (ModuleGraphNode* dependency : node->dependencies) {
+        ready = ready && dependency->handle.Valid();
+    }
+
+    if (ready) {
+        Mutex& lock = GetModuleLock();
+        lock.Lock();
+        node->entry->dependencyWait = CycleClock::Now() - graph.begin;
+        lock.Unlock();
+
+        node->handle = g_moduleLoader.Load(node->entry->name);
+    }
+
+    if (node->handle.Valid()) {
+        graph.lock.Lock();
+        graph.handles->Push(node->handle);
+        graph.lock.Unlock();
+    }
+
+    for (ModuleGraphNode* dependent : node->dependents) {
+        if (dependent->waiting.FetchSub(1, MemoryOrder::acquireRelease) == 1) {
+            ReleaseGraphNode(graph, dependent);
+        }
+    }
+
+    graph.remaining.FetchSub(1, MemoryOrder::acquireRelease);
+    graph.signal.FetchAdd(1, MemoryOrder::release);
+    graph.signal.NotifyAll();
+}
+
+static Task<void> LoadGraphNode(ModuleGraph& graph, ModuleGraphNode* node)
+{
+    co_await graph.scheduler->Schedule();
+    RunGraphNode(graph, node);
+}
+
+static void ReleaseGraphNode(ModuleGraph& graph, ModuleGraphNode* node)
+{
+    if (!node->mainThread) {
+        graph.scheduler->Spawn(LoadGraphNode(graph, node));
+        return;
+    }
+
+    graph.lock.Lock();
+    graph.mainReady.Push(node);
+    graph.lock.Unlock();
+
+    graph.signal.FetchAdd(1, MemoryOrder::release);
+    graph.signal.NotifyAll();
+}
+
+bool ModuleLoader::RegisterUninitialized(StringView name, SharedPtr<ModuleHandle> handle)
+{
+    Mutex& lock = GetModuleLock();
+    lock.Lock();
+
+    ModuleEntry* entry = FindOrAdd(name);
+    bool registered = !entry->pending.Valid();
+    if (registered) {
+        entry->pending = MoveArg(handle);
+    }
+
+    lock.Unlock();
+    return registered;
+}
+
+SharedPtr<ModuleHandle> ModuleLoader::Load(StringView name)
+{
+    PROFILE_SCOPE("ModuleLoader::Load");
+
+    CycleClock::TimePoint requested = CycleClock::Now();
+    Mutex& lock = GetModuleLock();
+    lock.Lock();
+
+    ModuleEntry* entry = FindOrAdd(name);
+    for (;;) {
+        SharedPtr<ModuleHandle> loaded = entry->handle.Lock();
+        if (loaded.Valid()) {
+            entry->dependencyWait = NanoSeconds(0);
+            lock.Unlock();
+            return loaded;
+        }
+
+        if (entry->state.Load(MemoryOrder::relaxed) != moduleLoading) {
+            break;
+        }
+
+        // another thread loads the module, its handle is shared once it is initialized
+        lock.Unlock();
+        entry->state.Wait(moduleLoading, MemoryOrder::acquire);
+        lock.Lock();
+    }
+
+    entry->state.Store(moduleLoading, MemoryOrder::relaxed);
+    NanoSeconds dependencyWait = entry->dependencyWait;
+    entry->dependencyWait = NanoSeconds(0);
+    lock.Unlock();
+
+    size_t residentBefore = ProcessResidentMemory();
+    CycleClock::TimePoint loadBegin = CycleClock::Now();
+
+    // initialization may load other modules, so the lock is not held while loading
+    bool dynamic = false;
+    SharedPtr<ModuleHandle> handle = LoadHandle(entry, dynamic);
+    if (handle.Valid()) {
+        ModuleStartupRecord record;
+        record.name = entry->name;
+        record.thread = Thread::CurrentId();
+        record.begin = loadBegin.SinceEpoch().Count();
+        record.wait = dependencyWait + (loadBegin - requested);
+        record.open = handle->OpenTime();
+        record.start = handle->StartTime();
+        record.dynamic = dynamic;
+
+        CycleClock::TimePoint initializeBegin = CycleClock::Now();
+        {
+            PROFILE_SCOPE("ModuleInterface::Initialize");
+            ModuleInterface* interface = handle->GetInterface();
+            record.loaded = interface == nullptr || interface->Initialize();
+        }
+
+        record.initialize = CycleClock::Now() - initializeBegin;
+        record.residentDelta = static_cast<int64>(ProcessResidentMemory()) - static_cast<int64>(residentBefore);
+        ModuleStartup::Record(record);
+
+        if (!record.loaded) {
+            handle.Reset();
+        }
+    }
+
+    lock.Lock();
+    if (handle.Valid()) {
+        entry->handle = handle;
+    }
+
+    entry->state.Store(moduleIdle, MemoryOrder::release);
+    lock.Unlock();
+
+    entry->state.NotifyAll();
+    return handle;
+}
+
+bool ModuleLoader::LoadGraph(InitializerList<StringView> names,
+                             Array<SharedPtr<ModuleHandle>>& handles,
+                             uint32 threadCount)
+{
+    PROFILE_SCOPE("ModuleLoader::LoadGraph");
+
+    ModuleGraph graph;
+    graph.handles = &handles;
+
+    Mutex& lock = GetModuleLock();
+    lock.Lock();
+
+    bool acyclic = true;
+    for (StringView name : names) {
+        acyclic = acyclic && Collect(graph, FindOrAdd(name)) != nullptr;
+    }
+
+    lock.Unlock();
+    ENSURE(acyclic, "module dependencies form a cycle") {
+        return false;
+    }
+
+    // roots are gathered first, a node released while iterating may already finish its dependents
+    Array<ModuleGraphNode*> roots;
+    uint32 workerNodes = 0;
+    for (UniquePtr<ModuleGraphNode> const& node : graph.nodes) {
+        node->waiting.Store(static_cast<uint32>(node->dependencies.Size()), MemoryOrder::relaxed);
+        workerNodes += node->mainThread ? 0 : 1;
+        if (node->dependencies.Empty()) {
+            roots.Push(node.Get());
+        }
+    }
+
+    graph.remaining.Store(static_cast<uint32>(graph.nodes.Size()), MemoryOrder::release);
+
+    // declared after the graph, so its workers are joined before the graph goes. A graph of main thread
+    // modules only, such as the one of the engine, starts no worker at all, and no more than it could use
+    UniquePtr<Scheduler> scheduler;
+    if (workerNodes != 0) {
+        if (threadCount == 0) {
+            threadCount = static_cast<uint32>(CpuTopology::Get().PhysicalCount());
+        }
+
+        ThreadOptions options;
+        options.name = "mini.module";
+        scheduler = MakeUnique<Scheduler>(threadCount < workerNodes ? threadCount : workerNodes, options);
+    }
+
+    graph.scheduler = scheduler.Get();
+    graph.begin = CycleClock::Now();
+
+    for (ModuleGraphNode* root : roots) {
+        ReleaseGraphNode(graph, root);
+    }
+
+    while (graph.remaining.Load(MemoryOrder::acquire) != 0) {
+        uint32 signal = graph.signal.Load(MemoryOrder::acquire);
+
+        ModuleGraphNode* node = nullptr;
+        graph.lock.Lock();
+        if (!graph.mainReady.Empty()) {
+            node = graph.mainReady.Last();
+            graph.mainReady.RemoveLast();
+        }
+        graph.lock.Unlock();
+
+        if (node != nullptr) {
+            RunGraphNode(graph, node);
+            continue;
+        }
+
+        if (graph.remaining.Load(MemoryOrder::acquire) == 0) {
+            break;
+        }
+
+        graph.signal.Wait(signal, MemoryOrder::acquire);
+    }
+
+    bool loaded = true;
+    for (UniquePtr<ModuleGraphNode> const& node : graph.nodes) {
+        loaded = loaded && node->handle.Valid();
+    }
+
+    return loaded;
+}
+
+void ModuleLoader::Declare(StringView name, InitializerList<StringView> dependencies, bool mainThread)
+{
+    Mutex& lock = GetModuleLock();
+    lock.Lock();
+
+    ModuleEntry* entry = FindOrAdd(name);
+    entry->dependencies.Clear();
+    for (StringView dependency : dependencies) {
+        entry->dependencies.Push(String(dependency));
+    }
+
+    entry->mainThread = mainThread;
+    lock.Unlock();
+}
+
+void ModuleLoader::SetBinding(StringView name, ModuleBinding binding)
+{
+    Mutex& lock = GetModuleLock();
+    lock.Lock();
+    FindOrAdd(name)->binding = binding;
+    lock.Unlock();
+}
+
+ModuleBinding ModuleLoader::GetBinding(StringView name) const noexcept
+{
+    Mutex& lock = GetModuleLock();
+    lock.Lock();
+
+    ModuleEntry* entry = Find(name);
+    ModuleBinding binding = entry != nullptr ? entry->binding : ModuleBinding::immediate;
+
+    lock.Unlock();
+    return binding;
+}
+
+size_t ModuleLoader::Count() const noexcept
+{
+    Mutex& lock = GetModuleLock();
+    lock.Lock();
+
+    size_t count = 0;
+    for (UniquePtr<ModuleEntry> const& entry : m_entries) {
+        if (entry->handle.Valid()) ++count;
+    }
+
+    lock.Unlock();
+    return count;
+}
+
+ModuleEntry* ModuleLoader::Find(StringView name) const noexcept
+{
+    if (m_slots.Empty()) {
+        return nullptr;
+    }
+
+    uint64 hash = HashModuleName(name);
+    size_t mask = m_slots.Size() - 1;
+    for (size_t slot = static_cast<size_t>(hash) & mask;; slot = (slot + 1) & mask) {
+        ModuleEntry* entry = m_slots[slot];
+        if (entry == nullptr) {
+            return nullptr;
+        }
+
+        if (entry->hash == hash && entry->name == name) {
+            return entry;
+        }
+    }
+}
+
+ModuleEntry* ModuleLoader::FindOrAdd(StringView name)
+{
+    ModuleEntry* entry = Find(name);
+    if (entry != nullptr) {
+        return entry;
+    }
+
+    // slots are kept at most half full
+    if ((m_entries.Size() + 1) * 2 > m_slots.Size()) {
+        Rehash(m_slots.Empty() ? minSlotCount : m_slots.Size() * 2);
+    }
+
+    UniquePtr<ModuleEntry> created(new ModuleEntry());
+    created->name = String(name);
+    created->hash = HashModuleName(name);
+    created->binding = ModuleBinding::immediate;
+    created->mainThread = false;
+    created->dependencyWait = NanoSeconds(0);
+
+    entry = created.Get();
+    m_entries.Push(MoveArg(created));
+    InsertSlot(m_slots, entry);
+
+    return entry;
+}
+
+void ModuleLoader::Rehash(size_t slotCount)
+{
+    m_slots.Clear();
+    m_slots.Resize(slotCount, nullptr);
+
+    for (UniquePtr<ModuleEntry> const& entry : m_entries) {
+        InsertSlot(m_slots, entry.Get());
+    }
+}
+
+ModuleGraphNode* ModuleLoader::Collect(ModuleGraph& graph, ModuleEntry* entry)
+{
+    for (UniquePtr<ModuleGraphNode> const& node : graph.nodes) {
+        if (node->entry == entry) {
+            // reaching a node that is still being visited closes a cycle
+            return node->visited ? node.Get() : nullptr;
+        }
+    }
+
+    UniquePtr<ModuleGraphNode> created(new ModuleGraphNode());
+    created->entry = entry;
+    created->mainThread = entry->mainThread;
+    created->visited = false;
+
+    ModuleGraphNode* node = created.Get();
+    graph.nodes.Push(MoveArg(created));
+
+    for (String const& name : entry->dependencies) {
+        ModuleGraphNode* dependency = Collect(graph, FindOrAdd(name));
+        if (dependency == nullptr) {
+            return nullptr;
+        }
+
+        node->dependencies.Push(dependency);
+        dependency->dependents.Push(node);
+    }
+
+    node->visited = true;
+    return node;
+}
+
+SharedPtr<ModuleHandle> ModuleLoader::LoadHandle(ModuleEntry* entry, bool& dynamic)
+{
+    PROFILE_SCOPE("ModuleLoader::LoadHandle");
+
+    Mutex& lock = GetModuleLock();
+    lock.Lock();
+    SharedPtr<ModuleHandle> pending = MoveArg(entry->pending);
+    ModuleBinding binding = entry->binding;
+    lock.Unlock();
+
+    if (pending.Valid()) {
+        return pending;
+    }
+
+    SharedPtr<DynamicModuleHandle> dynHandle = MakeShared<DynamicModuleHandle>(entry->name, binding);
+    if (dynHandle->Valid()) {
+        dynamic = true;
+        ReportLoadTime(entry->name, dynHandle->LoadTime());
+        return StaticCast<ModuleHandle>(MoveArg(dynHandle));
+    }
+
+    return nullptr;
+}
+
+void ModuleLoader::ReportLoadTime(StringView name, NanoSeconds loadTime)
+{
+    static Logger moduleLogger = Logger("Module");
+    static Histogram& loadTimes = Metrics::GetHistogram("module.load");
+
+    loadTimes.Record(loadTime);
+    moduleLogger.Info("{} loaded in {} us", name, DurationCast<MicroSeconds>(loadTime).Count());
+}
+
+} // namespace mini
\ No newline at end of file
@@ -0,0 +1,188 @@
+module mini.core;
+
+import :type;
+import :array;
+import :string_view;
+import :string;
+import :format;
+import :mutex;
+import :duration;
+import :logger;
+import :async_file;
+import :module_startup;
+
+namespace mini {
+
+struct StartupRegistry {
+    Mutex lock;
+    Array<ModuleStartupRecord> records;
+};
+
+static StartupRegistry& GetStartupRegistry()
+{
+    // never freed, modules still load and unload while statics are destroyed
+    static StartupRegistry* registry = new StartupRegistry();
+    return *registry;
+}
+
+static int64 ToMicroSeconds(NanoSeconds duration) noexcept
+{
+    return DurationCast<MicroSeconds>(duration).Count();
+}
+
+static void AppendTraceTime(String& out, int64 nanoSeconds)
+{
+    // trace timestamps are in microseconds, printed with nanosecond precision
+    FormatTo(out, "{}.{:03}", nanoSeconds / 1000, nanoSeconds % 1000);
+}
+
+static void AppendTraceEvent(String& out, StringView name, StringView phase, uint64 thread, int64 begin, int64 end)
+{
+    FormatTo(out,
+             ",\n{{\"name\":\"{} {}\",\"cat\":\"startup\",\"ph\":\"X\",\"pid\":0,\"tid\":{},\"ts\":",
+             name,
+             phase,
+             thread);
+    AppendTraceTime(out, begin);
+    out.Append(StringView(",\"dur\":"));
+    AppendTraceTime(out, end > begin ? end - begin : 0);
+    out.Push('}');
+}
+
+static bool WriteWholeFile(StringView path, String const& content)
+{
+    FileOpenOptions options;
+    options.write = true;
+    options.create = true;
+
+    AsyncFile file;
+    return file.Open(path, options) &&
+           file.WriteAt(0, content.Data(), content.Size()) == static_cast<int64>(content.Size());
+}
+
+template <typename Func>
+static void ForEachStartupLine(Func&& func)
+{
+    Array<ModuleStartupRecord> records;
+    ModuleStartup::Collect(records);
+
+    NanoSeconds total(0);
+    String line;
+    for (ModuleStartupRecord const& record : records) {
+        NanoSeconds load = record.open + record.start + record.initialize;
+        total += load;
+
+        line.Clear();
+        FormatTo(line,
+                 "module {} {} total={}us wait={}us open={}us start={}us initialize={}us resident={:+}KiB thread={}{}",
+                 StringView(record.name),
+                 record.dynamic ? "dynamic" : "static",
+                 ToMicroSeconds(load),
+                 ToMicroSeconds(record.wait),
+                 ToMicroSeconds(record.open),
+                 ToMicroSeconds(record.start),
+                 ToMicroSeconds(record.initialize),
+                 record.residentDelta / 1024,
+                 record.thread,
+                 record.loaded ? "" : " failed");
+        func(line);
+    }
+
+    // modules loaded concurrently are all counted, so this is the work done rather than the time it took
+    line.Clear();
+    FormatTo(line, "modules {} total={}us", records.Size(), ToMicroSeconds(total));
+    func(line);
+}
+
+void ModuleStartup::Record(ModuleStartupRecord const& record)
+{
+    StartupRegistry& registry = GetStartupRegistry();
+    registry.lock.Lock();
+    registry.records.Push(record);
+    registry.lock.Unlock();
+}
+
+void ModuleStartup::Clear()
+{
+    StartupRegistry& registry = GetStartupRegistry();
+    registry.lock.Lock();
+    registry.records.Clear();
+    registry.lock.Unlock();
+}
+
+void ModuleStartup::Collect(Array<ModuleStartupRecord>& records)
+{
+    StartupRegistry& registry = GetStartupRegistry();
+    registry.lock.Lock();
+    for (ModuleStartupRecord const& record : registry.records) {
+        records.Push(record);
+    }
+    registry.lock.Unlock();
+}
+
+void ModuleStartup::Report(String& out)
+{
+    ForEachStartupLine([&out](String const& line) {
+        out.Append(line);
+        out.Push('\n');
+    });
+}
+
+void ModuleStartup::Log()
+{
+    static Logger logger("Startup");
+    ForEachStartupLine([](String const& line) { logger.Info("{}", StringView(line)); });
+}
+
+bool ModuleStartup::WriteReport(StringView path)
+{
+    String report;
+    Report(report);
+    return WriteWholeFile(path, report);
+}
+
+void ModuleStartup::ExportTrace(String& out)
+{
+    Array<ModuleStartupRecord> records;
+    Collect(records);
+
+    // timestamps start at the earliest wait, which keeps them short and the trace readable
+    int64 origin = records.Empty() ? 0 : records[0].begin;
+    for (ModuleStartupRecord const& record : records) {
+        int64 begin = record.begin - record.wait.Count();
+        origin = begin < origin ? begin : origin;
+    }
+
+    out.Append(StringView("{\"traceEvents\":[\n"));
+    out.Append(StringView("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"startup\"}}"));
+
+    for (ModuleStartupRecord const& record : records) {
+        int64 open = record.begin - origin;
+        int64 start = open + record.open.Count();
+        // the factory of a static module ran at registration, its initialization follows the wait
+        int64 initialize = record.dynamic ? start + record.start.Count() : open;
+        int64 end = initialize + record.initialize.Count();
+
+        if (record.wait.Count() != 0) {
+            AppendTraceEvent(out, record.name, "wait", record.thread, open - record.wait.Count(), open);
+        }
+
+        if (record.dynamic) {
+            AppendTraceEvent(out, record.name, "open", record.thread, open, start);
+            AppendTraceEvent(out, record.name, "start", record.thread, start, initialize);
+        }
+
+        AppendTraceEvent(out, record.name, "initialize", record.thread, initialize, end);
+    }
+
+    out.Append(StringView("\n]}\n"));
+}
+
+bool ModuleStartup::ExportTraceToFile(StringView path)
+{
+    String trace;
+    ExportTrace(trace);
+    return WriteWholeFile(path, trace);
+}
+
+} // namespace mini
\ No newline at end of file
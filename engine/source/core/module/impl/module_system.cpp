@@ -5,6 +5,7 @@ import :string_view;
 import :shared_ptr;
 import :weak_ptr;
 import :algorithm;
+import :duration;
 import :module_system;
 import :module_loader;
 
@@ -18,6 +19,8 @@ ModuleHandle::ModuleHandle(ModulePoilcy const* policy,
     , m_nativeModule(nativeModule)
     , m_interface(interface)
     , m_libraryName(libraryName)
+    , m_openTime(0)
+    , m_startTime(0)
 {
 }
 
@@ -87,83 +90,28 @@ ModuleInterface* ModuleHandle::GetInterface() const noexcept
     return m_interface.Get();
 }
 
-SharedPtr<ModuleHandle> ModuleHandle::Load(StringView libName)
-{
-    if (libName.Empty()) [[unlikely]] {
-        return SharedPtr<ModuleHandle>();
-    }
-
-    return g_moduleLoader.Load(libName);
-}
-
-bool ModuleLoader::RegisterUninitialized(StringView name, SharedPtr<ModuleHandle> handle)
+NanoSeconds ModuleHandle::OpenTime() const noexcept
 {
-    RefIterator refIter = FindIf(m_uninitialized.Begin(),
-                                 m_uninitialized.End(),
-                                 [&name](ModuleRef const& ref) noexcept { return ref.name == name; });
-
-    if (refIter != m_uninitialized.End()) {
-        return false;
-    }
-
-    m_uninitialized.Push(ModuleRef{ .handle = MoveArg(handle), .name = name });
-    return true;
+    return m_openTime;
 }
 
-SharedPtr<ModuleHandle> ModuleLoader::Load(StringView name)
+NanoSeconds ModuleHandle::StartTime() const noexcept
 {
-    WeakRefIterator weakRefIter = FindIf(m_modules.Begin(),
-                                         m_modules.End(),
-                                         [&name](ModuleWeakRef const& ref) noexcept { return ref.name == name; });
-
-    if (weakRefIter != m_modules.End()) {
-        if (weakRefIter->handle.Valid()) {
-            return StaticCast<ModuleHandle>(weakRefIter->handle.Lock());
-        }
-
-        m_modules.RemoveAt(weakRefIter);
-    }
-
-    SharedPtr<ModuleHandle> handle = LoadHandle(name);
-    if (handle.Valid() == false) {
-        return nullptr;
-    }
-
-    ModuleInterface* interface = handle->GetInterface();
-    if (interface != nullptr && interface->Initialize() == false) {
-        return nullptr;
-    }
-
-    m_modules.Push(ModuleWeakRef{ .handle = handle, .name = name });
-    return handle;
+    return m_startTime;
 }
 
-SharedPtr<ModuleHandle> ModuleLoader::LoadHandle(StringView name)
+NanoSeconds ModuleHandle::LoadTime() const noexcept
 {
-    RefIterator refIter = FindIf(m_uninitialized.Begin(),
-                                 m_uninitialized.End(),
-                                 [&name](ModuleRef const& ref) noexcept { return ref.name == name; });
-
-    if (refIter != m_uninitialized.End()) {
-        return StaticCast<ModuleHandle>(MoveArg(refIter->handle));
-    }
-
-    SharedPtr<DynamicModuleHandle> dynHandle = MakeShared<DynamicModuleHandle>(name);
-    if (dynHandle->Valid()) {
-        return StaticCast<ModuleHandle>(MoveArg(dynHandle));
-    }
-
-    return nullptr;
+    return m_openTime + m_startTime;
 }
 
-size_t ModuleLoader::Count() const noexcept
+SharedPtr<ModuleHandle> ModuleHandle::Load(StringView libName)
 {
-    size_t count = 0;
-    for (auto const& mod : m_modules) {
-        if (mod.handle.Valid()) ++count;
+    if (libName.Empty()) [[unlikely]] {
+        return SharedPtr<ModuleHandle>();
     }
 
-    return count;
+    return g_moduleLoader.Load(libName);
 }
 
 } // namespace mini
\ No newline at end of file
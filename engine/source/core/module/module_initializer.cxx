@@ -2,6 +2,9 @@ export module mini.core:module_initializer;
 
 import :type;
 import :string_view;
+import :duration;
+import :time_point;
+import :cycle_clock;
 import :module_system;
 import :module_loader;
 
@@ -16,8 +19,11 @@ private:
 public:
     static void Register(StringView name)
     {
+        CycleClock::TimePoint startBegin = CycleClock::Now();
         ModuleInterface* interface = FactoryT{}();
-        SharedPtr<StaticModuleHandle> handle = MakeShared<StaticModuleHandle>(name, interface);
+        NanoSeconds startTime = CycleClock::Now() - startBegin;
+
+        SharedPtr<StaticModuleHandle> handle = MakeShared<StaticModuleHandle>(name, interface, startTime);
         g_moduleLoader.RegisterUninitialized(name, StaticCast<ModuleHandle>(MoveArg(handle)));
     }
 };
@@ -0,0 +1,84 @@
+module;
+
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+export module mini.core:module_platform;
+
+import :type;
+import :string;
+import :string_view;
+import :memory_operation;
+
+namespace mini {
+
+using NativeModuleHandle = void*;
+
+String BuildModulePath(StringView name)
+{
+    StringView prefix = MODULE_OUTPUT_PREFIX;
+    StringView suffix = MODULE_OUTPUT_SUFFIX;
+
+    String modulePath(prefix.Size() + name.Size() + suffix.Size());
+    modulePath.Append(prefix);
+    modulePath.Append(name);
+    modulePath.Append(suffix);
+
+    return modulePath;
+}
+
+NativeModuleHandle LoadModule(StringView path, bool lazy)
+{
+    // symbols stay local to the module, lazy binding defers resolving them to their first call
+    return dlopen(path.Data(), (lazy ? RTLD_LAZY : RTLD_NOW) | RTLD_LOCAL);
+}
+
+NativeModuleHandle LoadMainProgram()
+{
+    return dlopen(nullptr, RTLD_NOW | RTLD_LOCAL);
+}
+
+void UnloadModule(NativeModuleHandle handle)
+{
+    dlclose(handle);
+}
+
+void* LoadFunction(NativeModuleHandle handle, StringView name)
+{
+    ENSURE(handle, "module not loaded") {
+        return nullptr;
+    }
+
+    return dlsym(handle, name.Data());
+}
+
+size_t ProcessResidentMemory()
+{
+    // the second field of statm is the resident set in pages
+    int32 file = open("/proc/self/statm", O_RDONLY | O_CLOEXEC);
+    if (file < 0) {
+        return 0;
+    }
+
+    char buffer[128];
+    ssize_t size = read(file, buffer, sizeof(buffer) - 1);
+    close(file);
+    if (size <= 0) {
+        return 0;
+    }
+
+    ssize_t index = 0;
+    while (index < size && buffer[index] != ' ') {
+        ++index;
+    }
+
+    size_t pages = 0;
+    for (++index; index < size && buffer[index] >= '0' && buffer[index] <= '9'; ++index) {
+        pages = pages * 10 + static_cast<size_t>(buffer[index] - '0');
+    }
+
+    return pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+} // namespace mini
\ No newline at end of file
@@ -1,46 +1,114 @@
 export module mini.core:module_loader;
 
+import :type;
 import :array;
 import :string;
 import :string_view;
+import :initializer_list;
+import :unique_ptr;
 import :shared_ptr;
 import :weak_ptr;
+import :atomic_base;
+import :atomic;
+import :duration;
 import :module_system;
 
 namespace mini {
 
-struct ModuleRef {
+// Everything the loader knows about a module name, created on its first use and kept until the loader goes.
+// A registered module waits in pending until it is loaded, state is loading while a thread loads it.
+// The dependency wait of LoadGraph is handed to the startup record of the next load through the entry.
+struct ModuleEntry {
 public:
-    SharedPtr<ModuleHandle> handle;
     String name;
-};
-
-struct ModuleWeakRef {
-public:
+    uint64 hash;
+    SharedPtr<ModuleHandle> pending;
     WeakPtr<ModuleHandle> handle;
-    String name;
+    Array<String> dependencies;
+    ModuleBinding binding;
+    bool mainThread;
+    NanoSeconds dependencyWait;
+    Atomic<uint32> state;
 };
 
-class CORE_API ModuleLoader {
-private:
-    typedef typename Array<ModuleRef>::Iterator RefIterator;
-    typedef typename Array<ModuleRef>::ConstIterator RefConstIterator;
-    typedef typename Array<ModuleWeakRef>::Iterator WeakRefIterator;
+struct ModuleGraph;
+struct ModuleGraphNode;
 
-    // TODO: use hash map instead
-    Array<ModuleRef> m_uninitialized;
-    Array<ModuleWeakRef> m_modules;
+// Loads every module once and hands out the same handle while it is alive, from any thread.
+// Dynamic modules are loaded with the binding set for their name, their load time is recorded in the
+// "module.load" histogram and logged. Every module loaded also leaves a ModuleStartup record.
+// LoadGraph loads a set of modules together with the dependencies declared for them, initializing every
+// module after its dependencies and independent ones concurrently. Modules declared for the main thread are
+// initialized on the calling thread, which is what window systems usually require. Worker threads are only
+// started for the other modules, at most one for each of them.
+export class CORE_API ModuleLoader {
+private:
+    Array<UniquePtr<ModuleEntry>> m_entries;
+    Array<ModuleEntry*> m_slots;
 
 public:
     bool RegisterUninitialized(StringView, SharedPtr<ModuleHandle>);
     SharedPtr<ModuleHandle> Load(StringView);
+    bool LoadGraph(InitializerList<StringView>, Array<SharedPtr<ModuleHandle>>&, uint32 = 0);
+
+    void Declare(StringView, InitializerList<StringView>, bool = false);
+    void SetBinding(StringView, ModuleBinding);
+    ModuleBinding GetBinding(StringView) const noexcept;
 
     size_t Count() const noexcept;
 
 private:
-    SharedPtr<ModuleHandle> LoadHandle(StringView);
+    ModuleEntry* Find(StringView) const noexcept;
+    ModuleEntry* FindOrAdd(StringView);
+    void Rehash(size_t);
+    ModuleGraphNode* Collect(ModuleGraph&, ModuleEntry*);
+
+    SharedPtr<ModuleHandle> LoadHandle(ModuleEntry*, bool&);
+    void ReportLoadTime(StringView, NanoSeconds);
 };
 
-CORE_API ModuleLoader g_moduleLoader = ModuleLoader();
+export CORE_API ModuleLoader g_moduleLoader = ModuleLoader();
+
+// Keeps the modules of a LoadGraph call alive, Module instances of the same names share them.
+export class CORE_API ModuleGroup {
+private:
+    Array<SharedPtr<ModuleHandle>> m_handles;
+
+public:
+    ModuleGroup() noexcept = default;
+    ~ModuleGroup() noexcept;
+
+    bool Load(InitializerList<StringView>, uint32 = 0);
+    void Release() noexcept;
+
+    size_t Size() const noexcept;
+
+private:
+    ModuleGroup(ModuleGroup const&) = delete;
+    ModuleGroup& operator=(ModuleGroup const&) = delete;
+};
+
+inline ModuleGroup::~ModuleGroup() noexcept
+{
+    Release();
+}
+
+inline bool ModuleGroup::Load(InitializerList<StringView> names, uint32 threadCount)
+{
+    return g_moduleLoader.LoadGraph(names, m_handles, threadCount);
+}
+
+inline void ModuleGroup::Release() noexcept
+{
+    // dependents go first, the handles were added in the order the modules were initialized
+    while (!m_handles.Empty()) {
+        m_handles.RemoveLast();
+    }
+}
+
+inline size_t ModuleGroup::Size() const noexcept
+{
+    return m_handles.Size();
+}
 
 } // namespace mini
\ No newline at end of file
@@ -1,9 +1,11 @@
 module;
 
 #include <dlfcn.h>
+#include <mach/mach.h>
 
 export module mini.core:module_platform;
 
+import :type;
 import :string;
 import :string_view;
 import :memory_operation;
@@ -25,9 +27,9 @@ String BuildModulePath(StringView name)
     return modulePath;
 }
 
-NativeModuleHandle LoadModule(StringView path)
+NativeModuleHandle LoadModule(StringView path, bool lazy)
 {
-    return dlopen(path.Data(), RTLD_NOW | RTLD_LOCAL);
+    return dlopen(path.Data(), (lazy ? RTLD_LAZY : RTLD_NOW) | RTLD_LOCAL);
 }
 
 NativeModuleHandle LoadMainProgram()
@@ -49,4 +51,14 @@ void* LoadFunction(NativeModuleHandle handle, StringView name)
     return dlsym(handle, name.Data());
 }
 
+size_t ProcessResidentMemory()
+{
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    kern_return_t result =
+        task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count);
+
+    return result == KERN_SUCCESS ? static_cast<size_t>(info.resident_size) : 0;
+}
+
 } // namespace mini
\ No newline at end of file
@@ -0,0 +1,47 @@
+export module mini.core:module_startup;
+
+import :type;
+import :array;
+import :string_view;
+import :string;
+import :duration;
+
+namespace mini {
+
+// Cost of loading a single module, recorded once when the loader loads it rather than handing out a live one.
+// Wait is the time spent on dependencies and other threads loading the module before this load began.
+// Open is zero for static modules, their start is the factory called at registration. Begin is the
+// CycleClock time in nanoseconds at which the library was opened, or the static handle was taken.
+// The resident delta spans the whole load, so modules loaded concurrently are charged for each other.
+export struct ModuleStartupRecord {
+public:
+    String name;
+    uint64 thread;
+    int64 begin;
+    NanoSeconds wait;
+    NanoSeconds open;
+    NanoSeconds start;
+    NanoSeconds initialize;
+    int64 residentDelta;
+    bool dynamic;
+    bool loaded;
+};
+
+// Startup records of every module loaded by the process, in the order their loads finished.
+// Report writes one line per module with its phases in microseconds, ExportTrace writes the phases as Chrome
+// trace events on the threads that ran them.
+export class CORE_API ModuleStartup {
+public:
+    static void Record(ModuleStartupRecord const&);
+    static void Clear();
+
+    static void Collect(Array<ModuleStartupRecord>&);
+    static void Report(String&);
+    static void Log();
+    static bool WriteReport(StringView);
+
+    static void ExportTrace(String&);
+    static bool ExportTraceToFile(StringView);
+};
+
+} // namespace mini
\ No newline at end of file
@@ -9,10 +9,22 @@ import :string_view;
 import :deleter;
 import :unique_ptr;
 import :shared_ptr;
+import :duration;
+import :time_point;
+import :cycle_clock;
+import :mutex;
 import :module_platform;
 
 namespace mini {
 
+// How the symbols a dynamic module imports are resolved. Immediate binding resolves all of them while the
+// module loads, lazy binding on their first call, which makes loading cheaper but defers missing symbols.
+// Platforms without lazy binding always bind immediately.
+export enum class ModuleBinding : uint8 {
+    immediate,
+    lazy
+};
+
 export class CORE_API ModuleInterface {
 private:
     friend class ModuleLoader;
@@ -54,6 +66,8 @@ protected:
     UniquePtr<ModuleInterface> m_interface;
     String m_libraryName;
     Array<CallbackFunc> m_exitCallback;
+    NanoSeconds m_openTime;
+    NanoSeconds m_startTime;
 
 public:
     ModuleHandle(ModulePoilcy const*, NativeModule, ModuleInterface*, StringView) noexcept;
@@ -69,6 +83,11 @@ public:
     NativeModule NativeHandle() noexcept;
     ModuleInterface* GetInterface() const noexcept;
 
+    // opening the library, creating the interface, which is the static factory for static modules, and both
+    NanoSeconds OpenTime() const noexcept;
+    NanoSeconds StartTime() const noexcept;
+    NanoSeconds LoadTime() const noexcept;
+
     ModuleHandle& operator=(ModuleHandle&&) noexcept = default;
 
     static SharedPtr<ModuleHandle> Load(StringView);
@@ -84,16 +103,32 @@ public:
         .deleter = UnloadModule
     };
 
+private:
+    struct FunctionRef {
+    public:
+        String name;
+        void* function;
+    };
+
+    // handles are shared by every user of a module, which may look functions up from any thread
+    Mutex m_functionLock;
+    Array<FunctionRef> m_functions;
+
 public:
-    DynamicModuleHandle(StringView name) noexcept
+    DynamicModuleHandle(StringView name, ModuleBinding binding = ModuleBinding::immediate) noexcept
         : ModuleHandle(&policy, nullptr, nullptr, name)
     {
+        CycleClock::TimePoint openBegin = CycleClock::Now();
+
         String path = BuildModulePath(name);
-        m_nativeModule = LoadModule(path);
+        m_nativeModule = LoadModule(path, binding == ModuleBinding::lazy);
         if (m_nativeModule == nullptr) {
             return;
         }
 
+        CycleClock::TimePoint startBegin = CycleClock::Now();
+        m_openTime = startBegin - openBegin;
+
         StartFunc startFunc = GetFunction<ModuleInterface*>("__start_module");
         if (startFunc == nullptr) {
             return;
@@ -112,14 +147,35 @@ public:
         }
 
         m_interface = UniquePtr(interface);
+        m_startTime = CycleClock::Now() - startBegin;
     }
 
     template <typename RetT, typename... Args, typename FuncT = RetT (*)(Args...)>
     FuncT GetFunction(StringView name)
     {
-        void* funcPtr = LoadFunction(m_nativeModule, name);
+        void* funcPtr = FindFunction(name);
         return reinterpret_cast<FuncT>(funcPtr);
     }
+
+private:
+    void* FindFunction(StringView name)
+    {
+        m_functionLock.Lock();
+
+        // a module exports a handful of functions, scanning them is cheaper than another symbol lookup
+        for (FunctionRef const& ref : m_functions) {
+            if (ref.name == name) {
+                void* cached = ref.function;
+                m_functionLock.Unlock();
+                return cached;
+            }
+        }
+
+        void* funcPtr = LoadFunction(m_nativeModule, name);
+        m_functions.Push(FunctionRef{ .name = name, .function = funcPtr });
+        m_functionLock.Unlock();
+        return funcPtr;
+    }
 };
 
 class CORE_API StaticModuleHandle : public ModuleHandle {
@@ -131,9 +187,10 @@ public:
         ModulePoilcy{ .validator = nullptr, .deleter = nullptr };
 
 public:
-    StaticModuleHandle(StringView name, ModuleInterface* interface) noexcept
+    StaticModuleHandle(StringView name, ModuleInterface* interface, NanoSeconds startTime = NanoSeconds(0)) noexcept
         : ModuleHandle(&policy, programHandle, interface, name)
     {
+        m_startTime = startTime;
     }
 };
 
@@ -191,6 +248,7 @@ public:
     String LibraryName() const noexcept;
     InterfacePointer GetInterface() const noexcept;
     NativeModule NativeHandle() const noexcept;
+    NanoSeconds LoadTime() const noexcept;
 
     template <RelatedInterfaceToT<T> U>
     bool Equals(Module<U> const&) const noexcept;
@@ -329,6 +387,12 @@ inline Module<T>::NativeModule Module<T>::NativeHandle() const noexcept
     return m_handle != nullptr ? m_handle->NativeHandle() : nullptr;
 }
 
+template <ModuleInterfaceT T>
+inline NanoSeconds Module<T>::LoadTime() const noexcept
+{
+    return m_handle != nullptr ? m_handle->LoadTime() : NanoSeconds(0);
+}
+
 template <ModuleInterfaceT T>
 template <RelatedInterfaceToT<T> U>
 bool Module<T>::Equals(Module<U> const& other) const noexcept
@@ -2,8 +2,11 @@ module;
 
 #include "win_include.h"
 
+#include <psapi.h>
+
 export module mini.core:module_platform;
 
+import :type;
 import :string;
 import :string_view;
 import :memory_operation;
@@ -25,8 +28,9 @@ String BuildModulePath(StringView name)
     return modulePath;
 }
 
-NativeModuleHandle LoadModule(StringView path)
+NativeModuleHandle LoadModule(StringView path, bool)
 {
+    // imports of a dll are always bound when it is loaded
     return LoadLibraryA(path.Data());
 }
 
@@ -49,4 +53,14 @@ void* LoadFunction(NativeModuleHandle handle, StringView name)
     return GetProcAddress(handle, name.Data());
 }
 
+size_t ProcessResidentMemory()
+{
+    PROCESS_MEMORY_COUNTERS counters;
+    if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) == FALSE) {
+        return 0;
+    }
+
+    return static_cast<size_t>(counters.WorkingSetSize);
+}
+
 } // namespace mini
\ No newline at end of file
@@ -0,0 +1,16 @@
+export module mini.core:environment;
+
+import :type;
+
+namespace mini {
+
+// Reads of the process environment, which override options for a single run, e.g. MINI_TARGET_FPS.
+// Get returns null for a variable that is unset or empty. GetUnsigned parses a decimal number and returns
+// the fallback for an unset or empty variable, text that is not a number reads as zero.
+export class CORE_API Environment {
+public:
+    static char const* Get(char const*) noexcept;
+    static uint64 GetUnsigned(char const*, uint64) noexcept;
+};
+
+} // namespace mini
\ No newline at end of file
@@ -0,0 +1,24 @@
+module;
+
+#include <cstdlib>
+
+module mini.core;
+
+import :type;
+import :environment;
+
+namespace mini {
+
+char const* Environment::Get(char const* name) noexcept
+{
+    char const* value = std::getenv(name);
+    return value != nullptr && *value != '\0' ? value : nullptr;
+}
+
+uint64 Environment::GetUnsigned(char const* name, uint64 fallback) noexcept
+{
+    char const* value = Get(name);
+    return value != nullptr ? std::strtoull(value, nullptr, 10) : fallback;
+}
+
+} // namespace mini
\ No newline at end of file
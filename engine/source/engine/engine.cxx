@@ -4,11 +4,14 @@ import mini.core;
 import mini.platform;
 import mini.graphics;
 
+export import :frame_pipeline;
+
 namespace mini {
 
 export class ENGINE_API Engine final : public ModuleInterface {
 private:
     bool m_running;
+    TimerWheel m_timers;
 
 public:
     Engine();
@@ -20,6 +23,9 @@ public:
     static void Quit();
     static void Abort(String const& = "");
 
+    // timers advance once per frame on the main thread, their callbacks run before the frame begins
+    TimerWheel& GetTimers() noexcept { return m_timers; }
+
     static bool Running() noexcept;
 };
 
@@ -0,0 +1,65 @@
+export module mini.engine:frame_pipeline;
+
+import mini.core;
+import mini.platform;
+import mini.graphics;
+
+namespace mini {
+
+// Everything the render thread needs of a frame, built by the main thread before it is handed over.
+export struct FramePacket {
+public:
+    uint64 frame;
+    Clock::TimePoint begin;
+    RectInt windowSize;
+};
+
+// Hands frames from the main thread over to a render thread, so that frame N+1 is built while frame N is
+// submitted and presented. The depth is the number of packets in flight: one renders on the calling
+// thread without a render thread, two and three let the main thread run one or two frames ahead.
+// Packets travel through two single producer, single consumer queues. Acquire blocks once every
+// packet is in flight, which bounds how far the main thread gets ahead of the presented frame.
+// With a platform given to Start, Acquire polls its events while it waits. Swap chains that message the
+// window from Present or a resize, as DXGI does, would otherwise wait on the blocked main thread for good.
+export class ENGINE_API FramePipeline {
+public:
+    static constexpr uint32 MaxDepth = 3;
+
+private:
+    typedef SpscQueue<uint32, 4> PacketQueue;
+
+    static constexpr uint32 stopPacket = ~0u;
+
+    FramePacket m_packets[MaxDepth];
+    PacketQueue m_submitted;
+    PacketQueue m_free;
+
+    Thread m_renderThread;
+    Graphics* m_graphics;
+    Platform* m_platform;
+    uint32 m_depth;
+
+    Histogram* m_renderTime;
+    Histogram* m_latency;
+
+public:
+    explicit FramePipeline(uint32);
+    ~FramePipeline() noexcept;
+
+    void Start(Graphics*, Platform* = nullptr);
+    void Stop();
+
+    FramePacket& Acquire();
+    void Submit(FramePacket&);
+
+    uint32 Depth() const noexcept { return m_depth; }
+
+private:
+    void RunRenderThread();
+    void Render(FramePacket const&);
+
+    FramePipeline(FramePipeline const&) = delete;
+    FramePipeline& operator=(FramePipeline const&) = delete;
+};
+
+} // namespace mini
\ No newline at end of file
@@ -10,8 +10,25 @@ import mini.graphics;
 
 namespace mini {
 
+// frame and present times are logged periodically outside of release builds
+static constexpr Seconds metricsLogInterval = Seconds(10);
+
+// lines buffered by the platform writer are written at least this often while no new line pushes them out
+static constexpr MilliSeconds logFlushInterval = MilliSeconds(100);
+
+// a site logging every frame is cut down to a few lines a second, a burst of startup messages is never limited
+static constexpr uint32 logRate = 10;
+static constexpr uint32 logBurst = 100;
+
+// options tuned per run are overridden from the environment, e.g. to compare frame pacing settings
+static uint32 ReadOption(char const* name, uint32 fallback) noexcept
+{
+    return static_cast<uint32>(Environment::GetUnsigned(name, fallback));
+}
+
 Engine::Engine()
     : m_running(false)
+    , m_timers()
 {
     ASSERT(engine == nullptr, "another instance of engine is created");
     engine = this;
@@ -27,28 +44,100 @@ void Engine::Launch()
 {
     ENSURE(m_running == false, "engine is already running") return;
 
+    PROFILE_THREAD("main");
+    LogRateLimit::Configure(logRate, logBurst);
+
+    // both create native windows and surfaces, which window systems only allow on the main thread
+    g_moduleLoader.Declare("mini.platform", {}, true);
+    g_moduleLoader.Declare("mini.graphics", { "mini.platform" }, true);
+
+    ModuleGroup modules;
+    ENSURE(modules.Load({ "mini.platform", "mini.graphics" }), "failed to load engine modules") {
+        return;
+    }
+
+#if !RELEASE
+    ModuleStartup::Log();
+#endif
+
     Module<Platform> platform("mini.platform");
     Module<Graphics> graphics("mini.graphics");
 
     platform->GetWindow()->Show();
     platform->PollEvents();
 
+    Histogram& frameTime = Metrics::GetHistogram("engine.frame_time");
+    Histogram& frameJitter = Metrics::GetHistogram("engine.frame_jitter");
+    Histogram& pacerLateness = Metrics::GetHistogram("engine.pacer_lateness");
+    ShardedCounter& missedFrames = Metrics::GetCounter("engine.missed_frames");
+#if !RELEASE
+    TimerHandle metricsLog = m_timers.ScheduleEvery(metricsLogInterval, [](void*) { Metrics::Log(); }, nullptr);
+#endif
+    TimerHandle logFlush = m_timers.ScheduleEvery(logFlushInterval, [](void*) { Logger::FlushMessages(); }, nullptr);
+
+    FramePipeline pipeline(ReadOption("MINI_FRAME_PIPELINE_DEPTH", options::framePipelineDepth));
+#if PLATFORM_WINDOWS
+    // DXGI messages the window from Present and ResizeBuffers and waits for the main thread to handle them
+    pipeline.Start(graphics.GetInterface(), platform.GetInterface());
+#else
+    pipeline.Start(graphics.GetInterface());
+#endif
+
+    uint32 targetFrameRate = ReadOption("MINI_TARGET_FPS", options::targetFrameRate);
+    uint32 spinThreshold = ReadOption("MINI_PACER_SPIN_US", options::pacerSpinMicroSeconds);
+    FramePacer pacer(FramePacer::FromRate(targetFrameRate), MicroSeconds(spinThreshold));
+
     m_running = true;
+    uint64 frameIndex = 0;
+    Clock::TimePoint frameBegin = Clock::Now();
     while (m_running) {
-        graphics->BeginFrame();
+        PROFILE_SCOPE("Engine::Frame");
+
         {
-            platform::Window* window = platform->GetWindow();
-            RectInt windowSize = window->GetSize();
-            Rect windowRect(windowSize);
+            PROFILE_SCOPE("Engine::Timers");
+            m_timers.Advance();
+        }
 
-            graphics::Renderer* renderer = graphics->GetRenderer();
-            renderer->SetViewport(windowRect, 0.1f, 100.f);
-            renderer->SetScissorRect(windowSize);
+        // waits for the render thread once it is as many frames behind as the pipeline is deep
+        FramePacket& packet = pipeline.Acquire();
+        {
+            PROFILE_SCOPE("Engine::Update");
+            packet.frame = frameIndex++;
+            packet.begin = frameBegin;
+            packet.windowSize = platform->GetWindow()->GetSize();
+        }
+        pipeline.Submit(packet);
+
+        // waits before polling, so the next frame starts from the freshest input
+        if (pacer.Enabled()) {
+            PROFILE_SCOPE("Engine::Pace");
+            NanoSeconds lateness = pacer.Wait();
+            pacerLateness.Record(lateness);
+            if (lateness > NanoSeconds::Zero()) {
+                missedFrames.Add();
+            }
         }
-        graphics->EndFrame();
 
-        platform->PollEvents();
+        {
+            PROFILE_SCOPE("Platform::PollEvents");
+            platform->PollEvents();
+        }
+
+        Clock::TimePoint frameEnd = Clock::Now();
+        NanoSeconds frameInterval = frameEnd - frameBegin;
+        frameTime.Record(frameInterval);
+        if (pacer.Enabled()) {
+            frameJitter.Record(Abs(frameInterval - pacer.Target()));
+        }
+        frameBegin = frameEnd;
     }
+
+    pipeline.Stop();
+
+    m_timers.Cancel(logFlush);
+#if !RELEASE
+    m_timers.Cancel(metricsLog);
+#endif
 }
 
 void Engine::Shutdown()
@@ -0,0 +1,133 @@
+module mini.engine;
+
+import mini.core;
+import mini.platform;
+import mini.graphics;
+import :frame_pipeline;
+
+namespace mini {
+
+// how long Acquire waits for the render thread between polling the events of the platform
+static constexpr MilliSeconds pollInterval = MilliSeconds(1);
+
+FramePipeline::FramePipeline(uint32 depth)
+    : m_packets()
+    , m_submitted()
+    , m_free()
+    , m_renderThread()
+    , m_graphics(nullptr)
+    , m_platform(nullptr)
+    , m_depth(depth < 1 ? 1 : (depth > MaxDepth ? MaxDepth : depth))
+    , m_renderTime(nullptr)
+    , m_latency(nullptr)
+{
+    for (uint32 i = 0; i < m_depth; ++i) {
+        m_free.Enqueue(i);
+    }
+}
+
+FramePipeline::~FramePipeline() noexcept
+{
+    ASSERT(!m_renderThread.Joinable(), "frame pipeline is still running");
+}
+
+void FramePipeline::Start(Graphics* graphics, Platform* platform)
+{
+    ASSERT(graphics != nullptr);
+    ENSURE(m_graphics == nullptr, "frame pipeline is already running") return;
+
+    m_graphics = graphics;
+    m_platform = platform;
+    m_renderTime = &Metrics::GetHistogram("engine.render_time");
+    m_latency = &Metrics::GetHistogram("engine.frame_latency");
+
+    if (m_depth > 1) {
+        ThreadOptions options;
+        options.name = "mini.render";
+        options.priority = ThreadPriority::high;
+        m_renderThread = Thread([this]() { RunRenderThread(); }, options);
+    }
+}
+
+void FramePipeline::Stop()
+{
+    if (m_renderThread.Joinable()) {
+        // frames already submitted are still rendered, the render thread exits after them
+        m_submitted.Enqueue(stopPacket);
+        m_renderThread.Join();
+    }
+
+    m_graphics = nullptr;
+    m_platform = nullptr;
+}
+
+FramePacket& FramePipeline::Acquire()
+{
+    PROFILE_SCOPE("FramePipeline::Acquire");
+    if (m_platform == nullptr || !m_renderThread.Joinable()) {
+        return m_packets[m_free.Dequeue()];
+    }
+
+    // the render thread may be waiting on the window, which only gets its messages while events are polled
+    uint32 index = 0;
+    while (!m_free.TryDequeueFor(index, pollInterval)) {
+        m_platform->PollEvents();
+    }
+
+    return m_packets[index];
+}
+
+void FramePipeline::Submit(FramePacket& packet)
+{
+    uint32 index = static_cast<uint32>(&packet - m_packets);
+    ASSERT(index < m_depth, "packet does not belong to the pipeline");
+
+    if (!m_renderThread.Joinable()) {
+        Render(packet);
+        m_free.Enqueue(index);
+        return;
+    }
+
+    m_submitted.Enqueue(index);
+}
+
+void FramePipeline::RunRenderThread()
+{
+    PROFILE_THREAD("render");
+
+    uint32 index = m_submitted.Dequeue();
+    while (index != stopPacket) {
+        Render(m_packets[index]);
+        m_free.Enqueue(index);
+
+        index = m_submitted.Dequeue();
+    }
+}
+
+void FramePipeline::Render(FramePacket const& packet)
+{
+    PROFILE_SCOPE("FramePipeline::Render");
+    Clock::TimePoint renderBegin = Clock::Now();
+
+    {
+        PROFILE_SCOPE("Graphics::BeginFrame");
+        m_graphics->BeginFrame();
+    }
+    {
+        PROFILE_SCOPE("Engine::Render");
+        graphics::Renderer* renderer = m_graphics->GetRenderer();
+        renderer->SetViewport(Rect(packet.windowSize), 0.1f, 100.f);
+        renderer->SetScissorRect(packet.windowSize);
+    }
+    {
+        PROFILE_SCOPE("Graphics::EndFrame");
+        m_graphics->EndFrame();
+    }
+
+    // latency spans from the main thread starting the frame until it has been presented
+    Clock::TimePoint renderEnd = Clock::Now();
+    m_renderTime->Record(renderEnd - renderBegin);
+    m_latency->Record(renderEnd - packet.begin);
+}
+
+} // namespace mini
\ No newline at end of file
@@ -14,6 +14,12 @@ namespace mini {
 
 export class GRAPHICS_API Graphics final : public ModuleInterface {
 private:
+    struct Resolution {
+        uint32 width;
+        uint32 height;
+        bool fullscreen;
+    };
+
     API m_currentAPI;
     Module<Interface> m_currentModule;
 
@@ -21,6 +27,12 @@ private:
     UniquePtr<SwapChain> m_swapChain;
     UniquePtr<Renderer> m_renderer;
 
+    Histogram* m_presentTime;
+
+    Mutex m_resolutionLock;
+    Resolution m_resolution;
+    Atomic<bool> m_resolutionChanged;
+
 public:
     Graphics() noexcept;
     ~Graphics() noexcept;
@@ -35,6 +47,7 @@ public:
     SwapChain* GetSwapChain() const noexcept { return m_swapChain.Get(); }
     Renderer* GetRenderer() const noexcept { return m_renderer.Get(); }
 
+    // applied when the next frame begins, on the thread rendering it rather than the one asking for it
     static void ChangeResolution(uint32, uint32, bool);
 
     static bool IsDeviceCurrent() noexcept;
@@ -42,6 +55,7 @@ public:
 
 private:
     bool Initialize() final;
+    void ApplyResolution();
 };
 
 } // namespace mini
\ No newline at end of file
@@ -14,6 +14,7 @@ export enum class API : byte {
     D3D12,
     Metal4,
     Vulkan,
+    Software,
 };
 
 export enum class CommandType : int8 {
@@ -33,6 +34,7 @@ export enum class PrimitiveType : byte {
 GRAPHICS_API const std::regex d3d12_regex("[Dd]3[Dd]12");
 GRAPHICS_API const std::regex metal4_regex("[Mm][Ee][Tt][Aa][Ll]4");
 GRAPHICS_API const std::regex vulkan_regex("[Vv][Uu][Ll][Kk][Aa][Nn]");
+GRAPHICS_API const std::regex software_regex("[Ss][Oo][Ff][Tt][Gg][Pp][Uu]");
 
 export GRAPHICS_API API ParseAPI(String const& str)
 {
@@ -43,6 +45,8 @@ export GRAPHICS_API API ParseAPI(String const& str)
         return API::Metal4;
     } else if (std::regex_match(src, vulkan_regex)) {
         return API::Vulkan;
+    } else if (std::regex_match(src, software_regex)) {
+        return API::Software;
     }
     return API::Null;
 }
@@ -57,9 +61,10 @@ struct formatter<mini::graphics::API> : formatter<string_view> {
     {
         string_view sv;
         switch (api) {
-            case mini::graphics::API::D3D12:  sv = string_view{ "d3d12" }; break;
-            case mini::graphics::API::Metal4: sv = string_view{ "metal4" }; break;
-            case mini::graphics::API::Vulkan: sv = string_view{ "vulkan" }; break;
+            case mini::graphics::API::D3D12:    sv = string_view{ "d3d12" }; break;
+            case mini::graphics::API::Metal4:   sv = string_view{ "metal4" }; break;
+            case mini::graphics::API::Vulkan:   sv = string_view{ "vulkan" }; break;
+            case mini::graphics::API::Software: sv = string_view{ "softgpu" }; break;
 
             default: sv = string_view("null"); break;
         }
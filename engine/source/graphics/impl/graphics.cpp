@@ -7,7 +7,13 @@ using namespace mini::graphics;
 
 namespace mini {
 
+// the only module allowed to create a device without an api, which renders nothing
+static constexpr StringView nullGraphicsModule = "mini.null_graphics";
+
 Graphics::Graphics() noexcept
+    : m_presentTime(nullptr)
+    , m_resolution{ 0, 0, false }
+    , m_resolutionChanged(false)
 {
     graphics::interface = this;
 }
@@ -24,7 +30,10 @@ Graphics::~Graphics() noexcept
 
 bool Graphics::Initialize()
 {
-    m_currentModule.Load(mini::options::graphicsModule);
+    // a backend other than the default of the platform, such as mini.softgpu on a host without a GPU
+    char const* requested = Environment::Get("MINI_GRAPHICS_MODULE");
+    StringView requestedName = requested != nullptr ? requested : mini::options::graphicsModule;
+    m_currentModule.Load(requestedName);
     ENSURE(m_currentModule.Valid(), "failed to load graphics module") {
         return false;
     }
@@ -44,7 +53,7 @@ bool Graphics::Initialize()
     m_device = UniquePtr(device);
     m_currentAPI = m_device->GetAPI();
 
-    ENSURE(m_currentAPI != API::Null, "unknown api") return false;
+    ENSURE(m_currentAPI != API::Null || requestedName == nullGraphicsModule, "unknown api") return false;
     ENSURE(m_device->Initialize(), "failed to initialize graphics device") {
         return false;
     }
@@ -62,11 +71,16 @@ bool Graphics::Initialize()
     }
     LogInfo("{} swap chain initialized", m_currentAPI);
 
+    m_presentTime = &Metrics::GetHistogram("graphics.present_time");
     return true;
 }
 
 void Graphics::BeginFrame()
 {
+    if (m_resolutionChanged.Load(MemoryOrder::acquire)) [[unlikely]] {
+        ApplyResolution();
+    }
+
     m_renderer->BeginRender();
 }
 
@@ -75,7 +89,10 @@ void Graphics::EndFrame()
     m_renderer->EndRender();
     m_renderer->Execute();
 
+    PROFILE_SCOPE("SwapChain::Present");
+    Clock::TimePoint presentBegin = Clock::Now();
     m_swapChain->Present();
+    m_presentTime->Record(Clock::Now() - presentBegin);
 }
 
 bool Graphics::IsDeviceCurrent() noexcept
@@ -90,13 +107,29 @@ bool Graphics::IsDeviceCurrent(API api) noexcept
 
 void Graphics::ChangeResolution(uint32 width, uint32 height, bool fullscreen)
 {
-    SwapChain* swapChain = interface->GetSwapChain();
-    if (swapChain == nullptr) [[unlikely]] {
-        // graphics::LogError("failed to change resolution. SwapChain is not initialized");
+    if (interface == nullptr) [[unlikely]] {
+        return;
+    }
+
+    // only the latest request is kept, a frame never resizes more than once
+    interface->m_resolutionLock.Lock();
+    interface->m_resolution = Resolution{ width, height, fullscreen };
+    interface->m_resolutionChanged.Store(true, MemoryOrder::release);
+    interface->m_resolutionLock.Unlock();
+}
+
+void Graphics::ApplyResolution()
+{
+    m_resolutionLock.Lock();
+    Resolution resolution = m_resolution;
+    m_resolutionChanged.Store(false, MemoryOrder::relaxed);
+    m_resolutionLock.Unlock();
+
+    if (m_swapChain == nullptr) [[unlikely]] {
         return;
     }
 
-    swapChain->ResizeBackBuffer(width, height, fullscreen);
+    m_swapChain->ResizeBackBuffer(resolution.width, resolution.height, resolution.fullscreen);
 }
 
 } // namespace mini
\ No newline at end of file
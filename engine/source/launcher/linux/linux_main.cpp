@@ -0,0 +1,7 @@
+import mini.launcher;
+
+int main()
+{
+    mini::LaunchEngine();
+    return 0;
+}
\ No newline at end of file
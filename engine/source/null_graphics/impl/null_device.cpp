@@ -0,0 +1,26 @@
+module mini.null_graphics;
+
+import mini.core;
+import mini.graphics;
+import :swap_chain;
+import :renderer;
+
+namespace mini::null_graphics {
+
+Device::Device(Calls* calls, NanoSeconds presentLatency)
+    : m_calls(calls)
+    , m_presentLatency(presentLatency)
+{
+}
+
+graphics::SwapChain* Device::CreateSwapChain()
+{
+    return new SwapChain(m_calls, m_presentLatency);
+}
+
+graphics::Renderer* Device::CreateRenderer()
+{
+    return new Renderer(m_calls);
+}
+
+} // namespace mini::null_graphics
\ No newline at end of file
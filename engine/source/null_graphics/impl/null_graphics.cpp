@@ -0,0 +1,41 @@
+module mini.null_graphics;
+
+import mini.core;
+import mini.graphics;
+import :device;
+
+namespace mini {
+
+NullGraphics::NullGraphics() noexcept
+    : m_calls()
+    , m_presentLatency(MicroSeconds(static_cast<int64>(Environment::GetUnsigned("MINI_NULL_PRESENT_LATENCY", 0))))
+{
+    null_graphics::interface = this;
+}
+
+NullGraphics::~NullGraphics() noexcept
+{
+    null_graphics::interface = nullptr;
+}
+
+graphics::Device* NullGraphics::CreateDevice()
+{
+    return new null_graphics::Device(&m_calls, m_presentLatency);
+}
+
+null_graphics::Device* NullGraphics::GetDevice() noexcept
+{
+    return static_cast<null_graphics::Device*>(m_graphics->GetDevice());
+}
+
+null_graphics::SwapChain* NullGraphics::GetSwapChain() noexcept
+{
+    return static_cast<null_graphics::SwapChain*>(m_graphics->GetSwapChain());
+}
+
+null_graphics::Renderer* NullGraphics::GetRenderer() noexcept
+{
+    return static_cast<null_graphics::Renderer*>(m_graphics->GetRenderer());
+}
+
+} // namespace mini
\ No newline at end of file
@@ -0,0 +1,55 @@
+module mini.null_graphics;
+
+import mini.core;
+import mini.graphics;
+import :renderer;
+
+namespace mini::null_graphics {
+
+Renderer::Renderer(Calls* calls)
+    : m_calls(calls)
+    , m_viewport()
+    , m_scissorRect()
+    , m_recording(false)
+{
+}
+
+void Renderer::BeginRender()
+{
+    ASSERT(!m_recording, "render has already begun");
+
+    m_calls->beginRender.FetchAdd(1, MemoryOrder::relaxed);
+    m_recording = true;
+}
+
+void Renderer::EndRender()
+{
+    ASSERT(m_recording, "render has not begun");
+
+    m_calls->endRender.FetchAdd(1, MemoryOrder::relaxed);
+    m_recording = false;
+}
+
+void Renderer::WaitForIdle()
+{
+    m_calls->waitForIdle.FetchAdd(1, MemoryOrder::relaxed);
+}
+
+void Renderer::Execute()
+{
+    m_calls->execute.FetchAdd(1, MemoryOrder::relaxed);
+}
+
+void Renderer::SetViewport(Rect const& viewport, float32, float32)
+{
+    m_calls->setViewport.FetchAdd(1, MemoryOrder::relaxed);
+    m_viewport = viewport;
+}
+
+void Renderer::SetScissorRect(RectInt const& rect)
+{
+    m_calls->setScissorRect.FetchAdd(1, MemoryOrder::relaxed);
+    m_scissorRect = rect;
+}
+
+} // namespace mini::null_graphics
\ No newline at end of file
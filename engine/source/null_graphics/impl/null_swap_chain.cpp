@@ -0,0 +1,68 @@
+module mini.null_graphics;
+
+import mini.core;
+import mini.graphics;
+import :swap_chain;
+
+namespace mini::null_graphics {
+
+SwapChain::SwapChain(Calls* calls, NanoSeconds presentLatency)
+    : m_calls(calls)
+    , m_presentLatency(presentLatency)
+    , m_width(options::width)
+    , m_height(options::height)
+    , m_bufferCount(options::bufferCount)
+    , m_index(0)
+    , m_vSync(options::vsync)
+    , m_fullScreen(options::fullscreen)
+{
+}
+
+bool SwapChain::Initialize()
+{
+    return m_bufferCount != 0 && m_bufferCount <= MaxBackBuffer;
+}
+
+void SwapChain::Present()
+{
+    m_calls->present.FetchAdd(1, MemoryOrder::relaxed);
+
+    if (m_presentLatency.Count() > 0) {
+        Thread::SleepFor(m_presentLatency);
+    }
+
+    m_index = static_cast<uint8>((m_index + 1) % m_bufferCount);
+}
+
+void SwapChain::ResizeBackBuffer(uint32 width, uint32 height, bool fullscreen)
+{
+    m_calls->resizeBackBuffer.FetchAdd(1, MemoryOrder::relaxed);
+
+    m_width = width;
+    m_height = height;
+    m_fullScreen = fullscreen;
+    m_index = 0;
+}
+
+void SwapChain::SetBackBufferCount(uint8 count)
+{
+    m_calls->setBackBufferCount.FetchAdd(1, MemoryOrder::relaxed);
+    ENSURE(count != 0 && count <= MaxBackBuffer, "invalid back buffer count") return;
+
+    m_bufferCount = count;
+    m_index = 0;
+}
+
+void SwapChain::SetVSync(uint8 vsync)
+{
+    m_calls->setVSync.FetchAdd(1, MemoryOrder::relaxed);
+    m_vSync = vsync;
+}
+
+void SwapChain::SetFullScreen(bool fullscreen)
+{
+    m_calls->setFullScreen.FetchAdd(1, MemoryOrder::relaxed);
+    m_fullScreen = fullscreen;
+}
+
+} // namespace mini::null_graphics
\ No newline at end of file
@@ -0,0 +1,25 @@
+export module mini.null_graphics:calls;
+
+import mini.core;
+
+namespace mini::null_graphics {
+
+// Number of times each graphics call was made, read by benchmarks and tests after the engine loop.
+// Renderer and swap chain calls may come from a thread other than the one reading them.
+export struct Calls {
+public:
+    Atomic<uint64> beginRender;
+    Atomic<uint64> endRender;
+    Atomic<uint64> waitForIdle;
+    Atomic<uint64> execute;
+    Atomic<uint64> setViewport;
+    Atomic<uint64> setScissorRect;
+
+    Atomic<uint64> present;
+    Atomic<uint64> resizeBackBuffer;
+    Atomic<uint64> setBackBufferCount;
+    Atomic<uint64> setVSync;
+    Atomic<uint64> setFullScreen;
+};
+
+} // namespace mini::null_graphics
\ No newline at end of file
@@ -0,0 +1,25 @@
+export module mini.null_graphics:device;
+
+import mini.core;
+import mini.graphics;
+import :calls;
+
+namespace mini::null_graphics {
+
+export class NULL_GRAPHICS_API Device final : public graphics::Device {
+private:
+    Calls* m_calls;
+    NanoSeconds m_presentLatency;
+
+public:
+    Device(Calls*, NanoSeconds);
+
+    bool Initialize() final { return m_calls != nullptr; }
+
+    graphics::SwapChain* CreateSwapChain() final;
+    graphics::Renderer* CreateRenderer() final;
+
+    graphics::API GetAPI() const final { return graphics::API::Null; }
+};
+
+} // namespace mini::null_graphics
\ No newline at end of file
@@ -0,0 +1,39 @@
+export module mini.null_graphics;
+
+export import mini.core;
+import mini.graphics;
+
+export import :calls;
+export import :device;
+export import :renderer;
+export import :swap_chain;
+
+namespace mini {
+
+// Headless graphics for hosts without a GPU. Nothing is drawn, every call is counted instead.
+// The present latency is read in microseconds from MINI_NULL_PRESENT_LATENCY when the module is created.
+export class NULL_GRAPHICS_API NullGraphics final : public graphics::Interface {
+private:
+    null_graphics::Calls m_calls;
+    NanoSeconds m_presentLatency;
+
+public:
+    NullGraphics() noexcept;
+    ~NullGraphics() noexcept;
+
+    graphics::Device* CreateDevice() final;
+
+    null_graphics::Calls const& GetCalls() const noexcept { return m_calls; }
+
+    null_graphics::Device* GetDevice() noexcept;
+    null_graphics::SwapChain* GetSwapChain() noexcept;
+    null_graphics::Renderer* GetRenderer() noexcept;
+};
+
+} // namespace mini
+
+namespace mini::null_graphics {
+
+NULL_GRAPHICS_API NullGraphics* interface = nullptr;
+
+} // namespace mini::null_graphics
\ No newline at end of file
@@ -0,0 +1,35 @@
+export module mini.null_graphics:renderer;
+
+import mini.core;
+import mini.graphics;
+import :calls;
+
+namespace mini::null_graphics {
+
+// Renderer without a command stream, it keeps the last viewport and scissor rect it was given.
+export class NULL_GRAPHICS_API Renderer final : public graphics::Renderer {
+private:
+    Calls* m_calls;
+
+    Rect m_viewport;
+    RectInt m_scissorRect;
+    bool m_recording;
+
+public:
+    Renderer(Calls*);
+
+    bool Initialize() final { return true; }
+
+    void BeginRender() final;
+    void EndRender() final;
+    void WaitForIdle() final;
+    void Execute() final;
+
+    void SetViewport(Rect const&, float32, float32) final;
+    void SetScissorRect(RectInt const&) final;
+
+    Rect GetViewport() const noexcept { return m_viewport; }
+    RectInt GetScissorRect() const noexcept { return m_scissorRect; }
+};
+
+} // namespace mini::null_graphics
\ No newline at end of file
@@ -0,0 +1,45 @@
+export module mini.null_graphics:swap_chain;
+
+import mini.core;
+import mini.graphics;
+import :calls;
+
+namespace mini::null_graphics {
+
+// Swap chain without buffers. Present blocks for the simulated latency, standing in for the wait on a
+// display, and advances the back buffer index as a real flip would.
+export class NULL_GRAPHICS_API SwapChain final : public graphics::SwapChain {
+private:
+    Calls* m_calls;
+    NanoSeconds m_presentLatency;
+
+    uint32 m_width;
+    uint32 m_height;
+    uint8 m_bufferCount;
+    uint8 m_index;
+    uint8 m_vSync;
+    bool m_fullScreen;
+
+public:
+    SwapChain(Calls*, NanoSeconds);
+
+    bool Initialize() final;
+    void Present() final;
+
+    void ResizeBackBuffer(uint32, uint32, bool) final;
+    void SetBackBufferCount(uint8) final;
+    void SetVSync(uint8) final;
+    void SetFullScreen(bool) final;
+
+    Vector2Int GetBackBufferSize() const final { return Vector2Int(m_width, m_height); }
+    uint8 GetBackBufferCount() const final { return m_bufferCount; }
+    uint8 GetVSync() const final { return m_vSync; }
+    bool GetFullScreen() const final { return m_fullScreen; }
+
+    uint8 GetCurrentIndex() const noexcept { return m_index; }
+
+    void SetPresentLatency(NanoSeconds latency) noexcept { m_presentLatency = latency; }
+    NanoSeconds GetPresentLatency() const noexcept { return m_presentLatency; }
+};
+
+} // namespace mini::null_graphics
\ No newline at end of file
@@ -0,0 +1,30 @@
+module mini.null_platform;
+
+import mini.core;
+import mini.engine;
+import :handle;
+import :log;
+
+namespace mini::null_platform {
+
+Handle::Handle(Calls* calls, uint64 frameLimit)
+    : m_calls(calls)
+    , m_frameLimit(frameLimit)
+{
+}
+
+void Handle::PollEvents()
+{
+    uint64 polls = m_calls->pollEvents.FetchAdd(1, MemoryOrder::relaxed) + 1;
+    if (m_frameLimit != 0 && polls > m_frameLimit) {
+        Engine::Quit();
+    }
+}
+
+void Handle::AlertError(StringView const& msg)
+{
+    m_calls->alertError.FetchAdd(1, MemoryOrder::relaxed);
+    LogError("{}", msg);
+}
+
+} // namespace mini::null_platform
\ No newline at end of file
@@ -0,0 +1,42 @@
+module mini.null_platform;
+
+import mini.core;
+import mini.platform;
+import :handle;
+import :window;
+
+namespace mini {
+
+NullPlatform::NullPlatform() noexcept
+    : m_calls()
+    , m_frameLimit(Environment::GetUnsigned("MINI_NULL_FRAMES", 0))
+{
+    null_platform::interface = this;
+}
+
+NullPlatform::~NullPlatform() noexcept
+{
+    null_platform::interface = nullptr;
+}
+
+null_platform::Handle* NullPlatform::GetHandle() noexcept
+{
+    return static_cast<null_platform::Handle*>(m_platform->GetHandle());
+}
+
+null_platform::Window* NullPlatform::GetWindow() noexcept
+{
+    return static_cast<null_platform::Window*>(m_platform->GetWindow());
+}
+
+platform::Handle* NullPlatform::CreateHandle()
+{
+    return new null_platform::Handle(&m_calls, m_frameLimit);
+}
+
+platform::Window* NullPlatform::CreateWindow()
+{
+    return new null_platform::Window(&m_calls);
+}
+
+} // namespace mini
\ No newline at end of file
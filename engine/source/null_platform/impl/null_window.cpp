@@ -0,0 +1,49 @@
+module mini.null_platform;
+
+import mini.core;
+import mini.graphics;
+import :window;
+
+namespace mini::null_platform {
+
+Window::Window(Calls* calls)
+    : m_calls(calls)
+    , m_rect(options::x, options::y, options::width, options::height)
+    , m_isShowing(false)
+    , m_state(Default)
+{
+}
+
+void Window::Resize(RectInt const& rect)
+{
+    m_calls->resize.FetchAdd(1, MemoryOrder::relaxed);
+    m_rect = rect;
+
+    Graphics::ChangeResolution(static_cast<uint32>(rect.width), static_cast<uint32>(rect.height), false);
+}
+
+void Window::Minimize()
+{
+    m_calls->minimize.FetchAdd(1, MemoryOrder::relaxed);
+    m_state = Minimized;
+}
+
+void Window::Maximize()
+{
+    m_calls->maximize.FetchAdd(1, MemoryOrder::relaxed);
+    m_state = Maximized;
+}
+
+void Window::Show()
+{
+    m_calls->show.FetchAdd(1, MemoryOrder::relaxed);
+    m_isShowing = true;
+}
+
+void Window::Hide()
+{
+    m_calls->hide.FetchAdd(1, MemoryOrder::relaxed);
+    m_isShowing = false;
+}
+
+} // namespace mini::null_platform
\ No newline at end of file
@@ -0,0 +1,20 @@
+export module mini.null_platform:calls;
+
+import mini.core;
+
+namespace mini::null_platform {
+
+// Number of times each platform call was made, read by benchmarks and tests after the engine loop.
+export struct Calls {
+public:
+    Atomic<uint64> pollEvents;
+    Atomic<uint64> alertError;
+
+    Atomic<uint64> resize;
+    Atomic<uint64> minimize;
+    Atomic<uint64> maximize;
+    Atomic<uint64> show;
+    Atomic<uint64> hide;
+};
+
+} // namespace mini::null_platform
\ No newline at end of file
@@ -0,0 +1,29 @@
+export module mini.null_platform:handle;
+
+import mini.core;
+import mini.platform;
+import :calls;
+
+namespace mini::null_platform {
+
+// Handle without an event source, it quits the engine once the frame limit is reached.
+// The engine polls once before its first frame, so a limit of n runs n frames. Zero never quits.
+export class NULL_PLATFORM_API Handle final : public platform::Handle {
+private:
+    Calls* m_calls;
+    uint64 m_frameLimit;
+
+public:
+    Handle(Calls*, uint64);
+    ~Handle() noexcept = default;
+
+    bool Valid() const noexcept final { return m_calls != nullptr; }
+
+    void PollEvents() final;
+    void AlertError(StringView const&) final;
+
+    void SetFrameLimit(uint64 frames) noexcept { m_frameLimit = frames; }
+    uint64 GetFrameLimit() const noexcept { return m_frameLimit; }
+};
+
+} // namespace mini::null_platform
\ No newline at end of file
@@ -0,0 +1,39 @@
+export module mini.null_platform;
+
+export import mini.core;
+import mini.platform;
+
+export import :calls;
+export import :handle;
+export import :window;
+
+namespace mini {
+
+// Headless platform for hosts without a display. Nothing is shown, every call is counted instead.
+// The frame limit is read from MINI_NULL_FRAMES when the module is created.
+export class NULL_PLATFORM_API NullPlatform final : public platform::Interface {
+private:
+    null_platform::Calls m_calls;
+    uint64 m_frameLimit;
+
+public:
+    NullPlatform() noexcept;
+    ~NullPlatform() noexcept;
+
+    null_platform::Calls const& GetCalls() const noexcept { return m_calls; }
+
+    null_platform::Handle* GetHandle() noexcept;
+    null_platform::Window* GetWindow() noexcept;
+
+protected:
+    platform::Handle* CreateHandle() final;
+    platform::Window* CreateWindow() final;
+};
+
+} // namespace mini
+
+namespace mini::null_platform {
+
+NULL_PLATFORM_API NullPlatform* interface = nullptr;
+
+} // namespace mini::null_platform
\ No newline at end of file
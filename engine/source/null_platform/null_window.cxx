@@ -0,0 +1,41 @@
+export module mini.null_platform:window;
+
+import mini.core;
+import mini.platform;
+import :calls;
+
+namespace mini::null_platform {
+
+enum WindowState : uint8 {
+    Default,
+    Minimized,
+    Maximized,
+};
+
+export class NULL_PLATFORM_API Window final : public platform::Window {
+private:
+    Calls* m_calls;
+
+    RectInt m_rect;
+    bool m_isShowing;
+    WindowState m_state;
+
+public:
+    Window(Calls*);
+    ~Window() noexcept = default;
+
+    bool Valid() const noexcept final { return m_calls != nullptr; }
+
+    void Resize(RectInt const&) final;
+    void Minimize() final;
+    void Maximize() final;
+    void Show() final;
+    void Hide() final;
+
+    RectInt GetSize() const final { return m_rect; }
+    bool IsMinimized() const final { return m_state == Minimized; }
+    bool IsMaximized() const final { return m_state == Maximized; }
+    bool IsShowing() const noexcept { return m_isShowing; }
+};
+
+} // namespace mini::null_platform
\ No newline at end of file
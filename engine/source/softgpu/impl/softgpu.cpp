@@ -0,0 +1,44 @@
+module mini.softgpu;
+
+import mini.core;
+import mini.graphics;
+import :device;
+
+namespace mini {
+
+SoftGpu::SoftGpu() noexcept
+    : m_workerCount(0)
+{
+    // the thread executing the renderer shades tiles as well
+    uint64 threads = Environment::GetUnsigned("MINI_SOFTGPU_THREADS", CpuTopology::Get().PhysicalCount());
+    m_workerCount = threads > 1 ? static_cast<uint32>(threads - 1) : 0;
+
+    softgpu::interface = this;
+}
+
+SoftGpu::~SoftGpu() noexcept
+{
+    softgpu::interface = nullptr;
+}
+
+graphics::Device* SoftGpu::CreateDevice()
+{
+    return new softgpu::Device(m_workerCount);
+}
+
+softgpu::Device* SoftGpu::GetDevice() noexcept
+{
+    return static_cast<softgpu::Device*>(m_graphics->GetDevice());
+}
+
+softgpu::SwapChain* SoftGpu::GetSwapChain() noexcept
+{
+    return static_cast<softgpu::SwapChain*>(m_graphics->GetSwapChain());
+}
+
+softgpu::Renderer* SoftGpu::GetRenderer() noexcept
+{
+    return static_cast<softgpu::Renderer*>(m_graphics->GetRenderer());
+}
+
+} // namespace mini
\ No newline at end of file
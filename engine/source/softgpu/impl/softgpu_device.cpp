@@ -0,0 +1,25 @@
+module mini.softgpu;
+
+import mini.core;
+import mini.graphics;
+import :swap_chain;
+import :renderer;
+
+namespace mini::softgpu {
+
+Device::Device(uint32 workerCount)
+    : m_workerCount(workerCount)
+{
+}
+
+graphics::SwapChain* Device::CreateSwapChain()
+{
+    return new SwapChain();
+}
+
+graphics::Renderer* Device::CreateRenderer()
+{
+    return new Renderer(m_workerCount);
+}
+
+} // namespace mini::softgpu
\ No newline at end of file
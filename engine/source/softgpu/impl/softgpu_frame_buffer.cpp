@@ -0,0 +1,97 @@
+module mini.softgpu;
+
+import mini.core;
+import :common;
+import :frame_buffer;
+
+namespace mini::softgpu {
+
+FrameBuffer::FrameBuffer() noexcept
+    : m_color()
+    , m_depth()
+    , m_width(0)
+    , m_height(0)
+    , m_pitch(0)
+    , m_rows(0)
+{
+}
+
+bool FrameBuffer::Resize(int32 width, int32 height)
+{
+    ENSURE(width > 0 && height > 0, "invalid frame buffer size") return false;
+    ENSURE(width <= MaxDimension && height <= MaxDimension, "frame buffer is too large") return false;
+
+    m_width = width;
+    m_height = height;
+    m_pitch = (width + TileSize - 1) / TileSize * TileSize;
+    m_rows = (height + TileSize - 1) / TileSize * TileSize;
+
+    size_t size = static_cast<size_t>(m_pitch) * static_cast<size_t>(m_rows);
+    m_color.Clear();
+    m_depth.Clear();
+    m_color.Resize(size, 0u);
+    m_depth.Resize(size, 1.f);
+    return true;
+}
+
+void FrameBuffer::Clear(Color const& color)
+{
+    uint32 packed = PackColor(color);
+    for (uint32& pixel : m_color) {
+        pixel = packed;
+    }
+
+    for (float32& depth : m_depth) {
+        depth = 1.f;
+    }
+}
+
+uint32 FrameBuffer::GetPixel(int32 x, int32 y) const noexcept
+{
+    ASSERT(x >= 0 && x < m_width && y >= 0 && y < m_height, "pixel out of frame buffer");
+    return m_color[static_cast<size_t>(y) * static_cast<size_t>(m_pitch) + static_cast<size_t>(x)];
+}
+
+uint64 FrameBuffer::Hash() const noexcept
+{
+    // FNV-1a over the visible pixels, padding is left out so it does not depend on the tile size
+    uint64 hash = 14695981039346656037ull;
+    for (int32 y = 0; y < m_height; ++y) {
+        for (int32 x = 0; x < m_width; ++x) {
+            uint32 pixel = GetPixel(x, y);
+            for (int32 i = 0; i < 4; ++i) {
+                hash ^= (pixel >> (i * 8)) & 0xff;
+                hash *= 1099511628211ull;
+            }
+        }
+    }
+
+    return hash;
+}
+
+bool FrameBuffer::WriteImage(StringView path) const
+{
+    // binary portable pixmap, alpha is dropped
+    String image;
+    FormatTo(image, "P6\n{} {}\n255\n", m_width, m_height);
+    image.Reserve(image.Size() + static_cast<size_t>(m_width) * static_cast<size_t>(m_height) * 3);
+
+    for (int32 y = 0; y < m_height; ++y) {
+        for (int32 x = 0; x < m_width; ++x) {
+            uint32 pixel = GetPixel(x, y);
+            image.Push(static_cast<char>(pixel & 0xff));
+            image.Push(static_cast<char>((pixel >> 8) & 0xff));
+            image.Push(static_cast<char>((pixel >> 16) & 0xff));
+        }
+    }
+
+    FileOpenOptions options;
+    options.write = true;
+    options.create = true;
+
+    AsyncFile file;
+    return file.Open(path, options) &&
+           file.WriteAt(0, image.Data(), image.Size()) == static_cast<int64>(image.Size());
+}
+
+} // namespace mini::softgpu
\ No newline at end of file
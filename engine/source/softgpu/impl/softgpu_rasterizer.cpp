@@ -0,0 +1,631 @@
+module;
+
+#include <cmath>
+#include <coroutine>
+
+#if ARCH_X86_64
+#  include <immintrin.h>
+#  if MSVC
+#    include <intrin.h>
+#  endif
+#elif ARCH_ARM64
+#  include <arm_neon.h>
+#endif
+
+#if ARCH_X86_64 && (CLANG || GNUC)
+#  define AVX2_TARGET __attribute__((target("avx2")))
+#else
+#  define AVX2_TARGET
+#endif
+
+module mini.softgpu;
+
+import mini.core;
+import :common;
+import :frame_buffer;
+import :rasterizer;
+
+namespace mini::softgpu {
+
+struct ClipVertex {
+    float32 position[4];
+    float32 color[4];
+};
+
+// Sutherland-Hodgman against the six planes of the clip volume grows a triangle by at most one vertex a plane
+static constexpr int32 maxClipVertices = 9;
+
+typedef void (*ShadeFunc)(TriangleSetup const&, FrameBuffer&, RectInt const&) noexcept;
+
+static float32 ClipDistance(ClipVertex const& vertex, int32 plane) noexcept
+{
+    float32 const* p = vertex.position;
+    switch (plane) {
+        case 0:  return p[3] + p[0];
+        case 1:  return p[3] - p[0];
+        case 2:  return p[3] + p[1];
+        case 3:  return p[3] - p[1];
+        case 4:  return p[2];
+        default: return p[3] - p[2];
+    }
+}
+
+static ClipVertex LerpVertex(ClipVertex const& a, ClipVertex const& b, float32 t) noexcept
+{
+    ClipVertex result;
+    for (int32 i = 0; i < 4; ++i) {
+        result.position[i] = a.position[i] + (b.position[i] - a.position[i]) * t;
+        result.color[i] = a.color[i] + (b.color[i] - a.color[i]) * t;
+    }
+
+    return result;
+}
+
+static int32 ClipPolygon(ClipVertex* vertices, int32 count, ClipVertex* scratch) noexcept
+{
+    for (int32 plane = 0; plane < 6 && count > 0; ++plane) {
+        int32 clipped = 0;
+        for (int32 i = 0; i < count; ++i) {
+            ClipVertex const& current = vertices[i];
+            ClipVertex const& next = vertices[(i + 1) % count];
+            float32 currentDistance = ClipDistance(current, plane);
+            float32 nextDistance = ClipDistance(next, plane);
+
+            if (currentDistance >= 0.f) {
+                scratch[clipped++] = current;
+            }
+
+            if ((currentDistance >= 0.f) != (nextDistance >= 0.f)) {
+                float32 t = currentDistance / (currentDistance - nextDistance);
+                scratch[clipped++] = LerpVertex(current, next, t);
+            }
+        }
+
+        for (int32 i = 0; i < clipped; ++i) {
+            vertices[i] = scratch[i];
+        }
+        count = clipped;
+    }
+
+    return count;
+}
+
+static void ShadeTriangleScalar(TriangleSetup const& setup, FrameBuffer& target, RectInt const& area) noexcept
+{
+    int32 pitch = target.Pitch();
+    uint32* colors = target.ColorData();
+    float32* depths = target.DepthData();
+
+    for (int32 y = area.y; y < area.y + area.height; ++y) {
+        int32 edges[3];
+        for (int32 i = 0; i < 3; ++i) {
+            edges[i] = static_cast<int32>(int64(setup.stepX[i]) * area.x + int64(setup.stepY[i]) * y + setup.offset[i]);
+        }
+
+        for (int32 x = area.x; x < area.x + area.width; ++x) {
+            if ((edges[0] | edges[1] | edges[2]) >= 0) {
+                float32 w1 = static_cast<float32>(edges[1]) * setup.inverseArea;
+                float32 w2 = static_cast<float32>(edges[2]) * setup.inverseArea;
+                float32 depth = setup.depth[0] + w1 * setup.depth[1] + w2 * setup.depth[2];
+
+                size_t index = static_cast<size_t>(y) * static_cast<size_t>(pitch) + static_cast<size_t>(x);
+                if (depth < depths[index]) {
+                    Color const* c = setup.color;
+                    depths[index] = depth;
+                    colors[index] = PackColor(Color(c[0].r + w1 * c[1].r + w2 * c[2].r,
+                                                    c[0].g + w1 * c[1].g + w2 * c[2].g,
+                                                    c[0].b + w1 * c[1].b + w2 * c[2].b,
+                                                    c[0].a + w1 * c[1].a + w2 * c[2].a));
+                }
+            }
+
+            edges[0] += setup.stepX[0];
+            edges[1] += setup.stepX[1];
+            edges[2] += setup.stepX[2];
+        }
+    }
+}
+
+#if ARCH_X86_64
+AVX2_TARGET static __m256 InterpolateAvx2(float32 base, float32 delta1, float32 delta2, __m256 w1, __m256 w2) noexcept
+{
+    __m256 value = _mm256_add_ps(_mm256_set1_ps(base), _mm256_mul_ps(w1, _mm256_set1_ps(delta1)));
+    return _mm256_add_ps(value, _mm256_mul_ps(w2, _mm256_set1_ps(delta2)));
+}
+
+AVX2_TARGET static __m256i PackChannelAvx2(__m256 value, int32 shift) noexcept
+{
+    value = _mm256_min_ps(_mm256_max_ps(value, _mm256_setzero_ps()), _mm256_set1_ps(1.f));
+    value = _mm256_add_ps(_mm256_mul_ps(value, _mm256_set1_ps(255.f)), _mm256_set1_ps(0.5f));
+    return _mm256_sll_epi32(_mm256_cvttps_epi32(value), _mm_cvtsi32_si128(shift));
+}
+
+// eight pixels of a row at once, lanes outside of the area are masked off. Rows are padded to whole tiles,
+// so a group starting inside of a tile never reads or writes past the end of it.
+AVX2_TARGET static void ShadeTriangleAvx2(TriangleSetup const& setup, FrameBuffer& target, RectInt const& area) noexcept
+{
+    int32 pitch = target.Pitch();
+    uint32* colors = target.ColorData();
+    float32* depths = target.DepthData();
+
+    __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i minX = _mm256_set1_epi32(area.x - 1);
+    __m256i maxX = _mm256_set1_epi32(area.x + area.width);
+    __m256 inverseArea = _mm256_set1_ps(setup.inverseArea);
+
+    __m256i laneStep[3];
+    __m256i groupStep[3];
+    for (int32 i = 0; i < 3; ++i) {
+        laneStep[i] = _mm256_mullo_epi32(_mm256_set1_epi32(setup.stepX[i]), lane);
+        groupStep[i] = _mm256_set1_epi32(setup.stepX[i] * 8);
+    }
+
+    int32 beginX = area.x & ~7;
+    int32 endX = area.x + area.width;
+    for (int32 y = area.y; y < area.y + area.height; ++y) {
+        __m256i edges[3];
+        for (int32 i = 0; i < 3; ++i) {
+            int64 edge = int64(setup.stepX[i]) * beginX + int64(setup.stepY[i]) * y + setup.offset[i];
+            edges[i] = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int32>(edge)), laneStep[i]);
+        }
+
+        for (int32 x = beginX; x < endX; x += 8) {
+            __m256i xs = _mm256_add_epi32(_mm256_set1_epi32(x), lane);
+            __m256i inside = _mm256_or_si256(_mm256_or_si256(edges[0], edges[1]), edges[2]);
+            __m256i mask = _mm256_cmpgt_epi32(inside, _mm256_set1_epi32(-1));
+            mask = _mm256_and_si256(mask, _mm256_cmpgt_epi32(xs, minX));
+            mask = _mm256_and_si256(mask, _mm256_cmpgt_epi32(maxX, xs));
+
+            if (_mm256_movemask_ps(_mm256_castsi256_ps(mask)) != 0) {
+                __m256 w1 = _mm256_mul_ps(_mm256_cvtepi32_ps(edges[1]), inverseArea);
+                __m256 w2 = _mm256_mul_ps(_mm256_cvtepi32_ps(edges[2]), inverseArea);
+                __m256 depth = InterpolateAvx2(setup.depth[0], setup.depth[1], setup.depth[2], w1, w2);
+
+                size_t index = static_cast<size_t>(y) * static_cast<size_t>(pitch) + static_cast<size_t>(x);
+                __m256 stored = _mm256_loadu_ps(depths + index);
+                __m256 closer = _mm256_and_ps(_mm256_cmp_ps(depth, stored, _CMP_LT_OQ), _mm256_castsi256_ps(mask));
+                _mm256_storeu_ps(depths + index, _mm256_blendv_ps(stored, depth, closer));
+
+                Color const* c = setup.color;
+                __m256i packed = PackChannelAvx2(InterpolateAvx2(c[0].r, c[1].r, c[2].r, w1, w2), 0);
+                packed = _mm256_or_si256(packed, PackChannelAvx2(InterpolateAvx2(c[0].g, c[1].g, c[2].g, w1, w2), 8));
+                packed = _mm256_or_si256(packed, PackChannelAvx2(InterpolateAvx2(c[0].b, c[1].b, c[2].b, w1, w2), 16));
+                packed = _mm256_or_si256(packed, PackChannelAvx2(InterpolateAvx2(c[0].a, c[1].a, c[2].a, w1, w2), 24));
+
+                __m256i* address = reinterpret_cast<__m256i*>(colors + index);
+                __m256i previous = _mm256_loadu_si256(address);
+                __m256i result = _mm256_blendv_epi8(previous, packed, _mm256_castps_si256(closer));
+                _mm256_storeu_si256(address, result);
+            }
+
+            edges[0] = _mm256_add_epi32(edges[0], groupStep[0]);
+            edges[1] = _mm256_add_epi32(edges[1], groupStep[1]);
+            edges[2] = _mm256_add_epi32(edges[2], groupStep[2]);
+        }
+    }
+}
+
+static bool Avx2Supported() noexcept
+{
+#  if MSVC
+    int32 info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+
+    // the operating system has to save the ymm registers as well
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (!osxsave || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#  else
+    return __builtin_cpu_supports("avx2");
+#  endif
+}
+#elif ARCH_ARM64
+static float32x4_t InterpolateNeon(float32 base,
+                                   float32 delta1,
+                                   float32 delta2,
+                                   float32x4_t w1,
+                                   float32x4_t w2) noexcept
+{
+    float32x4_t value = vmlaq_n_f32(vdupq_n_f32(base), w1, delta1);
+    return vmlaq_n_f32(value, w2, delta2);
+}
+
+static uint32x4_t PackChannelNeon(float32x4_t value, int32 shift) noexcept
+{
+    value = vminq_f32(vmaxq_f32(value, vdupq_n_f32(0.f)), vdupq_n_f32(1.f));
+    value = vmlaq_n_f32(vdupq_n_f32(0.5f), value, 255.f);
+    return vshlq_u32(vcvtq_u32_f32(value), vdupq_n_s32(shift));
+}
+
+// four pixels of a row at once, the same masking as the AVX2 kernel
+static void ShadeTriangleNeon(TriangleSetup const& setup, FrameBuffer& target, RectInt const& area) noexcept
+{
+    int32 pitch = target.Pitch();
+    uint32* colors = target.ColorData();
+    float32* depths = target.DepthData();
+
+    int32 const laneValues[4] = { 0, 1, 2, 3 };
+    int32x4_t lane = vld1q_s32(laneValues);
+    int32x4_t minX = vdupq_n_s32(area.x);
+    int32x4_t maxX = vdupq_n_s32(area.x + area.width);
+
+    int32x4_t laneStep[3];
+    int32x4_t groupStep[3];
+    for (int32 i = 0; i < 3; ++i) {
+        laneStep[i] = vmulq_n_s32(lane, setup.stepX[i]);
+        groupStep[i] = vdupq_n_s32(setup.stepX[i] * 4);
+    }
+
+    int32 beginX = area.x & ~3;
+    int32 endX = area.x + area.width;
+    for (int32 y = area.y; y < area.y + area.height; ++y) {
+        int32x4_t edges[3];
+        for (int32 i = 0; i < 3; ++i) {
+            int64 edge = int64(setup.stepX[i]) * beginX + int64(setup.stepY[i]) * y + setup.offset[i];
+            edges[i] = vaddq_s32(vdupq_n_s32(static_cast<int32>(edge)), laneStep[i]);
+        }
+
+        for (int32 x = beginX; x < endX; x += 4) {
+            int32x4_t xs = vaddq_s32(vdupq_n_s32(x), lane);
+            int32x4_t inside = vorrq_s32(vorrq_s32(edges[0], edges[1]), edges[2]);
+            uint32x4_t mask = vcgeq_s32(inside, vdupq_n_s32(0));
+            mask = vandq_u32(mask, vcgeq_s32(xs, minX));
+            mask = vandq_u32(mask, vcltq_s32(xs, maxX));
+
+            if (vmaxvq_u32(mask) != 0) {
+                float32x4_t w1 = vmulq_n_f32(vcvtq_f32_s32(edges[1]), setup.inverseArea);
+                float32x4_t w2 = vmulq_n_f32(vcvtq_f32_s32(edges[2]), setup.inverseArea);
+                float32x4_t depth = InterpolateNeon(setup.depth[0], setup.depth[1], setup.depth[2], w1, w2);
+
+                size_t index = static_cast<size_t>(y) * static_cast<size_t>(pitch) + static_cast<size_t>(x);
+                float32x4_t stored = vld1q_f32(depths + index);
+                uint32x4_t closer = vandq_u32(vcltq_f32(depth, stored), mask);
+                vst1q_f32(depths + index, vbslq_f32(closer, depth, stored));
+
+                Color const* c = setup.color;
+                uint32x4_t packed = PackChannelNeon(InterpolateNeon(c[0].r, c[1].r, c[2].r, w1, w2), 0);
+                packed = vorrq_u32(packed, PackChannelNeon(InterpolateNeon(c[0].g, c[1].g, c[2].g, w1, w2), 8));
+                packed = vorrq_u32(packed, PackChannelNeon(InterpolateNeon(c[0].b, c[1].b, c[2].b, w1, w2), 16));
+                packed = vorrq_u32(packed, PackChannelNeon(InterpolateNeon(c[0].a, c[1].a, c[2].a, w1, w2), 24));
+                vst1q_u32(colors + index, vbslq_u32(closer, packed, vld1q_u32(colors + index)));
+            }
+
+            edges[0] = vaddq_s32(edges[0], groupStep[0]);
+            edges[1] = vaddq_s32(edges[1], groupStep[1]);
+            edges[2] = vaddq_s32(edges[2], groupStep[2]);
+        }
+    }
+}
+#endif
+
+static ShadeFunc SelectShadeFunc() noexcept
+{
+#if ARCH_X86_64
+    return Avx2Supported() ? ShadeTriangleAvx2 : ShadeTriangleScalar;
+#elif ARCH_ARM64
+    return ShadeTriangleNeon;
+#else
+    return ShadeTriangleScalar;
+#endif
+}
+
+static ShadeFunc GetShadeFunc() noexcept
+{
+    static ShadeFunc func = SelectShadeFunc();
+    return func;
+}
+
+Rasterizer::Rasterizer(uint32 workerCount)
+    : m_triangles()
+    , m_bins()
+    , m_scheduler()
+    , m_workerCount(workerCount)
+    , m_viewport()
+    , m_minDepth(0.f)
+    , m_maxDepth(1.f)
+    , m_scissorRect(0, 0, MaxDimension, MaxDimension)
+    , m_clearColor(Color::Black())
+    , m_clear(true)
+    , m_simd(true)
+    , m_nextTile(0)
+    , m_activeWorkers(0)
+    , m_target(nullptr)
+{
+    if (m_workerCount != 0) {
+        ThreadOptions options;
+        options.name = "mini.softgpu";
+        m_scheduler = MakeUnique<Scheduler>(m_workerCount, options);
+    }
+}
+
+Rasterizer::~Rasterizer()
+{
+    ASSERT(m_activeWorkers.Load(MemoryOrder::acquire) == 0, "rasterizer destroyed while drawing");
+}
+
+void Rasterizer::SetViewport(Rect const& viewport, float32 minDepth, float32 maxDepth) noexcept
+{
+    // vertices have to stay within the largest frame buffer for the edge functions to fit
+    float32 limit = static_cast<float32>(MaxDimension);
+    float32 x = Min(Max(viewport.x, 0.f), limit);
+    float32 y = Min(Max(viewport.y, 0.f), limit);
+
+    m_viewport = Rect(x, y, Min(Max(viewport.width, 0.f), limit - x), Min(Max(viewport.height, 0.f), limit - y));
+    m_minDepth = minDepth;
+    m_maxDepth = maxDepth;
+}
+
+void Rasterizer::SetScissorRect(RectInt const& rect) noexcept
+{
+    m_scissorRect = rect;
+}
+
+void Rasterizer::SetClearColor(Color const& color) noexcept
+{
+    m_clearColor = color;
+}
+
+void Rasterizer::SetClear(bool clear) noexcept
+{
+    m_clear = clear;
+}
+
+void Rasterizer::SetSimd(bool simd) noexcept
+{
+    m_simd = simd;
+}
+
+void Rasterizer::Submit(Vertex const* vertices, size_t count)
+{
+    ASSERT(count % 3 == 0, "triangle list has a partial triangle");
+
+    ClipVertex polygon[maxClipVertices];
+    ClipVertex scratch[maxClipVertices];
+    Vertex fan[3];
+
+    for (size_t i = 0; i + 2 < count; i += 3) {
+        for (int32 v = 0; v < 3; ++v) {
+            Vertex const& vertex = vertices[i + static_cast<size_t>(v)];
+            for (int32 c = 0; c < 4; ++c) {
+                polygon[v].position[c] = vertex.position.data[c];
+                polygon[v].color[c] = vertex.color.data[c];
+            }
+        }
+
+        int32 clipped = ClipPolygon(polygon, 3, scratch);
+        for (int32 v = 1; v + 1 < clipped; ++v) {
+            ClipVertex const* corners[3] = { &polygon[0], &polygon[v], &polygon[v + 1] };
+            for (int32 c = 0; c < 3; ++c) {
+                float32 const* p = corners[c]->position;
+                float32 const* color = corners[c]->color;
+                fan[c].position = Vector4(p[0], p[1], p[2], p[3]);
+                fan[c].color = Color(color[0], color[1], color[2], color[3]);
+            }
+
+            SetupTriangle(fan[0], fan[1], fan[2]);
+        }
+    }
+}
+
+void Rasterizer::SetupTriangle(Vertex const& v0, Vertex const& v1, Vertex const& v2)
+{
+    Vertex const* vertices[3] = { &v0, &v1, &v2 };
+    int32 xs[3];
+    int32 ys[3];
+    float32 depths[3];
+    float32 screen[3][2];
+
+    for (int32 i = 0; i < 3; ++i) {
+        Vector4 const& position = vertices[i]->position;
+        if (position.w <= 0.f) {
+            return;
+        }
+
+        float32 inverseW = 1.f / position.w;
+        screen[i][0] = m_viewport.x + (position.x * inverseW * 0.5f + 0.5f) * m_viewport.width;
+        screen[i][1] = m_viewport.y + (0.5f - position.y * inverseW * 0.5f) * m_viewport.height;
+        depths[i] = m_minDepth + position.z * inverseW * (m_maxDepth - m_minDepth);
+
+        xs[i] = static_cast<int32>(std::floor(screen[i][0] * SubPixelScale + 0.5f));
+        ys[i] = static_cast<int32>(std::floor(screen[i][1] * SubPixelScale + 0.5f));
+    }
+
+    int64 area = int64(xs[1] - xs[0]) * (ys[2] - ys[0]) - int64(ys[1] - ys[0]) * (xs[2] - xs[0]);
+    if (area == 0) {
+        return;
+    }
+
+    // both windings are drawn, the edges are ordered so the inside is positive
+    int32 order[3] = { 0, 1, 2 };
+    if (area < 0) {
+        order[1] = 2;
+        order[2] = 1;
+        area = -area;
+    }
+
+    TriangleSetup setup;
+    int32 minX = MaxDimension * SubPixelScale;
+    int32 minY = MaxDimension * SubPixelScale;
+    int32 maxX = 0;
+    int32 maxY = 0;
+
+    for (int32 i = 0; i < 3; ++i) {
+        int32 j = order[(i + 1) % 3];
+        int32 k = order[(i + 2) % 3];
+        int32 a = ys[j] - ys[k];
+        int32 b = xs[k] - xs[j];
+        int64 c = -(int64(a) * xs[j] + int64(b) * ys[j]);
+
+        // pixels on an edge belong to the triangle only if it is a left or a top edge
+        bool topLeft = a > 0 || (a == 0 && b > 0);
+        setup.stepX[i] = a * SubPixelScale;
+        setup.stepY[i] = b * SubPixelScale;
+        setup.offset[i] = c + int64(a + b) * (SubPixelScale / 2) - (topLeft ? 0 : 1);
+
+        int32 vertex = order[i];
+        minX = Min(minX, xs[vertex]);
+        minY = Min(minY, ys[vertex]);
+        maxX = Max(maxX, xs[vertex]);
+        maxY = Max(maxY, ys[vertex]);
+    }
+
+    setup.minX = Max(minX >> SubPixelBits, m_scissorRect.x);
+    setup.minY = Max(minY >> SubPixelBits, m_scissorRect.y);
+    setup.maxX = Min(maxX >> SubPixelBits, m_scissorRect.x + m_scissorRect.width - 1);
+    setup.maxY = Min(maxY >> SubPixelBits, m_scissorRect.y + m_scissorRect.height - 1);
+    if (setup.minX > setup.maxX || setup.minY > setup.maxY) {
+        return;
+    }
+
+    Vertex const& first = *vertices[order[0]];
+    setup.inverseArea = 1.f / static_cast<float32>(area);
+    setup.depth[0] = depths[order[0]];
+    setup.color[0] = first.color;
+    for (int32 i = 1; i < 3; ++i) {
+        setup.depth[i] = depths[order[i]] - depths[order[0]];
+        setup.color[i] = vertices[order[i]]->color - first.color;
+    }
+
+    m_triangles.Push(setup);
+}
+
+void Rasterizer::Bin(FrameBuffer& target)
+{
+    int32 tilesX = target.TileCountX();
+    int32 tilesY = target.TileCountY();
+    size_t tileCount = static_cast<size_t>(tilesX) * static_cast<size_t>(tilesY);
+
+    if (m_bins.Size() != tileCount) {
+        m_bins.Clear();
+        m_bins.Resize(tileCount);
+    }
+
+    for (TileBin& bin : m_bins) {
+        bin.triangles.Clear();
+    }
+
+    for (size_t index = 0; index < m_triangles.Size(); ++index) {
+        TriangleSetup const& setup = m_triangles[index];
+        int32 maxX = Min(setup.maxX, target.Width() - 1);
+        int32 maxY = Min(setup.maxY, target.Height() - 1);
+        if (setup.minX > maxX || setup.minY > maxY) {
+            continue;
+        }
+
+        for (int32 tileY = setup.minY / TileSize; tileY <= maxY / TileSize; ++tileY) {
+            for (int32 tileX = setup.minX / TileSize; tileX <= maxX / TileSize; ++tileX) {
+                // a tile is skipped once one of the edges is negative even in its most inside corner
+                bool outside = false;
+                for (int32 i = 0; i < 3 && !outside; ++i) {
+                    int32 x = tileX * TileSize + (setup.stepX[i] > 0 ? TileSize - 1 : 0);
+                    int32 y = tileY * TileSize + (setup.stepY[i] > 0 ? TileSize - 1 : 0);
+                    outside = int64(setup.stepX[i]) * x + int64(setup.stepY[i]) * y + setup.offset[i] < 0;
+                }
+
+                if (!outside) {
+                    m_bins[static_cast<size_t>(tileY * tilesX + tileX)].triangles.Push(static_cast<uint32>(index));
+                }
+            }
+        }
+    }
+}
+
+void Rasterizer::Draw(FrameBuffer& target)
+{
+    PROFILE_SCOPE("Rasterizer::Draw");
+    m_target = &target;
+
+    {
+        PROFILE_SCOPE("Rasterizer::Bin");
+        Bin(target);
+    }
+
+    uint32 workers = m_scheduler != nullptr ? Min(m_workerCount, static_cast<uint32>(m_bins.Size())) : 0;
+    m_nextTile.Store(0, MemoryOrder::relaxed);
+    m_activeWorkers.Store(workers, MemoryOrder::release);
+
+    for (uint32 i = 0; i < workers; ++i) {
+        m_scheduler->Spawn(ShadeWorker(this));
+    }
+
+    ShadeTiles();
+
+    uint32 active = m_activeWorkers.Load(MemoryOrder::acquire);
+    while (active != 0) {
+        m_activeWorkers.Wait(active, MemoryOrder::acquire);
+        active = m_activeWorkers.Load(MemoryOrder::acquire);
+    }
+
+    m_target = nullptr;
+}
+
+void Rasterizer::Reset() noexcept
+{
+    m_triangles.Clear();
+}
+
+bool Rasterizer::SimdSupported() noexcept
+{
+    return GetShadeFunc() != ShadeTriangleScalar;
+}
+
+Task<void> Rasterizer::ShadeWorker(Rasterizer* rasterizer)
+{
+    co_await rasterizer->m_scheduler->Schedule();
+    rasterizer->ShadeTiles();
+
+    if (rasterizer->m_activeWorkers.FetchSub(1, MemoryOrder::acquireRelease) == 1) {
+        rasterizer->m_activeWorkers.NotifyAll();
+    }
+}
+
+void Rasterizer::ShadeTiles() noexcept
+{
+    uint32 count = static_cast<uint32>(m_bins.Size());
+    uint32 tile = m_nextTile.FetchAdd(1, MemoryOrder::relaxed);
+
+    while (tile < count) {
+        ShadeTile(tile);
+        tile = m_nextTile.FetchAdd(1, MemoryOrder::relaxed);
+    }
+}
+
+void Rasterizer::ShadeTile(uint32 tile) noexcept
+{
+    FrameBuffer& target = *m_target;
+    int32 tilesX = target.TileCountX();
+    int32 tileX = static_cast<int32>(tile) % tilesX * TileSize;
+    int32 tileY = static_cast<int32>(tile) / tilesX * TileSize;
+
+    if (m_clear) {
+        uint32 color = PackColor(m_clearColor);
+        for (int32 y = tileY; y < tileY + TileSize; ++y) {
+            size_t row = static_cast<size_t>(y) * static_cast<size_t>(target.Pitch()) + static_cast<size_t>(tileX);
+            for (size_t x = 0; x < static_cast<size_t>(TileSize); ++x) {
+                target.ColorData()[row + x] = color;
+                target.DepthData()[row + x] = 1.f;
+            }
+        }
+    }
+
+    ShadeFunc shade = m_simd ? GetShadeFunc() : ShadeTriangleScalar;
+    for (uint32 index : m_bins[tile].triangles) {
+        TriangleSetup const& setup = m_triangles[index];
+        int32 minX = Max(setup.minX, tileX);
+        int32 minY = Max(setup.minY, tileY);
+        int32 maxX = Min(Min(setup.maxX, tileX + TileSize - 1), target.Width() - 1);
+        int32 maxY = Min(Min(setup.maxY, tileY + TileSize - 1), target.Height() - 1);
+
+        shade(setup, target, RectInt(minX, minY, maxX - minX + 1, maxY - minY + 1));
+    }
+}
+
+} // namespace mini::softgpu
\ No newline at end of file
@@ -0,0 +1,57 @@
+module mini.softgpu;
+
+import mini.core;
+import mini.graphics;
+import :renderer;
+import :swap_chain;
+
+namespace mini::softgpu {
+
+Renderer::Renderer(uint32 workerCount)
+    : m_rasterizer(workerCount)
+    , m_recording(false)
+{
+}
+
+void Renderer::BeginRender()
+{
+    ASSERT(!m_recording, "render has already begun");
+
+    m_rasterizer.Reset();
+    m_recording = true;
+}
+
+void Renderer::EndRender()
+{
+    ASSERT(m_recording, "render has not begun");
+    m_recording = false;
+}
+
+void Renderer::Execute()
+{
+    ASSERT(!m_recording, "render has not ended");
+    m_rasterizer.Draw(*interface->GetSwapChain()->GetCurrentBuffer());
+}
+
+void Renderer::SetViewport(Rect const& viewport, float32 minDepth, float32 maxDepth)
+{
+    m_rasterizer.SetViewport(viewport, minDepth, maxDepth);
+}
+
+void Renderer::SetScissorRect(RectInt const& rect)
+{
+    m_rasterizer.SetScissorRect(rect);
+}
+
+void Renderer::SetClearColor(Color const& color) noexcept
+{
+    m_rasterizer.SetClearColor(color);
+}
+
+void Renderer::DrawTriangles(Vertex const* vertices, size_t count)
+{
+    ASSERT(m_recording, "draw outside of BeginRender and EndRender");
+    m_rasterizer.Submit(vertices, count);
+}
+
+} // namespace mini::softgpu
\ No newline at end of file
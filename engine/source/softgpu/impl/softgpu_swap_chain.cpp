@@ -0,0 +1,98 @@
+module mini.softgpu;
+
+import mini.core;
+import mini.graphics;
+import :swap_chain;
+
+namespace mini::softgpu {
+
+SwapChain::SwapChain()
+    : m_buffers()
+    , m_index(0)
+    , m_presented(0)
+    , m_vSync(options::vsync)
+    , m_fullScreen(options::fullscreen)
+    , m_hasPresented(false)
+{
+}
+
+bool SwapChain::Initialize()
+{
+    return CreateBuffers(options::bufferCount, options::width, options::height);
+}
+
+void SwapChain::Present()
+{
+    m_presented = m_index;
+    m_hasPresented = true;
+    m_index = static_cast<uint8>((m_index + 1) % m_buffers.Size());
+}
+
+void SwapChain::ResizeBackBuffer(uint32 width, uint32 height, bool fullscreen)
+{
+    ENSURE(width * height > 0, "invalid width and height") return;
+
+    if (CreateBuffers(GetBackBufferCount(), static_cast<int32>(width), static_cast<int32>(height))) {
+        m_fullScreen = fullscreen;
+    }
+}
+
+void SwapChain::SetBackBufferCount(uint8 count)
+{
+    ENSURE(count > 0 && count <= MaxBackBuffer, "invalid swap chain count") return;
+
+    Vector2Int size = GetBackBufferSize();
+    CreateBuffers(count, size.x, size.y);
+}
+
+void SwapChain::SetVSync(uint8 vsync)
+{
+    m_vSync = vsync;
+}
+
+void SwapChain::SetFullScreen(bool fullscreen)
+{
+    m_fullScreen = fullscreen;
+}
+
+Vector2Int SwapChain::GetBackBufferSize() const
+{
+    if (m_buffers.Empty()) {
+        return Vector2Int(0, 0);
+    }
+
+    return Vector2Int(m_buffers[0].Width(), m_buffers[0].Height());
+}
+
+FrameBuffer const* SwapChain::GetPresentedBuffer() const noexcept
+{
+    return m_hasPresented ? &m_buffers[m_presented] : nullptr;
+}
+
+bool SwapChain::WriteImage(StringView path) const
+{
+    FrameBuffer const* buffer = GetPresentedBuffer();
+    ENSURE(buffer != nullptr, "nothing has been presented") return false;
+
+    return buffer->WriteImage(path);
+}
+
+bool SwapChain::CreateBuffers(uint8 count, int32 width, int32 height)
+{
+    // the current buffers are kept when a size is refused, the swap chain never ends up without buffers
+    Array<FrameBuffer> buffers;
+    buffers.Resize(count);
+
+    for (FrameBuffer& buffer : buffers) {
+        if (!buffer.Resize(width, height)) {
+            return false;
+        }
+    }
+
+    m_buffers.Swap(buffers);
+    m_index = 0;
+    m_hasPresented = false;
+    return true;
+}
+
+} // namespace mini::softgpu
\ No newline at end of file
@@ -0,0 +1,39 @@
+export module mini.softgpu;
+
+export import mini.core;
+import mini.graphics;
+
+export import :common;
+export import :frame_buffer;
+export import :rasterizer;
+export import :device;
+export import :renderer;
+export import :swap_chain;
+
+namespace mini {
+
+// Graphics on the processor, for hosts without a GPU and for output that has to match between runs.
+// MINI_SOFTGPU_THREADS sets the number of threads shading tiles, the thread calling Execute included.
+// Without it every physical core shades.
+export class SOFTGPU_API SoftGpu final : public graphics::Interface {
+private:
+    uint32 m_workerCount;
+
+public:
+    SoftGpu() noexcept;
+    ~SoftGpu() noexcept;
+
+    graphics::Device* CreateDevice() final;
+
+    softgpu::Device* GetDevice() noexcept;
+    softgpu::SwapChain* GetSwapChain() noexcept;
+    softgpu::Renderer* GetRenderer() noexcept;
+};
+
+} // namespace mini
+
+namespace mini::softgpu {
+
+SOFTGPU_API SoftGpu* interface = nullptr;
+
+} // namespace mini::softgpu
\ No newline at end of file
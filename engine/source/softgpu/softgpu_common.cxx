@@ -0,0 +1,34 @@
+export module mini.softgpu:common;
+
+import mini.core;
+
+namespace mini::softgpu {
+
+// Back buffers are split into square tiles, each binned and shaded on its own by one thread.
+// Storage of a frame buffer is padded to whole tiles so a tile is never clipped to the buffer.
+export constexpr int32 TileSize = 32;
+
+// Vertices are snapped to 1/16 of a pixel. Together with the largest frame buffer this keeps every
+// edge function value of a triangle within an int32.
+export constexpr int32 SubPixelBits = 4;
+export constexpr int32 SubPixelScale = 1 << SubPixelBits;
+export constexpr int32 MaxDimension = 2048;
+
+// Position is in clip space, the rasterizer divides by w. Depth follows the D3D convention of 0 to w.
+export struct Vertex {
+public:
+    Vector4 position;
+    Color color;
+};
+
+export inline uint32 PackColor(Color const& color) noexcept
+{
+    auto channel = [](float32 value) -> uint32 {
+        value = value < 0.f ? 0.f : (value > 1.f ? 1.f : value);
+        return static_cast<uint32>(value * 255.f + 0.5f);
+    };
+
+    return channel(color.r) | (channel(color.g) << 8) | (channel(color.b) << 16) | (channel(color.a) << 24);
+}
+
+} // namespace mini::softgpu
\ No newline at end of file
@@ -0,0 +1,24 @@
+export module mini.softgpu:device;
+
+import mini.core;
+import mini.graphics;
+
+namespace mini::softgpu {
+
+export class SOFTGPU_API Device final : public graphics::Device {
+private:
+    uint32 m_workerCount;
+
+public:
+    Device(uint32);
+
+    bool Initialize() final { return true; }
+
+    graphics::SwapChain* CreateSwapChain() final;
+    graphics::Renderer* CreateRenderer() final;
+
+    graphics::API GetAPI() const final { return graphics::API::Software; }
+    uint32 GetWorkerCount() const noexcept { return m_workerCount; }
+};
+
+} // namespace mini::softgpu
\ No newline at end of file
@@ -0,0 +1,51 @@
+export module mini.softgpu:frame_buffer;
+
+import mini.core;
+import :common;
+
+namespace mini::softgpu {
+
+// Color and depth of a back buffer. Colors are RGBA8 with red in the lowest byte, depth is cleared to 1.
+// Rows are padded to whole tiles, the pitch is the number of pixels from one row to the next.
+export class SOFTGPU_API FrameBuffer {
+private:
+    Array<uint32> m_color;
+    Array<float32> m_depth;
+
+    int32 m_width;
+    int32 m_height;
+    int32 m_pitch;
+    int32 m_rows;
+
+public:
+    FrameBuffer() noexcept;
+    FrameBuffer(FrameBuffer&&) noexcept = default;
+    ~FrameBuffer() noexcept = default;
+
+    bool Resize(int32, int32);
+    void Clear(Color const&);
+
+    int32 Width() const noexcept { return m_width; }
+    int32 Height() const noexcept { return m_height; }
+    int32 Pitch() const noexcept { return m_pitch; }
+    int32 Rows() const noexcept { return m_rows; }
+    int32 TileCountX() const noexcept { return m_pitch / TileSize; }
+    int32 TileCountY() const noexcept { return m_rows / TileSize; }
+
+    uint32* ColorData() noexcept { return m_color.Data(); }
+    float32* DepthData() noexcept { return m_depth.Data(); }
+    uint32 const* ColorData() const noexcept { return m_color.Data(); }
+    float32 const* DepthData() const noexcept { return m_depth.Data(); }
+
+    uint32 GetPixel(int32, int32) const noexcept;
+    uint64 Hash() const noexcept;
+    bool WriteImage(StringView) const;
+
+    FrameBuffer& operator=(FrameBuffer&&) noexcept = default;
+
+private:
+    FrameBuffer(FrameBuffer const&) = delete;
+    FrameBuffer& operator=(FrameBuffer const&) = delete;
+};
+
+} // namespace mini::softgpu
\ No newline at end of file
@@ -0,0 +1,89 @@
+export module mini.softgpu:rasterizer;
+
+import mini.core;
+import :common;
+import :frame_buffer;
+
+namespace mini::softgpu {
+
+// Triangle after clipping and viewport transform, in the form the tile kernels step through.
+// Edge i is zero on the edge opposite of vertex i and positive inside. Its value at the center of pixel
+// (x, y) is stepX * x + stepY * y + offset, with the top-left rule folded into the offset.
+// Depth and color hold vertex 0 followed by the deltas of vertices 1 and 2, weighted by their edges.
+export struct TriangleSetup {
+public:
+    int32 stepX[3];
+    int32 stepY[3];
+    int64 offset[3];
+    int32 minX;
+    int32 minY;
+    int32 maxX;
+    int32 maxY;
+
+    float32 inverseArea;
+    float32 depth[3];
+    Color color[3];
+};
+
+// Tile based rasterizer of triangle lists. Submit clips and sets up triangles, Draw bins them into tiles
+// and shades the tiles across the workers and the calling thread. Within a tile triangles are drawn in
+// submission order, which keeps the output identical for any number of threads.
+// Edge functions are stepped with AVX2 where the processor supports it, with NEON on arm64 and in scalar
+// code elsewhere. The scalar kernel can be forced per rasterizer, the SIMD kernels match it pixel for pixel.
+// Colors are interpolated linearly in screen space, without perspective correction.
+export class SOFTGPU_API Rasterizer {
+private:
+    struct TileBin {
+        Array<uint32> triangles;
+    };
+
+    Array<TriangleSetup> m_triangles;
+    Array<TileBin> m_bins;
+    UniquePtr<Scheduler> m_scheduler;
+    uint32 m_workerCount;
+
+    Rect m_viewport;
+    float32 m_minDepth;
+    float32 m_maxDepth;
+    RectInt m_scissorRect;
+    Color m_clearColor;
+    bool m_clear;
+    bool m_simd;
+
+    Atomic<uint32> m_nextTile;
+    Atomic<uint32> m_activeWorkers;
+    FrameBuffer* m_target;
+
+public:
+    explicit Rasterizer(uint32 = 0);
+    ~Rasterizer();
+
+    void SetViewport(Rect const&, float32, float32) noexcept;
+    void SetScissorRect(RectInt const&) noexcept;
+    void SetClearColor(Color const&) noexcept;
+    void SetClear(bool) noexcept;
+    void SetSimd(bool) noexcept;
+
+    void Submit(Vertex const*, size_t);
+    void Draw(FrameBuffer&);
+    void Reset() noexcept;
+
+    size_t TriangleCount() const noexcept { return m_triangles.Size(); }
+    uint32 WorkerCount() const noexcept { return m_workerCount; }
+    bool SimdEnabled() const noexcept { return m_simd && SimdSupported(); }
+
+    static bool SimdSupported() noexcept;
+
+private:
+    void SetupTriangle(Vertex const&, Vertex const&, Vertex const&);
+    void Bin(FrameBuffer&);
+    void ShadeTiles() noexcept;
+    void ShadeTile(uint32) noexcept;
+
+    static Task<void> ShadeWorker(Rasterizer*);
+
+    Rasterizer(Rasterizer const&) = delete;
+    Rasterizer& operator=(Rasterizer const&) = delete;
+};
+
+} // namespace mini::softgpu
\ No newline at end of file
@@ -0,0 +1,36 @@
+export module mini.softgpu:renderer;
+
+import mini.core;
+import mini.graphics;
+import :common;
+import :rasterizer;
+
+namespace mini::softgpu {
+
+// Records triangle lists between BeginRender and EndRender, Execute rasterizes them into the current back
+// buffer of the swap chain and returns once the frame is complete, so there is nothing to wait for.
+export class SOFTGPU_API Renderer final : public graphics::Renderer {
+private:
+    Rasterizer m_rasterizer;
+    bool m_recording;
+
+public:
+    Renderer(uint32);
+
+    bool Initialize() final { return true; }
+
+    void BeginRender() final;
+    void EndRender() final;
+    void WaitForIdle() final {}
+    void Execute() final;
+
+    void SetViewport(Rect const&, float32, float32) final;
+    void SetScissorRect(RectInt const&) final;
+    void SetClearColor(Color const&) noexcept;
+
+    void DrawTriangles(Vertex const*, size_t);
+
+    Rasterizer& GetRasterizer() noexcept { return m_rasterizer; }
+};
+
+} // namespace mini::softgpu
\ No newline at end of file
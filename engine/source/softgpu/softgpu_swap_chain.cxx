@@ -0,0 +1,44 @@
+export module mini.softgpu:swap_chain;
+
+import mini.core;
+import mini.graphics;
+import :frame_buffer;
+
+namespace mini::softgpu {
+
+// Back buffers kept in memory. Present hands the current buffer over as the presented one, which stays
+// readable until the buffer comes around again, and moves on to the next buffer.
+export class SOFTGPU_API SwapChain final : public graphics::SwapChain {
+private:
+    Array<FrameBuffer> m_buffers;
+    uint8 m_index;
+    uint8 m_presented;
+    uint8 m_vSync;
+    bool m_fullScreen;
+    bool m_hasPresented;
+
+public:
+    SwapChain();
+
+    bool Initialize() final;
+    void Present() final;
+
+    void ResizeBackBuffer(uint32, uint32, bool) final;
+    void SetBackBufferCount(uint8) final;
+    void SetVSync(uint8) final;
+    void SetFullScreen(bool) final;
+
+    Vector2Int GetBackBufferSize() const final;
+    uint8 GetBackBufferCount() const final { return static_cast<uint8>(m_buffers.Size()); }
+    uint8 GetVSync() const final { return m_vSync; }
+    bool GetFullScreen() const final { return m_fullScreen; }
+
+    FrameBuffer* GetCurrentBuffer() noexcept { return &m_buffers[m_index]; }
+    FrameBuffer const* GetPresentedBuffer() const noexcept;
+    bool WriteImage(StringView) const;
+
+private:
+    bool CreateBuffers(uint8, int32, int32);
+};
+
+} // namespace mini::softgpu
\ No newline at end of file
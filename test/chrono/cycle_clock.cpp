@@ -0,0 +1,69 @@
+#include "test_macro.h"
+
+import mini.test;
+
+using namespace mini;
+using namespace mini::test;
+
+int32 TestCycles()
+{
+    TEST_ENSURE(CycleClock::Frequency() != 0);
+
+    uint64 first = CycleClock::Cycles();
+    uint64 second = CycleClock::CyclesOrdered();
+    TEST_ENSURE(second >= first);
+
+    // conversions round trip within a cycle of precision
+    uint64 perSecond = CycleClock::FromDuration(Seconds(1));
+    TEST_ENSURE(perSecond + 1 >= CycleClock::Frequency() && perSecond <= CycleClock::Frequency() + 1);
+    TEST_ENSURE(CycleClock::ToDuration(CycleClock::Frequency()) >= MilliSeconds(999));
+    TEST_ENSURE(CycleClock::ToDuration(CycleClock::Frequency()) <= MilliSeconds(1001));
+    TEST_ENSURE(CycleClock::FromDuration(NanoSeconds(-1)) == 0);
+
+    return 0;
+}
+
+int32 TestNow()
+{
+    mini::Clock::TimePoint clockStart = mini::Clock::Now();
+    CycleClock::TimePoint cycleStart = CycleClock::Now();
+    uint64 cycles = CycleClock::Cycles();
+
+    Thread::SleepFor(MilliSeconds(20));
+
+    mini::Clock::TimePoint clockEnd = mini::Clock::Now();
+    CycleClock::TimePoint cycleEnd = CycleClock::Now();
+    NanoSeconds measured = CycleClock::ToDuration(CycleClock::Cycles() - cycles);
+
+    // both clocks share an epoch and agree on elapsed time, up to the calibration error and scheduling noise
+    TEST_ENSURE(cycleEnd >= cycleStart);
+    TEST_ENSURE(measured >= MilliSeconds(19));
+    NanoSeconds difference = (cycleEnd - cycleStart) - (clockEnd - clockStart);
+    TEST_ENSURE(difference < MilliSeconds(2) && difference > MilliSeconds(-2));
+    NanoSeconds offset = cycleStart - clockStart;
+    TEST_ENSURE(offset < MilliSeconds(10) && offset > MilliSeconds(-10));
+
+    return 0;
+}
+
+int32 TestCoarse()
+{
+    CoarseClock::TimePoint start = CoarseClock::Now();
+    Thread::SleepFor(MilliSeconds(50));
+    CoarseClock::TimePoint end = CoarseClock::Now();
+
+    // windows only advances the tick count every 16ms
+    TEST_ENSURE(end >= start);
+    TEST_ENSURE(end - start >= MilliSeconds(30));
+
+    return 0;
+}
+
+int32 main()
+{
+    TEST_ENSURE(TestCycles() == 0);
+    TEST_ENSURE(TestNow() == 0);
+    TEST_ENSURE(TestCoarse() == 0);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "test_macro.h"
+
+import mini.test;
+
+using namespace mini;
+using namespace mini::test;
+
+int32 TestCadence()
+{
+    FramePacer pacer(MilliSeconds(4));
+    TEST_ENSURE(pacer.Enabled());
+    TEST_ENSURE(FramePacer::FromRate(250) == MilliSeconds(4));
+    TEST_ENSURE(FramePacer::FromRate(0) == NanoSeconds::Zero());
+
+    // deadlines advance from each other, the average frame matches the target however long Wait takes to return
+    CycleClock::TimePoint start = CycleClock::Now();
+    for (int32 i = 0; i < 25; ++i) {
+        pacer.Wait();
+        TEST_ENSURE(CycleClock::Now() >= pacer.Deadline() - MilliSeconds(4));
+    }
+
+    NanoSeconds elapsed = CycleClock::Now() - start;
+    TEST_ENSURE(elapsed >= MilliSeconds(99));
+    TEST_ENSURE(pacer.Stats().frames == 25);
+    TEST_ENSURE(pacer.Stats().resyncs <= pacer.Stats().missed);
+
+    return 0;
+}
+
+int32 TestMissed()
+{
+    FramePacer pacer(MilliSeconds(5));
+
+    // a frame running past its deadline is late, but within a target the next deadline stays on the cadence
+    CycleClock::TimePoint deadline = pacer.Deadline();
+    Thread::SleepFor(MilliSeconds(7));
+    NanoSeconds lateness = pacer.Wait();
+    TEST_ENSURE(lateness >= MilliSeconds(2));
+    TEST_ENSURE(pacer.Stats().missed == 1);
+    TEST_ENSURE(pacer.Stats().maxLateness == lateness);
+
+    if (lateness < MilliSeconds(5)) {
+        TEST_ENSURE(pacer.Deadline() == deadline + MilliSeconds(5));
+        TEST_ENSURE(pacer.Stats().resyncs == 0);
+    }
+
+    // later than a whole frame restarts the cadence from now instead of bursting through the missed frames
+    Thread::SleepFor(MilliSeconds(30));
+    lateness = pacer.Wait();
+    CycleClock::TimePoint now = CycleClock::Now();
+    TEST_ENSURE(lateness >= MilliSeconds(5));
+    TEST_ENSURE(pacer.Stats().resyncs >= 1);
+    TEST_ENSURE(pacer.Deadline() > now);
+    TEST_ENSURE(pacer.Deadline() <= now + MilliSeconds(5));
+
+    pacer.Reset();
+    TEST_ENSURE(pacer.Stats().frames == 0 && pacer.Stats().missed == 0);
+
+    return 0;
+}
+
+int32 TestDisabled()
+{
+    FramePacer pacer;
+    TEST_ENSURE(!pacer.Enabled());
+
+    // without a target Wait returns right away and keeps no statistics
+    CycleClock::TimePoint start = CycleClock::Now();
+    for (int32 i = 0; i < 1000; ++i) {
+        TEST_ENSURE(pacer.Wait() == NanoSeconds::Zero());
+    }
+
+    TEST_ENSURE(CycleClock::Now() - start < MilliSeconds(10));
+    TEST_ENSURE(pacer.Stats().frames == 0);
+
+    // the target changes at runtime and restarts the cadence
+    pacer.SetTarget(MilliSeconds(2));
+    pacer.SetSpinThreshold(NanoSeconds::Zero());
+    TEST_ENSURE(pacer.Enabled());
+    pacer.Wait();
+    TEST_ENSURE(pacer.Stats().frames == 1);
+
+    return 0;
+}
+
+int32 main()
+{
+    TEST_ENSURE(TestCadence() == 0);
+    TEST_ENSURE(TestMissed() == 0);
+    TEST_ENSURE(TestDisabled() == 0);
+
+    return 0;
+}
\ No newline at end of file
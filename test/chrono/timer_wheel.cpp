@@ -0,0 +1,182 @@
+#include "test_macro.h"
+
+import mini.test;
+
+using namespace mini;
+using namespace mini::test;
+
+struct Record {
+public:
+    int32 count;
+    TimerWheel* wheel;
+    TimerHandle other;
+
+    Record() noexcept
+        : count(0)
+        , wheel(nullptr)
+        , other()
+    {
+    }
+};
+
+static void Count(void* userData)
+{
+    ++static_cast<Record*>(userData)->count;
+}
+
+static void CancelOther(void* userData)
+{
+    Record* record = static_cast<Record*>(userData);
+    ++record->count;
+    record->wheel->Cancel(record->other);
+}
+
+static mini::Clock::TimePoint At(mini::Clock::TimePoint start, int64 milliseconds)
+{
+    return start + MilliSeconds(milliseconds);
+}
+
+int32 TestSchedule()
+{
+    mini::Clock::TimePoint start = mini::Clock::Now();
+    TimerWheel wheel(MilliSeconds(1), start);
+    TEST_ENSURE(wheel.Empty());
+    TEST_ENSURE(wheel.NextExpiry() == mini::Clock::TimePoint::Max());
+
+    Record first;
+    Record second;
+    TimerHandle firstHandle = wheel.ScheduleAfter(MilliSeconds(10), Count, &first);
+    wheel.ScheduleAt(At(start, 5), Count, &second);
+    TEST_ENSURE(wheel.Size() == 2);
+    TEST_ENSURE(wheel.Pending(firstHandle));
+    TEST_ENSURE(wheel.NextExpiry() == At(start, 5));
+
+    TEST_ENSURE(wheel.Advance(At(start, 4)) == 0);
+    TEST_ENSURE(wheel.Advance(At(start, 5)) == 1);
+    TEST_ENSURE(second.count == 1);
+    TEST_ENSURE(first.count == 0);
+
+    // never early, not even by a fraction of a tick
+    TEST_ENSURE(wheel.Advance(At(start, 10) - NanoSeconds(1)) == 0);
+    TEST_ENSURE(wheel.Advance(At(start, 10)) == 1);
+    TEST_ENSURE(first.count == 1);
+    TEST_ENSURE(!wheel.Pending(firstHandle));
+    TEST_ENSURE(wheel.Empty());
+
+    return 0;
+}
+
+int32 TestCancel()
+{
+    mini::Clock::TimePoint start = mini::Clock::Now();
+    TimerWheel wheel(MilliSeconds(1), start);
+
+    Record record;
+    TimerHandle handle = wheel.ScheduleAfter(MilliSeconds(3), Count, &record);
+    TEST_ENSURE(wheel.Cancel(handle));
+    TEST_ENSURE(!wheel.Cancel(handle));
+    TEST_ENSURE(!wheel.Cancel(TimerHandle()));
+
+    // a stale handle must not cancel the timer reusing its entry
+    TimerHandle reused = wheel.ScheduleAfter(MilliSeconds(3), Count, &record);
+    TEST_ENSURE(reused.index == handle.index);
+    TEST_ENSURE(!wheel.Cancel(handle));
+    TEST_ENSURE(wheel.Pending(reused));
+
+    // callbacks may cancel other timers, even ones due within the same advance
+    Record canceller;
+    canceller.wheel = &wheel;
+    canceller.other = reused;
+    wheel.ScheduleAfter(MilliSeconds(2), CancelOther, &canceller);
+
+    wheel.Advance(At(start, 3));
+    TEST_ENSURE(canceller.count == 1);
+    TEST_ENSURE(record.count == 0);
+    TEST_ENSURE(wheel.Empty());
+
+    return 0;
+}
+
+int32 TestCascade()
+{
+    mini::Clock::TimePoint start = mini::Clock::Now();
+    TimerWheel wheel(MilliSeconds(1), start);
+
+    // spread over every level, each timer has to fire in exactly the tick of its deadline
+    static constexpr int64 delays[] = { 1, 63, 64, 65, 4095, 4096, 4097, 300000, 16777216, 16777217 };
+    Record records[sizeof(delays) / sizeof(delays[0])];
+    for (size_t i = 0; i < sizeof(delays) / sizeof(delays[0]); ++i) {
+        wheel.ScheduleAfter(MilliSeconds(delays[i]), Count, &records[i]);
+    }
+
+    for (size_t i = 0; i < sizeof(delays) / sizeof(delays[0]); ++i) {
+        TEST_ENSURE(wheel.NextExpiry() <= At(start, delays[i]));
+
+        wheel.Advance(At(start, delays[i] - 1));
+        TEST_ENSURE(records[i].count == 0);
+
+        wheel.Advance(At(start, delays[i]));
+        TEST_ENSURE(records[i].count == 1);
+    }
+
+    TEST_ENSURE(wheel.Empty());
+    return 0;
+}
+
+int32 TestPeriodic()
+{
+    mini::Clock::TimePoint start = mini::Clock::Now();
+    TimerWheel wheel(MilliSeconds(1), start);
+
+    Record record;
+    TimerHandle handle = wheel.ScheduleEvery(MilliSeconds(7), Count, &record);
+
+    for (int64 i = 1; i <= 700; ++i) {
+        wheel.Advance(At(start, i));
+    }
+    TEST_ENSURE(record.count == 100);
+
+    // a late advance catches up on every period it missed, keeping the original phase
+    wheel.Advance(At(start, 750));
+    TEST_ENSURE(record.count == 107);
+    TEST_ENSURE(wheel.Pending(handle));
+
+    TEST_ENSURE(wheel.Cancel(handle));
+    TEST_ENSURE(wheel.Empty());
+
+    return 0;
+}
+
+int32 TestMany()
+{
+    mini::Clock::TimePoint start = mini::Clock::Now();
+    TimerWheel wheel(MilliSeconds(1), start);
+
+    static constexpr int32 count = 10000;
+    Record record;
+    Array<TimerHandle> handles;
+    for (int32 i = 0; i < count; ++i) {
+        handles.Push(wheel.ScheduleAfter(MilliSeconds(1 + i * 37 % 5000), Count, &record));
+    }
+
+    for (int32 i = 0; i < count; i += 2) {
+        TEST_ENSURE(wheel.Cancel(handles[i]));
+    }
+
+    wheel.Advance(At(start, 5000));
+    TEST_ENSURE(record.count == count / 2);
+    TEST_ENSURE(wheel.Empty());
+
+    return 0;
+}
+
+int32 main()
+{
+    TEST_ENSURE(TestSchedule() == 0);
+    TEST_ENSURE(TestCancel() == 0);
+    TEST_ENSURE(TestCascade() == 0);
+    TEST_ENSURE(TestPeriodic() == 0);
+    TEST_ENSURE(TestMany() == 0);
+
+    return 0;
+}
\ No newline at end of file
@@ -42,9 +42,9 @@ static int32 TestAtomicLockFree()
     static_assert(sizeof(Atomic<S<8>>) == 8);
     static_assert(sizeof(Atomic<S<9>>) == 16);
     static_assert(sizeof(Atomic<S<16>>) == 16);
-    static_assert(sizeof(Atomic<S<17>>) == 17);
+    static_assert(sizeof(Atomic<S<17>>) == 24);
     static_assert(sizeof(Atomic<Unaligned>) == 8);
-    static_assert(sizeof(Atomic<NonAtomic>) == sizeof(NonAtomic));
+    static_assert(sizeof(Atomic<NonAtomic>) == 24);
 
     static_assert(Atomic<S<1>>::IsAlwaysLockFree() == true);
     static_assert(Atomic<S<2>>::IsAlwaysLockFree() == true);
@@ -323,6 +323,79 @@ int32 TestSpinLock()
     return 0;
 }
 
+template <typename T>
+int32 TestTimedWait()
+{
+    Atomic<T> atomic(0);
+
+    // nothing changes the value, so these must time out
+    TEST_ENSURE(atomic.WaitFor(0, MilliSeconds(1), MemoryOrder::acquire) == false);
+    TEST_ENSURE(atomic.WaitFor(0, NanoSeconds(-1), MemoryOrder::acquire) == false);
+    TEST_ENSURE(atomic.WaitUntil(0, Clock::Now() + MilliSeconds(1), MemoryOrder::acquire) == false);
+    TEST_ENSURE(atomic.WaitUntil(0, Clock::TimePoint::Min(), MemoryOrder::acquire) == false);
+    TEST_ENSURE(atomic.WaitFor(0, MilliSeconds(1), MemoryOrder::acquire, AtomicSpinPolicy(0, NanoSeconds(0))) == false);
+
+    // value already differs, returns immediately
+    TEST_ENSURE(atomic.WaitFor(1, Seconds::Max(), MemoryOrder::acquire) == true);
+    TEST_ENSURE(atomic.WaitUntil(1, Clock::TimePoint::Max(), MemoryOrder::acquire) == true);
+
+    Clock::TimePoint start = Clock::Now();
+    TEST_ENSURE(atomic.WaitFor(0, MilliSeconds(10), MemoryOrder::acquire) == false);
+    TEST_ENSURE(Clock::Now() - start >= MilliSeconds(10));
+
+    std::thread thread([&atomic]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        atomic.Store(1, MemoryOrder::release);
+        atomic.Notify();
+    });
+
+    TEST_ENSURE(atomic.WaitFor(0, Seconds(10), MemoryOrder::acquire) == true);
+    TEST_ENSURE(atomic.Load(MemoryOrder::acquire) == 1);
+    thread.join();
+
+    return 0;
+}
+
+template <typename T>
+struct CountWatch : public AtomicWatch {
+public:
+    Atomic<T> const* atomic;
+    int32 notified;
+};
+
+template <typename T>
+int32 TestWatch()
+{
+    Atomic<T> atomic(0);
+    CountWatch<T> watch = {};
+    watch.atomic = &atomic;
+    watch.changed = [](AtomicWatch const* base) noexcept -> bool {
+        CountWatch<T> const* counted = static_cast<CountWatch<T> const*>(base);
+        return static_cast<int32>(counted->atomic->Load(MemoryOrder::acquire)) != 0;
+    };
+    watch.notify = [](AtomicWatch* base) noexcept { ++static_cast<CountWatch<T>*>(base)->notified; };
+
+    // a notify leaving the value as it was keeps the watch
+    TEST_ENSURE(atomic.Watch(&watch));
+    atomic.Notify();
+    TEST_ENSURE(watch.notified == 0);
+
+    atomic.Store(1, MemoryOrder::release);
+    atomic.NotifyAll();
+    TEST_ENSURE(watch.notified == 1);
+
+    // unlinked once notified
+    atomic.Notify();
+    TEST_ENSURE(watch.notified == 1);
+
+    // already changed, never registered
+    TEST_ENSURE(!atomic.Watch(&watch));
+    atomic.Notify();
+    TEST_ENSURE(watch.notified == 1);
+
+    return 0;
+}
+
 int main()
 {
     TEST_ENSURE(TestAtomicLockFree() == 0);
@@ -353,5 +426,13 @@ int main()
     TEST_ENSURE(TestSpinLock<Unaligned>() == 0);
     TEST_ENSURE(TestSpinLock<NonAtomic>() == 0);
 
+    TEST_ENSURE(TestTimedWait<int32>() == 0);
+    TEST_ENSURE(TestTimedWait<Unaligned>() == 0);
+    TEST_ENSURE(TestTimedWait<NonAtomic>() == 0);
+
+    TEST_ENSURE(TestWatch<int32>() == 0);
+    TEST_ENSURE(TestWatch<Unaligned>() == 0);
+    TEST_ENSURE(TestWatch<NonAtomic>() == 0);
+
     return 0;
 }
\ No newline at end of file
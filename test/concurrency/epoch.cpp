@@ -0,0 +1,126 @@
+#include <thread>
+
+#include "test_macro.h"
+
+import mini.test;
+
+using namespace mini;
+using namespace mini::test;
+
+struct Node {
+public:
+    int32 value;
+    Atomic<int32>* counter;
+
+    Node(int32 v, Atomic<int32>* c) noexcept
+        : value(v)
+        , counter(c)
+    {
+    }
+
+    ~Node() noexcept { counter->FetchAdd(1, MemoryOrder::relaxed); }
+};
+
+static Node* NewNode(int32 value, Atomic<int32>* counter)
+{
+    Node* node = Allocator<Node>().Allocate(1).pointer;
+    memory::ConstructAt(node, value, counter);
+    return node;
+}
+
+static int32 TestDeferred()
+{
+    Atomic<int32> reclaimed(0);
+    {
+        EpochDomain domain;
+        EpochHandle reader(domain);
+        EpochHandle writer(domain);
+
+        reader.Enter();
+        TEST_ENSURE(reader.Active());
+
+        writer.Retire(NewNode(0, &reclaimed));
+        writer.Collect();
+        writer.Collect();
+        writer.Collect();
+
+        // reader still pins the epoch the node was retired in
+        TEST_ENSURE(reclaimed.Load(MemoryOrder::relaxed) == 0);
+
+        reader.Exit();
+        TEST_ENSURE(!reader.Active());
+
+        writer.Collect();
+        writer.Collect();
+        writer.Collect();
+        TEST_ENSURE(reclaimed.Load(MemoryOrder::relaxed) == 1);
+
+        // nested sections only release the pin on the outermost exit
+        {
+            EpochGuard outer(reader);
+            EpochGuard inner(reader);
+            TEST_ENSURE(reader.Active());
+        }
+
+        TEST_ENSURE(!reader.Active());
+        writer.Retire(NewNode(1, &reclaimed));
+    }
+
+    // pending nodes are reclaimed by the domain at the latest
+    TEST_ENSURE(reclaimed.Load(MemoryOrder::relaxed) == 2);
+    return 0;
+}
+
+static int32 TestConcurrentSwap()
+{
+    constexpr int32 readerCount = 3;
+    constexpr int32 swapCount = 1 << 14;
+
+    Atomic<int32> reclaimed(0);
+    Atomic<bool> done(false);
+    Atomic<bool> corrupted(false);
+    {
+        EpochDomain domain;
+        Atomic<Node*> shared(NewNode(0, &reclaimed));
+
+        auto reader = [&domain, &shared, &done, &corrupted]() {
+            EpochHandle handle(domain);
+            while (!done.Load(MemoryOrder::relaxed)) {
+                EpochGuard guard(handle);
+                Node* node = shared.Load(MemoryOrder::acquire);
+                if (node->value < 0 || node->counter == nullptr) {
+                    corrupted.Store(true, MemoryOrder::relaxed);
+                }
+            }
+        };
+
+        std::thread readers[readerCount];
+        for (std::thread& thread : readers) {
+            thread = std::thread(reader);
+        }
+
+        EpochHandle writer(domain);
+        for (int32 i = 1; i <= swapCount; ++i) {
+            writer.Retire(shared.Exchange(NewNode(i, &reclaimed), MemoryOrder::acquireRelease));
+        }
+
+        done.Store(true, MemoryOrder::relaxed);
+        for (std::thread& thread : readers) {
+            thread.join();
+        }
+
+        writer.Retire(shared.Exchange(nullptr, MemoryOrder::acquireRelease));
+    }
+
+    TEST_ENSURE(corrupted.Load(MemoryOrder::relaxed) == false);
+    TEST_ENSURE(reclaimed.Load(MemoryOrder::relaxed) == swapCount + 1);
+    return 0;
+}
+
+int main()
+{
+    TEST_ENSURE(TestDeferred() == 0);
+    TEST_ENSURE(TestConcurrentSwap() == 0);
+
+    return 0;
+}
\ No newline at end of file
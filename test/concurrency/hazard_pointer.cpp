@@ -0,0 +1,116 @@
+#include <thread>
+
+#include "test_macro.h"
+
+import mini.test;
+
+using namespace mini;
+using namespace mini::test;
+
+struct Node {
+public:
+    int32 value;
+    Atomic<int32>* counter;
+
+    Node(int32 v, Atomic<int32>* c) noexcept
+        : value(v)
+        , counter(c)
+    {
+    }
+
+    ~Node() noexcept { counter->FetchAdd(1, MemoryOrder::relaxed); }
+};
+
+static Node* NewNode(int32 value, Atomic<int32>* counter)
+{
+    Node* node = Allocator<Node>().Allocate(1).pointer;
+    memory::ConstructAt(node, value, counter);
+    return node;
+}
+
+static int32 TestProtect()
+{
+    Atomic<int32> reclaimed(0);
+    {
+        HazardDomain domain;
+        Atomic<Node*> shared(NewNode(1, &reclaimed));
+
+        HazardPointer hazard(domain);
+        Node* node = hazard.Protect(shared);
+        TEST_ENSURE(node->value == 1);
+
+        domain.Retire(shared.Exchange(NewNode(2, &reclaimed), MemoryOrder::acquireRelease));
+        domain.Reclaim();
+
+        // still protected, must not be reclaimed
+        TEST_ENSURE(reclaimed.Load(MemoryOrder::relaxed) == 0);
+        TEST_ENSURE(node->value == 1);
+
+        hazard.Reset();
+        domain.Reclaim();
+        TEST_ENSURE(reclaimed.Load(MemoryOrder::relaxed) == 1);
+
+        node = hazard.Protect(shared);
+        TEST_ENSURE(node->value == 2);
+        hazard.Reset();
+
+        domain.Retire(shared.Exchange(nullptr, MemoryOrder::acquireRelease));
+    }
+
+    TEST_ENSURE(reclaimed.Load(MemoryOrder::relaxed) == 2);
+    return 0;
+}
+
+static int32 TestConcurrentSwap()
+{
+    constexpr int32 readerCount = 3;
+    constexpr int32 swapCount = 1 << 14;
+
+    Atomic<int32> reclaimed(0);
+    Atomic<bool> done(false);
+    Atomic<bool> corrupted(false);
+    {
+        HazardDomain domain;
+        Atomic<Node*> shared(NewNode(0, &reclaimed));
+
+        auto reader = [&domain, &shared, &done, &corrupted]() {
+            HazardPointer hazard(domain);
+            while (!done.Load(MemoryOrder::relaxed)) {
+                Node* node = hazard.Protect(shared);
+                if (node->value < 0 || node->counter == nullptr) {
+                    corrupted.Store(true, MemoryOrder::relaxed);
+                }
+
+                hazard.Reset();
+            }
+        };
+
+        std::thread readers[readerCount];
+        for (std::thread& thread : readers) {
+            thread = std::thread(reader);
+        }
+
+        for (int32 i = 1; i <= swapCount; ++i) {
+            domain.Retire(shared.Exchange(NewNode(i, &reclaimed), MemoryOrder::acquireRelease));
+        }
+
+        done.Store(true, MemoryOrder::relaxed);
+        for (std::thread& thread : readers) {
+            thread.join();
+        }
+
+        domain.Retire(shared.Exchange(nullptr, MemoryOrder::acquireRelease));
+    }
+
+    TEST_ENSURE(corrupted.Load(MemoryOrder::relaxed) == false);
+    TEST_ENSURE(reclaimed.Load(MemoryOrder::relaxed) == swapCount + 1);
+    return 0;
+}
+
+int main()
+{
+    TEST_ENSURE(TestProtect() == 0);
+    TEST_ENSURE(TestConcurrentSwap() == 0);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include <thread>
+
+#include "test_macro.h"
+
+import mini.test;
+
+using namespace mini;
+using namespace mini::test;
+
+static int32 TestSingleThread()
+{
+    MpmcQueue<int32, 4> queue;
+    int32 value = 0;
+
+    TEST_ENSURE(queue.Capacity() == 4);
+    TEST_ENSURE(queue.Empty());
+    TEST_ENSURE(queue.TryDequeue(value) == false);
+
+    for (int32 i = 0; i < 4; ++i) {
+        TEST_ENSURE(queue.TryEnqueue(i));
+    }
+
+    TEST_ENSURE(queue.Size() == 4);
+    TEST_ENSURE(queue.TryEnqueue(4) == false);
+
+    for (int32 i = 0; i < 4; ++i) {
+        TEST_ENSURE(queue.TryDequeue(value));
+        TEST_ENSURE(value == i);
+    }
+
+    TEST_ENSURE(queue.Empty());
+
+    for (int32 i = 0; i < 10; ++i) {
+        queue.Enqueue(i);
+        queue.Enqueue(i + 1);
+        TEST_ENSURE(queue.Dequeue() == i);
+        TEST_ENSURE(queue.Dequeue() == i + 1);
+    }
+
+    return 0;
+}
+
+static int32 TestRange()
+{
+    MpmcQueue<int32, 8> queue;
+    FixedArray<int32, 6> input = { 0, 1, 2, 3, 4, 5 };
+    FixedArray<int32, 6> output = { -1, -1, -1, -1, -1, -1 };
+
+    TEST_ENSURE(queue.TryEnqueueRange(input.Begin(), input.End()) == 6);
+    TEST_ENSURE(queue.TryEnqueueRange(input.Begin(), input.End()) == 2);
+    TEST_ENSURE(queue.Size() == 8);
+
+    TEST_ENSURE(queue.TryDequeueRange(output.Begin(), output.End()) == 6);
+    for (int32 i = 0; i < 6; ++i) {
+        TEST_ENSURE(output[i] == i);
+    }
+
+    TEST_ENSURE(queue.DequeueRange(output.Begin(), output.End()) == 2);
+    TEST_ENSURE(output[0] == 0);
+    TEST_ENSURE(output[1] == 1);
+    TEST_ENSURE(queue.TryDequeueRange(output.Begin(), output.End()) == 0);
+
+    return 0;
+}
+
+static int32 TestNonTrivial()
+{
+    {
+        MpmcQueue<UniquePtr<int32>, 4> queue;
+        queue.Enqueue(MakeUnique<int32>(1));
+        queue.Enqueue(MakeUnique<int32>(2));
+        queue.Enqueue(MakeUnique<int32>(3));
+
+        UniquePtr<int32> ptr = queue.Dequeue();
+        TEST_ENSURE(*ptr == 1);
+        TEST_ENSURE(queue.TryDequeue(ptr));
+        TEST_ENSURE(*ptr == 2);
+    }
+
+    return 0;
+}
+
+static int32 TestMultiProducerConsumer()
+{
+    constexpr uint32 threadCount = 4;
+    constexpr uint32 count = 1 << 18;
+    MpmcQueue<uint32, 64> queue;
+    Atomic<uint64> sum(0);
+    Atomic<uint32> received(0);
+
+    auto producer = [&queue]() {
+        for (uint32 i = 0; i < count; ++i) {
+            queue.Enqueue(i);
+        }
+    };
+
+    auto consumer = [&queue, &sum, &received]() {
+        uint64 local = 0;
+        for (uint32 i = 0; i < count; ++i) {
+            local += queue.Dequeue();
+        }
+
+        sum.FetchAdd(local, MemoryOrder::relaxed);
+        received.FetchAdd(count, MemoryOrder::relaxed);
+    };
+
+    std::thread threads[threadCount * 2];
+    for (uint32 i = 0; i < threadCount; ++i) {
+        threads[i * 2] = std::thread(producer);
+        threads[i * 2 + 1] = std::thread(consumer);
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    TEST_ENSURE(received.Load(MemoryOrder::relaxed) == threadCount * count);
+    TEST_ENSURE(sum.Load(MemoryOrder::relaxed) == threadCount * ((uint64(count) * (count - 1)) / 2));
+    TEST_ENSURE(queue.Empty());
+
+    return 0;
+}
+
+int main()
+{
+    TEST_ENSURE(TestSingleThread() == 0);
+    TEST_ENSURE(TestRange() == 0);
+    TEST_ENSURE(TestNonTrivial() == 0);
+    TEST_ENSURE(TestMultiProducerConsumer() == 0);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include <thread>
+
+#include "test_macro.h"
+
+import mini.test;
+
+using namespace mini;
+using namespace mini::test;
+
+struct Snapshot {
+public:
+    int64 v[6];
+
+    Snapshot() noexcept = default;
+    Snapshot(int64 n) noexcept { memory::FillRange(&v[0], &v[6], n); }
+
+    bool Consistent() const noexcept
+    {
+        for (int32 i = 1; i < 6; ++i) {
+            if (v[i] != v[0]) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+};
+
+int32 TestSeqLock()
+{
+    SeqLock<Snapshot> lock(1);
+    TEST_ENSURE(lock.Load().v[0] == 1);
+
+    SeqLock<Snapshot>::Sequence sequence = lock.CurrentSequence();
+    TEST_ENSURE(lock.Changed(sequence) == false);
+
+    lock.Store(Snapshot(2));
+    TEST_ENSURE(lock.Changed(sequence) == true);
+    TEST_ENSURE(lock.Load().v[5] == 2);
+
+    lock.Update([](Snapshot& s) { s.v[0] = 3; });
+    TEST_ENSURE(lock.Load().v[0] == 3);
+    TEST_ENSURE(lock.Load().v[1] == 2);
+
+    Snapshot out;
+    TEST_ENSURE(lock.TryLoad(out) == true);
+    TEST_ENSURE(out.v[0] == 3);
+
+    return 0;
+}
+
+template <typename LockT, typename ReadF, typename WriteF>
+int32 TestConsistency(LockT& lock, ReadF read, WriteF write)
+{
+    static constexpr int64 writeCount = 100000;
+    Atomic<bool> done(false);
+    Atomic<int32> torn(0);
+
+    std::thread readers[4];
+    for (std::thread& reader : readers) {
+        reader = std::thread([&]() {
+            int64 last = 0;
+            while (!done.Load(MemoryOrder::acquire)) {
+                Snapshot s = read(lock);
+                if (!s.Consistent() || s.v[0] < last) {
+                    torn.FetchAdd(1, MemoryOrder::relaxed);
+                }
+
+                last = s.v[0];
+            }
+        });
+    }
+
+    for (int64 i = 1; i <= writeCount; ++i) {
+        write(lock, Snapshot(i));
+    }
+
+    done.Store(true, MemoryOrder::release);
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    TEST_ENSURE(torn.Load(MemoryOrder::relaxed) == 0);
+    TEST_ENSURE(read(lock).v[0] == writeCount);
+
+    return 0;
+}
+
+int32 TestLargeAtomic()
+{
+    static_assert(Atomic<Snapshot>::IsAlwaysLockFree() == false);
+
+    Atomic<Snapshot> atomic(0);
+    Snapshot expected(1);
+    TEST_ENSURE(atomic.CompareExchangeStrong(expected, Snapshot(2), MemoryOrder::acquireRelease) == false);
+    TEST_ENSURE(expected.v[0] == 0);
+    TEST_ENSURE(atomic.CompareExchangeStrong(expected, Snapshot(2), MemoryOrder::acquireRelease) == true);
+    TEST_ENSURE(atomic.Exchange(Snapshot(0), MemoryOrder::acquireRelease).v[3] == 2);
+
+    return TestConsistency(
+        atomic,
+        [](Atomic<Snapshot>& a) { return a.Load(MemoryOrder::acquire); },
+        [](Atomic<Snapshot>& a, Snapshot s) { a.Store(s, MemoryOrder::release); });
+}
+
+int32 main()
+{
+    TEST_ENSURE(TestSeqLock() == 0);
+
+    SeqLock<Snapshot> lock(0);
+    TEST_ENSURE(TestConsistency(
+                    lock,
+                    [](SeqLock<Snapshot>& l) { return l.Load(); },
+                    [](SeqLock<Snapshot>& l, Snapshot s) { l.Store(s); }) == 0);
+
+    TEST_ENSURE(TestLargeAtomic() == 0);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include "test_macro.h"
+
+import mini.test;
+
+using namespace mini;
+using namespace mini::test;
+
+template <typename Counter>
+int32 TestSingle()
+{
+    Counter counter;
+    TEST_ENSURE(counter.Load() == 0);
+
+    counter.Add();
+    counter.Add(4);
+    counter.Sub(2);
+    TEST_ENSURE(counter.Load() == 3);
+
+    counter.Reset();
+    TEST_ENSURE(counter.Load() == 0);
+
+    return 0;
+}
+
+template <typename Counter>
+int32 TestConcurrent()
+{
+    constexpr int32 threadCount = 4;
+    constexpr int32 count = 100000;
+
+    Counter counter;
+    Thread threads[threadCount];
+    for (Thread& thread : threads) {
+        thread = Thread([&counter]() {
+            for (int32 i = 0; i < count; ++i) {
+                counter.Add();
+            }
+        });
+    }
+
+    for (Thread& thread : threads) {
+        thread.Join();
+    }
+
+    TEST_ENSURE(counter.Load() == int64(threadCount) * count);
+
+    return 0;
+}
+
+int32 main()
+{
+    TEST_ENSURE(TestSingle<ShardedCounter>() == 0);
+    TEST_ENSURE(TestSingle<PerCpuCounter>() == 0);
+    TEST_ENSURE(TestConcurrent<ShardedCounter>() == 0);
+    TEST_ENSURE(TestConcurrent<PerCpuCounter>() == 0);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include <thread>
+
+#include "test_macro.h"
+
+import mini.test;
+
+using namespace mini;
+using namespace mini::test;
+
+static int32 TestSingleThread()
+{
+    SpscQueue<int32, 4> queue;
+    int32 value = 0;
+
+    TEST_ENSURE(queue.Capacity() == 4);
+    TEST_ENSURE(queue.Empty());
+    TEST_ENSURE(queue.TryDequeue(value) == false);
+
+    for (int32 i = 0; i < 4; ++i) {
+        TEST_ENSURE(queue.TryEnqueue(i));
+    }
+
+    TEST_ENSURE(queue.Full());
+    TEST_ENSURE(queue.TryEnqueue(4) == false);
+
+    for (int32 i = 0; i < 4; ++i) {
+        TEST_ENSURE(queue.TryDequeue(value));
+        TEST_ENSURE(value == i);
+    }
+
+    TEST_ENSURE(queue.Empty());
+
+    // wrap around the buffer a couple of times
+    for (int32 i = 0; i < 10; ++i) {
+        TEST_ENSURE(queue.TryEnqueue(i));
+        TEST_ENSURE(queue.TryEnqueue(i + 1));
+        TEST_ENSURE(queue.Dequeue() == i);
+        TEST_ENSURE(queue.Dequeue() == i + 1);
+    }
+
+    return 0;
+}
+
+static int32 TestRange()
+{
+    SpscQueue<int32, 8> queue;
+    FixedArray<int32, 6> input = { 0, 1, 2, 3, 4, 5 };
+    FixedArray<int32, 6> output = { -1, -1, -1, -1, -1, -1 };
+
+    TEST_ENSURE(queue.TryEnqueueRange(input.Begin(), input.End()) == 6);
+    TEST_ENSURE(queue.TryEnqueueRange(input.Begin(), input.End()) == 2);
+    TEST_ENSURE(queue.Full());
+
+    TEST_ENSURE(queue.TryDequeueRange(output.Begin(), output.End()) == 6);
+    for (int32 i = 0; i < 6; ++i) {
+        TEST_ENSURE(output[i] == i);
+    }
+
+    TEST_ENSURE(queue.DequeueRange(output.Begin(), output.End()) == 2);
+    TEST_ENSURE(output[0] == 0);
+    TEST_ENSURE(output[1] == 1);
+    TEST_ENSURE(queue.TryDequeueRange(output.Begin(), output.End()) == 0);
+
+    return 0;
+}
+
+static int32 TestTimedDequeue()
+{
+    SpscQueue<int32, 4> queue;
+    int32 value = 0;
+
+    // an empty queue waits out the timeout
+    Clock::TimePoint begin = Clock::Now();
+    TEST_ENSURE(queue.TryDequeueFor(value, MilliSeconds(5)) == false);
+    TEST_ENSURE(Clock::Now() - begin >= MilliSeconds(5));
+
+    // a producer publishing within the timeout ends the wait early
+    std::thread producer([&queue]() {
+        Thread::SleepFor(MilliSeconds(2));
+        queue.Enqueue(7);
+    });
+
+    TEST_ENSURE(queue.TryDequeueFor(value, Seconds(10)));
+    TEST_ENSURE(value == 7);
+    producer.join();
+
+    TEST_ENSURE(queue.TryEnqueue(8));
+    TEST_ENSURE(queue.TryDequeueFor(value, NanoSeconds::Zero()));
+    TEST_ENSURE(value == 8);
+
+    return 0;
+}
+
+static int32 TestNonTrivial()
+{
+    {
+        SpscQueue<UniquePtr<int32>, 4> queue;
+        queue.Enqueue(MakeUnique<int32>(1));
+        queue.Enqueue(MakeUnique<int32>(2));
+        queue.Enqueue(MakeUnique<int32>(3));
+
+        UniquePtr<int32> ptr = queue.Dequeue();
+        TEST_ENSURE(*ptr == 1);
+        TEST_ENSURE(queue.TryDequeue(ptr));
+        TEST_ENSURE(*ptr == 2);
+
+        // remaining element is released by the destructor
+    }
+
+    return 0;
+}
+
+static int32 TestProducerConsumer()
+{
+    constexpr uint32 count = 1 << 20;
+    SpscQueue<uint32, 64> queue;
+    uint64 sum = 0;
+
+    std::thread producer([&queue]() {
+        for (uint32 i = 0; i < count; ++i) {
+            queue.Enqueue(i);
+        }
+    });
+
+    for (uint32 i = 0; i < count; ++i) {
+        uint32 value = queue.Dequeue();
+        TEST_ENSURE(value == i);
+        sum += value;
+    }
+
+    producer.join();
+    TEST_ENSURE(sum == (uint64(count) * (count - 1)) / 2);
+    TEST_ENSURE(queue.Empty());
+
+    return 0;
+}
+
+int main()
+{
+    TEST_ENSURE(TestSingleThread() == 0);
+    TEST_ENSURE(TestRange() == 0);
+    TEST_ENSURE(TestTimedDequeue() == 0);
+    TEST_ENSURE(TestNonTrivial() == 0);
+    TEST_ENSURE(TestProducerConsumer() == 0);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include "test_macro.h"
+
+import mini.test;
+
+using namespace mini;
+using namespace mini::test;
+
+static constexpr bool ConstexprAffinity()
+{
+    ThreadAffinity affinity(3);
+    affinity.Set(64);
+    affinity.Set(255);
+
+    ThreadAffinity other(3);
+    other |= affinity;
+    other.Reset(255);
+
+    return affinity.Count() == 3 && affinity.Test(64) && !affinity.Test(4) && other.Count() == 2 &&
+           !ThreadAffinity().Test(0) && ThreadAffinity().Empty();
+}
+
+int32 TestRun()
+{
+    Atomic<int32> counter(0);
+    Thread::Id mainId = Thread::CurrentId();
+    Atomic<Thread::Id> threadId(mainId);
+
+    ThreadOptions options;
+    options.name = "mini.test.worker";
+    options.stackSize = 256 * 1024;
+
+    Thread thread(
+        [&]() {
+            counter.FetchAdd(1, MemoryOrder::relaxed);
+            threadId.Store(Thread::CurrentId(), MemoryOrder::relaxed);
+        },
+        options);
+
+    TEST_ENSURE(thread.Joinable());
+    thread.Join();
+    TEST_ENSURE(!thread.Joinable());
+    TEST_ENSURE(counter.Load(MemoryOrder::relaxed) == 1);
+    TEST_ENSURE(threadId.Load(MemoryOrder::relaxed) != mainId);
+
+    return 0;
+}
+
+int32 TestMove()
+{
+    Atomic<int32> counter(0);
+    Thread first([&counter]() { counter.FetchAdd(1, MemoryOrder::relaxed); });
+    Thread second(MoveArg(first));
+    TEST_ENSURE(!first.Joinable());
+    TEST_ENSURE(second.Joinable());
+
+    first = MoveArg(second);
+    first.Join();
+    TEST_ENSURE(counter.Load(MemoryOrder::relaxed) == 1);
+
+    return 0;
+}
+
+int32 TestTopology()
+{
+    CpuTopology const& topology = CpuTopology::Get();
+    TEST_ENSURE(topology.LogicalCount() >= 1);
+    TEST_ENSURE(topology.PhysicalCount() >= 1);
+    TEST_ENSURE(topology.PhysicalCount() <= topology.LogicalCount());
+    TEST_ENSURE(topology.PackageCount() >= 1);
+    TEST_ENSURE(topology.CacheDomainCount() >= 1);
+
+    TEST_ENSURE(topology.All().Count() == topology.LogicalCount());
+    TEST_ENSURE(topology.PhysicalCores().Count() == topology.PhysicalCount());
+
+    uint32 cpu = topology.At(0).logical;
+    TEST_ENSURE(topology.SiblingsOf(cpu).Test(cpu));
+    TEST_ENSURE(topology.CacheDomainOf(cpu).Test(cpu));
+
+    return 0;
+}
+
+int32 TestAffinity()
+{
+    // pinning might be refused by the platform (or a restricted cpuset), only check it when applied
+    CpuTopology const& topology = CpuTopology::Get();
+    ThreadAffinity affinity(topology.At(0).logical);
+
+    Atomic<uint32> cpu(ThreadAffinity::maxCpu);
+    Atomic<bool> pinned(false);
+
+    Thread thread([&]() {
+        pinned.Store(Thread::SetCurrentAffinity(affinity), MemoryOrder::relaxed);
+        cpu.Store(Thread::CurrentCpu(), MemoryOrder::relaxed);
+    });
+
+    thread.Join();
+    if (pinned.Load(MemoryOrder::relaxed) && PLATFORM_LINUX) {
+        TEST_ENSURE(cpu.Load(MemoryOrder::relaxed) == topology.At(0).logical);
+    }
+
+    return 0;
+}
+
+int32 TestSleep()
+{
+    mini::Clock::TimePoint start = mini::Clock::Now();
+    Thread::SleepFor(MilliSeconds(5));
+    TEST_ENSURE(mini::Clock::Now() - start >= MilliSeconds(5));
+
+    Thread::SleepFor(MilliSeconds(-1));
+    Thread::YieldNow();
+
+    return 0;
+}
+
+int32 main()
+{
+    static_assert(ConstexprAffinity());
+
+    TEST_ENSURE(TestRun() == 0);
+    TEST_ENSURE(TestMove() == 0);
+    TEST_ENSURE(TestTopology() == 0);
+    TEST_ENSURE(TestAffinity() == 0);
+    TEST_ENSURE(TestSleep() == 0);
+
+    return 0;
+}
\ No newline at end of file
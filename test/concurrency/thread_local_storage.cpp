@@ -0,0 +1,102 @@
+#include "test_macro.h"
+
+import mini.test;
+
+using namespace mini;
+using namespace mini::test;
+
+struct Value {
+public:
+    int32 value;
+    Thread::Id owner;
+
+    Value() noexcept
+        : value(0)
+        , owner(Thread::CurrentId())
+    {
+    }
+};
+
+int32 TestGet()
+{
+    ThreadLocal<Value> local;
+    TEST_ENSURE(local.TryGet() == nullptr);
+
+    Value& value = local.Get();
+    TEST_ENSURE(&value == &local.Get());
+    TEST_ENSURE(local.TryGet() == &value);
+    TEST_ENSURE(value.owner == Thread::CurrentId());
+
+    value.value = 3;
+    TEST_ENSURE(local.Get().value == 3);
+
+    return 0;
+}
+
+int32 TestThreads()
+{
+    constexpr int32 threadCount = 4;
+    ThreadLocal<Value> local;
+    local.Get().value = 1;
+
+    Atomic<int32> fresh(0);
+    Thread threads[threadCount];
+    for (int32 i = 0; i < threadCount; ++i) {
+        threads[i] = Thread([&local, &fresh, i]() {
+            Value& value = local.Get();
+            if (value.value == 0 && value.owner == Thread::CurrentId()) {
+                fresh.FetchAdd(1, MemoryOrder::relaxed);
+            }
+
+            value.value = i + 2;
+        });
+    }
+
+    for (Thread& thread : threads) {
+        thread.Join();
+    }
+
+    TEST_ENSURE(fresh.Load(MemoryOrder::relaxed) == threadCount);
+
+    // values outlive the threads that wrote them
+    int32 count = 0, sum = 0;
+    local.ForEach([&](Value const& value) {
+        ++count;
+        sum += value.value;
+    });
+
+    TEST_ENSURE(count == threadCount + 1);
+    TEST_ENSURE(sum == 1 + 2 + 3 + 4 + 5);
+    TEST_ENSURE(local.Get().value == 1);
+
+    return 0;
+}
+
+int32 TestReuse()
+{
+    // a recycled index must not hand out the record of its previous owner
+    for (int32 i = 0; i < 8; ++i) {
+        ThreadLocal<Value> local;
+        TEST_ENSURE(local.TryGet() == nullptr);
+        TEST_ENSURE(local.Get().value == 0);
+        local.Get().value = i + 1;
+    }
+
+    ThreadLocal<Value> first;
+    ThreadLocal<Value> second;
+    first.Get().value = 1;
+    second.Get().value = 2;
+    TEST_ENSURE(first.Get().value == 1);
+    TEST_ENSURE(second.Get().value == 2);
+
+    return 0;
+}
+
+int32 main()
+{
+    TEST_ENSURE(TestGet() == 0);
+    TEST_ENSURE(TestThreads() == 0);
+    TEST_ENSURE(TestReuse() == 0);
+
+    return 0;
+}
\ No newline at end of file
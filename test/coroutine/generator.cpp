@@ -0,0 +1,105 @@
+#include "test_macro.h"
+
+import mini.test;
+
+using namespace mini;
+using namespace mini::test;
+
+static Generator<int32> Range(int32 begin, int32 end)
+{
+    for (int32 i = begin; i < end; ++i) {
+        co_yield i;
+    }
+}
+
+static Generator<int64> Fibonacci()
+{
+    int64 a = 0, b = 1;
+    while (true) {
+        co_yield a;
+        int64 next = a + b;
+        a = b;
+        b = next;
+    }
+}
+
+static Generator<int32&> Elements(Array<int32>& array)
+{
+    for (int32& element : array) {
+        co_yield element;
+    }
+}
+
+int32 TestNext()
+{
+    Generator<int32> range = Range(0, 3);
+    TEST_ENSURE(!range.Done());
+
+    TEST_ENSURE(range.Next());
+    TEST_ENSURE(range.Current() == 0);
+    TEST_ENSURE(range.Next());
+    TEST_ENSURE(range.Current() == 1);
+    TEST_ENSURE(range.Next());
+    TEST_ENSURE(range.Current() == 2);
+    TEST_ENSURE(!range.Next());
+    TEST_ENSURE(range.Done());
+    TEST_ENSURE(!range.Next());
+
+    return 0;
+}
+
+int32 TestRangeFor()
+{
+    int32 sum = 0;
+    for (int32 value : Range(1, 11)) {
+        sum += value;
+    }
+    TEST_ENSURE(sum == 55);
+
+    int32 count = 0;
+    for (int32 value : Range(5, 5)) {
+        count += value;
+    }
+    TEST_ENSURE(count == 0);
+
+    return 0;
+}
+
+int32 TestInfinite()
+{
+    int64 last = 0;
+    int32 count = 0;
+    for (int64 value : Fibonacci()) {
+        last = value;
+        if (++count == 50) {
+            break;
+        }
+    }
+
+    TEST_ENSURE(last == 7778742049);
+    return 0;
+}
+
+int32 TestReference()
+{
+    Array<int32> array = { 1, 2, 3 };
+    for (int32& element : Elements(array)) {
+        element *= 2;
+    }
+
+    TEST_ENSURE(array[0] == 2);
+    TEST_ENSURE(array[1] == 4);
+    TEST_ENSURE(array[2] == 6);
+
+    return 0;
+}
+
+int32 main()
+{
+    TEST_ENSURE(TestNext() == 0);
+    TEST_ENSURE(TestRangeFor() == 0);
+    TEST_ENSURE(TestInfinite() == 0);
+    TEST_ENSURE(TestReference() == 0);
+
+    return 0;
+}
\ No newline at end of file
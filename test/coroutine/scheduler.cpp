@@ -0,0 +1,102 @@
+#include "test_macro.h"
+
+import mini.test;
+
+using namespace mini;
+using namespace mini::test;
+
+static Task<Thread::Id> Hop(Scheduler& scheduler)
+{
+    co_await scheduler.Schedule();
+    co_return Thread::CurrentId();
+}
+
+static Task<int64> Delay(Scheduler& scheduler, MilliSeconds delay)
+{
+    mini::Clock::TimePoint start = mini::Clock::Now();
+    co_await scheduler.ScheduleAfter(delay);
+    co_return DurationCast<MilliSeconds>(mini::Clock::Now() - start).Count();
+}
+
+static Task<int32> WaitValue(Scheduler& scheduler, Atomic<int32>& atomic)
+{
+    co_await scheduler.WaitChange(atomic, 0);
+    co_return atomic.Load(MemoryOrder::acquire);
+}
+
+static Task<void> Count(Scheduler& scheduler, Atomic<int32>& counter)
+{
+    co_await scheduler.Schedule();
+    counter.FetchAdd(1, MemoryOrder::release);
+    counter.Notify();
+}
+
+int32 TestHop()
+{
+    Scheduler scheduler(2);
+    TEST_ENSURE(scheduler.ThreadCount() == 2);
+    TEST_ENSURE(SyncWait(Hop(scheduler)) != Thread::CurrentId());
+
+    return 0;
+}
+
+int32 TestDelay()
+{
+    Scheduler scheduler(1);
+    TEST_ENSURE(SyncWait(Delay(scheduler, MilliSeconds(10))) >= 10);
+    TEST_ENSURE(SyncWait(Delay(scheduler, MilliSeconds(0))) >= 0);
+
+    return 0;
+}
+
+int32 TestWaitChange()
+{
+    Atomic<int32> atomic(0);
+    Scheduler scheduler(1);
+
+    // resumed by the notify after the change, a notify that left the value as it was keeps it waiting
+    Thread setter([&atomic]() {
+        Thread::SleepFor(MilliSeconds(5));
+        atomic.NotifyAll();
+        Thread::SleepFor(MilliSeconds(5));
+        atomic.Store(4, MemoryOrder::release);
+        atomic.NotifyAll();
+    });
+
+    TEST_ENSURE(SyncWait(WaitValue(scheduler, atomic)) == 4);
+    setter.Join();
+
+    // already changed, resumes without suspending
+    TEST_ENSURE(SyncWait(WaitValue(scheduler, atomic)) == 4);
+
+    return 0;
+}
+
+int32 TestSpawn()
+{
+    constexpr int32 count = 64;
+    // outlives the scheduler, whose workers may still be finishing the last spawned task
+    Atomic<int32> counter(0);
+    Scheduler scheduler(4);
+
+    for (int32 i = 0; i < count; ++i) {
+        scheduler.Spawn(Count(scheduler, counter));
+    }
+
+    for (int32 value = counter.Load(MemoryOrder::acquire); value != count;) {
+        counter.Wait(value, MemoryOrder::acquire);
+        value = counter.Load(MemoryOrder::acquire);
+    }
+
+    return 0;
+}
+
+int32 main()
+{
+    TEST_ENSURE(TestHop() == 0);
+    TEST_ENSURE(TestDelay() == 0);
+    TEST_ENSURE(TestWaitChange() == 0);
+    TEST_ENSURE(TestSpawn() == 0);
+
+    return 0;
+}
\ No newline at end of file
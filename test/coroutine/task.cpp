@@ -0,0 +1,128 @@
+#include "test_macro.h"
+
+import mini.test;
+
+using namespace mini;
+using namespace mini::test;
+
+struct MoveOnly {
+public:
+    int32 value;
+
+    explicit MoveOnly(int32 v) noexcept
+        : value(v)
+    {
+    }
+
+    MoveOnly(MoveOnly&&) noexcept = default;
+    MoveOnly& operator=(MoveOnly&&) noexcept = default;
+};
+
+static Task<int32> Value(int32 value)
+{
+    co_return value;
+}
+
+static Task<int32> Sum(int32 count)
+{
+    int32 sum = 0;
+    for (int32 i = 1; i <= count; ++i) {
+        sum += co_await Value(i);
+    }
+
+    co_return sum;
+}
+
+static Task<int32> Depth(int32 depth)
+{
+    // symmetric transfer keeps this from growing the stack with the depth of the chain
+    if (depth == 0) {
+        co_return 0;
+    }
+
+    co_return co_await Depth(depth - 1) + 1;
+}
+
+static Task<MoveOnly> MakeMoveOnly(int32 value)
+{
+    co_return MoveOnly(value);
+}
+
+static Task<void> Increment(int32& value)
+{
+    value += co_await Value(1);
+}
+
+int32 TestValue()
+{
+    TEST_ENSURE(SyncWait(Value(3)) == 3);
+    TEST_ENSURE(SyncWait(Sum(10)) == 55);
+    TEST_ENSURE(SyncWait(MakeMoveOnly(7)).value == 7);
+
+    int32 value = 0;
+    SyncWait(Increment(value));
+    TEST_ENSURE(value == 1);
+
+    return 0;
+}
+
+int32 TestLazy()
+{
+    int32 value = 0;
+    Task<void> task = Increment(value);
+    TEST_ENSURE(task.Valid());
+    TEST_ENSURE(!task.Done());
+    TEST_ENSURE(value == 0);
+
+    Task<void> moved = MoveArg(task);
+    TEST_ENSURE(!task.Valid());
+    SyncWait(MoveArg(moved));
+    TEST_ENSURE(value == 1);
+
+    // destroying a task that never started must not run it
+    {
+        Task<void> unused = Increment(value);
+    }
+    TEST_ENSURE(value == 1);
+
+    return 0;
+}
+
+int32 TestDepth()
+{
+    TEST_ENSURE(SyncWait(Depth(100000)) == 100000);
+    return 0;
+}
+
+int32 TestFramePool()
+{
+    static_assert(FramePool::ClassOf(1) == 0);
+    static_assert(FramePool::ClassOf(64) == 0);
+    static_assert(FramePool::ClassOf(65) == 1);
+    static_assert(FramePool::ClassOf(FramePool::maxClassSize) == FramePool::classCount - 1);
+    static_assert(FramePool::ClassSize(FramePool::classCount - 1) == FramePool::maxClassSize);
+
+    void* first = FramePool::Allocate(100);
+    FramePool::Deallocate(first, 100);
+
+    // a freed frame is handed out again to the next frame of the same class
+    void* second = FramePool::Allocate(120);
+    TEST_ENSURE(first == second);
+    FramePool::Deallocate(second, 120);
+
+    void* large = FramePool::Allocate(FramePool::maxClassSize + 1);
+    TEST_ENSURE(large != nullptr);
+    FramePool::Deallocate(large, FramePool::maxClassSize + 1);
+
+    return 0;
+}
+
+int32 main()
+{
+    TEST_ENSURE(TestValue() == 0);
+    TEST_ENSURE(TestLazy() == 0);
+    TEST_ENSURE(TestDepth() == 0);
+    TEST_ENSURE(TestFramePool() == 0);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "test_macro.h"
+
+import mini.test;
+
+using namespace mini;
+using namespace mini::test;
+
+int32 TestBuckets()
+{
+    // every value maps into a bucket spanning it, and buckets tile the whole range without gaps
+    for (uint32 i = 0; i < HistogramBuckets::count; ++i) {
+        TEST_ENSURE(HistogramBuckets::Index(HistogramBuckets::Lowest(i)) == i);
+        TEST_ENSURE(HistogramBuckets::Index(HistogramBuckets::Highest(i)) == i);
+        TEST_ENSURE(i == 0 || HistogramBuckets::Lowest(i) == HistogramBuckets::Highest(i - 1) + 1);
+    }
+
+    TEST_ENSURE(HistogramBuckets::Index(0) == 0);
+    TEST_ENSURE(HistogramBuckets::Index(~uint64(0)) == HistogramBuckets::count - 1);
+
+    // the relative error stays within one sub bucket
+    for (uint64 value = 1; value < (uint64(1) << 40); value = value * 3 + 1) {
+        uint32 index = HistogramBuckets::Index(value);
+        uint64 width = HistogramBuckets::Highest(index) - HistogramBuckets::Lowest(index);
+        TEST_ENSURE(width * HistogramBuckets::subBucketCount <= value);
+    }
+
+    return 0;
+}
+
+int32 TestPercentile()
+{
+    HistogramSnapshot snapshot;
+    TEST_ENSURE(snapshot.Count() == 0);
+    TEST_ENSURE(snapshot.Percentile(50.0) == 0);
+
+    for (uint64 value = 1; value <= 1000; ++value) {
+        snapshot.Record(value);
+    }
+
+    TEST_ENSURE(snapshot.Count() == 1000);
+    TEST_ENSURE(snapshot.Min() == 1);
+    TEST_ENSURE(snapshot.Max() == 1000);
+    TEST_ENSURE(snapshot.Sum() == 500500);
+    TEST_ENSURE(snapshot.Mean() == 500.5);
+
+    // reported percentiles are never below the exact one, and at most one bucket above it
+    static constexpr double percents[] = { 50.0, 90.0, 99.0, 99.9 };
+    for (double percent : percents) {
+        uint64 exact = static_cast<uint64>(percent * 10.0 + 0.5);
+        uint64 value = snapshot.Percentile(percent);
+        TEST_ENSURE(value >= exact);
+        TEST_ENSURE(value - exact <= exact / HistogramBuckets::subBucketCount);
+    }
+
+    TEST_ENSURE(snapshot.Percentile(0.0) == 1);
+    TEST_ENSURE(snapshot.Percentile(100.0) == 1000);
+
+    snapshot.Clear();
+    TEST_ENSURE(snapshot.Count() == 0);
+    TEST_ENSURE(snapshot.Max() == 0);
+
+    return 0;
+}
+
+int32 TestMerge()
+{
+    HistogramSnapshot low;
+    HistogramSnapshot high;
+    low.Record(10, 99);
+    high.Record(100000);
+
+    low.Merge(high);
+    TEST_ENSURE(low.Count() == 100);
+    TEST_ENSURE(low.Min() == 10);
+    TEST_ENSURE(low.Max() == 100000);
+    TEST_ENSURE(low.Percentile(99.0) == 10);
+    TEST_ENSURE(low.Percentile(100.0) == 100000);
+
+    return 0;
+}
+
+int32 TestThreads()
+{
+    static constexpr int32 threadCount = 4;
+    static constexpr int32 recordCount = 10000;
+
+    Histogram histogram;
+    Thread threads[threadCount];
+    for (int32 i = 0; i < threadCount; ++i) {
+        threads[i] = Thread([&histogram, i]() {
+            for (int32 j = 0; j < recordCount; ++j) {
+                histogram.Record(static_cast<uint64>(i * recordCount + j));
+            }
+        });
+    }
+
+    for (Thread& thread : threads) {
+        thread.Join();
+    }
+
+    HistogramSnapshot snapshot;
+    histogram.Snapshot(snapshot);
+    TEST_ENSURE(snapshot.Count() == threadCount * recordCount);
+    TEST_ENSURE(snapshot.Min() == 0);
+    TEST_ENSURE(snapshot.Max() == threadCount * recordCount - 1);
+
+    histogram.Record(MicroSeconds(3));
+    snapshot.Clear();
+    histogram.Snapshot(snapshot);
+    TEST_ENSURE(snapshot.Count() == threadCount * recordCount + 1);
+
+    histogram.Reset();
+    snapshot.Clear();
+    histogram.Snapshot(snapshot);
+    TEST_ENSURE(snapshot.Count() == 0);
+
+    return 0;
+}
+
+int32 main()
+{
+    TEST_ENSURE(TestBuckets() == 0);
+    TEST_ENSURE(TestPercentile() == 0);
+    TEST_ENSURE(TestMerge() == 0);
+    TEST_ENSURE(TestThreads() == 0);
+
+    return 0;
+}
\ No newline at end of file
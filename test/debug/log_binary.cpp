@@ -0,0 +1,217 @@
+#include <cstdio>
+
+#include "test_macro.h"
+
+import mini.test;
+
+using namespace mini;
+using namespace mini::test;
+
+static constexpr char const* testPath = "mini_log_binary_test.bin";
+static constexpr char const* corruptPath = "mini_log_binary_corrupt.bin";
+
+static Logger logger("test");
+
+template <typename... Args>
+static LogRecord MakeDeferred(LogSite const* site, Args const&... args)
+{
+    return LogRecord(nullptr, 1, site, args...);
+}
+
+int32 TestSite()
+{
+    SourceLocation location = SourceLocation::current();
+    LogArgType const* argTypes = logArgTypes<int32, double>;
+
+    LogSite const* site = LogSiteTable::Find(location, "{} {}", argTypes, 2);
+    TEST_ENSURE(site != nullptr);
+    TEST_ENSURE(site->format == StringView("{} {}"));
+    TEST_ENSURE(site->argCount == 2);
+    TEST_ENSURE(site->argTypes[0] == LogArgType::signedInt);
+    TEST_ENSURE(site->argTypes[1] == LogArgType::floating);
+    TEST_ENSURE(LogSiteTable::Find(location, "{} {}", argTypes, 2) == site);
+
+    // same location with other argument types, as a template logging different types would
+    LogSite const* other = LogSiteTable::Find(location, "{} {}", logArgTypes<uint8, bool>, 2);
+    TEST_ENSURE(other != nullptr && other != site);
+    TEST_ENSURE(other->id != site->id);
+
+    return 0;
+}
+
+int32 TestMaterialize()
+{
+    StringView format = "{} {} {:.2f} {} {} {} {} {} {}";
+    LogArgType const* argTypes =
+        logArgTypes<int32, uint64, double, bool, char, StringView, char const*, String, void const*>;
+    LogSite const* site = LogSiteTable::Find(SourceLocation::current(), format, argTypes, 9);
+    TEST_ENSURE(site != nullptr);
+
+    String text("string");
+    void const* pointer = nullptr;
+    LogRecord record = MakeDeferred(site, -12, uint64(34), 5.678, true, 'c', StringView("view"), "literal", text,
+                                    pointer);
+    TEST_ENSURE(record.GetKind() == LogRecord::Kind::deferred);
+
+    record.Materialize();
+    TEST_ENSURE(record.GetKind() == LogRecord::Kind::message);
+    TEST_ENSURE(record.Message() == StringView("-12 34 5.68 true c view literal string 0x0"));
+    TEST_ENSURE(record.Message().Data()[record.Message().Size()] == '\0');
+
+    // arguments longer than the inline buffer are encoded into the heap
+    String longText;
+    for (size_t i = 0; i < LogRecord::inlineSize * 2; ++i) {
+        longText.Push('x');
+    }
+
+    LogSite const* longSite = LogSiteTable::Find(SourceLocation::current(), "[{}]", logArgTypes<String>, 1);
+    LogRecord longRecord = MakeDeferred(longSite, longText);
+    LogRecord moved(MoveArg(longRecord));
+    moved.Materialize();
+    TEST_ENSURE(moved.Message().Size() == longText.Size() + 2);
+    TEST_ENSURE(moved.Message().Data()[longText.Size() + 1] == ']');
+
+    LogSite const* invalidSite = LogSiteTable::Find(SourceLocation::current(), "{:d}", logArgTypes<StringView>, 1);
+    LogRecord invalid = MakeDeferred(invalidSite, StringView("text"));
+    invalid.Materialize();
+    TEST_ENSURE(!invalid.Message().Empty());
+
+    return 0;
+}
+
+int32 TestFloat()
+{
+    LogSite const* site = LogSiteTable::Find(SourceLocation::current(), "{} {}", logArgTypes<float32, double>, 2);
+    TEST_ENSURE(site != nullptr);
+    TEST_ENSURE(site->argTypes[0] == LogArgType::floating32);
+
+    // a float widened to double would print all digits of its binary value
+    LogRecord record = MakeDeferred(site, 0.1f, 0.1);
+    TEST_ENSURE(record.PayloadSize() == sizeof(float32) + sizeof(double));
+    record.Materialize();
+    TEST_ENSURE(record.Message() == StringView(Format("{} {}", 0.1f, 0.1)));
+
+    CaptureState capture;
+    TEST_ENSURE(LogQueue::Start(UniquePtr<LogSink>(new CaptureSink(&capture))));
+    logger.Info("float {}", 0.1f);
+    LogQueue::Stop();
+
+    // the same message printed synchronously
+    TEST_ENSURE(capture.lines.Size() == 1);
+    TEST_ENSURE(StringView(capture.lines[0]) == StringView(Format("float {}", 0.1f)));
+    TEST_ENSURE(StringView(capture.lines[0]) == StringView("float 0.1"));
+
+    return 0;
+}
+
+int32 TestQueue()
+{
+    CaptureState capture;
+    TEST_ENSURE(LogQueue::Start(UniquePtr<LogSink>(new CaptureSink(&capture))));
+    TEST_ENSURE(LogQueue::Current()->Deferred());
+
+    uint32 sites = LogSiteTable::Count();
+    for (int32 i = 0; i < 100; ++i) {
+        logger.Info("message {} {}", i, StringView("text"));
+    }
+
+    // not a literal, formatted by the producer without a site
+    String format("formatted {}");
+    logger.Info(format, 1);
+
+    // a buffer is not a literal either, even though it is a character array
+    char buffer[] = "first {}";
+    for (int32 i = 0; i < 2; ++i) {
+        logger.Info(buffer, i);
+        buffer[0] = 'F';
+    }
+
+    LogQueue::Stop();
+    TEST_ENSURE(LogSiteTable::Count() == sites + 1);
+    TEST_ENSURE(capture.lines.Size() == 103);
+    TEST_ENSURE(StringView(capture.lines[101]) == StringView("first 0"));
+    TEST_ENSURE(StringView(capture.lines[102]) == StringView("First 1"));
+    for (int32 i = 0; i < 100; ++i) {
+        TEST_ENSURE(StringView(capture.lines[i]) == StringView(Format("message {} {}", i, StringView("text"))));
+    }
+
+    TEST_ENSURE(StringView(capture.lines[100]) == StringView("formatted 1"));
+    return 0;
+}
+
+int32 TestBinaryFile()
+{
+    BinaryLogSink* sink = new BinaryLogSink();
+    TEST_ENSURE(sink->Open(testPath));
+    TEST_ENSURE(LogQueue::Start(UniquePtr<LogSink>(sink)));
+
+    static Logger other("other");
+    for (int32 i = 0; i < 10; ++i) {
+        logger.Info("value {} of {}", i, 10);
+        other.Warn("plain message");
+    }
+
+    String format("text {}");
+    logger.Error(format, "formatted");
+    LogQueue::Stop();
+
+    BinaryLogReader reader;
+    TEST_ENSURE(reader.Open(testPath));
+
+    String line;
+    for (int32 i = 0; i < 10; ++i) {
+        line.Clear();
+        TEST_ENSURE(reader.Next(line));
+        TEST_ENSURE(EndsWith(line, Format("[test] [info] value {} of 10\n", i)));
+
+        line.Clear();
+        TEST_ENSURE(reader.Next(line));
+        TEST_ENSURE(EndsWith(line, "[other] [warn] plain message\n"));
+    }
+
+    line.Clear();
+    TEST_ENSURE(reader.Next(line));
+    TEST_ENSURE(EndsWith(line, "[test] [error] text formatted\n"));
+
+    TEST_ENSURE(!reader.Next(line));
+    TEST_ENSURE(!reader.Corrupted());
+
+    return 0;
+}
+
+int32 TestCorruptFile()
+{
+    // a site claiming far more argument types than the file holds
+    std::FILE* file = std::fopen(corruptPath, "wb");
+    TEST_ENSURE(file != nullptr);
+
+    uint32 header[] = { BinaryLogReader::version, 12, 0xffff'fff0u };
+    std::fwrite(BinaryLogReader::magic, 1, sizeof(BinaryLogReader::magic), file);
+    std::fwrite(&header[0], sizeof(uint32), 1, file);
+    std::fputc('S', file);
+    std::fwrite(&header[1], sizeof(uint32), 2, file);
+    std::fclose(file);
+
+    BinaryLogReader reader;
+    TEST_ENSURE(reader.Open(corruptPath));
+
+    String line;
+    TEST_ENSURE(!reader.Next(line));
+    TEST_ENSURE(reader.Corrupted());
+
+    return 0;
+}
+
+int32 main()
+{
+    TEST_ENSURE(TestSite() == 0);
+    TEST_ENSURE(TestMaterialize() == 0);
+    TEST_ENSURE(TestFloat() == 0);
+    TEST_ENSURE(TestQueue() == 0);
+    TEST_ENSURE(TestBinaryFile() == 0);
+    TEST_ENSURE(TestCorruptFile() == 0);
+
+    std::remove(testPath);
+    std::remove(corruptPath);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include "test_macro.h"
+
+import mini.test;
+
+using namespace mini;
+using namespace mini::test;
+
+static Logger logger("test");
+
+static void CloseGate(CaptureState& state)
+{
+    state.entered.Store(0, MemoryOrder::relaxed);
+    state.open.Store(0, MemoryOrder::release);
+
+    logger.Info("gate");
+    while (state.entered.Load(MemoryOrder::acquire) == 0) {
+        state.entered.Wait(0, MemoryOrder::acquire);
+    }
+}
+
+static void OpenGate(CaptureState& state)
+{
+    state.open.Store(1, MemoryOrder::release);
+    state.open.NotifyAll();
+}
+
+int32 TestRecord()
+{
+    LogRecord record(nullptr, 1, SourceLocation::current(), "{} + {} = {}", 1, 2, 3);
+    TEST_ENSURE(record.GetKind() == LogRecord::Kind::message);
+    TEST_ENSURE(record.Level() == 1);
+    TEST_ENSURE(record.Message() == StringView("1 + 2 = 3"));
+    TEST_ENSURE(record.Message().Data()[record.Message().Size()] == '\0');
+
+    // longer than the inline buffer, formatted into the heap instead
+    String longText;
+    for (size_t i = 0; i < LogRecord::inlineSize * 2; ++i) {
+        longText.Push('x');
+    }
+
+    LogRecord longRecord(nullptr, 1, SourceLocation::current(), "[{}]", longText);
+    TEST_ENSURE(longRecord.Message().Size() == longText.Size() + 2);
+    TEST_ENSURE(longRecord.Message().Data()[longText.Size() + 1] == ']');
+
+    LogRecord moved(MoveArg(longRecord));
+    TEST_ENSURE(moved.Message().Size() == longText.Size() + 2);
+    TEST_ENSURE(longRecord.Message().Empty());
+
+    LogRecord invalid(nullptr, 1, SourceLocation::current(), "{:d}", "text");
+    TEST_ENSURE(!invalid.Message().Empty());
+
+    return 0;
+}
+
+int32 TestOrder()
+{
+    CaptureState state;
+    TEST_ENSURE(LogQueue::Start(MakeUnique<CaptureSink>(&state)));
+    TEST_ENSURE(!LogQueue::Start());
+
+    static constexpr int32 count = 1000;
+    for (int32 i = 0; i < count; ++i) {
+        logger.Info("message {}", i);
+    }
+
+    LogQueue::Current()->Flush();
+    TEST_ENSURE(state.Count() == count);
+    for (int32 i = 0; i < count; ++i) {
+        TEST_ENSURE(StringView(state.lines[i]) == StringView(Format("message {}", i)));
+    }
+
+    LogQueue::Stop();
+    TEST_ENSURE(LogQueue::Current() == nullptr);
+
+    return 0;
+}
+
+int32 TestDrop()
+{
+    CaptureState state;
+    TEST_ENSURE(LogQueue::Start(MakeUnique<CaptureSink>(&state), LogOverflow::drop));
+    CloseGate(state);
+
+    static constexpr size_t extra = 100;
+    for (size_t i = 0; i < LogQueue::capacity + extra; ++i) {
+        logger.Info("message {}", i);
+    }
+
+    TEST_ENSURE(LogQueue::Current()->Dropped() == extra);
+
+    OpenGate(state);
+    LogQueue::Stop();
+    TEST_ENSURE(state.Count() == LogQueue::capacity + 1);
+
+    return 0;
+}
+
+int32 TestGrow()
+{
+    CaptureState state;
+    TEST_ENSURE(LogQueue::Start(MakeUnique<CaptureSink>(&state), LogOverflow::grow));
+    CloseGate(state);
+
+    static constexpr size_t extra = 100;
+    for (size_t i = 0; i < LogQueue::capacity + extra; ++i) {
+        logger.Info("message {}", i);
+    }
+
+    TEST_ENSURE(LogQueue::Current()->Dropped() == 0);
+
+    // messages queued while the spill is pending are still written after it
+    OpenGate(state);
+    for (size_t i = LogQueue::capacity + extra; i < LogQueue::capacity * 2; ++i) {
+        logger.Info("message {}", i);
+    }
+
+    LogQueue::Current()->Flush();
+    TEST_ENSURE(state.Count() == LogQueue::capacity * 2 + 1);
+    for (size_t i = 0; i < LogQueue::capacity * 2; ++i) {
+        TEST_ENSURE(StringView(state.lines[i + 1]) == StringView(Format("message {}", i)));
+    }
+
+    LogQueue::Stop();
+    return 0;
+}
+
+int32 TestBlock()
+{
+    CaptureState state;
+    TEST_ENSURE(LogQueue::Start(MakeUnique<CaptureSink>(&state), LogOverflow::block));
+
+    static constexpr int32 threadCount = 4;
+    static constexpr size_t count = LogQueue::capacity;
+
+    Thread threads[threadCount];
+    for (Thread& thread : threads) {
+        thread = Thread([]() {
+            for (size_t i = 0; i < count; ++i) {
+                logger.Warn("message {}", i);
+            }
+        });
+    }
+
+    for (Thread& thread : threads) {
+        thread.Join();
+    }
+
+    LogQueue::Stop();
+    TEST_ENSURE(state.Count() == threadCount * count);
+
+    return 0;
+}
+
+int32 main()
+{
+    TEST_ENSURE(TestRecord() == 0);
+    TEST_ENSURE(TestOrder() == 0);
+    TEST_ENSURE(TestDrop() == 0);
+    TEST_ENSURE(TestGrow() == 0);
+    TEST_ENSURE(TestBlock() == 0);
+
+    return 0;
+}
\ No newline at end of file
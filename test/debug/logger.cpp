@@ -0,0 +1,110 @@
+#include "test_macro.h"
+
+import mini.test;
+
+using namespace mini;
+using namespace mini::test;
+
+static void LogBurst(Logger& logger, int32 count)
+{
+    // one call site for every message, which is what the rate limit is keyed on
+    for (int32 i = 0; i < count; ++i) {
+        logger.Error("burst {}", i);
+    }
+}
+
+int32 TestLevel()
+{
+    Logger logger("level");
+    TEST_ENSURE(logger.GetLevel() == Logger::minLevel);
+    TEST_ENSURE(logger.Enabled(Logger::Level::fatal));
+    TEST_ENSURE(logger.Enabled(Logger::Level::debug) == (Logger::minLevel == Logger::Level::debug));
+
+    logger.SetLevel(Logger::Level::error);
+    TEST_ENSURE(!logger.Enabled(Logger::Level::warn));
+    TEST_ENSURE(logger.Enabled(Logger::Level::error));
+
+    CaptureState capture;
+    TEST_ENSURE(LogQueue::Start(UniquePtr<LogSink>(new CaptureSink(&capture))));
+
+    logger.Info("filtered");
+    logger.Warn("filtered");
+    logger.Error("passed");
+
+    LogQueue::Stop();
+    TEST_ENSURE(capture.lines.Size() == 1);
+    TEST_ENSURE(StringView(capture.lines[0]) == StringView("passed"));
+
+    return 0;
+}
+
+int32 TestCategoryLevel()
+{
+    Logger before("category");
+    Logger other("other category");
+
+    Logger::SetCategoryLevel("category", Logger::Level::warn);
+    TEST_ENSURE(before.GetLevel() == Logger::Level::warn);
+    TEST_ENSURE(other.GetLevel() == Logger::minLevel);
+
+    // the level also applies to loggers of the category created afterwards
+    Logger after("category");
+    TEST_ENSURE(after.GetLevel() == Logger::Level::warn);
+
+    Logger::SetCategoryLevel("category", Logger::Level::fatal);
+    TEST_ENSURE(before.GetLevel() == Logger::Level::fatal);
+    TEST_ENSURE(after.GetLevel() == Logger::Level::fatal);
+
+    return 0;
+}
+
+int32 TestRateLimit()
+{
+    static constexpr uint32 rate = 1000;
+    static constexpr uint32 burst = 5;
+    static constexpr int32 count = 50;
+
+    Logger logger("limit");
+    CaptureState capture;
+    TEST_ENSURE(LogQueue::Start(UniquePtr<LogSink>(new CaptureSink(&capture))));
+
+    LogRateLimit::Configure(rate, burst);
+    TEST_ENSURE(LogRateLimit::Enabled());
+
+    // a slow run may refill a token or two while the burst is logged
+    LogBurst(logger, count);
+    LogQueue::Current()->Flush();
+    size_t passed = capture.lines.Size();
+    TEST_ENSURE(passed >= burst && passed < burst + 5);
+
+    // the next message that passes reports how many were dropped before it
+    Thread::SleepFor(MilliSeconds(10));
+    LogBurst(logger, 1);
+    LogQueue::Current()->Flush();
+    TEST_ENSURE(capture.lines.Size() == passed + 2);
+    TEST_ENSURE(StringView(capture.lines[passed]) == StringView(Format("{} messages suppressed", count - passed)));
+    TEST_ENSURE(StringView(capture.lines[passed + 1]) == StringView("burst 0"));
+
+    // fatal messages are never limited
+    for (int32 i = 0; i < count; ++i) {
+        logger.Fatal("fatal {}", i);
+    }
+
+    LogQueue::Current()->Flush();
+    TEST_ENSURE(capture.lines.Size() == passed + 2 + count);
+
+    LogRateLimit::Configure(0, 0);
+    TEST_ENSURE(!LogRateLimit::Enabled());
+
+    LogQueue::Stop();
+    return 0;
+}
+
+int32 main()
+{
+    TEST_ENSURE(TestLevel() == 0);
+    TEST_ENSURE(TestCategoryLevel() == 0);
+    TEST_ENSURE(TestRateLimit() == 0);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "test_macro.h"
+
+import mini.test;
+
+using namespace mini;
+using namespace mini::test;
+
+static constexpr char const* testPath = "mini_logger_linux_test.log";
+static constexpr char const* backupPath = "mini_logger_linux_test.log.1";
+
+class CaptureWriter final : public PlatformLogWriter {
+private:
+    Array<String>* m_lines;
+    int32* m_flushes;
+
+public:
+    CaptureWriter(Array<String>* lines, int32* flushes) noexcept
+        : m_lines(lines)
+        , m_flushes(flushes)
+    {
+    }
+
+    void Write(byte, StringView category, StringView message) final
+    {
+        m_lines->Push(Format("{}: {}", category, message));
+    }
+
+    void Flush() final { ++*m_flushes; }
+};
+
+static String ReadFile(char const* path)
+{
+    String content;
+    std::FILE* file = std::fopen(path, "rb");
+    if (file == nullptr) {
+        return content;
+    }
+
+    char buffer[1024];
+    size_t read = 0;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), file)) != 0) {
+        content.Append(StringView(buffer, read));
+    }
+
+    std::fclose(file);
+    return content;
+}
+
+// takes what is waiting in a non blocking pipe
+static String ReadPipe(int32 file)
+{
+    String content;
+    char buffer[1024];
+    ssize_t count = 0;
+    while ((count = read(file, buffer, sizeof(buffer))) > 0) {
+        content.Append(StringView(buffer, static_cast<size_t>(count)));
+    }
+
+    return content;
+}
+
+int32 TestWriter()
+{
+    Array<String> lines;
+    int32 flushes = 0;
+    LoggerBase::SetWriter(MakeUnique<CaptureWriter>(&lines, &flushes));
+
+    // without a log queue every message is printed right away, but only errors flush the writer
+    Logger logger("linux");
+    logger.Info("value {}", 1);
+    TEST_ENSURE(flushes == 0);
+    logger.Error("plain");
+
+    TEST_ENSURE(lines.Size() == 2);
+    TEST_ENSURE(StringView(lines[0]) == StringView("linux: value 1"));
+    TEST_ENSURE(StringView(lines[1]) == StringView("linux: plain"));
+    TEST_ENSURE(flushes == 1);
+
+    LoggerBase::FlushMessages();
+    TEST_ENSURE(flushes == 2);
+
+    LoggerBase::SetWriter(UniquePtr<PlatformLogWriter>());
+    return 0;
+}
+
+int32 TestStderrDelay()
+{
+    int32 pipes[2];
+    TEST_ENSURE(pipe(pipes) == 0);
+    TEST_ENSURE(fcntl(pipes[0], F_SETFL, O_NONBLOCK) == 0);
+
+    int32 saved = dup(STDERR_FILENO);
+    TEST_ENSURE(dup2(pipes[1], STDERR_FILENO) == STDERR_FILENO);
+
+    String first;
+    String second;
+    String fallback;
+    {
+        // a pipe is not a terminal, so lines stay buffered until the oldest one is maxDelay old
+        StderrLogWriter writer;
+        writer.Write(1, "stderr", "first");
+        first = ReadPipe(pipes[0]);
+
+        Thread::SleepFor(StderrLogWriter::maxDelay + MilliSeconds(20));
+        writer.Write(2, "stderr", "second");
+        second = ReadPipe(pipes[0]);
+
+        // a file writer without a mapped file writes through to stderr
+        RotatingFileLogWriter file;
+        file.Write(3, "file", "unmapped");
+        fallback = ReadPipe(pipes[0]);
+    }
+
+    // restored before checking, a failure is reported on the real stderr
+    dup2(saved, STDERR_FILENO);
+    close(saved);
+    close(pipes[0]);
+    close(pipes[1]);
+
+    TEST_ENSURE(first.Empty());
+    TEST_ENSURE(StringView(second) == StringView("[stderr] [info] first\n[stderr] [warn] second\n"));
+    TEST_ENSURE(StringView(fallback) == StringView("[file] [error] unmapped\n"));
+
+    return 0;
+}
+
+int32 TestRotatingFile()
+{
+    RotatingFileLogWriter writer;
+    TEST_ENSURE(writer.Open(testPath, 1, 1));
+    TEST_ENSURE(writer.IsOpen());
+
+    writer.Write(1, "file", "first");
+    writer.Write(3, "file", "second");
+    writer.Close();
+
+    // the file is trimmed to the lines written when closed
+    String content = ReadFile(testPath);
+    TEST_ENSURE(StringView(content) == StringView("[file] [info] first\n[file] [error] second\n"));
+
+    // the size is rounded up to a page, filling it moves the file to the backup
+    size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    TEST_ENSURE(writer.Open(testPath, 1, 1));
+    String line(StringView("0123456789012345678901234567890123456789"));
+    size_t written = 0;
+    while (written < pageSize * 2) {
+        writer.Write(1, "file", line);
+        written += line.Size() + 15;
+    }
+
+    writer.Write(2, "file", "rotated");
+    writer.Close();
+
+    TEST_ENSURE(EndsWith(ReadFile(testPath), "[file] [warn] rotated\n"));
+    TEST_ENSURE(!ReadFile(backupPath).Empty());
+
+    return 0;
+}
+
+int32 main()
+{
+    TEST_ENSURE(TestWriter() == 0);
+    TEST_ENSURE(TestStderrDelay() == 0);
+    TEST_ENSURE(TestRotatingFile() == 0);
+
+    std::remove(testPath);
+    std::remove(backupPath);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include <cstdio>
+
+#include "test_macro.h"
+
+import mini.test;
+
+using namespace mini;
+using namespace mini::test;
+
+static constexpr char const* snapshotPath = "mini_metrics_test.txt";
+
+int32 TestRegistry()
+{
+    ShardedCounter& counter = Metrics::GetCounter("test.counter");
+    TEST_ENSURE(&counter == &Metrics::GetCounter("test.counter"));
+    TEST_ENSURE(&counter != &Metrics::GetCounter("test.other"));
+
+    Gauge& gauge = Metrics::GetGauge("test.gauge");
+    TEST_ENSURE(&gauge == &Metrics::GetGauge("test.gauge"));
+
+    Histogram& histogram = Metrics::GetHistogram("test.histogram");
+    TEST_ENSURE(&histogram == &Metrics::GetHistogram("test.histogram"));
+
+    return 0;
+}
+
+int32 TestSnapshot()
+{
+    Metrics::GetCounter("test.counter").Add(3);
+    Metrics::GetGauge("test.gauge").Set(-7);
+
+    Histogram& histogram = Metrics::GetHistogram("test.histogram");
+    for (uint64 value = 1; value <= 100; ++value) {
+        histogram.Record(value);
+    }
+
+    String snapshot;
+    Metrics::Snapshot(snapshot);
+    TEST_ENSURE(Contains(snapshot, "counter test.counter 3\n"));
+    TEST_ENSURE(Contains(snapshot, "gauge test.gauge -7\n"));
+    TEST_ENSURE(Contains(snapshot, "histogram test.histogram count=100 min=1 p50=50 "));
+    TEST_ENSURE(Contains(snapshot, " max=100 mean=50.5\n"));
+
+    Metrics::Log();
+    TEST_ENSURE(Metrics::WriteToFile(snapshotPath));
+
+    return 0;
+}
+
+int32 main()
+{
+    TEST_ENSURE(TestRegistry() == 0);
+    TEST_ENSURE(TestSnapshot() == 0);
+
+    std::remove(snapshotPath);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,144 @@
+#include <cstdio>
+
+#include "test_macro.h"
+
+import mini.test;
+
+using namespace mini;
+using namespace mini::test;
+
+static constexpr char const* tracePath = "mini_profiler_test.json";
+
+static size_t CountZones(char const* name)
+{
+    Array<ProfileZone> zones;
+    Profiler::Collect(zones);
+
+    size_t count = 0;
+    for (ProfileZone const& zone : zones) {
+        count += zone.name == name ? 1 : 0;
+    }
+
+    return count;
+}
+
+int32 TestRecord()
+{
+    Profiler::Clear();
+
+    static constexpr char const* outer = "test.outer";
+    static constexpr char const* inner = "test.inner";
+    {
+        ProfileScope outerScope(outer);
+        ProfileScope innerScope(inner);
+    }
+
+    Array<ProfileZone> zones;
+    Profiler::Collect(zones);
+    TEST_ENSURE(zones.Size() == 2);
+
+    // zones are recorded as they end, the inner one first
+    TEST_ENSURE(zones[0].name == inner);
+    TEST_ENSURE(zones[1].name == outer);
+    TEST_ENSURE(zones[0].thread == Thread::CurrentId());
+    TEST_ENSURE(zones[1].begin <= zones[0].begin);
+    TEST_ENSURE(zones[0].end <= zones[1].end);
+
+    return 0;
+}
+
+int32 TestThreads()
+{
+    Profiler::Clear();
+
+    static constexpr int32 threadCount = 4;
+    static constexpr char const* name = "test.thread";
+
+    Thread threads[threadCount];
+    for (Thread& thread : threads) {
+        thread = Thread([]() {
+            for (int32 i = 0; i < 100; ++i) {
+                ProfileScope scope(name);
+            }
+        });
+    }
+
+    for (Thread& thread : threads) {
+        thread.Join();
+    }
+
+    // zones of exited threads are still around
+    TEST_ENSURE(CountZones(name) == threadCount * 100);
+
+    return 0;
+}
+
+int32 TestWrap()
+{
+    Profiler::Clear();
+
+    static constexpr char const* name = "test.wrap";
+    for (size_t i = 0; i < Profiler::bufferCapacity + 100; ++i) {
+        ProfileScope scope(name);
+    }
+
+    // readers give up the slot a writer may be in the middle of, one zone less than the capacity is kept
+    TEST_ENSURE(CountZones(name) == Profiler::bufferCapacity - 1);
+    return 0;
+}
+
+int32 TestEnable()
+{
+    Profiler::Clear();
+
+    static constexpr char const* name = "test.disabled";
+    Profiler::SetEnabled(false);
+    TEST_ENSURE(!Profiler::Enabled());
+    {
+        ProfileScope scope(name);
+    }
+
+    Profiler::SetEnabled(true);
+    TEST_ENSURE(CountZones(name) == 0);
+
+    {
+        ProfileScope scope(name);
+    }
+
+    TEST_ENSURE(CountZones(name) == 1);
+    Profiler::Clear();
+    TEST_ENSURE(CountZones(name) == 0);
+
+    return 0;
+}
+
+int32 TestExport()
+{
+    Profiler::Clear();
+    Profiler::SetThreadName("test \"main\"");
+    {
+        ProfileScope scope("test.export");
+    }
+
+    String trace;
+    Profiler::Export(trace);
+    TEST_ENSURE(Contains(trace, "{\"traceEvents\":["));
+    TEST_ENSURE(Contains(trace, "\"name\":\"test.export\",\"cat\":\"cpu\",\"ph\":\"X\""));
+    TEST_ENSURE(Contains(trace, "\"args\":{\"name\":\"test \\\"main\\\"\"}"));
+    TEST_ENSURE(Contains(trace, "\"displayTimeUnit\":\"ns\"}"));
+
+    TEST_ENSURE(Profiler::ExportToFile(tracePath));
+    return 0;
+}
+
+int32 main()
+{
+    TEST_ENSURE(TestRecord() == 0);
+    TEST_ENSURE(TestThreads() == 0);
+    TEST_ENSURE(TestWrap() == 0);
+    TEST_ENSURE(TestEnable() == 0);
+    TEST_ENSURE(TestExport() == 0);
+
+    std::remove(tracePath);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+#include <cstdlib>
+
+#include "test_macro.h"
+
+import mini.test;
+import mini.platform;
+import mini.graphics;
+import mini.engine;
+import mini.null_platform;
+import mini.null_graphics;
+
+using namespace mini;
+using namespace mini::test;
+
+static constexpr uint64 frameCount = 24;
+
+static RectInt FrameRect(uint64 frame)
+{
+    return RectInt(0, 0, static_cast<int32>(frame) + 1, 1);
+}
+
+static void Fill(FramePacket& packet, uint64 frame)
+{
+    packet.frame = frame;
+    packet.begin = Clock::Now();
+    packet.windowSize = FrameRect(frame);
+}
+
+static uint64 Presents(NullGraphics* null)
+{
+    return null->GetCalls().present.Load(MemoryOrder::relaxed);
+}
+
+int32 TestInline(Graphics* graphics, NullGraphics* null)
+{
+    FramePipeline pipeline(1);
+    TEST_ENSURE(pipeline.Depth() == 1);
+    pipeline.Start(graphics);
+
+    // without a render thread the packet has been presented by the time Submit returns
+    for (uint64 frame = 0; frame < frameCount; ++frame) {
+        uint64 presents = Presents(null);
+        FramePacket& packet = pipeline.Acquire();
+        Fill(packet, frame);
+        pipeline.Submit(packet);
+
+        TEST_ENSURE(Presents(null) == presents + 1);
+        TEST_ENSURE(null->GetRenderer()->GetScissorRect() == FrameRect(frame));
+    }
+
+    pipeline.Stop();
+    return 0;
+}
+
+int32 TestOrder(Graphics* graphics, NullGraphics* null, uint32 depth)
+{
+    FramePipeline pipeline(depth);
+    TEST_ENSURE(pipeline.Depth() == depth);
+    pipeline.Start(graphics);
+
+    // packets come back in the order they were rendered, rendering in submission order cycles through them
+    uint64 presents = Presents(null);
+    FramePacket* packets[FramePipeline::MaxDepth] = {};
+    for (uint64 frame = 0; frame < frameCount; ++frame) {
+        FramePacket& packet = pipeline.Acquire();
+        if (frame < depth) {
+            packets[frame] = &packet;
+        }
+
+        TEST_ENSURE(&packet == packets[frame % depth]);
+        Fill(packet, frame);
+        pipeline.Submit(packet);
+    }
+
+    pipeline.Stop();
+    TEST_ENSURE(Presents(null) == presents + frameCount);
+    TEST_ENSURE(null->GetRenderer()->GetScissorRect() == FrameRect(frameCount - 1));
+
+    return 0;
+}
+
+int32 TestStop(Graphics* graphics, NullGraphics* null)
+{
+    FramePipeline pipeline(FramePipeline::MaxDepth);
+    pipeline.Start(graphics);
+
+    // every packet is in flight behind the slow present, stopping still renders all of them before joining
+    uint64 presents = Presents(null);
+    for (uint64 frame = 0; frame < FramePipeline::MaxDepth; ++frame) {
+        FramePacket& packet = pipeline.Acquire();
+        Fill(packet, frame);
+        pipeline.Submit(packet);
+    }
+
+    pipeline.Stop();
+    TEST_ENSURE(Presents(null) == presents + FramePipeline::MaxDepth);
+    TEST_ENSURE(null->GetRenderer()->GetScissorRect() == FrameRect(FramePipeline::MaxDepth - 1));
+
+    return 0;
+}
+
+int32 TestPoll(Graphics* graphics, Platform* platform, NullPlatform* null)
+{
+    FramePipeline pipeline(2);
+    pipeline.Start(graphics, platform);
+
+    // waiting on the render thread keeps polling the platform, the window is never left without its events
+    uint64 polls = null->GetCalls().pollEvents.Load(MemoryOrder::relaxed);
+    for (uint64 frame = 0; frame < 8; ++frame) {
+        FramePacket& packet = pipeline.Acquire();
+        Fill(packet, frame);
+        pipeline.Submit(packet);
+    }
+
+    pipeline.Stop();
+    TEST_ENSURE(null->GetCalls().pollEvents.Load(MemoryOrder::relaxed) > polls);
+
+    return 0;
+}
+
+int32 main()
+{
+    // presents take long enough for packets to queue up behind the render thread
+    TEST_ENSURE(setenv("MINI_NULL_PRESENT_LATENCY", "2000", 1) == 0);
+
+    Module<Core> core("mini.core");
+    Module<NullPlatform> nullPlatform("mini.null_platform");
+    Module<NullGraphics> nullGraphics("mini.null_graphics");
+    Module<Platform> platform("mini.platform");
+    Module<Graphics> graphics("mini.graphics");
+    TEST_ENSURE(platform.Valid() && graphics.Valid());
+
+    TEST_ENSURE(TestInline(graphics.GetInterface(), nullGraphics.GetInterface()) == 0);
+    TEST_ENSURE(TestOrder(graphics.GetInterface(), nullGraphics.GetInterface(), 2) == 0);
+    TEST_ENSURE(TestOrder(graphics.GetInterface(), nullGraphics.GetInterface(), 3) == 0);
+    TEST_ENSURE(TestStop(graphics.GetInterface(), nullGraphics.GetInterface()) == 0);
+    TEST_ENSURE(TestPoll(graphics.GetInterface(), platform.GetInterface(), nullPlatform.GetInterface()) == 0);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include <cstdlib>
+
+#include "test_macro.h"
+
+import mini.test;
+import mini.engine;
+import mini.null_platform;
+import mini.null_graphics;
+
+using namespace mini;
+using namespace mini::test;
+
+static constexpr uint64 frameLimit = 30;
+
+int32 TestFrames()
+{
+    // read by the null platform when it is created, it quits the engine once it was polled past the limit
+    TEST_ENSURE(setenv("MINI_NULL_FRAMES", "30", 1) == 0);
+    TEST_ENSURE(setenv("MINI_TARGET_FPS", "0", 1) == 0);
+
+    // the engine loads the same modules by name, holding them keeps their counters alive past the loop
+    Module<Core> core("mini.core");
+    Module<NullPlatform> platform("mini.null_platform");
+    Module<NullGraphics> graphics("mini.null_graphics");
+    TEST_ENSURE(platform.Valid() && graphics.Valid());
+
+    Module<Engine> engine("mini.engine");
+    TEST_ENSURE(engine.Valid());
+    engine->Launch();
+    engine.Release();
+
+    // the engine polls once after showing the window and once more every frame
+    null_platform::Calls const& platformCalls = platform->GetCalls();
+    TEST_ENSURE(platformCalls.pollEvents.Load(MemoryOrder::relaxed) == frameLimit + 1);
+    TEST_ENSURE(platformCalls.show.Load(MemoryOrder::relaxed) == 1);
+    TEST_ENSURE(platformCalls.alertError.Load(MemoryOrder::relaxed) == 0);
+
+    // frames still in the pipeline when the loop quits are rendered before the engine returns
+    null_graphics::Calls const& graphicsCalls = graphics->GetCalls();
+    TEST_ENSURE(graphicsCalls.present.Load(MemoryOrder::relaxed) == frameLimit);
+    TEST_ENSURE(graphicsCalls.beginRender.Load(MemoryOrder::relaxed) == frameLimit);
+    TEST_ENSURE(graphicsCalls.endRender.Load(MemoryOrder::relaxed) == frameLimit);
+    TEST_ENSURE(graphicsCalls.execute.Load(MemoryOrder::relaxed) == frameLimit);
+    TEST_ENSURE(graphicsCalls.setViewport.Load(MemoryOrder::relaxed) == frameLimit);
+
+    return 0;
+}
+
+int32 main()
+{
+    TEST_ENSURE(TestFrames() == 0);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,141 @@
+#include <cstdio>
+
+#include "test_macro.h"
+
+import mini.test;
+
+using namespace mini;
+using namespace mini::test;
+
+static constexpr char const* testPath = "mini_io_queue_test.bin";
+static constexpr uint32 blockSize = IoBuffer::alignment;
+static constexpr uint32 blockCount = 16;
+
+static byte Pattern(uint64 index) noexcept
+{
+    return static_cast<byte>((index * 31 + 7) & 0xFF);
+}
+
+static bool CheckBlock(byte const* data, uint32 block) noexcept
+{
+    for (uint32 i = 0; i < blockSize; ++i) {
+        if (data[i] != Pattern(static_cast<uint64>(block) * blockSize + i)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void CountCompletion(IoRequest& request, void* userData)
+{
+    if (request.Result() == blockSize) {
+        static_cast<Atomic<uint32>*>(userData)->FetchAdd(1, MemoryOrder::relaxed);
+    }
+}
+
+static Task<int64> ReadBlock(IoQueue& queue, AsyncFile const& file, uint32 block, byte* data)
+{
+    co_return co_await queue.Read(file, static_cast<uint64>(block) * blockSize, data, blockSize);
+}
+
+int32 TestFile()
+{
+    IoBuffer buffer(blockSize * blockCount);
+    TEST_ENSURE(buffer.Size() == blockSize * blockCount);
+    TEST_ENSURE(IoBuffer::AlignSize(1) == IoBuffer::alignment);
+    TEST_ENSURE((reinterpret_cast<size_t>(buffer.Data()) & (IoBuffer::alignment - 1)) == 0);
+
+    for (size_t i = 0; i < buffer.Size(); ++i) {
+        buffer.Data()[i] = Pattern(i);
+    }
+
+    FileOpenOptions options;
+    options.write = true;
+    options.create = true;
+
+    AsyncFile file;
+    TEST_ENSURE(file.Open(testPath, options));
+    TEST_ENSURE(file.WriteAt(0, buffer.Data(), buffer.Size()) == static_cast<int64>(buffer.Size()));
+    TEST_ENSURE(file.Size() == static_cast<int64>(buffer.Size()));
+
+    byte block[blockSize];
+    TEST_ENSURE(file.ReadAt(blockSize * 3, block, blockSize) == blockSize);
+    TEST_ENSURE(CheckBlock(block, 3));
+
+    AsyncFile moved(MoveArg(file));
+    TEST_ENSURE(!file.IsOpen());
+    TEST_ENSURE(moved.IsOpen());
+
+    return 0;
+}
+
+int32 TestQueue(bool forceThreadPool)
+{
+    IoQueueOptions queueOptions;
+    queueOptions.forceThreadPool = forceThreadPool;
+
+    IoQueue queue(queueOptions);
+    TEST_ENSURE(!forceThreadPool || queue.Backend() == IoBackend::threadPool);
+
+    FileOpenOptions options;
+    options.direct = true;
+
+    AsyncFile file;
+    TEST_ENSURE(file.Open(testPath, options));
+
+    IoBuffer buffer(blockSize * blockCount);
+    // registering may be refused by the memory lock limit, requests then simply keep the plain buffer
+    bool registered = queue.RegisterBuffers(&buffer, 1);
+
+    // a whole batch is submitted before a single flush
+    IoRequest requests[blockCount];
+    for (uint32 i = 0; i < blockCount; ++i) {
+        requests[i].PrepareRead(file, static_cast<uint64>(i) * blockSize, buffer.Data() + i * blockSize, blockSize);
+        requests[i].SetBufferIndex(registered ? 0 : -1);
+        queue.Submit(requests[i]);
+    }
+
+    queue.Flush();
+
+    for (uint32 i = 0; i < blockCount; ++i) {
+        requests[i].Wait();
+        TEST_ENSURE(requests[i].Done());
+        TEST_ENSURE(requests[i].Result() == blockSize);
+        TEST_ENSURE(CheckBlock(buffer.Data() + i * blockSize, i));
+    }
+
+    // requests are reusable once completed, this time reporting through a callback
+    Atomic<uint32> completed(0);
+    for (uint32 i = 0; i < blockCount; ++i) {
+        requests[i].PrepareRead(file, static_cast<uint64>(i) * blockSize, buffer.Data() + i * blockSize, blockSize);
+        requests[i].SetCallback(CountCompletion, &completed);
+        queue.Submit(requests[i]);
+    }
+
+    queue.Flush();
+
+    for (uint32 i = 0; i < blockCount; ++i) {
+        requests[i].Wait();
+    }
+    TEST_ENSURE(completed.Load(MemoryOrder::relaxed) == blockCount);
+
+    byte* last = buffer.Data() + (blockCount - 1) * blockSize;
+    TEST_ENSURE(SyncWait(ReadBlock(queue, file, blockCount - 1, last)) == blockSize);
+    TEST_ENSURE(CheckBlock(last, blockCount - 1));
+
+    // reading past the end transfers nothing
+    TEST_ENSURE(SyncWait(ReadBlock(queue, file, blockCount, buffer.Data())) == 0);
+
+    return 0;
+}
+
+int32 main()
+{
+    TEST_ENSURE(TestFile() == 0);
+    TEST_ENSURE(TestQueue(true) == 0);
+    TEST_ENSURE(TestQueue(false) == 0);
+
+    std::remove(testPath);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "test_macro.h"
+
+import mini.test;
+
+using namespace mini;
+using namespace mini::test;
+
+static constexpr char const* testPath = "mini_io_ring_linux_test.bin";
+static constexpr uint32 blockSize = IoBuffer::alignment;
+
+// the only io_uring instance of the process is the one of the queue under test
+static int32 FindRingFile()
+{
+    DIR* directory = opendir("/proc/self/fd");
+    if (directory == nullptr) {
+        return -1;
+    }
+
+    int32 found = -1;
+    for (dirent* entry = readdir(directory); entry != nullptr && found < 0; entry = readdir(directory)) {
+        char path[300];
+        char target[64] = {};
+        std::snprintf(path, sizeof(path), "/proc/self/fd/%s", entry->d_name);
+
+        if (readlink(path, target, sizeof(target) - 1) > 0 && std::strcmp(target, "anon_inode:[io_uring]") == 0) {
+            found = std::atoi(entry->d_name);
+        }
+    }
+
+    closedir(directory);
+    return found;
+}
+
+static int32 SubmitRefused(AsyncFile const& file, IoBuffer& buffer)
+{
+    IoQueue queue;
+    if (queue.Backend() != IoBackend::ioUring) {
+        // io_uring is unavailable or blocked here, there is no submission to refuse
+        return 0;
+    }
+
+    // replacing the ring descriptor makes every later io_uring_enter fail with a hard error,
+    // the completion thread is idle and keeps its own reference to the ring
+    int32 ring = FindRingFile();
+    TEST_ENSURE(ring >= 0);
+
+    int32 null = open("/dev/null", O_RDONLY);
+    TEST_ENSURE(null >= 0);
+    TEST_ENSURE(dup2(null, ring) == ring);
+    close(null);
+
+    IoRequest request;
+    request.PrepareRead(file, 0, buffer.Data(), blockSize);
+    queue.Submit(request);
+    queue.Flush();
+
+    // the refused request completes with the error instead of staying in flight
+    TEST_ENSURE(request.Done());
+    TEST_ENSURE(request.Result() < 0);
+
+    // destroying the queue must not wait on the kernel accepting anything else
+    return 0;
+}
+
+int32 TestRefused()
+{
+    FileOpenOptions options;
+    options.write = true;
+    options.create = true;
+
+    AsyncFile file;
+    TEST_ENSURE(file.Open(testPath, options));
+
+    IoBuffer buffer(blockSize);
+    TEST_ENSURE(file.WriteAt(0, buffer.Data(), blockSize) == blockSize);
+    TEST_ENSURE(SubmitRefused(file, buffer) == 0);
+
+    file.Close();
+    std::remove(testPath);
+    return 0;
+}
+
+int32 main()
+{
+    TEST_ENSURE(TestRefused() == 0);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include <cstdio>
+
+#include "test_macro.h"
+
+import mini.test;
+
+using namespace mini;
+using namespace mini::test;
+
+static constexpr char const* testPath = "mini_mapped_file_test.txt";
+static constexpr char const* emptyPath = "mini_mapped_file_empty.txt";
+static constexpr StringView content = "key = value\nname = mini\n";
+
+static bool WriteFile(char const* path, StringView text)
+{
+    FileOpenOptions options;
+    options.write = true;
+    options.create = true;
+
+    AsyncFile file;
+    return file.Open(path, options) &&
+           file.WriteAt(0, text.Data(), text.Size()) == static_cast<int64>(text.Size());
+}
+
+int32 TestRead()
+{
+    TEST_ENSURE(WriteFile(testPath, content));
+
+    MappedFile file;
+    TEST_ENSURE(!file.IsOpen());
+    TEST_ENSURE(file.Open(testPath));
+    TEST_ENSURE(file.IsOpen());
+    TEST_ENSURE(!file.IsWritable());
+    TEST_ENSURE(file.Size() == content.Size());
+
+    // views point straight into the mapping
+    TEST_ENSURE(file.View() == content);
+    TEST_ENSURE(file.View().Data() == reinterpret_cast<char const*>(file.Data()));
+    TEST_ENSURE(file.View(12, 11) == StringView("name = mini"));
+
+    TEST_ENSURE(file.Advise(MapAdvice::normal));
+    TEST_ENSURE(file.Prefetch(4, 8));
+#if PLATFORM_LINUX || PLATFORM_MACOS
+    TEST_ENSURE(file.Advise(MapAdvice::sequential));
+#endif
+
+    MappedFile moved(MoveArg(file));
+    TEST_ENSURE(!file.IsOpen());
+    TEST_ENSURE(moved.View() == content);
+
+    moved.Close();
+    TEST_ENSURE(!moved.IsOpen());
+    TEST_ENSURE(!file.Open("mini_mapped_file_missing.txt"));
+
+    return 0;
+}
+
+int32 TestWrite()
+{
+    TEST_ENSURE(WriteFile(testPath, content));
+
+    MappedFile file;
+    TEST_ENSURE(file.Open(testPath, MapAccess::readWrite));
+    TEST_ENSURE(file.IsWritable());
+
+    file.MutableData()[0] = static_cast<byte>('K');
+    TEST_ENSURE(file.Flush());
+    file.Close();
+
+    AsyncFile reader;
+    TEST_ENSURE(reader.Open(testPath));
+
+    char first = 0;
+    TEST_ENSURE(reader.ReadAt(0, &first, 1) == 1);
+    TEST_ENSURE(first == 'K');
+
+    return 0;
+}
+
+int32 TestEmpty()
+{
+    TEST_ENSURE(WriteFile(emptyPath, StringView()));
+
+    MappedFile file;
+    TEST_ENSURE(file.Open(emptyPath));
+    TEST_ENSURE(file.IsOpen());
+    TEST_ENSURE(file.Empty());
+    TEST_ENSURE(file.View().Empty());
+    TEST_ENSURE(file.Advise(MapAdvice::sequential));
+
+    return 0;
+}
+
+int32 main()
+{
+    TEST_ENSURE(TestRead() == 0);
+    TEST_ENSURE(TestWrite() == 0);
+    TEST_ENSURE(TestEmpty() == 0);
+
+    std::remove(testPath);
+    std::remove(emptyPath);
+    return 0;
+}
\ No newline at end of file
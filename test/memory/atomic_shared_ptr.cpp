@@ -0,0 +1,163 @@
+#include <thread>
+
+#include "test_macro.h"
+
+import mini.test;
+
+using namespace mini;
+using namespace mini::test;
+
+struct Config {
+public:
+    int32 version;
+    Atomic<int32>* destroyed;
+
+    Config(int32 v, Atomic<int32>* d) noexcept
+        : version(v)
+        , destroyed(d)
+    {
+    }
+
+    ~Config() noexcept { destroyed->FetchAdd(1, MemoryOrder::relaxed); }
+};
+
+int32 TestLoadStore()
+{
+    Atomic<int32> destroyed(0);
+    {
+        AtomicSharedPtr<Config> a;
+        TEST_ENSURE(a.Load(MemoryOrder::acquire) == nullptr);
+
+        a.Store(MakeShared<Config>(1, &destroyed), MemoryOrder::release);
+        SharedPtr<Config> p = a.Load(MemoryOrder::acquire);
+        TEST_ENSURE(p.Valid());
+        TEST_ENSURE(p->version == 1);
+
+        a.Store(MakeShared<Config>(2, &destroyed), MemoryOrder::release);
+        TEST_ENSURE(destroyed.Load(MemoryOrder::relaxed) == 0);
+        TEST_ENSURE(a.Load(MemoryOrder::acquire)->version == 2);
+
+        p.Reset();
+        TEST_ENSURE(destroyed.Load(MemoryOrder::relaxed) == 1);
+    }
+    TEST_ENSURE(destroyed.Load(MemoryOrder::relaxed) == 2);
+
+    return 0;
+}
+
+int32 TestExchange()
+{
+    Atomic<int32> destroyed(0);
+    {
+        AtomicSharedPtr<Config> a(MakeShared<Config>(1, &destroyed));
+        SharedPtr<Config> old = a.Exchange(MakeShared<Config>(2, &destroyed), MemoryOrder::acquireRelease);
+        TEST_ENSURE(old->version == 1);
+        TEST_ENSURE(a.Load(MemoryOrder::acquire)->version == 2);
+
+        SharedPtr<Config> expected = old;
+        TEST_ENSURE(!a.CompareExchange(expected, MakeShared<Config>(3, &destroyed), MemoryOrder::acquireRelease));
+        TEST_ENSURE(expected->version == 2);
+        TEST_ENSURE(destroyed.Load(MemoryOrder::relaxed) == 1);
+
+        TEST_ENSURE(a.CompareExchange(expected, MakeShared<Config>(4, &destroyed), MemoryOrder::acquireRelease));
+        TEST_ENSURE(a.Load(MemoryOrder::acquire)->version == 4);
+
+        expected.Reset();
+        TEST_ENSURE(destroyed.Load(MemoryOrder::relaxed) == 2);
+    }
+    TEST_ENSURE(destroyed.Load(MemoryOrder::relaxed) == 4);
+
+    return 0;
+}
+
+int32 TestWeak()
+{
+    Atomic<int32> destroyed(0);
+    SharedPtr<Config> p = MakeShared<Config>(1, &destroyed);
+
+    AtomicWeakPtr<Config> a(p);
+    TEST_ENSURE(a.Load(MemoryOrder::acquire).Lock().Equals(p));
+
+    p.Reset();
+    TEST_ENSURE(destroyed.Load(MemoryOrder::relaxed) == 1);
+    TEST_ENSURE(a.Load(MemoryOrder::acquire).Lock() == nullptr);
+
+    return 0;
+}
+
+int32 TestWait()
+{
+    Atomic<int32> destroyed(0);
+    AtomicSharedPtr<Config> a(MakeShared<Config>(1, &destroyed));
+    SharedPtr<Config> old = a.Load(MemoryOrder::acquire);
+    Atomic<bool> failed(false);
+
+    std::thread waiter([&]() {
+        a.Wait(old, MemoryOrder::acquire);
+        if (a.Load(MemoryOrder::acquire)->version != 2) {
+            failed.Store(true, MemoryOrder::relaxed);
+        }
+    });
+
+    a.Store(MakeShared<Config>(2, &destroyed), MemoryOrder::sequential);
+    a.NotifyAll();
+    waiter.join();
+
+    TEST_ENSURE(!failed.Load(MemoryOrder::relaxed));
+
+    return 0;
+}
+
+int32 TestConcurrent()
+{
+    static constexpr int32 readerCount = 4;
+    static constexpr int32 storeCount = 10000;
+
+    Atomic<int32> destroyed(0);
+    {
+        AtomicSharedPtr<Config> a(MakeShared<Config>(0, &destroyed));
+        Atomic<bool> done(false);
+        Atomic<int32> reordered(0);
+
+        std::thread readers[readerCount];
+        for (std::thread& reader : readers) {
+            reader = std::thread([&]() {
+                int32 last = 0;
+                while (!done.Load(MemoryOrder::acquire)) {
+                    SharedPtr<Config> p = a.Load(MemoryOrder::acquire);
+                    if (p->version < last) {
+                        reordered.FetchAdd(1, MemoryOrder::relaxed);
+                    }
+
+                    last = p->version;
+                }
+            });
+        }
+
+        for (int32 i = 1; i <= storeCount; ++i) {
+            a.Store(MakeShared<Config>(i, &destroyed), MemoryOrder::release);
+        }
+
+        done.Store(true, MemoryOrder::release);
+        for (std::thread& reader : readers) {
+            reader.join();
+        }
+
+        TEST_ENSURE(reordered.Load(MemoryOrder::relaxed) == 0);
+        TEST_ENSURE(destroyed.Load(MemoryOrder::relaxed) == storeCount);
+    }
+    TEST_ENSURE(destroyed.Load(MemoryOrder::relaxed) == storeCount + 1);
+
+    return 0;
+}
+
+int32 main()
+{
+    TEST_ENSURE(TestLoadStore() == 0);
+    TEST_ENSURE(TestExchange() == 0);
+    TEST_ENSURE(TestWeak() == 0);
+    TEST_ENSURE(TestWait() == 0);
+    TEST_ENSURE(TestConcurrent() == 0);
+
+    return 0;
+}
\ No newline at end of file
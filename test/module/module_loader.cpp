@@ -0,0 +1,133 @@
+#include "test_macro.h"
+
+import mini.test;
+
+using namespace mini;
+using namespace mini::test;
+
+static Atomic<uint32> initCount;
+
+class OrderModule final : public ModuleInterface {
+public:
+    uint32 order;
+    Thread::Id thread;
+
+    OrderModule() noexcept
+        : order(0)
+        , thread(0)
+    {
+    }
+
+protected:
+    bool Initialize() final
+    {
+        // give independent modules the chance to overlap
+        Thread::SleepFor(MilliSeconds(5));
+        order = initCount.FetchAdd(1, MemoryOrder::acquireRelease);
+        thread = Thread::CurrentId();
+        return true;
+    }
+};
+
+struct OrderFactory {
+    ModuleInterface* operator()() const noexcept { return new OrderModule(); }
+};
+
+static ModuleStartupRecord const* FindRecord(Array<ModuleStartupRecord> const& records, StringView name)
+{
+    for (ModuleStartupRecord const& record : records) {
+        if (StringView(record.name) == name) {
+            return &record;
+        }
+    }
+
+    return nullptr;
+}
+
+static uint32 OrderOf(StringView name)
+{
+    Module<OrderModule> module(name);
+    return module.Valid() ? module->order : ~0u;
+}
+
+int32 TestGraph()
+{
+    StaticModuleInitializer<OrderFactory>::Register("test.base");
+    StaticModuleInitializer<OrderFactory>::Register("test.left");
+    StaticModuleInitializer<OrderFactory>::Register("test.right");
+    StaticModuleInitializer<OrderFactory>::Register("test.top");
+
+    g_moduleLoader.Declare("test.left", { "test.base" });
+    g_moduleLoader.Declare("test.right", { "test.base" });
+    g_moduleLoader.Declare("test.top", { "test.left", "test.right" }, true);
+
+    ModuleGroup group;
+    TEST_ENSURE(group.Load({ "test.top" }, 2));
+    TEST_ENSURE(group.Size() == 4);
+    TEST_ENSURE(g_moduleLoader.Count() == 4);
+
+    // modules of the group are shared with every later load of their name
+    TEST_ENSURE(OrderOf("test.base") == 0);
+    TEST_ENSURE(OrderOf("test.left") < 3 && OrderOf("test.right") < 3);
+    TEST_ENSURE(OrderOf("test.top") == 3);
+
+    Module<OrderModule> top("test.top");
+    TEST_ENSURE(top->thread == Thread::CurrentId());
+
+    top.Release();
+    group.Release();
+    TEST_ENSURE(g_moduleLoader.Count() == 0);
+
+    return 0;
+}
+
+int32 TestStartup()
+{
+    Array<ModuleStartupRecord> records;
+    ModuleStartup::Collect(records);
+
+    ModuleStartupRecord const* base = FindRecord(records, "test.base");
+    ModuleStartupRecord const* top = FindRecord(records, "test.top");
+    TEST_ENSURE(base != nullptr && top != nullptr);
+    TEST_ENSURE(!base->dynamic && base->loaded);
+    TEST_ENSURE(base->open.Count() == 0);
+    TEST_ENSURE(base->initialize >= MilliSeconds(5));
+
+    // the top module waited for two layers of dependencies, each sleeping in its initialization
+    TEST_ENSURE(top->wait >= MilliSeconds(10));
+    TEST_ENSURE(top->thread == Thread::CurrentId());
+
+    String report;
+    ModuleStartup::Report(report);
+    TEST_ENSURE(Contains(report, "module test.top static"));
+
+    String trace;
+    ModuleStartup::ExportTrace(trace);
+    TEST_ENSURE(Contains(trace, "\"test.top initialize\""));
+
+    return 0;
+}
+
+int32 TestMissingDependency()
+{
+    StaticModuleInitializer<OrderFactory>::Register("test.user");
+    g_moduleLoader.Declare("test.user", { "test.missing" });
+
+    // a module is not initialized when one of its dependencies failed to load
+    uint32 count = initCount.Load(MemoryOrder::acquire);
+    ModuleGroup group;
+    TEST_ENSURE(!group.Load({ "test.user" }));
+    TEST_ENSURE(group.Size() == 0);
+    TEST_ENSURE(initCount.Load(MemoryOrder::acquire) == count);
+
+    return 0;
+}
+
+int32 main()
+{
+    TEST_ENSURE(TestGraph() == 0);
+    TEST_ENSURE(TestStartup() == 0);
+    TEST_ENSURE(TestMissingDependency() == 0);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include "test_macro.h"
+
+import mini.test;
+import mini.softgpu;
+
+using namespace mini;
+using namespace mini::test;
+using namespace mini::softgpu;
+
+static Vertex MakeVertex(float32 x, float32 y, float32 z, Color const& color)
+{
+    return Vertex{ Vector4(x, y, z, 1.f), color };
+}
+
+static int32 CountCovered(FrameBuffer const& buffer)
+{
+    int32 count = 0;
+    for (int32 y = 0; y < buffer.Height(); ++y) {
+        for (int32 x = 0; x < buffer.Width(); ++x) {
+            count += (buffer.GetPixel(x, y) >> 24) != 0 ? 1 : 0;
+        }
+    }
+
+    return count;
+}
+
+static int32 DrawCovered(int32 width, int32 height, Vertex const* vertices, size_t count)
+{
+    FrameBuffer buffer;
+    TEST_ENSURE(buffer.Resize(width, height));
+
+    Rasterizer rasterizer;
+    rasterizer.SetViewport(Rect(0.f, 0.f, float32(width), float32(height)), 0.f, 1.f);
+    rasterizer.SetClearColor(Color::Clear());
+    rasterizer.Submit(vertices, count);
+    rasterizer.Draw(buffer);
+
+    return CountCovered(buffer);
+}
+
+int32 TestCoverage()
+{
+    Color red = Color::Red();
+    Vertex lower[3] = { MakeVertex(-1.f, -1.f, 0.5f, red),
+                        MakeVertex(1.f, -1.f, 0.5f, red),
+                        MakeVertex(1.f, 1.f, 0.5f, red) };
+    Vertex upper[3] = { MakeVertex(-1.f, -1.f, 0.5f, red),
+                        MakeVertex(1.f, 1.f, 0.5f, red),
+                        MakeVertex(-1.f, 1.f, 0.5f, red) };
+
+    // pixels on the shared edge belong to exactly one of the two triangles
+    int32 lowerCount = DrawCovered(100, 70, lower, 3);
+    int32 upperCount = DrawCovered(100, 70, upper, 3);
+    TEST_ENSURE(lowerCount + upperCount == 100 * 70);
+
+    Vertex both[6] = { lower[0], lower[1], lower[2], upper[0], upper[1], upper[2] };
+    TEST_ENSURE(DrawCovered(100, 70, both, 6) == 100 * 70);
+
+    return 0;
+}
+
+int32 TestClipping()
+{
+    // a triangle far larger than the clip volume is clipped into a polygon covering the whole buffer
+    Color white = Color::White();
+    Vertex large[3] = { MakeVertex(-5.f, -5.f, 0.5f, white),
+                        MakeVertex(5.f, -5.f, 0.5f, white),
+                        MakeVertex(0.f, 8.f, 0.5f, white) };
+    TEST_ENSURE(DrawCovered(64, 64, large, 3) == 64 * 64);
+
+    // behind the near plane nothing is left
+    Vertex behind[3] = { MakeVertex(-1.f, -1.f, -0.5f, white),
+                         MakeVertex(1.f, -1.f, -0.5f, white),
+                         MakeVertex(0.f, 1.f, -0.5f, white) };
+    TEST_ENSURE(DrawCovered(64, 64, behind, 3) == 0);
+
+    return 0;
+}
+
+int32 TestDepth()
+{
+    FrameBuffer buffer;
+    TEST_ENSURE(buffer.Resize(40, 40));
+
+    Vertex vertices[6] = {
+        MakeVertex(-1.f, -1.f, 0.2f, Color::Red()),   MakeVertex(3.f, -1.f, 0.2f, Color::Red()),
+        MakeVertex(-1.f, 3.f, 0.2f, Color::Red()),    MakeVertex(-1.f, -1.f, 0.8f, Color::Green()),
+        MakeVertex(3.f, -1.f, 0.8f, Color::Green()),  MakeVertex(-1.f, 3.f, 0.8f, Color::Green()),
+    };
+
+    // the farther triangle is drawn later and hidden behind the nearer one
+    Rasterizer rasterizer;
+    rasterizer.SetViewport(Rect(0.f, 0.f, 40.f, 40.f), 0.f, 1.f);
+    rasterizer.Submit(vertices, 6);
+    rasterizer.Draw(buffer);
+
+    TEST_ENSURE(buffer.GetPixel(20, 20) == PackColor(Color::Red()));
+    TEST_ENSURE(buffer.DepthData()[20 * buffer.Pitch() + 20] < 0.5f);
+
+    return 0;
+}
+
+static Array<Vertex> MakeRandomVertices()
+{
+    Array<Vertex> vertices;
+    uint32 seed = 1;
+    auto random = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return float32(seed >> 8) / float32(1 << 24);
+    };
+
+    for (int32 i = 0; i < 300; ++i) {
+        Color color(random(), random(), random(), 1.f);
+        vertices.Push(MakeVertex(random() * 2.4f - 1.2f, random() * 2.4f - 1.2f, random(), color));
+    }
+
+    return vertices;
+}
+
+static uint64 DrawHash(Array<Vertex> const& vertices, uint32 workers, bool simd)
+{
+    FrameBuffer buffer;
+    if (!buffer.Resize(203, 150)) {
+        return 0;
+    }
+
+    Rasterizer rasterizer(workers);
+    rasterizer.SetSimd(simd);
+    rasterizer.SetViewport(Rect(0.f, 0.f, 203.f, 150.f), 0.f, 1.f);
+    rasterizer.Submit(vertices.Data(), vertices.Size());
+    rasterizer.Draw(buffer);
+
+    return buffer.Hash();
+}
+
+int32 TestThreads()
+{
+    Array<Vertex> vertices = MakeRandomVertices();
+
+    // tiles are shaded by whichever thread takes them, the image has to come out the same
+    uint64 single = DrawHash(vertices, 0, true);
+    TEST_ENSURE(single != 0);
+    TEST_ENSURE(DrawHash(vertices, 3, true) == single);
+
+    return 0;
+}
+
+int32 TestKernels()
+{
+    Array<Vertex> vertices = MakeRandomVertices();
+
+    // the scalar kernel is the reference, the SIMD kernel of the processor has to write the same pixels
+    Rasterizer rasterizer;
+    rasterizer.SetSimd(false);
+    TEST_ENSURE(rasterizer.SimdEnabled() == false);
+    rasterizer.SetSimd(true);
+    TEST_ENSURE(rasterizer.SimdEnabled() == Rasterizer::SimdSupported());
+
+    uint64 scalar = DrawHash(vertices, 0, false);
+    TEST_ENSURE(scalar != 0);
+    TEST_ENSURE(DrawHash(vertices, 0, true) == scalar);
+    TEST_ENSURE(DrawHash(vertices, 3, false) == scalar);
+
+    return 0;
+}
+
+int32 main()
+{
+    TEST_ENSURE(TestCoverage() == 0);
+    TEST_ENSURE(TestClipping() == 0);
+    TEST_ENSURE(TestDepth() == 0);
+    TEST_ENSURE(TestThreads() == 0);
+    TEST_ENSURE(TestKernels() == 0);
+
+    return 0;
+}
\ No newline at end of file
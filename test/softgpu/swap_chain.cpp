@@ -0,0 +1,45 @@
+#include "test_macro.h"
+
+import mini.test;
+import mini.softgpu;
+
+using namespace mini;
+using namespace mini::test;
+using namespace mini::softgpu;
+
+int32 TestResize()
+{
+    SwapChain swapChain;
+    TEST_ENSURE(swapChain.Initialize());
+
+    uint8 count = swapChain.GetBackBufferCount();
+    Vector2Int size = swapChain.GetBackBufferSize();
+    TEST_ENSURE(count != 0);
+
+    // a size past the limit is refused, the swap chain keeps presenting into the buffers it had
+    swapChain.ResizeBackBuffer(static_cast<uint32>(MaxDimension) + 1, 16, true);
+    TEST_ENSURE(swapChain.GetBackBufferCount() == count);
+    TEST_ENSURE(swapChain.GetBackBufferSize() == size);
+    TEST_ENSURE(swapChain.GetFullScreen() == false);
+
+    for (uint8 i = 0; i <= count; ++i) {
+        TEST_ENSURE(swapChain.GetCurrentBuffer()->Width() == size.x);
+        swapChain.Present();
+    }
+    TEST_ENSURE(swapChain.GetPresentedBuffer() != nullptr);
+
+    swapChain.ResizeBackBuffer(64, 32, true);
+    TEST_ENSURE(swapChain.GetBackBufferCount() == count);
+    TEST_ENSURE(swapChain.GetBackBufferSize() == Vector2Int(64, 32));
+    TEST_ENSURE(swapChain.GetFullScreen());
+    TEST_ENSURE(swapChain.GetPresentedBuffer() == nullptr);
+
+    return 0;
+}
+
+int32 main()
+{
+    TEST_ENSURE(TestResize() == 0);
+
+    return 0;
+}
\ No newline at end of file
@@ -86,6 +86,71 @@ struct DebugAlloc : public Allocator<T> {
     DebugAlloc& operator=(DebugAlloc&&) noexcept = default;
 };
 
+TEST_API inline bool Contains(StringView text, StringView pattern)
+{
+    for (size_t i = 0; i + pattern.Size() <= text.Size(); ++i) {
+        if (text.SubString(i, pattern.Size()) == pattern) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+TEST_API inline bool EndsWith(StringView text, StringView suffix)
+{
+    return text.Size() >= suffix.Size() && text.SubString(text.Size() - suffix.Size(), suffix.Size()) == suffix;
+}
+
+// Messages written by a CaptureSink, together with the gate holding its sink thread.
+struct TEST_API CaptureState {
+public:
+    Mutex lock;
+    Array<String> lines;
+    Atomic<uint32> entered;
+    Atomic<uint32> open;
+
+    CaptureState() noexcept
+        : entered(0)
+        , open(1)
+    {
+    }
+
+    size_t Count()
+    {
+        lock.Lock();
+        size_t count = lines.Size();
+        lock.Unlock();
+        return count;
+    }
+};
+
+// Log sink keeping every message it is handed in its state.
+// Closing the gate of the state holds the sink thread in Write, so tests can fill up the queue behind it.
+class TEST_API CaptureSink final : public LogSink {
+private:
+    CaptureState* m_state;
+
+public:
+    explicit CaptureSink(CaptureState* state) noexcept
+        : m_state(state)
+    {
+    }
+
+    void Write(LogRecord const& record) final
+    {
+        m_state->entered.Store(1, MemoryOrder::release);
+        m_state->entered.NotifyAll();
+        while (m_state->open.Load(MemoryOrder::acquire) == 0) {
+            m_state->open.Wait(0, MemoryOrder::acquire);
+        }
+
+        m_state->lock.Lock();
+        m_state->lines.Push(String(record.Message()));
+        m_state->lock.Unlock();
+    }
+};
+
 // clang-format off
 
 struct TEST_API TestObject {